@@ -1,1991 +1,7146 @@
-﻿// BiNums, see binary numbers
-
-#include "precomp.h"
-
-////////////////////////////////////////////////////////////////////////////////
-// Generic functions/classes.
-
-template <typename Enum>
-bool ComparedMaskedFlags(Enum fullEnum, Enum mask, Enum subvalue)
-{
-    static_assert(sizeof(Enum) == sizeof(uint32_t)); // Doesn't work with 64-bit enums.
-    return (static_cast<uint32_t>(fullEnum) & static_cast<uint32_t>(mask)) == static_cast<uint32_t>(subvalue);
-}
-
-template <typename Enum>
-Enum SetFlags(Enum e, Enum clear, Enum set)
-{
-    return static_cast<Enum>((static_cast<uint32_t>(e) & ~static_cast<uint32_t>(clear)) | static_cast<uint32_t>(set));
-}
-
-template <typename T, typename O>
-T& CastReferenceAs(O& o)
-{
-    static_assert(sizeof(T) <= sizeof(O));
-    return reinterpret_cast<T&>(o);
-}
-
-template <typename T, typename O>
-const T& CastReferenceAs(O const& o)
-{
-    static_assert(sizeof(T) <= sizeof(O));
-    return reinterpret_cast<const T&>(o);
-}
-
-// The format string is compatible with printf (not std::format).
-std::string GetFormatted(char const* formatString, ...)
-{
-    std::string formattedMessage;
-
-    va_list argList;
-    va_start(argList, formatString);
-    char buffer[1000];
-    buffer[0] = 0;
-
-    vsnprintf(buffer, std::size(buffer), formatString, argList);
-    formattedMessage.assign(buffer);
-    return formattedMessage;
-}
-
-// The format string is compatible with printf (not std::format).
-void AppendFormatted(/*inout*/ std::string& s, char const* formatString, ...)
-{
-    std::string formattedMessage;
-
-    va_list argList;
-    va_start(argList, formatString);
-    char buffer[1000];
-    buffer[0] = 0;
-
-    vsnprintf(buffer, std::size(buffer), formatString, argList);
-    s.append(buffer);
-}
-
-constexpr size_t Hash(std::string_view input)
-{
-    size_t hash = sizeof(size_t) == 8 ? 0XCBF29CE484222325 : 0X811C9DC5;
-    const size_t prime = sizeof(size_t) == 8 ? 0X00000100000001B3 : 0X01000193;
-
-    for (auto ch : input)
-    {
-        hash ^= static_cast<size_t>(ch);
-        hash *= prime;
-    }
-
-    return hash;
-}
-
-// Place these around usage if Visual Studio unnecessarily complains:
-// #pragma warning(push)
-// #pragma warning(disable:4307) // "The overflow is deliberate - warning C4307: '*': integral constant overflow"
-// #pragma warning(pop)
-constexpr size_t Hash(_In_z_ const char* input)
-{
-    size_t hash = sizeof(size_t) == 8 ? 0XCBF29CE484222325 : 0X811C9DC5;
-    const size_t prime = sizeof(size_t) == 8 ? 0X00000100000001B3 : 0X01000193;
-
-    while (*input)
-    {
-        hash ^= static_cast<size_t>(*input);
-        hash *= prime;
-        ++input;
-    }
-
-    return hash;
-}
-
-using namespace std::literals::string_view_literals;
-
-////////////////////////////////////////////////////////////////////////////////
-
-using Fixed24f12i12 = FixedNumber<int24_t, 12, 12>;
-using Fixed32f16i16 = FixedNumber<int32_t, 16, 16>;
-using Fixed32f24i8  = FixedNumber<int32_t, 8, 24>;
-
-// TODO: Support all these from:
-// https://onnx.ai/onnx/technical/float8.html
-// https://github.com/onnx/onnx/blob/main/onnx/reference/custom_element_types.py
-//
-// bfloat16 = np.dtype((np.uint16, {"bfloat16": (np.uint16, 0)}))
-// float8e4m3fn = np.dtype((np.uint8, {"e4m3fn": (np.uint8, 0)}))
-// float8e4m3fnuz = np.dtype((np.uint8, {"e4m3fnuz": (np.uint8, 0)}))
-// float8e5m2 = np.dtype((np.uint8, {"e5m2": (np.uint8, 0)}))
-// float8e5m2fnuz = np.dtype((np.uint8, {"e5m2fnuz": (np.uint8, 0)}))
-
-union NumberUnion
-{
-    uint8_t         buffer[8];
-    uint8_t         ui8;
-    uint16_t        ui16;
-    uint32_t        ui32;
-    uint64_t        ui64;
-    int8_t          i8;
-    int16_t         i16;
-    int32_t         i32;
-    int64_t         i64;
-    float8m3e4s1_t  f3e4s1;
-    float8m2e5s1_t  f2e5s1;
-    float16_t       f16;
-    float16m7e8s1_t f16m7e8s1;
-    float32_t       f32;
-    float64_t       f64;
-    Fixed24f12i12   x24f12i12;
-    Fixed32f16i16   x32f16i16;
-    Fixed32f24i8    x32f24i8;
-
-    NumberUnion() : ui64(0) {}
-};
-
-enum class ElementType : uint32_t
-{
-    Undefined = 0,
-    Float32 = 1,    // starting from bit 0 - mantissa:23 exponent:8 sign:1
-    Uint8 = 2,
-    Int8 = 3,
-    Uint16 = 4,
-    Int16 = 5,
-    Int32 = 6,
-    Int64 = 7,
-    StringChar8 = 8,
-    Bool8 = 9,
-    Float16m10e5s1 = 10, // mantissa:10 exponent:5 sign:1
-    Float16 = Float16m10e5s1,
-    Float64 = 11,   // mantissa:52 exponent:11 sign:1
-    Uint32 = 12,
-    Uint64 = 13,
-    Complex64 = 14,
-    Complex128 = 15,
-    Float16m7e8s1 = 16,   // mantissa:7 exponent:8 sign:1
-    Bfloat16 = Float16m7e8s1,
-    Fixed24f12i12 = 17, // TODO: Make naming more consistent. Fixed24f12i12 vs Fixed12_12
-    Fixed32f16i16 = 18,
-    Fixed32f24i8 = 19,
-    Float8m2e5s1 = 20, // mantissa:2 exponent:5 sign:1
-    Float8m3e4s1 = 21, // mantissa:3 exponent:4 sign:1
-    Total = 22,
-};
-
-enum class NumericOperationType : uint32_t
-{
-    None,       // Invalid value
-    Nothing,    // No result, taking N outputs, returning 0 outputs
-    Nop,            // No operation, taking N inputs, returning N outputs (identity)
-    Identity = Nop,
-    Add,
-    Subtract,
-    Multiply,
-    Divide,
-    Dot,
-    Truncate,
-    Total
-};
-
-enum class NumericPrintingFlags : uint32_t
-{
-    ShowNumericType = 1 << 0,
-    ShowNumericValue = 1 << 1,
-    ShowBinaryValue = 1 << 2,
-
-    ShowRawHex = 0 << 4,
-    ShowRawBinary = 1 << 4,
-    ShowRawDecimal = 2 << 4,
-    ShowRawOctal = 3 << 4,
-    ShowDataMask = 3 << 4,
-
-    ShowFloatDecimal = 0 << 6,
-    ShowFloatHex = 1 << 6,
-    ShowFloatMask = 1 << 6,
-
-    HideRawFields = 0 << 7,
-    ShowRawFields = 1 << 7,
-    ShowRawFieldsMask = 1 << 7,
-
-    ShowRawBinaryFields = ShowRawBinary | ShowRawFields,
-
-    Default = ShowBinaryValue | ShowNumericValue | ShowNumericType,
-};
-
-inline constexpr NumericPrintingFlags operator ~ (NumericPrintingFlags lhs) { return NumericPrintingFlags(~uint32_t(lhs)); }
-inline constexpr NumericPrintingFlags operator & (NumericPrintingFlags lhs, NumericPrintingFlags rhs) { return NumericPrintingFlags(uint32_t(lhs) & uint32_t(rhs)); }
-inline constexpr NumericPrintingFlags operator | (NumericPrintingFlags lhs, NumericPrintingFlags rhs) { return NumericPrintingFlags(uint32_t(lhs) & uint32_t(rhs)); }
-inline constexpr bool operator == (NumericPrintingFlags lhs, uint32_t rhs) { return uint32_t(lhs) == rhs; }
-inline constexpr bool operator != (NumericPrintingFlags lhs, uint32_t rhs) { return uint32_t(lhs) != rhs; }
-
-struct NumberUnionAndType
-{
-    NumberUnion numberUnion;
-    ElementType elementType;
-    NumericPrintingFlags printingFlags = NumericPrintingFlags::Default;
-};
-
-struct NumericOperationAndRange
-{
-    NumericOperationType numericOperationType;
-    Range range;
-    ElementType outputElementType;
-};
-
-// TODO: Utilize nested operands instead of single operator lists.
-struct Operand
-{
-    SmallEnum<NumericOperationType, uint8_t> numericOperationType;
-    SmallEnum<ElementType, uint8_t> elementType;
-    uint8_t padding[2];
-    NumericPrintingFlags printingFlags;
-    union
-    {
-        NumberUnion numberUnion;
-        Range range;
-    };
-};
-
-struct NumberSubstructure
-{
-    Range fraction;
-    Range integer;
-    Range exponent;
-    Range sign;
-
-    // e.g. {0,30, 0,0, 30,31, 31,32} float32
-};
-
-////////////////////////////////////////////////////////////////////////////////
-
-const char* g_numericOperationTypeNames[] =
-{
-    "none",
-    "nothing",
-    "nop",
-    "add",
-    "subtract",
-    "multiply",
-    "divide",
-    "dot",
-    "truncate",
-};
-static_assert(int(NumericOperationType::Total) == 9 && std::size(g_numericOperationTypeNames) == 9);
-
-const char* g_elementTypeNames[] =
-{
-    "undefined",    // Undefined = 0,
-    "float32",      // Float32 = 1,
-    "uint8",        // Uint8 = 2,
-    "int8",         // Int8 = 3,
-    "uint16",       // Uint16 = 4,
-    "int16",        // Int16 = 5,
-    "int32",        // Int32 = 6,
-    "int64",        // Int64 = 7,
-    "string8",      // StringChar8 = 8,
-    "bool8",        // Bool = 9,
-    "float16",      // Float16 = 10,
-    "float64",      // Float64 = 11,
-    "uint32",       // Uint32 = 12,
-    "uint64",       // Uint64 = 13,
-    "complex64",    // Complex64 = 14,
-    "complex128",   // Complex128 = 15,
-    "bfloat16",     // Float16m7e8s1 = 16,
-    "fixed12_12",   // Fixed24f12i12 = 17,
-    "fixed16_16",   // Fixed32f16i16 = 18,
-    "fixed8_24",    // Fixed32f24i8 = 19,
-    "float8f3e4s1", // Float8f3e4s1 = 20,
-    "float8f2e5s1", // Float8f2e5s1 = 21,
-};
-static_assert(int(ElementType::Total) == 22 && std::size(g_elementTypeNames) == 22);
-
-const static uint8_t g_byteSizeOfElementType[] =
-{
-    0,  // Undefined = 0,
-    4,  // Float32 = 1,
-    1,  // Uint8 = 2,
-    1,  // Int8 = 3,
-    2,  // Uint16 = 4,
-    2,  // Int16 = 5,
-    4,  // Int32 = 6,
-    8,  // Int64 = 7,
-    0,  // sizeof(TypedBufferStringElement), // StringChar8 = 8,
-    1,  // Bool = 9,
-    2,  // Float16 = 10,
-    8,  // Float64 = 11,
-    4,  // Uint32 = 12,
-    8,  // Uint64 = 13,
-    8,  // Complex64 = 14,
-    16, // Complex128 = 15,
-    2,  // Float16m7e8s1 = 16,
-    3,  // Fixed24f12i12 = 17,
-    4,  // Fixed32f16i16 = 18,
-    4,  // Fixed32f24i8 = 19,
-    1,  // Float8f3e4s1 = 20,
-    1,  // Float8f2e5s1 = 21,
-};
-static_assert(int(ElementType::Total) == 22 && std::size(g_byteSizeOfElementType) == 22);
-
-const static uint8_t g_isFractionalElementType[] =
-{
-    false, // Undefined = 0,
-    true , // Float32 = 1,
-    false, // Uint8 = 2,
-    false, // Int8 = 3,
-    false, // Uint16 = 4,
-    false, // Int16 = 5,
-    false, // Int32 = 6,
-    false, // Int64 = 7,
-    false, // sizeof(TypedBufferStringElement), // StringChar8 = 8,
-    false, // Bool = 9,
-    true , // Float16 = 10,
-    true , // Float64 = 11,
-    false, // Uint32 = 12,
-    false, // Uint64 = 13,
-    true , // Complex64 = 14,
-    true , // Complex128 = 15,
-    true , // Float16m7e8s1 = 16,
-    true , // Fixed24f12i12 = 17,
-    true , // Fixed32f16i16 = 18,
-    true , // Fixed32f24i8 = 19,
-    true , // Float8f3e4s1 = 20,
-    true , // Float8f2e5s1 = 21,
-};
-static_assert(int(ElementType::Total) == 22 && std::size(g_isFractionalElementType) == 22);
-
-const static uint8_t g_isSignedElementType[] =
-{
-    false, // Undefined = 0,
-    true , // Float32 = 1,
-    false, // Uint8 = 2,
-    true , // Int8 = 3,
-    false, // Uint16 = 4,
-    true , // Int16 = 5,
-    true , // Int32 = 6,
-    true , // Int64 = 7,
-    false, // sizeof(TypedBufferStringElement), // StringChar8 = 8,
-    false, // Bool = 9,
-    true , // Float16 = 10,
-    true , // Float64 = 11,
-    false, // Uint32 = 12,
-    false, // Uint64 = 13,
-    true , // Complex64 = 14,
-    true , // Complex128 = 15,
-    true , // Float16m7e8s1 = 16,
-    true , // Fixed24f12i12 = 17,
-    true , // Fixed32f16i16 = 18,
-    true , // Fixed32f24i8 = 19,
-    true , // Float8f3e4s1 = 20,
-    true , // Float8f2e5s1 = 21,
-};
-static_assert(int(ElementType::Total) == 22 && std::size(g_isSignedElementType) == 22);
-
-// ElementType enum reordered by priority of promotion rules.
-enum class ElementTypePriority : uint32_t
-{
-    Undefined,
-    Bool8,
-    StringChar8,
-    Uint8,
-    Int8,
-    Uint16,
-    Int16,
-    Uint32,
-    Int32,
-    Uint64,
-    Int64,
-    Float16m10e5s1,
-    Float16 = Float16m10e5s1,
-    Float16m7e8s1,
-    Bfloat16 = Float16m7e8s1,
-    Fixed32f24i8,
-    Fixed24f12i12,
-    Fixed32f16i16,
-    Float32,
-    Float64,
-    Complex64,
-    Complex128,
-    Float8f3e4s1,
-    Float8f2e5s1,
-    Total,
-};
-static_assert(size_t(ElementType::Total) == size_t(ElementTypePriority::Total));
-
-const ElementTypePriority g_elementTypePriorityTable[] = // The index is an ElementType enum.
-{
-    /* Undefined = 0       */ ElementTypePriority::Undefined,
-    /* Float32 = 1         */ ElementTypePriority::Float32,
-    /* Uint8 = 2           */ ElementTypePriority::Uint8,
-    /* Int8 = 3            */ ElementTypePriority::Int8,
-    /* Uint16 = 4          */ ElementTypePriority::Uint16,
-    /* Int16 = 5           */ ElementTypePriority::Int16,
-    /* Int32 = 6           */ ElementTypePriority::Int32,
-    /* Int64 = 7           */ ElementTypePriority::Int64,
-    /* StringChar8 = 8     */ ElementTypePriority::StringChar8,
-    /* Bool8 = 9           */ ElementTypePriority::Bool8,
-    /* Float16m10e5s1 = 10 */ ElementTypePriority::Float16m10e5s1,
-    /* Float64 = 11        */ ElementTypePriority::Float64,
-    /* Uint32 = 12         */ ElementTypePriority::Uint32,
-    /* Uint64 = 13         */ ElementTypePriority::Uint64,
-    /* Complex64 = 14      */ ElementTypePriority::Complex64,
-    /* Complex128 = 15     */ ElementTypePriority::Complex128,
-    /* Float16m7e8s1 = 16  */ ElementTypePriority::Float16m7e8s1,
-    /* Fixed24f12i12 = 17  */ ElementTypePriority::Fixed24f12i12,
-    /* Fixed32f16i16 = 18  */ ElementTypePriority::Fixed32f16i16,
-    /* Fixed32f24i8 = 19   */ ElementTypePriority::Fixed32f24i8,
-    /* Float8f3e4s1 = 20   */ ElementTypePriority::Float8f3e4s1,
-    /* Float8f2e5s1 = 21   */ ElementTypePriority::Float8f2e5s1,
-};
-static_assert(std::size(g_elementTypePriorityTable) == size_t(ElementType::Total));
-
-const NumberSubstructure g_elementTypeSubstructures[] = // The index is an ElementType enum.
-{
-    //                       fraction, integer, exponent, sign
-    /* Undefined = 0       */ {{ 0, 0},{ 0, 0},{ 0, 0},{ 0, 0}},
-    /* Float32 = 1         */ {{ 0,23},{ 0, 0},{23,31},{31,32}},
-    /* Uint8 = 2           */ {{ 0, 0},{ 0, 8},{ 0, 0},{ 0, 0}},
-    /* Int8 = 3            */ {{ 0, 0},{ 0, 7},{ 0, 0},{ 7, 8}},
-    /* Uint16 = 4          */ {{ 0, 0},{ 0,16},{ 0, 0},{ 0, 0}},
-    /* Int16 = 5           */ {{ 0, 0},{ 0,15},{ 0, 0},{15,16}},
-    /* Int32 = 6           */ {{ 0, 0},{ 0,31},{ 0, 0},{31,32}},
-    /* Int64 = 7           */ {{ 0, 0},{ 0,63},{ 0, 0},{63,64}},
-    /* StringChar8 = 8     */ {{ 0, 0},{ 0, 0},{ 0, 0},{ 0, 0}},
-    /* Bool8 = 9           */ {{ 0, 0},{ 0, 8},{ 0, 0},{ 0, 0}},
-    /* Float16m10e5s1 = 10 */ {{ 0,10},{ 0, 0},{10,15},{15,16}},
-    /* Float64 = 11        */ {{ 0,52},{ 0, 0},{52,63},{63,64}},
-    /* Uint32 = 12         */ {{ 0, 0},{ 0,32},{ 0, 0},{ 0, 0}},
-    /* Uint64 = 13         */ {{ 0, 0},{ 0,64},{ 0, 0},{ 0, 0}},
-    /* Complex64 = 14      */ {{ 0,23},{ 0, 0},{23,31},{31,32}},
-    /* Complex128 = 15     */ {{ 0,52},{ 0, 0},{52,63},{63,64}},
-    /* Float16m7e8s1 = 16  */ {{ 0, 7},{ 0, 0},{ 7,15},{15,16}},
-    /* Fixed24f12i12 = 17  */ {{ 0,12},{12,24},{ 0, 0},{ 0, 0}},
-    /* Fixed32f16i16 = 18  */ {{ 0,16},{16,32},{ 0, 0},{ 0, 0}},
-    /* Fixed32f24i8 = 19   */ {{ 0, 8},{ 8,32},{ 0, 0},{ 0, 0}},
-    /* Float8f3e4s1 = 20   */ {{ 0, 3},{ 0, 0},{ 3, 7},{ 7, 8}},
-    /* Float8f2e5s1 = 21   */ {{ 0, 2},{ 0, 0},{ 2, 7},{ 7, 8}},
-};
-static_assert(std::size(g_elementTypeSubstructures) == size_t(ElementType::Total));
-
-uint32_t GetSizeOfTypeInBytes(ElementType dataType) noexcept
-{
-    size_t index = static_cast<size_t>(dataType);
-    return g_byteSizeOfElementType[index < std::size(g_byteSizeOfElementType) ? index : 0];
-}
-
-uint32_t GetSizeOfTypeInBits(ElementType dataType) noexcept
-{
-    size_t index = static_cast<size_t>(dataType);
-    return g_byteSizeOfElementType[index < std::size(g_byteSizeOfElementType) ? index : 0] * 8;
-}
-
-std::string_view GetTypeNameFromElementType(ElementType dataType) noexcept
-{
-    size_t index = static_cast<size_t>(dataType);
-    return g_elementTypeNames[index < std::size(g_elementTypeNames) ? index : 0];
-}
-
-bool IsFractionalElementType(ElementType dataType) noexcept
-{
-    size_t index = static_cast<size_t>(dataType);
-    return g_isFractionalElementType[index < std::size(g_isFractionalElementType) ? index : 0];
-}
-
-bool IsSignedElementType(ElementType dataType) noexcept
-{
-    size_t index = static_cast<size_t>(dataType);
-    return g_isSignedElementType[index < std::size(g_isSignedElementType) ? index : 0];
-}
-
-NumberSubstructure const& GetElementTypeSubstructure(ElementType dataType) noexcept
-{
-    size_t index = static_cast<size_t>(dataType);
-    return g_elementTypeSubstructures[index < std::size(g_elementTypeSubstructures) ? index : 0];
-}
-
-// Read data type and cast to double.
-// The caller passes a data pointer of the given type.
-/*static*/ double ReadToDouble(ElementType dataType, const void* data)
-{
-    double value = 0;
-    switch (dataType)
-    {
-    case ElementType::Float32:          value = *reinterpret_cast<const float*>(data);              break;
-    case ElementType::Uint8:            value = *reinterpret_cast<const uint8_t*>(data);            break;
-    case ElementType::Int8:             value = *reinterpret_cast<const int8_t*>(data);             break;
-    case ElementType::Uint16:           value = *reinterpret_cast<const uint16_t*>(data);           break;
-    case ElementType::Int16:            value = *reinterpret_cast<const int16_t*>(data);            break;
-    case ElementType::Int32:            value = *reinterpret_cast<const int32_t*>(data);            break;
-    case ElementType::Int64:            value = double(*reinterpret_cast<const int64_t*>(data));    break;
-    case ElementType::StringChar8:      value = 0; /* no numeric value for strings */               break;
-    case ElementType::Bool8:            value = *reinterpret_cast<const bool*>(data);               break;
-    case ElementType::Float16:          value = *reinterpret_cast<const float16_t*>(data);          break;
-    case ElementType::Bfloat16:         value = *reinterpret_cast<const bfloat16_t*>(data);         break;
-    case ElementType::Float64:          value = *reinterpret_cast<const double*>(data);             break;
-    case ElementType::Uint32:           value = *reinterpret_cast<const uint32_t*>(data);           break;
-    case ElementType::Uint64:           value = double(*reinterpret_cast<const uint64_t*>(data));   break;
-    case ElementType::Complex64:        throw std::invalid_argument("Complex64 type is not supported.");
-    case ElementType::Complex128:       throw std::invalid_argument("Complex128 type is not supported.");
-    case ElementType::Fixed24f12i12:    value = *reinterpret_cast<const Fixed24f12i12*>(data);      break;
-    case ElementType::Fixed32f16i16:    value = *reinterpret_cast<const Fixed32f16i16*>(data);      break;
-    case ElementType::Fixed32f24i8:     value = *reinterpret_cast<const Fixed32f24i8*>(data);       break;
-    default:                            assert(false);                                              break;
-    }
-
-    return value;
-}
-
-// Read data type and cast to int64.
-// The caller passes a data pointer of the given type.
-/*static*/ int64_t ReadToInt64(ElementType dataType, const void* data)
-{
-    int64_t value = 0;
-    switch (dataType)
-    {
-    case ElementType::Float32:          value = int64_t(*reinterpret_cast<const float*>(data));         break;
-    case ElementType::Uint8:            value = int64_t(*reinterpret_cast<const uint8_t*>(data));       break;
-    case ElementType::Int8:             value = int64_t(*reinterpret_cast<const int8_t*>(data));        break;
-    case ElementType::Uint16:           value = int64_t(*reinterpret_cast<const uint16_t*>(data));      break;
-    case ElementType::Int16:            value = int64_t(*reinterpret_cast<const int16_t*>(data));       break;
-    case ElementType::Int32:            value = int64_t(*reinterpret_cast<const int32_t*>(data));       break;
-    case ElementType::Int64:            value = int64_t(*reinterpret_cast<const int64_t*>(data));       break;
-    case ElementType::StringChar8:      value = int64_t(0); /* no numeric value for strings */          break;
-    case ElementType::Bool8:            value = int64_t(*reinterpret_cast<const bool*>(data));          break;
-    case ElementType::Float16:          value = int64_t(*reinterpret_cast<const float16_t*>(data));     break;
-    case ElementType::Bfloat16:         value = int64_t(*reinterpret_cast<const bfloat16_t*>(data));    break;
-    case ElementType::Float64:          value = int64_t(*reinterpret_cast<const double*>(data));        break;
-    case ElementType::Uint32:           value = int64_t(*reinterpret_cast<const uint32_t*>(data));      break;
-    case ElementType::Uint64:           value = int64_t(*reinterpret_cast<const uint64_t*>(data));      break;
-    case ElementType::Complex64:        throw std::invalid_argument("Complex64 type is not supported.");
-    case ElementType::Complex128:       throw std::invalid_argument("Complex128 type is not supported.");
-    case ElementType::Fixed24f12i12:    value = int64_t(*reinterpret_cast<const Fixed24f12i12*>(data)); break;
-    case ElementType::Fixed32f16i16:    value = int64_t(*reinterpret_cast<const Fixed32f16i16*>(data)); break;
-    case ElementType::Fixed32f24i8:;    value = int64_t(*reinterpret_cast<const Fixed32f24i8*>(data));  break;
-    default:                            assert(false);                                              break;
-    }
-
-    return value;
-}
-
-// Read the raw bits, returned as int64.
-// Useful for Unit Last Place comparisons.
-/*static*/ int64_t ReadRawBitValue(ElementType dataType, const void* data)
-{
-    int64_t value = 0;
-    switch (dataType)
-    {
-    case ElementType::Float32:          value = int64_t(*reinterpret_cast<const int32_t*>(data));   break;
-    case ElementType::Uint8:            value = int64_t(*reinterpret_cast<const uint8_t*>(data));   break;
-    case ElementType::Int8:             value = int64_t(*reinterpret_cast<const int8_t*>(data));    break;
-    case ElementType::Uint16:           value = int64_t(*reinterpret_cast<const uint16_t*>(data));  break;
-    case ElementType::Int16:            value = int64_t(*reinterpret_cast<const int16_t*>(data));   break;
-    case ElementType::Int32:            value = int64_t(*reinterpret_cast<const int32_t*>(data));   break;
-    case ElementType::Int64:            value = int64_t(*reinterpret_cast<const int64_t*>(data));   break;
-    case ElementType::StringChar8:      value = int64_t(0); /* no numeric value for strings */      break;
-    case ElementType::Bool8:            value = int64_t(*reinterpret_cast<const bool*>(data));      break;
-    case ElementType::Float16:          value = int64_t(*reinterpret_cast<const int16_t*>(data));   break;
-    case ElementType::Bfloat16:         value = int64_t(*reinterpret_cast<const int16_t*>(data));   break;
-    case ElementType::Float64:          value = int64_t(*reinterpret_cast<const int64_t*>(data));   break;
-    case ElementType::Uint32:           value = int64_t(*reinterpret_cast<const uint32_t*>(data));  break;
-    case ElementType::Uint64:           value = int64_t(*reinterpret_cast<const uint64_t*>(data));  break;
-    case ElementType::Complex64:        throw std::invalid_argument("Complex64 type is not supported.");
-    case ElementType::Complex128:       throw std::invalid_argument("Complex128 type is not supported.");
-    case ElementType::Fixed24f12i12:    value = int64_t(*reinterpret_cast<const int24_t*>(data));   break;
-    case ElementType::Fixed32f16i16:    value = int64_t(*reinterpret_cast<const int32_t*>(data));   break;
-    case ElementType::Fixed32f24i8:;    value = int64_t(*reinterpret_cast<const int32_t*>(data));   break;
-    default:                            assert(false);                                              break;
-    }
-
-    return value;
-}
-
-// The caller passes a data pointer of the given type.
-void WriteFromDouble(ElementType dataType, double value, /*out*/ void* data)
-{
-    switch (dataType)
-    {
-    case ElementType::Float32:          *reinterpret_cast<float*>(data) = float(value);             break;
-    case ElementType::Uint8:            *reinterpret_cast<uint8_t*>(data) = uint8_t(value);         break;
-    case ElementType::Int8:             *reinterpret_cast<int8_t*>(data) = int8_t(value);           break;
-    case ElementType::Uint16:           *reinterpret_cast<uint16_t*>(data) = uint16_t(value);       break;
-    case ElementType::Int16:            *reinterpret_cast<int16_t*>(data) = int16_t(value);         break;
-    case ElementType::Int32:            *reinterpret_cast<int32_t*>(data) = int32_t(value);         break;
-    case ElementType::Int64:            *reinterpret_cast<int64_t*>(data) = int64_t(value);         break;
-    case ElementType::StringChar8:      /* no change value for strings */                           break;
-    case ElementType::Bool8:            *reinterpret_cast<bool*>(data) = bool(value);               break;
-    case ElementType::Float16:          *reinterpret_cast<uint16_t*>(data) = half_float::detail::float2half<std::round_to_nearest, float>(float(value)); break;
-    case ElementType::Bfloat16:         *reinterpret_cast<bfloat16_t*>(data) = bfloat16_t(float(value)); break;
-    case ElementType::Float64:          *reinterpret_cast<double*>(data) = value;                   break;
-    case ElementType::Uint32:           *reinterpret_cast<uint32_t*>(data) = uint32_t(value);       break;
-    case ElementType::Uint64:           *reinterpret_cast<uint64_t*>(data) = uint64_t(value);       break;
-    case ElementType::Complex64:        throw std::invalid_argument("Complex64 type is not supported.");
-    case ElementType::Complex128:       throw std::invalid_argument("Complex128 type is not supported.");
-    case ElementType::Fixed24f12i12:    *reinterpret_cast<Fixed24f12i12*>(data) = float(value);     break;
-    case ElementType::Fixed32f16i16:    *reinterpret_cast<Fixed32f16i16*>(data) = float(value);     break;
-    case ElementType::Fixed32f24i8:;    *reinterpret_cast<Fixed32f24i8*>(data) = float(value);      break;
-    default:                            assert(false);                                              break;
-    }
-
-    // Use half_float::detail::float2half explicitly rather than the half constructor.
-    // Otherwise values do not round-trip as expected.
-    //
-    // e.g. If you print float16 0x2C29, you get 0.0650024, but if you try to parse
-    // 0.0650024, you get 0x2C28 instead. Then printing 0x2C28 shows 0.0649414,
-    // but trying to parse 0.0649414 returns 0x2C27. Rounding to nearest fixes this.
-}
-
-// The caller passes a data pointer of the given type.
-void WriteFromInt64(ElementType dataType, int64_t value, /*out*/ void* data)
-{
-    switch (dataType)
-    {
-    case ElementType::Float32:       *reinterpret_cast<float*>(data) = float(value);                    break;
-    case ElementType::Uint8:         *reinterpret_cast<uint8_t*>(data) = uint8_t(value);                break;
-    case ElementType::Int8:          *reinterpret_cast<int8_t*>(data) = int8_t(value);                  break;
-    case ElementType::Uint16:        *reinterpret_cast<uint16_t*>(data) = uint16_t(value);              break;
-    case ElementType::Int16:         *reinterpret_cast<int16_t*>(data) = int16_t(value);                break;
-    case ElementType::Int32:         *reinterpret_cast<int32_t*>(data) = int32_t(value);                break;
-    case ElementType::Int64:         *reinterpret_cast<int64_t*>(data) = int64_t(value);                break;
-    case ElementType::StringChar8:   /* no change value for strings */                                  break;
-    case ElementType::Bool8:         *reinterpret_cast<bool*>(data) = bool(value);                      break;
-    case ElementType::Float16:       *reinterpret_cast<float16_t*>(data) = float16_t(float(value));     break;
-    case ElementType::Bfloat16:      *reinterpret_cast<bfloat16_t*>(data) = bfloat16_t(float(value));   break;
-    case ElementType::Float64:       *reinterpret_cast<double*>(data) = double(value);                  break;
-    case ElementType::Uint32:        *reinterpret_cast<uint32_t*>(data) = uint32_t(value);              break;
-    case ElementType::Uint64:        *reinterpret_cast<uint64_t*>(data) = uint64_t(value);              break;
-    case ElementType::Complex64:     throw std::invalid_argument("Complex64 type is not supported.");
-    case ElementType::Complex128:    throw std::invalid_argument("Complex128 type is not supported.");
-    case ElementType::Fixed24f12i12: *reinterpret_cast<Fixed24f12i12*>(data) = float(value);            break;
-    case ElementType::Fixed32f16i16: *reinterpret_cast<Fixed32f16i16*>(data) = float(value);            break;
-    case ElementType::Fixed32f24i8:  *reinterpret_cast<Fixed32f24i8*>(data) = float(value);             break;
-    default:                         assert(false);                                                     break;
-    }
-}
-
-// Just copy a single element from the input to output.
-void CastElementType(ElementType dataType, void const* inputData, /*out*/ void* outputData)
-{
-    switch (dataType)
-    {
-    case ElementType::Float32:       *reinterpret_cast<uint32_t*>(outputData)   = *reinterpret_cast<const uint32_t*>(inputData);    break;
-    case ElementType::Uint8:         *reinterpret_cast<uint8_t*>(outputData)    = *reinterpret_cast<const uint8_t*>(inputData);     break;
-    case ElementType::Int8:          *reinterpret_cast<uint8_t*>(outputData)    = *reinterpret_cast<const uint8_t*>(inputData);     break;
-    case ElementType::Uint16:        *reinterpret_cast<uint16_t*>(outputData)   = *reinterpret_cast<const uint16_t*>(inputData);    break;
-    case ElementType::Int16:         *reinterpret_cast<uint16_t*>(outputData)   = *reinterpret_cast<const uint16_t*>(inputData);    break;
-    case ElementType::Int32:         *reinterpret_cast<uint32_t*>(outputData)   = *reinterpret_cast<const uint32_t*>(inputData);    break;
-    case ElementType::Int64:         *reinterpret_cast<uint64_t*>(outputData)   = *reinterpret_cast<const uint64_t*>(inputData);    break;
-    case ElementType::StringChar8:   /* no change value for strings */                                                              break;
-    case ElementType::Bool8:         *reinterpret_cast<uint8_t*>(outputData)    = *reinterpret_cast<const uint8_t*>(inputData);     break;
-    case ElementType::Float16:       *reinterpret_cast<uint16_t*>(outputData)   = *reinterpret_cast<const uint16_t*>(inputData);    break;
-    case ElementType::Bfloat16:      *reinterpret_cast<uint16_t*>(outputData)   = *reinterpret_cast<const uint16_t*>(inputData);    break;
-    case ElementType::Float64:       *reinterpret_cast<uint64_t*>(outputData)   = *reinterpret_cast<const uint64_t*>(inputData);    break;
-    case ElementType::Uint32:        *reinterpret_cast<uint32_t*>(outputData)   = *reinterpret_cast<const uint32_t*>(inputData);    break;
-    case ElementType::Uint64:        *reinterpret_cast<uint64_t*>(outputData)   = *reinterpret_cast<const uint64_t*>(inputData);    break;
-    case ElementType::Complex64:     throw std::invalid_argument("Complex64 type is not supported.");
-    case ElementType::Complex128:    throw std::invalid_argument("Complex128 type is not supported.");
-    case ElementType::Fixed24f12i12: *reinterpret_cast<Fixed24f12i12*>(outputData) = *reinterpret_cast<const Fixed24f12i12*>(inputData);  break;
-    case ElementType::Fixed32f16i16: *reinterpret_cast<uint32_t*>(outputData)   = *reinterpret_cast<const uint32_t*>(inputData);    break;
-    case ElementType::Fixed32f24i8:  *reinterpret_cast<uint32_t*>(outputData)   = *reinterpret_cast<const uint32_t*>(inputData);    break;
-    default:                         assert(false);                                                                                 break;
-    }
-}
-
-// Cast copy a single element from the input type to output type.
-void CastElementType(
-    ElementType inputDataType,
-    ElementType outputDataType,
-    void const* inputData,
-    /*out*/ void* outputData
-)
-{
-    if (inputDataType == outputDataType)
-    {
-        CastElementType(inputDataType, inputData, outputData);
-    }
-    else if (IsFractionalElementType(inputDataType))
-    {
-        double value = ReadToDouble(inputDataType, inputData);
-        if (IsFractionalElementType(outputDataType))
-        {
-            WriteFromDouble(outputDataType, value, outputData);
-        }
-        else
-        {
-            WriteFromInt64(outputDataType, static_cast<int64_t>(value), outputData);
-        }
-    }
-    else // !IsFractionalElementType(inputDataType)
-    {
-        int64_t value = ReadToInt64(inputDataType, inputData);
-        if (IsFractionalElementType(outputDataType))
-        {
-            WriteFromDouble(outputDataType, static_cast<double>(value), outputData);
-        }
-        else
-        {
-            WriteFromInt64(outputDataType, value, outputData);
-        }
-    }
-}
-
-// Cast from input type to output type, returning direct reference to the output data.
-template <typename T>
-T& CastNumberType(NumberUnionAndType const& input, _Inout_ NumberUnionAndType& output)
-{
-    CastElementType(input.elementType, output.elementType, input.numberUnion.buffer, output.numberUnion.buffer);
-    return CastReferenceAs<T>(output.numberUnion.buffer);
-}
-
-// Cast from input type to output type, returning value.
-template <typename T>
-T CastNumberType(NumberUnionAndType const& input, ElementType outputElementType)
-{
-    NumberUnion output;
-    CastElementType(input.elementType, outputElementType, input.numberUnion.buffer, output.buffer);
-    return CastReferenceAs<T>(output.buffer);
-}
-
-// Cast from input type to output type, returning value.
-NumberUnionAndType CastNumberType(NumberUnionAndType const& input, ElementType outputElementType)
-{
-    NumberUnionAndType output;
-    output.elementType = outputElementType;
-    output.printingFlags = input.printingFlags;
-    CastElementType(input.elementType, outputElementType, input.numberUnion.buffer, output.numberUnion.buffer);
-    return output;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-std::string_view GetNumericOperationNameFromNumericOperationType(NumericOperationType numericOperationType) noexcept
-{
-    size_t index = static_cast<size_t>(numericOperationType);
-    return g_numericOperationTypeNames[index < std::size(g_numericOperationTypeNames) ? index : 0];
-}
-
-void AppendFormattedRawInteger(
-    /*inout*/ std::string& stringValue,
-    uint32_t radix, // 2 or 16
-    Range bitRange,
-    uint64_t value
-)
-{
-    const uint32_t bitOffset = bitRange.begin;
-    const uint32_t bitCount = bitRange.end - bitOffset;
-    const uint64_t valueMask = (bitCount >= 64) ? ~uint64_t(0) : (uint64_t(1) << bitCount) - 1;
-    value >>= bitOffset;
-    value &= valueMask;
-
-    switch (radix)
-    {
-    case 2: // binary
-        {
-            stringValue.append("0b"sv);
-            uint32_t index = bitCount;
-            while (index > 0)
-            {
-                --index;
-                bool isBitSet = value & (uint64_t(1) << index);
-                stringValue.push_back('0' + isBitSet);
-            }
-        }
-        break;
-
-    case 10: // decimal
-        {
-            uint64_t maxValue = (uint64_t(1) << bitCount) - 1;
-            uint32_t digitCount = static_cast<uint32_t>(floor(log10(maxValue) + 1));
-            AppendFormatted(/*inout*/ stringValue, "%.*lld", digitCount, value);
-        }
-        break;
-
-    case 16: // hexadecimal
-        {
-            uint32_t digitCount = (bitCount + 3) / 4u;
-            AppendFormatted(/*inout*/ stringValue, "0x%.*llX", digitCount, value);
-        }
-        break;
-
-    default: // arbitrary radix. Using 'itoa' is dubious with unbounded buffer sizes.
-        {
-            uint64_t maxValue = (uint64_t(1) << bitCount) - 1;
-            uint32_t digitCount = static_cast<uint32_t>(floor((log(maxValue) / log(radix)) + 1));
-
-            if (radix == 8)
-            {
-                stringValue.append("0o"sv);
-            }
-
-            size_t oldSize = stringValue.size();
-            size_t newSize = oldSize + digitCount;
-            size_t index = newSize;
-            stringValue.resize(newSize);
-
-            while (index > oldSize)
-            {
-                --index;
-                uint32_t remainder = static_cast<uint32_t>(value % radix); // Note std::div doesn't support uint64_t.
-                value /= radix;
-                char32_t wc = remainder <= 10 ? ('0' + remainder) : ('A' + remainder - 10);
-                stringValue[index] = static_cast<char>(wc);
-            }
-        }
-        break;
-
-    }
-}
-
-void AppendFormattedRawInteger(
-    /*inout*/ std::string& stringValue, 
-    std::string_view name,
-    uint32_t radix, // 2 or 16
-    Range bitRange,
-    uint64_t value
-)
-{
-    // Print nothing if there are no bits (such as an exponent field for an integer).
-    if (bitRange.begin == bitRange.end)
-    {
-        return;
-    }
-
-    // Separate preceding text with a space.
-    if (!stringValue.empty())
-    {
-        char c = stringValue.back();
-        if (c != ' ' && c != '(' && c != '[' && c != '{')
-        {
-            stringValue.push_back(' ');
-        }
-    }
-    stringValue.append(name);
-    stringValue.push_back(':');
-    AppendFormattedRawInteger(/*inout*/ stringValue, radix, bitRange, value);
-}
-
-// Overload accepting value as number.
-void AppendFormattedNumericValue(
-    /*inout*/ std::string& output,
-    ElementType elementType,
-    double floatValue,
-    int64_t integerValue,
-    NumericPrintingFlags printingFlags
-)
-{
-    // Print the numeric component, per typical human-readable value.
-
-    if (IsFractionalElementType(elementType))
-    {
-        if (ComparedMaskedFlags(printingFlags, NumericPrintingFlags::ShowFloatMask, NumericPrintingFlags::ShowFloatHex))
-        {
-            AppendFormatted(/*inout*/ output, "%a", floatValue);
-        }
-        else // NumericPrintingFlags::ShowDecimalFloat
-        {
-            AppendFormatted(/*inout*/ output, "%.24g", floatValue);
-        }
-    }
-    else if (IsSignedElementType(elementType))
-    {
-        AppendFormatted(/*inout*/ output, "%lld", integerValue);
-    }
-    else // unsigned
-    {
-        AppendFormatted(/*inout*/ output, "%llu", integerValue);
-    }
-}
-
-// Overload accepting value as raw bits.
-void AppendFormattedNumericValue(
-    /*inout*/ std::string& output,
-    ElementType elementType,
-    int64_t rawBitValue,
-    NumericPrintingFlags printingFlags
-)
-{
-    // Print the raw part of the value.
-
-    uint32_t rawDisplayRadix = 16;
-    if (ComparedMaskedFlags(printingFlags, NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawBinary))
-    {
-        rawDisplayRadix = 2;
-    }
-    else if (ComparedMaskedFlags(printingFlags, NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawHex))
-    {
-        rawDisplayRadix = 16;
-    }
-    else if (ComparedMaskedFlags(printingFlags, NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawDecimal))
-    {
-        rawDisplayRadix = 10;
-    }
-    else if (ComparedMaskedFlags(printingFlags, NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawOctal))
-    {
-        rawDisplayRadix = 8;
-    }
-
-    // Print raw data, as binary or hex.
-    if (ComparedMaskedFlags(printingFlags, NumericPrintingFlags::ShowRawFieldsMask, NumericPrintingFlags::ShowRawFields))
-    {
-        NumberSubstructure const& numberSubstructure = GetElementTypeSubstructure(elementType);
-        AppendFormattedRawInteger(/*inout*/ output, "int"sv, rawDisplayRadix, numberSubstructure.integer, rawBitValue);
-        AppendFormattedRawInteger(/*inout*/ output, "frac"sv, rawDisplayRadix, numberSubstructure.fraction, rawBitValue);
-        AppendFormattedRawInteger(/*inout*/ output, "exp"sv, rawDisplayRadix, numberSubstructure.exponent, rawBitValue);
-        AppendFormattedRawInteger(/*inout*/ output, "sign"sv, rawDisplayRadix, numberSubstructure.sign, rawBitValue);
-    }
-    else
-    {
-        const uint32_t sizeOfTypeInBits = GetSizeOfTypeInBits(elementType);
-        AppendFormattedRawInteger(/*inout*/ output, rawDisplayRadix, { 0, sizeOfTypeInBits }, rawBitValue);
-    }
-}
-
-// Overload accepting value as arbitrary data.
-void AppendFormattedNumericValue(
-    /*inout*/ std::string& stringValue,
-    ElementType elementType,
-    const void* binaryData,
-    std::string_view leftFlank,
-    std::string_view rightFlank,
-    NumericPrintingFlags valueFlags
-)
-{
-    const int64_t rawBitValue = ReadRawBitValue(elementType, binaryData);
-    const double floatValue = ReadToDouble(elementType, binaryData);
-
-    const char* elementTypeName = GetTypeNameFromElementType(elementType).data();
-    bool showNumericType = (valueFlags & NumericPrintingFlags::ShowNumericType) != 0;
-    bool showNumericValue = (valueFlags & NumericPrintingFlags::ShowNumericValue) != 0;
-    bool showBinaryValue = (valueFlags & NumericPrintingFlags::ShowBinaryValue) != 0;
-
-    // Print formatted string. e.g.
-    //
-    //      float32 15361 (0x46700400)
-
-    if (showNumericType)
-    {
-        AppendFormatted(/*inout*/ stringValue, "%10s ", elementTypeName);
-    }
-
-    // Print numeric component.
-    if (showNumericValue)
-    {
-        AppendFormattedNumericValue(/*inout*/ stringValue, elementType, floatValue, rawBitValue, valueFlags);
-    }
-
-    if (showBinaryValue)
-    {
-        if (showNumericValue)
-        {
-            stringValue.append(leftFlank);
-        }
-        AppendFormattedNumericValue(/*inout*/ stringValue, elementType, rawBitValue, valueFlags);
-        if (showNumericValue)
-        {
-            stringValue.append(rightFlank);
-        }
-    }
-}
-
-void SprintNumericType(
-    /*inout*/ std::string& output,
-    ElementType elementType,
-    const void* binaryData,
-    std::string_view leftFlank,
-    std::string_view rightFlank,
-    NumericPrintingFlags numericPrintingFlags = NumericPrintingFlags::Default,
-    ElementType originalElementType = ElementType::Undefined
-)
-{
-    output.append((elementType == originalElementType) ? " -> " : "    ");
-    AppendFormattedNumericValue(/*inout*/ output, elementType, binaryData, leftFlank, rightFlank, numericPrintingFlags);
-    output.append("\n");
-}
-
-void PrintBytes(/*inout*/ std::string& stringOutput, const void* binaryData, size_t binaryDataByteSize)
-{
-    stringOutput.append("         bytes ");
-
-    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(binaryData);
-    for (size_t i = 0; i < binaryDataByteSize; ++i)
-    {
-        AppendFormatted(/*inout*/ stringOutput, "%02X ", bytes[i]);
-    }
-
-    stringOutput.append("\n");
-}
-
-void SprintAllNumericTypesToBinary(
-    /*inout*/ std::string& stringOutput,
-    NumberUnion const& numberUnion,
-    NumericPrintingFlags numericPrintingFlags = NumericPrintingFlags::Default,
-    ElementType numberElementType = ElementType::Undefined
-)
-{
-    constexpr std::string_view leftFlank = "";
-    constexpr std::string_view rightFlank = "";
-
-    NumberUnionAndType input = {.numberUnion = numberUnion, .elementType = numberElementType};
-    NumberUnionAndType output = {.numberUnion = numberUnion, .elementType = numberElementType};
-    numericPrintingFlags = numericPrintingFlags & ~NumericPrintingFlags::ShowNumericValue;
-
-    output = CastNumberType(input, ElementType::Uint8 ); SprintNumericType(/*inout*/ stringOutput, ElementType::Uint8,  &output.numberUnion.ui8,  leftFlank, rightFlank, numericPrintingFlags, numberElementType);
-    output = CastNumberType(input, ElementType::Uint16); SprintNumericType(/*inout*/ stringOutput, ElementType::Uint16, &output.numberUnion.ui16, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
-    output = CastNumberType(input, ElementType::Uint32); SprintNumericType(/*inout*/ stringOutput, ElementType::Uint32, &output.numberUnion.ui32, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
-    output = CastNumberType(input, ElementType::Uint64); SprintNumericType(/*inout*/ stringOutput, ElementType::Uint64, &output.numberUnion.ui64, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
-
-    output = CastNumberType(input, ElementType::Int8 ); SprintNumericType(/*inout*/ stringOutput, ElementType::Int8,  &output.numberUnion.i8,  leftFlank, rightFlank, numericPrintingFlags, numberElementType);
-    output = CastNumberType(input, ElementType::Int16); SprintNumericType(/*inout*/ stringOutput, ElementType::Int16, &output.numberUnion.i16, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
-    output = CastNumberType(input, ElementType::Int32); SprintNumericType(/*inout*/ stringOutput, ElementType::Int32, &output.numberUnion.i32, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
-    output = CastNumberType(input, ElementType::Int64); SprintNumericType(/*inout*/ stringOutput, ElementType::Int64, &output.numberUnion.i64, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
-
-    output = CastNumberType(input, ElementType::Float16 ); SprintNumericType(/*inout*/ stringOutput, ElementType::Float16,  &output.numberUnion.f16, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
-    output = CastNumberType(input, ElementType::Bfloat16); SprintNumericType(/*inout*/ stringOutput, ElementType::Bfloat16, &output.numberUnion.f16m7e8s1, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
-    output = CastNumberType(input, ElementType::Float32 ); SprintNumericType(/*inout*/ stringOutput, ElementType::Float32,  &output.numberUnion.f32, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
-    output = CastNumberType(input, ElementType::Float64 ); SprintNumericType(/*inout*/ stringOutput, ElementType::Float64,  &output.numberUnion.f64, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
-
-    output = CastNumberType(input, ElementType::Fixed24f12i12); SprintNumericType(/*inout*/ stringOutput, ElementType::Fixed24f12i12, &output.numberUnion.x24f12i12, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
-    output = CastNumberType(input, ElementType::Fixed32f16i16); SprintNumericType(/*inout*/ stringOutput, ElementType::Fixed32f16i16, &output.numberUnion.x32f16i16, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
-    output = CastNumberType(input, ElementType::Fixed32f24i8 ); SprintNumericType(/*inout*/ stringOutput, ElementType::Fixed32f24i8,  &output.numberUnion.x32f24i8,  leftFlank, rightFlank, numericPrintingFlags, numberElementType);
-}
-
-void SprintAllNumericTypesFromBinary(
-    /*inout*/ std::string& stringOutput,
-    int64_t value,
-    NumericPrintingFlags numericPrintingFlags = NumericPrintingFlags::Default,
-    ElementType originalElementType = ElementType::Undefined
-)
-{
-    constexpr std::string_view leftFlank = " <- ";
-    constexpr std::string_view rightFlank = "";
-
-    NumberUnion numberUnion = {};
-    numberUnion.i64 = value;
-
-    numericPrintingFlags = numericPrintingFlags & ~NumericPrintingFlags::ShowBinaryValue;
-
-    SprintNumericType(/*inout*/ stringOutput, ElementType::Uint8,  &numberUnion.ui8,  leftFlank, rightFlank, numericPrintingFlags, originalElementType);
-    SprintNumericType(/*inout*/ stringOutput, ElementType::Uint16, &numberUnion.ui16, leftFlank, rightFlank, numericPrintingFlags, originalElementType);
-    SprintNumericType(/*inout*/ stringOutput, ElementType::Uint32, &numberUnion.ui32, leftFlank, rightFlank, numericPrintingFlags, originalElementType);
-    SprintNumericType(/*inout*/ stringOutput, ElementType::Uint64, &numberUnion.ui64, leftFlank, rightFlank, numericPrintingFlags, originalElementType);
-
-    SprintNumericType(/*inout*/ stringOutput, ElementType::Int8,   &numberUnion.i8,  leftFlank, rightFlank, numericPrintingFlags, originalElementType);
-    SprintNumericType(/*inout*/ stringOutput, ElementType::Int16,  &numberUnion.i16, leftFlank, rightFlank, numericPrintingFlags, originalElementType);
-    SprintNumericType(/*inout*/ stringOutput, ElementType::Int32,  &numberUnion.i32, leftFlank, rightFlank, numericPrintingFlags, originalElementType);
-    SprintNumericType(/*inout*/ stringOutput, ElementType::Int64,  &numberUnion.i64, leftFlank, rightFlank, numericPrintingFlags, originalElementType);
-
-    SprintNumericType(/*inout*/ stringOutput, ElementType::Float16,  &numberUnion.f16, leftFlank, rightFlank, numericPrintingFlags, originalElementType);
-    SprintNumericType(/*inout*/ stringOutput, ElementType::Bfloat16, &numberUnion.f16m7e8s1,      leftFlank, rightFlank, numericPrintingFlags, originalElementType);
-    SprintNumericType(/*inout*/ stringOutput, ElementType::Float32,  &numberUnion.f32, leftFlank, rightFlank, numericPrintingFlags, originalElementType);
-    SprintNumericType(/*inout*/ stringOutput, ElementType::Float64,  &numberUnion.f64, leftFlank, rightFlank, numericPrintingFlags, originalElementType);
-
-    SprintNumericType(/*inout*/ stringOutput, ElementType::Fixed24f12i12, &numberUnion.x24f12i12, leftFlank, rightFlank, numericPrintingFlags, originalElementType);
-    SprintNumericType(/*inout*/ stringOutput, ElementType::Fixed32f16i16, &numberUnion.x32f16i16, leftFlank, rightFlank, numericPrintingFlags, originalElementType);
-    SprintNumericType(/*inout*/ stringOutput, ElementType::Fixed32f24i8,  &numberUnion.x32f24i8,  leftFlank, rightFlank, numericPrintingFlags, originalElementType);
-}
-
-void SprintAllPrintingFormats(
-    /*inout*/ std::string& stringOutput,
-    double valueFloat,
-    int64_t valueInteger,
-    ElementType elementType = ElementType::Undefined
-)
-{
-    // Print the number in various representations.
-
-    const char* elementTypeName = GetTypeNameFromElementType(elementType).data();
-
-    stringOutput.append("          type ");
-    stringOutput.append(elementTypeName);
-    stringOutput.append("\n");
-
-    stringOutput.append("       decimal ");
-    AppendFormattedNumericValue(/*inout*/ stringOutput, elementType, valueFloat, valueInteger, NumericPrintingFlags::Default);
-    stringOutput.append("\n");
-
-    stringOutput.append("      floathex ");
-    AppendFormattedNumericValue(/*inout*/ stringOutput, elementType, valueFloat, valueInteger, NumericPrintingFlags::ShowFloatHex);
-    stringOutput.append("\n");
-
-    stringOutput.append("       raw hex ");
-    AppendFormattedNumericValue(/*inout*/ stringOutput, elementType, valueInteger, NumericPrintingFlags::ShowRawHex);
-    stringOutput.append("\n");
-
-    stringOutput.append("       raw oct ");
-    AppendFormattedNumericValue(/*inout*/ stringOutput, elementType, valueInteger, NumericPrintingFlags::ShowRawOctal);
-    stringOutput.append("\n");
-
-    stringOutput.append("       raw bin ");
-    AppendFormattedNumericValue(/*inout*/ stringOutput, elementType, valueInteger, NumericPrintingFlags::ShowRawBinary);
-    stringOutput.append("\n");
-
-    stringOutput.append("    fields bin ");
-    AppendFormattedNumericValue(/*inout*/ stringOutput, elementType, valueInteger, NumericPrintingFlags::ShowRawBinaryFields);
-    stringOutput.append("\n");
-}
-
-void ParseNumber(
-    _In_z_ const char* valueString,
-    ElementType preferredElementType,
-    bool parseAsRawData,
-    _Out_ NumberUnionAndType& number
-)
-{
-    number = {};
-    number.elementType = preferredElementType;
-
-    // Try to read the number as the preferred element type, or if undefined,
-    // try to read the numbers as float64 and int64.
-
-    const bool isUndefinedType = (preferredElementType == ElementType::Undefined);
-    const bool isFractionalType = IsFractionalElementType(preferredElementType);
-
-    char* valueStringEnd = nullptr;
-    const double valueFloat = strtod(valueString, &valueStringEnd);
-    const bool wasFloatValueParsed = (valueStringEnd > valueString);
-    const bool wasDecimalPresent = wasFloatValueParsed && (std::find(valueString, const_cast<char const*>(valueStringEnd), '.') != valueStringEnd);
-    const bool isValueFloatZero = (valueFloat == 0);
-
-    // Read as signed or unsigned value.
-    int64_t valueInt = 0;
-    if (preferredElementType == ElementType::Undefined
-    ||  (IsSignedElementType(preferredElementType) && !parseAsRawData)
-    ||  valueString[0] == '-')
-    {
-        valueInt = strtoll(valueString, &valueStringEnd, 0);
-    }
-    else
-    {
-        valueInt = strtoull(valueString, &valueStringEnd, 0);
-    }
-
-    // Parse binary or octal numbers, e.g. 0b1101, 0o123. 'strtol' doesn't recognize these.
-    if (valueInt == 0 && valueString[0] == '0')
-    {
-        uint32_t radix = 0;
-        if (valueString[1] == 'b') radix = 2;
-        if (valueString[1] == 'o') radix = 8;
-
-        if (radix != 0)
-        {
-            valueInt = strtoull(valueString + 2, &valueStringEnd, radix);
-        }
-    }
-
-    // If the type wasn't given, deduce from whether the number had a fraction.
-    if (isUndefinedType)
-    {
-        // Treat as floating point if a decimal was present.
-        if (wasDecimalPresent)
-        {
-            if (parseAsRawData)
-            {
-                number.numberUnion.i64 = valueInt;
-            }
-            else
-            {
-                number.numberUnion.f64 = valueFloat;
-            }
-            number.elementType = ElementType::Float64;
-        }
-        else if (valueInt <= INT32_MAX && valueInt >= -INT32_MAX)
-        {
-            number.numberUnion.i32 = static_cast<int32_t>(valueInt);
-            number.elementType = ElementType::Int32;
-        }
-        else if (valueInt <= UINT32_MAX)
-        {
-            number.numberUnion.ui32 = static_cast<uint32_t>(valueInt);
-            number.elementType = ElementType::Uint32;
-        }
-        else // Treat as 64-bit integer.
-        {
-            number.numberUnion.i64 = valueInt;
-            number.elementType = ElementType::Int64;
-        }
-    }
-    else if (isFractionalType)
-    {
-        if (parseAsRawData)
-        {
-            number.numberUnion.i64 = valueInt;
-        }
-        else if (isValueFloatZero)
-        {
-            WriteFromInt64(preferredElementType, valueInt, /*out*/ &number.numberUnion);
-        }
-        else
-        {
-            WriteFromDouble(preferredElementType, valueFloat, /*out*/ &number.numberUnion);
-        }
-    }
-    else // integer
-    {
-        WriteFromInt64(preferredElementType, valueInt, /*out*/ &number.numberUnion);
-    }
-}
-
-void SprintAllNumbers(/*inout*/ std::string& stringOutput, Span<const NumberUnionAndType> numbers)
-{
-    constexpr std::string_view leftFlank = " (";
-    constexpr std::string_view rightFlank = ")";
-
-    for (NumberUnionAndType const& number : numbers)
-    {
-        if (number.elementType != ElementType::Undefined)
-        {
-            stringOutput.append("    ");
-            AppendFormattedNumericValue(/*inout*/ stringOutput, number.elementType, &number.numberUnion, leftFlank, rightFlank, number.printingFlags);
-            stringOutput.append("\n");
-        }
-    }
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-template<typename T>
-T Truncate(T t) { return static_cast<T>(std::trunc(t)); }
-template<> uint8_t Truncate(uint8_t t) { return t; }
-template<> uint16_t Truncate(uint16_t t) { return t; }
-template<> uint32_t Truncate(uint32_t t) { return t; }
-template<> uint64_t Truncate(uint64_t t) { return t; }
-template<> int8_t Truncate(int8_t t) { return t; }
-template<> int16_t Truncate(int16_t t) { return t; }
-template<> int32_t Truncate(int32_t t) { return t; }
-template<> int64_t Truncate(int64_t t) { return t; }
-template<> Fixed24f12i12 Truncate(Fixed24f12i12 t) { t.Truncate(); return t; }
-template<> Fixed32f16i16 Truncate(Fixed32f16i16 t) { t.Truncate(); return t; }
-template<> Fixed32f24i8 Truncate(Fixed32f24i8 t) { t.Truncate(); return t; }
-
-////////////////////////////////////////////////////////////////////////////////
-
-struct INumericOperationPerformer
-{
-    virtual void Add(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) = 0;
-    virtual void Subtract(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) = 0;
-    virtual void Multiply(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) = 0;
-    virtual void Divide(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) = 0;
-    virtual void Dot(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) = 0;
-    virtual void Truncate(Span<const NumberUnionAndType> numbers, _Out_ Span<NumberUnionAndType> results) = 0;
-};
-
-template <typename T>
-class NumericOperationPerformer : public INumericOperationPerformer
-{
-    void Add(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) override
-    {
-        T result = T(0);
-        NumberUnionAndType intermediate = finalResult; // Intermediate needed for casting.
-
-        for (NumberUnionAndType const& n : numbers)
-        {
-            result += CastNumberType<T>(n, /*inout*/ intermediate);
-        }
-        CastReferenceAs<T>(finalResult) = result;
-    }
-
-    void Subtract(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) override
-    {
-        T result = T(0);
-        NumberUnionAndType intermediate = finalResult;
-
-        if (!numbers.empty())
-        {
-            result = CastNumberType<T>(numbers.front(), /*inout*/ intermediate);
-
-            numbers.PopFront();
-            for (NumberUnionAndType const& n : numbers)
-            {
-                result -= CastNumberType<T>(n, /*inout*/ intermediate);
-            }
-        }
-        CastReferenceAs<T>(finalResult) = result;
-    };
-
-    void Multiply(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) override
-    {
-        T result = T(1);
-        NumberUnionAndType intermediate = finalResult;
-
-        for (auto& n : numbers)
-        {
-            result *= CastNumberType<T>(n, /*inout*/ intermediate);
-        }
-        CastReferenceAs<T>(finalResult) = result;
-    };
-
-    void Divide(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) override
-    {
-        T result = T(0);
-        NumberUnionAndType intermediate = finalResult;
-
-        if (!numbers.empty())
-        {
-            result = CastNumberType<T>(numbers.front(), /*inout*/ intermediate);
-
-            numbers.PopFront();
-            for (NumberUnionAndType const& n : numbers)
-            {
-                result /= CastNumberType<T>(n, /*inout*/ intermediate);
-            }
-        }
-        CastReferenceAs<T>(finalResult) = result;
-    };
-
-    void Dot(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) override
-    {
-        T result = T(0); 
-        size_t i = 0;
-        size_t numberCount = numbers.size();
-        size_t evenNumberCount = numbers.size() & ~size_t(1);
-        NumberUnionAndType intermediate1 = finalResult;
-        NumberUnionAndType intermediate2 = finalResult;
-
-        for (i = 0; i < evenNumberCount; i += 2)
-        {
-            T product = CastNumberType<T>(numbers[i],     /*out*/ intermediate1)
-                      * CastNumberType<T>(numbers[i + 1], /*out*/ intermediate2);
-            result += product;
-        }
-        if (i < numberCount)
-        {
-            result += CastNumberType<T>(numbers[i], /*out*/ intermediate1);
-        }
-        CastReferenceAs<T>(finalResult) = result;
-
-    #if 0 // Experimental rounding.
-        constexpr uint64_t mantissaMaskLowBits = (0x1ui64 << 42) - 1;
-        constexpr uint64_t mantissaMaskHighBits = ~mantissaMaskLowBits;
-        constexpr uint64_t mantissaEvenBit = 0x1ui64 << 42;
-        constexpr uint64_t mantissaMaskRoundingBit = 1ui64 << (42 - 1);
-
-        // Round halves to evens
-        NumberUnion result;
-        result.f64 = double(0);
-        size_t i = 0;
-        size_t numberCount = numbers.size();
-        size_t evenNumberCount = numbers.size() & ~size_t(1);
-
-        for (i = 0; i < evenNumberCount; i += 2)
-        {
-            NumberUnion product;
-            product.f64 = double(CastAs<T>(numbers[i])) * double(CastAs<T>(numbers[i + 1]));
-
-            if ((product.ui64 & mantissaMaskLowBits) == mantissaMaskRoundingBit)
-            {
-                product.ui64 += (product.ui64 & mantissaEvenBit) ? -int64_t(mantissaMaskRoundingBit) : mantissaMaskRoundingBit;
-            }
-            result.f64 += product.f64;
-            if ((result.ui64 & mantissaMaskLowBits) == mantissaMaskRoundingBit)
-            {
-                result.ui64 += (result.ui64 & mantissaEvenBit) ? -int64_t(mantissaMaskRoundingBit) : mantissaMaskRoundingBit;
-            }
-        }
-        if (i < numberCount)
-        {
-            result.f64 += CastAs<T>(numbers[i]);
-            if ((result.ui64 & mantissaMaskLowBits) == mantissaMaskRoundingBit)
-            {
-                result.ui64 += (result.ui64 & mantissaEvenBit) ? -int64_t(mantissaMaskRoundingBit) : mantissaMaskRoundingBit;
-            }
-        }
-        CastAs<T>(finalResult) = T(float(result.f64));
-
-        // Round halves towards infinity
-        NumberUnion result;
-        result.f64 = double(0);
-        size_t i = 0;
-        size_t numberCount = numbers.size();
-        size_t evenNumberCount = numbers.size() & ~size_t(1);
-
-        for (i = 0; i < evenNumberCount; i += 2)
-        {
-            NumberUnion product;
-            product.f64 = double(CastAs<T>(numbers[i])) * double(CastAs<T>(numbers[i + 1]));
-            product.ui64 += (0x1ui64 << 41);
-            product.ui64 &= ~((0x1ui64 << 42) - 1);
-            result.f64 += product.f64;
-            result.ui64 += (0x1ui64 << 41);
-            result.ui64 &= ~((0x1ui64 << 42) - 1);
-        }
-        if (i < numberCount)
-        {
-            result.f64 += CastAs<T>(numbers[i]);
-            result.ui64 += (0x1ui64 << 41);
-            result.ui64 &= ~((0x1ui64 << 42) - 1);
-        }
-        CastAs<T>(finalResult) = T(float(result.f64));
-    #endif
-    }
-
-    void Truncate(Span<const NumberUnionAndType> numbers, _Out_ Span<NumberUnionAndType> results) override
-    {
-        assert(numbers.size() == results.size());
-        const size_t count = numbers.size();
-
-        for (size_t i = 0; i < count; ++i)
-        {
-            NumberUnionAndType intermediate = results[i];
-            T result = CastNumberType<T>(numbers[i], /*inout*/ intermediate);
-            result = ::Truncate(result);
-            CastReferenceAs<T>(results[i]) = result;
-        }
-    }
-};
-
-// Declare singletons since they are stateless anyway.
-NumericOperationPerformer<float> g_numericOperationPerformerFloat32;
-NumericOperationPerformer<double> g_numericOperationPerformerFloat64;
-NumericOperationPerformer<float16_t> g_numericOperationPerformerFloat16;
-NumericOperationPerformer<float16m7e8s1_t> g_numericOperationPerformerFloat16m7e8s1;
-NumericOperationPerformer<uint8_t> g_numericOperationPerformerUint8;
-NumericOperationPerformer<uint16_t> g_numericOperationPerformerUint16;
-NumericOperationPerformer<uint32_t> g_numericOperationPerformerUint32;
-NumericOperationPerformer<uint64_t> g_numericOperationPerformerUint64;
-NumericOperationPerformer<int8_t> g_numericOperationPerformerInt8;
-NumericOperationPerformer<int16_t> g_numericOperationPerformerInt16;
-NumericOperationPerformer<int32_t> g_numericOperationPerformerInt32;
-NumericOperationPerformer<int64_t> g_numericOperationPerformerInt64;
-NumericOperationPerformer<Fixed24f12i12> g_numericOperationPerformerFixed24f12i12;
-NumericOperationPerformer<Fixed32f16i16> g_numericOperationPerformerFixed32f16i16;
-NumericOperationPerformer<Fixed32f24i8> g_numericOperationPerformerFixed32f24i8;
-
-ElementType GetPromotedOutputElementType(Span<const NumberUnionAndType> numbers)
-{
-    // Determine the output element type based on the priority of each pair of types.
-    // If all data types are identical or there is only one, the result is simply the first input type.
-
-    ElementType outputElementType = ElementType::Undefined;
-    if (!numbers.empty())
-    {
-        outputElementType = numbers.front().elementType;
-        numbers.PopFront();
-
-        for (auto& number : numbers)
-        {
-            ElementType inputElementType = number.elementType;
-            outputElementType = g_elementTypePriorityTable[size_t(inputElementType)] > g_elementTypePriorityTable[size_t(outputElementType)]
-                ? inputElementType
-                : outputElementType;
-        }
-    }
-
-    return outputElementType;
-}
-
-void PerformNumericOperation(
-    NumericOperationType numericOperationType,
-    Span<const NumberUnionAndType> numbers,
-    _Inout_ std::vector<NumberUnionAndType>& results // in for initial element type
-)
-{
-    size_t resultCount = 1;
-    switch (numericOperationType)
-    {
-    // case NumericOperationType::Add:
-    // case NumericOperationType::Subtract:
-    // case NumericOperationType::Multiply:
-    // case NumericOperationType::Divide:
-    //     resultCount = 1;
-    //     break;
-
-    case NumericOperationType::Nop:
-    case NumericOperationType::Truncate:
-        resultCount = numbers.size();
-        break;
-
-    case NumericOperationType::Nothing:
-        results.clear();
-        return;
-
-    default:
-        break;
-    }
-
-    if (resultCount <= 0)
-    {
-        return;
-    }
-
-    results.resize(resultCount);
-    ElementType promotedElementType = GetPromotedOutputElementType(numbers);
-    for (size_t i = 0; i < resultCount; ++i)
-    {
-        auto& result = results[i];
-        result.numberUnion = {};
-        // Determine the output element type based on the inputs.
-        if (result.elementType == ElementType::Undefined)
-        {
-            result.elementType = (resultCount > 1) ? numbers[i].elementType : promotedElementType;
-        }
-    }
-
-    INumericOperationPerformer* performer = &g_numericOperationPerformerFloat32;
-
-    // Choose the respective operation performer based on data type.
-    switch (results.front().elementType)
-    {
-    case ElementType::Undefined:        return;
-    case ElementType::Float32:          performer = &g_numericOperationPerformerFloat32; break;
-    case ElementType::Uint8:            performer = &g_numericOperationPerformerUint8; break;
-    case ElementType::Int8:             performer = &g_numericOperationPerformerInt8; break;
-    case ElementType::Uint16:           performer = &g_numericOperationPerformerUint16; break;
-    case ElementType::Int16:            performer = &g_numericOperationPerformerInt16; break;
-    case ElementType::Int32:            performer = &g_numericOperationPerformerInt32; break;
-    case ElementType::Int64:            performer = &g_numericOperationPerformerInt64; break;
-    case ElementType::StringChar8:      return;
-    case ElementType::Bool8:            return;
-    case ElementType::Float16:          performer = &g_numericOperationPerformerFloat16; break;
-    case ElementType::Float64:          performer = &g_numericOperationPerformerFloat64; break;
-    case ElementType::Uint32:           performer = &g_numericOperationPerformerUint32; break;
-    case ElementType::Uint64:           performer = &g_numericOperationPerformerUint64; break;
-    case ElementType::Complex64:        return;
-    case ElementType::Complex128:       return;
-    case ElementType::Float16m7e8s1:    performer = &g_numericOperationPerformerFloat16m7e8s1; break;
-    case ElementType::Fixed24f12i12:    performer = &g_numericOperationPerformerFixed24f12i12; break;
-    case ElementType::Fixed32f16i16:    performer = &g_numericOperationPerformerFixed32f16i16; break;
-    case ElementType::Fixed32f24i8:     performer = &g_numericOperationPerformerFixed32f24i8; break;
-    default: assert(false);
-    }
-
-    switch (numericOperationType)
-    {
-    case NumericOperationType::Nothing:     /*no output*/ break;
-    case NumericOperationType::Nop:         results.assign(numbers.begin(), numbers.end()); break;
-    case NumericOperationType::Add:         performer->Add(numbers, /*out*/ results.front()); break;
-    case NumericOperationType::Subtract:    performer->Subtract(numbers, /*out*/ results.front()); break;
-    case NumericOperationType::Multiply:    performer->Multiply(numbers, /*out*/ results.front()); break;
-    case NumericOperationType::Divide:      performer->Divide(numbers, /*out*/ results.front()); break;
-    case NumericOperationType::Dot:         performer->Dot(numbers, /*out*/ results.front()); break;
-    case NumericOperationType::Truncate:    performer->Truncate(numbers, /*out*/ MakeSpan(results)); break;
-    case NumericOperationType::None:
-    default: assert(false);
-    }
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void PrintUsage()
-{
-    std::puts(
-        "Usage:\n"
-        "   binums 12.75  // floating point value in various formats\n"
-        "   binums 0b1101  // read binary integer\n"
-        "   binums float32 raw 0x40490FDB  // read raw floating point bits\n"
-        "   binums float16 raw 0x5140  // read raw floating point bits\n"
-        "   binums fields hex 7 12.75 -13 bin 7 12.75 -13  // see fields of numbers\n"
-        "   binums int8 fields 13 -13  // see fields of numbers\n"
-        "   binums uint32 add 1.5 3.25  // perform operation\n"
-        "   binums float32 add float16 2 3  // read float16, compute in float32\n"
-        "   binums uint32 mul 3 2 add 3 2 subtract 3 2 dot 1 2 3 4\n"
-        "   binums 0x1.5p5  // floating point hexadecimal\n"
-        "   binums fixed12_12 sub 3.5 2  // fixed point arithmetic\n"
-        "\n"
-        "Options:\n"
-        "   bin hex dec oct - display raw bits as binary/hex/decimal/octal\n"
-        "   floathex floatdec - display floating values as hex or decimal (default)\n"
-        "   raw num - read input as raw bit data or as number (default)\n"
-        "   fields nofields - show numeric component bitfields\n"
-        "   add subtract multiply divide dot nop - apply operation to following numbers\n"
-        "   float16 bfloat16 float32 float64 - set floating point data type\n"
-        "   uint8 uint16 uint32 uint64 int8 int16 int32 int64 - set integer data type\n"
-        "   fixed12_12 fixed16_16 fixed8_24 - set fixed precision data type\n"
-        "\n"
-        "Dwayne Robinson, 2019-02-14..2022-11-17, No Copyright\n"
-        "https://github.com/fdwr/BiNums\n"
-    );
-}
-
-std::string_view GetIdentifier(std::string_view s)
-{
-    size_t i = 0;
-    size_t const size = s.size();
-
-    // Skip whitespace.
-    for (/*above*/; i < size && s[i] == ' '; ++i)
-    { }
-
-    if (i >= size)
-    {
-        return {s.data() + size, 0}; // Point at end with empty view.
-    }
-
-    // Check if token starts with identifier.
-    auto isIdentifier = [](char ch)->bool
-    {
-        return (ch >= '0' && ch <= '9')
-            || (ch >= 'A' && ch <= 'Z')
-            || (ch >= 'a' && ch <= 'z')
-            || (ch == '.')
-            || (ch == '-')
-            || (ch == '_');
-    };
-
-    if (!isIdentifier(s[i]))
-    {
-        return {s.data() + i, 1}; // Return single token.
-    }
-
-    // Find end of identifier.
-    size_t j = i + 1;
-    for (/*above*/; j < size && isIdentifier(s[j]); ++j)
-    { }
-
-    return {s.data() + i, j - i};
-}
-
-int ParseOperations(
-    std::string_view operationString,
-    _Out_ std::vector<NumericOperationAndRange>& operations,
-    _Out_ std::vector<NumberUnionAndType>& numbers,
-    /*out*/ std::string& errorMessage
-)
-{
-    NumberUnionAndType numberUnionAndType;
-    bool parseAsRawData = false;
-    ElementType preferredElementType = ElementType::Undefined;
-    NumericPrintingFlags numericPrintingFlags = NumericPrintingFlags::Default;
-    bool isWithinParentheses = false;
-
-    operations.clear();
-    numbers.clear();
-    char const* end = operationString.data() + operationString.size();
-
-    while (!operationString.empty())
-    {
-        std::string_view param = GetIdentifier(operationString);
-        char const* paramEnd = param.data() + param.size();
-        operationString = std::string_view{paramEnd, size_t(end - paramEnd)};
-
-        NumericOperationAndRange numericOperationAndRange = {};
-
-        // Check if ordinary number or operator.
-        if ((!param.empty() && isdigit(param.front()))
-        ||  (param.size() >= 2 && param.front() == '-' && isdigit(param[1])))
-        {
-            auto value = param.begin();
-            while (value != param.end())
-            {
-                ParseNumber(&*value, preferredElementType, parseAsRawData, /*out*/ numberUnionAndType);
-                numberUnionAndType.printingFlags = numericPrintingFlags;
-                numbers.push_back(numberUnionAndType);
-                value = std::find(value, param.end(), ',');
-                if (value == param.end())
-                {
-                    break;
-                }
-                else
-                {
-                    ++value; // Skip the comma.
-                }
-            }
-        }
-        else
-        {
-            switch (Hash(param))
-            {
-            case Hash("nop"):
-                numericOperationAndRange.numericOperationType = NumericOperationType::Nop;
-                break;
-
-            case Hash("nothing"):
-                numericOperationAndRange.numericOperationType = NumericOperationType::Nothing;
-                break;
-
-            case Hash("add"):
-                numericOperationAndRange.numericOperationType = NumericOperationType::Add;
-                break;
-
-            case Hash("sub"):
-            case Hash("subtract"):
-                numericOperationAndRange.numericOperationType = NumericOperationType::Subtract;
-                break;
-
-            case Hash("mul"):
-            case Hash("multiply"):
-                numericOperationAndRange.numericOperationType = NumericOperationType::Multiply;
-                break;
-
-            case Hash("div"):
-            case Hash("divide"):
-                numericOperationAndRange.numericOperationType = NumericOperationType::Divide;
-                break;
-
-            case Hash("dot"):
-            case Hash("dotproduct"):
-                numericOperationAndRange.numericOperationType = NumericOperationType::Dot;
-                break;
-
-            case Hash("trunc"):
-            case Hash("truncate"):
-                numericOperationAndRange.numericOperationType = NumericOperationType::Truncate;
-                break;
-
-            case Hash("raw"):
-                parseAsRawData = true;
-                break;
-
-            case Hash("num"):
-            case Hash("number"):
-                parseAsRawData = false;
-                break;
-
-            case Hash("undefined"):
-                preferredElementType = ElementType::Undefined;
-                break;
-
-            case Hash("i8"):
-            case Hash("int8"):
-                preferredElementType = ElementType::Int8;
-                break;
-
-            case Hash("ui8"):
-            case Hash("uint8"):
-                preferredElementType = ElementType::Uint8;
-                break;
-
-            case Hash("i16"):
-            case Hash("int16"):
-                preferredElementType = ElementType::Int16;
-                break;
-
-            case Hash("ui16"):
-            case Hash("uint16"):
-                preferredElementType = ElementType::Uint16;
-                break;
-
-            case Hash("i32"):
-            case Hash("int32"):
-            case Hash("int"):
-                preferredElementType = ElementType::Int32;
-                break;
-
-            case Hash("ui32"):
-            case Hash("uint32"):
-            case Hash("uint"):
-                preferredElementType = ElementType::Uint32;
-                break;
-
-            case Hash("i64"):
-            case Hash("int64"):
-                preferredElementType = ElementType::Int64;
-                break;
-
-            case Hash("ui64"):
-            case Hash("uint64"):
-                preferredElementType = ElementType::Uint64;
-                break;
-
-            case Hash("f16"):
-            case Hash("float16"):
-                preferredElementType = ElementType::Float16;
-                break;
-
-            case Hash("f16m7e8s1"):
-            case Hash("bfloat16"):
-                preferredElementType = ElementType::Float16m7e8s1;
-                break;
-
-            case Hash("f32"):
-            case Hash("float32"):
-            case Hash("float"):
-                preferredElementType = ElementType::Float32;
-                break;
-
-            case Hash("f64"):
-            case Hash("float64"):
-            case Hash("double"):
-                preferredElementType = ElementType::Float64;
-                break;
-
-            case Hash("fixed12_12"):
-                preferredElementType = ElementType::Fixed24f12i12;
-                break;
-
-            case Hash("fixed16_16"):
-                preferredElementType = ElementType::Fixed32f16i16;
-                break;
-
-            case Hash("fixed8_24"):
-                preferredElementType = ElementType::Fixed32f24i8;
-                break;
-
-            case Hash("bin"):
-            case Hash("binary"):
-            case Hash("showrawbinary"):
-                numericPrintingFlags = SetFlags(numericPrintingFlags, NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawBinary);
-                break;
-
-            case Hash("hex"):
-            case Hash("hexademical"):
-            case Hash("showrawhexadecimal"):
-                numericPrintingFlags = SetFlags(numericPrintingFlags, NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawHex);
-                break;
-
-            case Hash("dec"):
-            case Hash("decimal"):
-            case Hash("showrawdecimal"):
-                numericPrintingFlags = SetFlags(numericPrintingFlags, NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawDecimal);
-                break;
-
-            case Hash("oct"):
-            case Hash("octal"):
-            case Hash("showrawoctal"):
-                numericPrintingFlags = SetFlags(numericPrintingFlags, NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawOctal);
-                break;
-
-            case Hash("floathex"):
-            case Hash("showfloathexadecimal"):
-                numericPrintingFlags = SetFlags(numericPrintingFlags, NumericPrintingFlags::ShowFloatMask, NumericPrintingFlags::ShowFloatHex);
-                break;
-
-            case Hash("floatdec"):
-            case Hash("showfloatdecimal"):
-                numericPrintingFlags = SetFlags(numericPrintingFlags, NumericPrintingFlags::ShowFloatMask, NumericPrintingFlags::ShowFloatDecimal);
-                break;
-
-            case Hash("fields"):
-            case Hash("showrawfields"):
-                numericPrintingFlags = SetFlags(numericPrintingFlags, NumericPrintingFlags::ShowRawFieldsMask, NumericPrintingFlags::ShowRawFields);
-                break;
-
-            case Hash("nofields"):
-            case Hash("hiderawfields"):
-                numericPrintingFlags = SetFlags(numericPrintingFlags, NumericPrintingFlags::ShowRawFieldsMask, NumericPrintingFlags::HideRawFields);
-                break;
-
-            case Hash("("):
-                if (isWithinParentheses)
-                {
-                    errorMessage = GetFormatted("Nested parentheses not supported");
-                    return EXIT_FAILURE;
-                }
-                isWithinParentheses = true;
-                break;
-
-            case Hash(")"):
-                if (!isWithinParentheses)
-                {
-                    errorMessage = GetFormatted("Closing parenthesis without opening parenthesis");
-                    return EXIT_FAILURE;
-                }
-                isWithinParentheses = false;
-                break;
-
-            case Hash(","):
-                // Ignore commas.
-                break;
-
-            default:
-                errorMessage = GetFormatted("Unknown parameter: \"%.*s\"", int(param.size()), param.data());
-                return EXIT_FAILURE;
-            }
-        }
-
-        // Append any new numeric operations.
-        if (numericOperationAndRange.numericOperationType != NumericOperationType::None)
-        {
-            if (isWithinParentheses)
-            {
-                errorMessage = GetFormatted("Operations are not supported inside parentheses");
-            }
-
-            const uint32_t numberCount = static_cast<uint32_t>(numbers.size());
-            if (!operations.empty())
-            {
-                operations.back().range.end = numberCount;
-            }
-            numericOperationAndRange.range.begin = numberCount;
-            numericOperationAndRange.range.end = numberCount;
-            numericOperationAndRange.outputElementType = preferredElementType;
-            operations.push_back(numericOperationAndRange);
-        }
-    }
-
-    if (isWithinParentheses)
-    {
-        errorMessage = GetFormatted("Unclosed parentheses");
-        return EXIT_FAILURE;
-    }
-
-    const uint32_t numberCount = static_cast<uint32_t>(numbers.size());
-    if (!operations.empty())
-    {
-        operations.back().range.end = numberCount;
-    }
-
-    return EXIT_SUCCESS;
-}
-
-std::string ConcatenateCommandLineParameters(int argc, char* argv[])
-{
-    std::string commandLine;
-    for (size_t i = 1; i < size_t(argc); ++i)
-    {
-        if (!commandLine.empty())
-        {
-            commandLine.push_back(' ');
-        }
-        commandLine.append(argv[i]);
-    }
-
-    return commandLine;
-}
-
-int MainImplementation(std::string_view commandLine, /*out*/ std::string& stringOutput)
-{
-    if (commandLine.empty())
-    {
-        PrintUsage();
-        return EXIT_SUCCESS;
-    }
-
-    std::vector<NumericOperationAndRange> operations;
-    std::vector<NumberUnionAndType> numbers;
-
-    std::string errorMessage;
-    int exitCode = ParseOperations(commandLine, /*out*/ operations, /*out*/ numbers, /*out*/ stringOutput);
-    if (exitCode != EXIT_SUCCESS)
-    {
-        return exitCode;
-    }
-
-    if (!operations.empty())
-    {
-        // Process every operation in order.
-        for (auto& operation : operations)
-        {
-            _Null_terminated_ const char* numericOperationName = GetNumericOperationNameFromNumericOperationType(operation.numericOperationType).data();
-
-            // Print the operands.
-            AppendFormatted(/*inout*/ stringOutput, "Operands to %s:\n", numericOperationName);
-            Span<const NumberUnionAndType> span(numbers.data() + operation.range.begin, numbers.data() + operation.range.end);
-            SprintAllNumbers(/*inout*/ stringOutput, span);
-
-            // Process the values.
-            std::vector<NumberUnionAndType> operationResults(1);
-            operationResults.front().elementType = operation.outputElementType;
-            operationResults.front().printingFlags = span.empty() ? NumericPrintingFlags::Default : span.front().printingFlags;
-            PerformNumericOperation(operation.numericOperationType, span, /*inout*/ operationResults);
-
-            // Print the result.
-            AppendFormatted(/*inout*/ stringOutput, "Result from %s:\n", numericOperationName);
-            SprintAllNumbers(/*inout*/ stringOutput, MakeSpan(operationResults));
-            stringOutput.append("\n");
-        }
-    }
-    else if (numbers.size() == 1)
-    {
-        // If exactly one number is given, show it in possible formats.
-        auto& numberUnion = numbers.front();
-        double valueFloat = ReadToDouble(numberUnion.elementType, &numberUnion.numberUnion);
-        int64_t valueInteger = ReadRawBitValue(numberUnion.elementType, &numberUnion.numberUnion);
-
-        stringOutput.append("Representations:\n");
-        SprintAllPrintingFormats(/*inout*/ stringOutput, valueFloat, valueInteger, numberUnion.elementType);
-
-        stringOutput.append("\n" "As raw bits:\n");
-        SprintAllNumericTypesToBinary(/*inout*/ stringOutput, numberUnion.numberUnion, numberUnion.printingFlags, numberUnion.elementType);
-
-        stringOutput.append("\n" "As number:\n");
-        SprintAllNumericTypesFromBinary(/*inout*/ stringOutput, valueInteger, numberUnion.printingFlags, numberUnion.elementType);
-    }
-    else if (!numbers.empty())
-    {
-        // If multiple numbers are given, print them all.
-        SprintAllNumbers(/*inout*/ stringOutput, Span<const NumberUnionAndType>(numbers.data(), numbers.size()));
-    }
-
-    return EXIT_SUCCESS;
-}
+﻿// BiNums, see binary numbers
+
+#include "precomp.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Generic functions/classes.
+
+template <typename Enum>
+bool ComparedMaskedFlags(Enum fullEnum, Enum mask, Enum subvalue)
+{
+    static_assert(sizeof(Enum) == sizeof(uint32_t)); // Doesn't work with 64-bit enums.
+    return (static_cast<uint32_t>(fullEnum) & static_cast<uint32_t>(mask)) == static_cast<uint32_t>(subvalue);
+}
+
+template <typename Enum>
+Enum SetFlags(Enum e, Enum clear, Enum set)
+{
+    return static_cast<Enum>((static_cast<uint32_t>(e) & ~static_cast<uint32_t>(clear)) | static_cast<uint32_t>(set));
+}
+
+template <typename T, typename O>
+T& CastReferenceAs(O& o)
+{
+    static_assert(sizeof(T) <= sizeof(O));
+    return reinterpret_cast<T&>(o);
+}
+
+template <typename T, typename O>
+const T& CastReferenceAs(O const& o)
+{
+    static_assert(sizeof(T) <= sizeof(O));
+    return reinterpret_cast<const T&>(o);
+}
+
+// The format string is compatible with printf (not std::format).
+std::string GetFormatted(char const* formatString, ...)
+{
+    std::string formattedMessage;
+
+    va_list argList;
+    va_start(argList, formatString);
+    char buffer[1000];
+    buffer[0] = 0;
+
+    vsnprintf(buffer, std::size(buffer), formatString, argList);
+    formattedMessage.assign(buffer);
+    return formattedMessage;
+}
+
+// The format string is compatible with printf (not std::format).
+void AppendFormatted(/*inout*/ std::string& s, char const* formatString, ...)
+{
+    std::string formattedMessage;
+
+    va_list argList;
+    va_start(argList, formatString);
+    char buffer[1000];
+    buffer[0] = 0;
+
+    vsnprintf(buffer, std::size(buffer), formatString, argList);
+    s.append(buffer);
+}
+
+// Appends a value via std::to_chars, which formats identically to the printf equivalent.
+template <typename... Arguments>
+void AppendCharacters(/*inout*/ std::string& s, Arguments... arguments)
+{
+    char buffer[64];
+    std::to_chars_result result = std::to_chars(std::begin(buffer), std::end(buffer), arguments...);
+    assert(result.ec == std::errc());
+    s.append(buffer, result.ptr);
+}
+
+using namespace std::literals::string_view_literals;
+
+////////////////////////////////////////////////////////////////////////////////
+
+using Fixed24f12i12 = FixedNumber<int24_t, 12, 12>;
+using Fixed32f16i16 = FixedNumber<int32_t, 16, 16>;
+using Fixed32f24i8  = FixedNumber<int32_t, 8, 24>;
+
+// TODO: Support all these from:
+// https://onnx.ai/onnx/technical/float8.html
+// https://github.com/onnx/onnx/blob/main/onnx/reference/custom_element_types.py
+//
+// bfloat16 = np.dtype((np.uint16, {"bfloat16": (np.uint16, 0)}))
+// float8e4m3fn = np.dtype((np.uint8, {"e4m3fn": (np.uint8, 0)}))
+// float8e4m3fnuz = np.dtype((np.uint8, {"e4m3fnuz": (np.uint8, 0)}))
+// float8e5m2 = np.dtype((np.uint8, {"e5m2": (np.uint8, 0)}))
+// float8e5m2fnuz = np.dtype((np.uint8, {"e5m2fnuz": (np.uint8, 0)}))
+
+union NumberUnion
+{
+    uint8_t         buffer[8];
+    uint8_t         ui8;
+    uint16_t        ui16;
+    uint32_t        ui32;
+    uint64_t        ui64;
+    int8_t          i8;
+    int16_t         i16;
+    int32_t         i32;
+    int64_t         i64;
+    float8m3e4s1_t  f3e4s1;
+    float8m2e5s1_t  f2e5s1;
+    float16_t       f16;
+    float16m7e8s1_t f16m7e8s1;
+    float32_t       f32;
+    float64_t       f64;
+    Fixed24f12i12   x24f12i12;
+    Fixed32f16i16   x32f16i16;
+    Fixed32f24i8    x32f24i8;
+
+    NumberUnion() : ui64(0) {}
+};
+
+enum class ElementType : uint32_t
+{
+    Undefined = 0,
+    Float32 = 1,    // starting from bit 0 - mantissa:23 exponent:8 sign:1
+    Uint8 = 2,
+    Int8 = 3,
+    Uint16 = 4,
+    Int16 = 5,
+    Int32 = 6,
+    Int64 = 7,
+    StringChar8 = 8,
+    Bool8 = 9,
+    Float16m10e5s1 = 10, // mantissa:10 exponent:5 sign:1
+    Float16 = Float16m10e5s1,
+    Float64 = 11,   // mantissa:52 exponent:11 sign:1
+    Uint32 = 12,
+    Uint64 = 13,
+    Complex64 = 14,
+    Complex128 = 15,
+    Float16m7e8s1 = 16,   // mantissa:7 exponent:8 sign:1
+    Bfloat16 = Float16m7e8s1,
+    Fixed24f12i12 = 17, // TODO: Make naming more consistent. Fixed24f12i12 vs Fixed12_12
+    Fixed32f16i16 = 18,
+    Fixed32f24i8 = 19,
+    Float8m3e4s1 = 20, // mantissa:3 exponent:4 sign:1
+    Float8m2e5s1 = 21, // mantissa:2 exponent:5 sign:1
+    Total = 22,
+};
+
+enum class NumericOperationType : uint32_t
+{
+    None,       // Invalid value
+    Nothing,    // No result, taking N outputs, returning 0 outputs
+    Nop,            // No operation, taking N inputs, returning N outputs (identity)
+    Identity = Nop,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Dot,
+    Truncate,
+    Total
+};
+
+enum class NumericPrintingFlags : uint32_t
+{
+    ShowNumericType = 1 << 0,
+    ShowNumericValue = 1 << 1,
+    ShowBinaryValue = 1 << 2,
+
+    ShowRawHex = 0 << 4,
+    ShowRawBinary = 1 << 4,
+    ShowRawDecimal = 2 << 4,
+    ShowRawOctal = 3 << 4,
+    ShowDataMask = 3 << 4,
+
+    ShowFloatDecimal = 0 << 6,
+    ShowFloatHex = 1 << 6,
+    ShowFloatMask = 1 << 6,
+
+    HideRawFields = 0 << 7,
+    ShowRawFields = 1 << 7,
+    ShowRawFieldsMask = 1 << 7,
+
+    ShowRawBinaryFields = ShowRawBinary | ShowRawFields,
+
+    Default = ShowBinaryValue | ShowNumericValue | ShowNumericType,
+};
+
+inline constexpr NumericPrintingFlags operator ~ (NumericPrintingFlags lhs) { return NumericPrintingFlags(~uint32_t(lhs)); }
+inline constexpr NumericPrintingFlags operator & (NumericPrintingFlags lhs, NumericPrintingFlags rhs) { return NumericPrintingFlags(uint32_t(lhs) & uint32_t(rhs)); }
+inline constexpr NumericPrintingFlags operator | (NumericPrintingFlags lhs, NumericPrintingFlags rhs) { return NumericPrintingFlags(uint32_t(lhs) & uint32_t(rhs)); }
+inline constexpr bool operator == (NumericPrintingFlags lhs, uint32_t rhs) { return uint32_t(lhs) == rhs; }
+inline constexpr bool operator != (NumericPrintingFlags lhs, uint32_t rhs) { return uint32_t(lhs) != rhs; }
+
+struct NumberUnionAndType
+{
+    NumberUnion numberUnion;
+    ElementType elementType;
+    NumericPrintingFlags printingFlags = NumericPrintingFlags::Default;
+};
+
+struct NumericOperationAndRange
+{
+    NumericOperationType numericOperationType;
+    Range range;
+    ElementType outputElementType;
+};
+
+// A run of elements within a binary file, which are decoded only as they are streamed, so that
+// multi-gigabyte files never need to be held entirely as NumberUnionAndType. Long runs of numbers
+// in the command text are viewed likewise, parsed only as they are streamed.
+struct NumberFileView
+{
+    std::shared_ptr<const void> storage; // The mapped file (or parsed text file numbers) that data points into.
+    const uint8_t* data;
+    uint64_t elementCount;
+    ElementType elementType;
+    uint32_t blockQuantizedType; // ggml type of GGUF blocks decoded to float32 elements, else zero.
+    bool isInt24;                // Packed 24-bit integers decoded to int32 elements.
+    bool isBigEndian;            // Byte swapped as decoded, like 16-bit PPM samples.
+    uint64_t elementStride;      // Elements between consecutive elements, like the channel count when viewing one channel.
+    uint64_t rowElementCount;    // Elements per row of a region, after which the next row starts rowStride elements on.
+    uint64_t rowStride;
+    NumericPrintingFlags printingFlags;
+    size_t numberIndex;    // Count of parsed numbers before the file, to keep operand order.
+    size_t operationIndex; // Count of operations before the file, the last of which it belongs to.
+    std::string_view text; // Numbers of the command text (and commas) rather than file data, else empty.
+    ElementType textElementType; // Type to parse the text numbers as, else undefined to deduce each (elementType is then the promoted type).
+    bool parseAsRawData;
+};
+
+// TODO: Utilize nested operands instead of single operator lists.
+struct Operand
+{
+    SmallEnum<NumericOperationType, uint8_t> numericOperationType;
+    SmallEnum<ElementType, uint8_t> elementType;
+    uint8_t padding[2];
+    NumericPrintingFlags printingFlags;
+    union
+    {
+        NumberUnion numberUnion;
+        Range range;
+    };
+};
+
+struct NumberSubstructure
+{
+    Range fraction;
+    Range integer;
+    Range exponent;
+    Range sign;
+
+    // e.g. {0,30, 0,0, 30,31, 31,32} float32
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char* g_numericOperationTypeNames[] =
+{
+    "none",
+    "nothing",
+    "nop",
+    "add",
+    "subtract",
+    "multiply",
+    "divide",
+    "dot",
+    "truncate",
+};
+static_assert(int(NumericOperationType::Total) == 9 && std::size(g_numericOperationTypeNames) == 9);
+
+const char* g_elementTypeNames[] =
+{
+    "undefined",    // Undefined = 0,
+    "float32",      // Float32 = 1,
+    "uint8",        // Uint8 = 2,
+    "int8",         // Int8 = 3,
+    "uint16",       // Uint16 = 4,
+    "int16",        // Int16 = 5,
+    "int32",        // Int32 = 6,
+    "int64",        // Int64 = 7,
+    "string8",      // StringChar8 = 8,
+    "bool8",        // Bool = 9,
+    "float16",      // Float16 = 10,
+    "float64",      // Float64 = 11,
+    "uint32",       // Uint32 = 12,
+    "uint64",       // Uint64 = 13,
+    "complex64",    // Complex64 = 14,
+    "complex128",   // Complex128 = 15,
+    "bfloat16",     // Float16m7e8s1 = 16,
+    "fixed12_12",   // Fixed24f12i12 = 17,
+    "fixed16_16",   // Fixed32f16i16 = 18,
+    "fixed8_24",    // Fixed32f24i8 = 19,
+    "float8e4m3",   // Float8f3e4s1 = 20,
+    "float8e5m2",   // Float8f2e5s1 = 21,
+};
+static_assert(int(ElementType::Total) == 22 && std::size(g_elementTypeNames) == 22);
+
+const static uint8_t g_byteSizeOfElementType[] =
+{
+    0,  // Undefined = 0,
+    4,  // Float32 = 1,
+    1,  // Uint8 = 2,
+    1,  // Int8 = 3,
+    2,  // Uint16 = 4,
+    2,  // Int16 = 5,
+    4,  // Int32 = 6,
+    8,  // Int64 = 7,
+    0,  // sizeof(TypedBufferStringElement), // StringChar8 = 8,
+    1,  // Bool = 9,
+    2,  // Float16 = 10,
+    8,  // Float64 = 11,
+    4,  // Uint32 = 12,
+    8,  // Uint64 = 13,
+    8,  // Complex64 = 14,
+    16, // Complex128 = 15,
+    2,  // Float16m7e8s1 = 16,
+    3,  // Fixed24f12i12 = 17,
+    4,  // Fixed32f16i16 = 18,
+    4,  // Fixed32f24i8 = 19,
+    1,  // Float8f3e4s1 = 20,
+    1,  // Float8f2e5s1 = 21,
+};
+static_assert(int(ElementType::Total) == 22 && std::size(g_byteSizeOfElementType) == 22);
+
+const static uint8_t g_isFractionalElementType[] =
+{
+    false, // Undefined = 0,
+    true , // Float32 = 1,
+    false, // Uint8 = 2,
+    false, // Int8 = 3,
+    false, // Uint16 = 4,
+    false, // Int16 = 5,
+    false, // Int32 = 6,
+    false, // Int64 = 7,
+    false, // sizeof(TypedBufferStringElement), // StringChar8 = 8,
+    false, // Bool = 9,
+    true , // Float16 = 10,
+    true , // Float64 = 11,
+    false, // Uint32 = 12,
+    false, // Uint64 = 13,
+    true , // Complex64 = 14,
+    true , // Complex128 = 15,
+    true , // Float16m7e8s1 = 16,
+    true , // Fixed24f12i12 = 17,
+    true , // Fixed32f16i16 = 18,
+    true , // Fixed32f24i8 = 19,
+    true , // Float8f3e4s1 = 20,
+    true , // Float8f2e5s1 = 21,
+};
+static_assert(int(ElementType::Total) == 22 && std::size(g_isFractionalElementType) == 22);
+
+const static uint8_t g_isSignedElementType[] =
+{
+    false, // Undefined = 0,
+    true , // Float32 = 1,
+    false, // Uint8 = 2,
+    true , // Int8 = 3,
+    false, // Uint16 = 4,
+    true , // Int16 = 5,
+    true , // Int32 = 6,
+    true , // Int64 = 7,
+    false, // sizeof(TypedBufferStringElement), // StringChar8 = 8,
+    false, // Bool = 9,
+    true , // Float16 = 10,
+    true , // Float64 = 11,
+    false, // Uint32 = 12,
+    false, // Uint64 = 13,
+    true , // Complex64 = 14,
+    true , // Complex128 = 15,
+    true , // Float16m7e8s1 = 16,
+    true , // Fixed24f12i12 = 17,
+    true , // Fixed32f16i16 = 18,
+    true , // Fixed32f24i8 = 19,
+    true , // Float8f3e4s1 = 20,
+    true , // Float8f2e5s1 = 21,
+};
+static_assert(int(ElementType::Total) == 22 && std::size(g_isSignedElementType) == 22);
+
+// NumPy dtype strings of each element type for .npy files. Types which numpy lacks are stored as
+// raw bits of the same size (e.g. bfloat16 as uint16), to be read back with an explicit type.
+const char* g_npyElementTypeDescrs[] =
+{
+    "",     // Undefined = 0,
+    "<f4",  // Float32 = 1,
+    "|u1",  // Uint8 = 2,
+    "|i1",  // Int8 = 3,
+    "<u2",  // Uint16 = 4,
+    "<i2",  // Int16 = 5,
+    "<i4",  // Int32 = 6,
+    "<i8",  // Int64 = 7,
+    "",     // StringChar8 = 8,
+    "|b1",  // Bool = 9,
+    "<f2",  // Float16 = 10,
+    "<f8",  // Float64 = 11,
+    "<u4",  // Uint32 = 12,
+    "<u8",  // Uint64 = 13,
+    "<c8",  // Complex64 = 14,
+    "<c16", // Complex128 = 15,
+    "<u2",  // Float16m7e8s1 = 16,
+    "|V3",  // Fixed24f12i12 = 17,
+    "<i4",  // Fixed32f16i16 = 18,
+    "<i4",  // Fixed32f24i8 = 19,
+    "|u1",  // Float8f3e4s1 = 20,
+    "|u1",  // Float8f2e5s1 = 21,
+};
+static_assert(int(ElementType::Total) == 22 && std::size(g_npyElementTypeDescrs) == 22);
+
+// safetensors dtype strings of each element type, empty for types the format lacks.
+const char* g_safetensorsElementTypeDtypes[] =
+{
+    "",         // Undefined = 0,
+    "F32",      // Float32 = 1,
+    "U8",       // Uint8 = 2,
+    "I8",       // Int8 = 3,
+    "U16",      // Uint16 = 4,
+    "I16",      // Int16 = 5,
+    "I32",      // Int32 = 6,
+    "I64",      // Int64 = 7,
+    "",         // StringChar8 = 8,
+    "BOOL",     // Bool = 9,
+    "F16",      // Float16 = 10,
+    "F64",      // Float64 = 11,
+    "U32",      // Uint32 = 12,
+    "U64",      // Uint64 = 13,
+    "",         // Complex64 = 14,
+    "",         // Complex128 = 15,
+    "BF16",     // Float16m7e8s1 = 16,
+    "",         // Fixed24f12i12 = 17,
+    "",         // Fixed32f16i16 = 18,
+    "",         // Fixed32f24i8 = 19,
+    "F8_E4M3",  // Float8f3e4s1 = 20,
+    "F8_E5M2",  // Float8f2e5s1 = 21,
+};
+static_assert(int(ElementType::Total) == 22 && std::size(g_safetensorsElementTypeDtypes) == 22);
+
+// ElementType enum reordered by priority of promotion rules.
+enum class ElementTypePriority : uint32_t
+{
+    Undefined,
+    Bool8,
+    StringChar8,
+    Uint8,
+    Int8,
+    Uint16,
+    Int16,
+    Uint32,
+    Int32,
+    Uint64,
+    Int64,
+    Float16m10e5s1,
+    Float16 = Float16m10e5s1,
+    Float16m7e8s1,
+    Bfloat16 = Float16m7e8s1,
+    Fixed32f24i8,
+    Fixed24f12i12,
+    Fixed32f16i16,
+    Float32,
+    Float64,
+    Complex64,
+    Complex128,
+    Float8f3e4s1,
+    Float8f2e5s1,
+    Total,
+};
+static_assert(size_t(ElementType::Total) == size_t(ElementTypePriority::Total));
+
+const ElementTypePriority g_elementTypePriorityTable[] = // The index is an ElementType enum.
+{
+    /* Undefined = 0       */ ElementTypePriority::Undefined,
+    /* Float32 = 1         */ ElementTypePriority::Float32,
+    /* Uint8 = 2           */ ElementTypePriority::Uint8,
+    /* Int8 = 3            */ ElementTypePriority::Int8,
+    /* Uint16 = 4          */ ElementTypePriority::Uint16,
+    /* Int16 = 5           */ ElementTypePriority::Int16,
+    /* Int32 = 6           */ ElementTypePriority::Int32,
+    /* Int64 = 7           */ ElementTypePriority::Int64,
+    /* StringChar8 = 8     */ ElementTypePriority::StringChar8,
+    /* Bool8 = 9           */ ElementTypePriority::Bool8,
+    /* Float16m10e5s1 = 10 */ ElementTypePriority::Float16m10e5s1,
+    /* Float64 = 11        */ ElementTypePriority::Float64,
+    /* Uint32 = 12         */ ElementTypePriority::Uint32,
+    /* Uint64 = 13         */ ElementTypePriority::Uint64,
+    /* Complex64 = 14      */ ElementTypePriority::Complex64,
+    /* Complex128 = 15     */ ElementTypePriority::Complex128,
+    /* Float16m7e8s1 = 16  */ ElementTypePriority::Float16m7e8s1,
+    /* Fixed24f12i12 = 17  */ ElementTypePriority::Fixed24f12i12,
+    /* Fixed32f16i16 = 18  */ ElementTypePriority::Fixed32f16i16,
+    /* Fixed32f24i8 = 19   */ ElementTypePriority::Fixed32f24i8,
+    /* Float8f3e4s1 = 20   */ ElementTypePriority::Float8f3e4s1,
+    /* Float8f2e5s1 = 21   */ ElementTypePriority::Float8f2e5s1,
+};
+static_assert(std::size(g_elementTypePriorityTable) == size_t(ElementType::Total));
+
+const NumberSubstructure g_elementTypeSubstructures[] = // The index is an ElementType enum.
+{
+    //                       fraction, integer, exponent, sign
+    /* Undefined = 0       */ {{ 0, 0},{ 0, 0},{ 0, 0},{ 0, 0}},
+    /* Float32 = 1         */ {{ 0,23},{ 0, 0},{23,31},{31,32}},
+    /* Uint8 = 2           */ {{ 0, 0},{ 0, 8},{ 0, 0},{ 0, 0}},
+    /* Int8 = 3            */ {{ 0, 0},{ 0, 7},{ 0, 0},{ 7, 8}},
+    /* Uint16 = 4          */ {{ 0, 0},{ 0,16},{ 0, 0},{ 0, 0}},
+    /* Int16 = 5           */ {{ 0, 0},{ 0,15},{ 0, 0},{15,16}},
+    /* Int32 = 6           */ {{ 0, 0},{ 0,31},{ 0, 0},{31,32}},
+    /* Int64 = 7           */ {{ 0, 0},{ 0,63},{ 0, 0},{63,64}},
+    /* StringChar8 = 8     */ {{ 0, 0},{ 0, 0},{ 0, 0},{ 0, 0}},
+    /* Bool8 = 9           */ {{ 0, 0},{ 0, 8},{ 0, 0},{ 0, 0}},
+    /* Float16m10e5s1 = 10 */ {{ 0,10},{ 0, 0},{10,15},{15,16}},
+    /* Float64 = 11        */ {{ 0,52},{ 0, 0},{52,63},{63,64}},
+    /* Uint32 = 12         */ {{ 0, 0},{ 0,32},{ 0, 0},{ 0, 0}},
+    /* Uint64 = 13         */ {{ 0, 0},{ 0,64},{ 0, 0},{ 0, 0}},
+    /* Complex64 = 14      */ {{ 0,23},{ 0, 0},{23,31},{31,32}},
+    /* Complex128 = 15     */ {{ 0,52},{ 0, 0},{52,63},{63,64}},
+    /* Float16m7e8s1 = 16  */ {{ 0, 7},{ 0, 0},{ 7,15},{15,16}},
+    /* Fixed24f12i12 = 17  */ {{ 0,12},{12,24},{ 0, 0},{ 0, 0}},
+    /* Fixed32f16i16 = 18  */ {{ 0,16},{16,32},{ 0, 0},{ 0, 0}},
+    /* Fixed32f24i8 = 19   */ {{ 0, 8},{ 8,32},{ 0, 0},{ 0, 0}},
+    /* Float8f3e4s1 = 20   */ {{ 0, 3},{ 0, 0},{ 3, 7},{ 7, 8}},
+    /* Float8f2e5s1 = 21   */ {{ 0, 2},{ 0, 0},{ 2, 7},{ 7, 8}},
+};
+static_assert(std::size(g_elementTypeSubstructures) == size_t(ElementType::Total));
+
+uint32_t GetSizeOfTypeInBytes(ElementType dataType) noexcept
+{
+    size_t index = static_cast<size_t>(dataType);
+    return g_byteSizeOfElementType[index < std::size(g_byteSizeOfElementType) ? index : 0];
+}
+
+uint32_t GetSizeOfTypeInBits(ElementType dataType) noexcept
+{
+    size_t index = static_cast<size_t>(dataType);
+    return g_byteSizeOfElementType[index < std::size(g_byteSizeOfElementType) ? index : 0] * 8;
+}
+
+// Whether elements of the type can be read directly from raw file bytes.
+bool IsFileElementType(ElementType dataType) noexcept
+{
+    return GetSizeOfTypeInBytes(dataType) != 0
+        && dataType != ElementType::Complex64
+        && dataType != ElementType::Complex128;
+}
+
+std::string_view GetTypeNameFromElementType(ElementType dataType) noexcept
+{
+    size_t index = static_cast<size_t>(dataType);
+    return g_elementTypeNames[index < std::size(g_elementTypeNames) ? index : 0];
+}
+
+std::string_view GetNpyDescrFromElementType(ElementType dataType) noexcept
+{
+    size_t index = static_cast<size_t>(dataType);
+    return g_npyElementTypeDescrs[index < std::size(g_npyElementTypeDescrs) ? index : 0];
+}
+
+// Returns the element type of a numpy dtype string, or undefined if unsupported, and whether its
+// elements are big endian (like ">f4"), to be byte swapped as read.
+ElementType GetElementTypeFromNpyDescr(std::string_view descr, /*out*/ bool& isBigEndian) noexcept
+{
+    isBigEndian = false;
+    if (descr.size() < 3)
+    {
+        return ElementType::Undefined;
+    }
+
+    // Little endian, native (little endian on all supported hosts), big endian, or not applicable
+    // for single bytes.
+    const char byteOrder = descr.front();
+    const bool isSingleByte = descr.substr(2) == "1";
+    if (byteOrder != '<' && byteOrder != '=' && byteOrder != '|' && byteOrder != '>')
+    {
+        return ElementType::Undefined;
+    }
+    isBigEndian = (byteOrder == '>' && !isSingleByte);
+
+    // Match only the numpy native types, rather than the raw bits standing in for missing ones.
+    std::string_view typeCode = descr.substr(1);
+    for (ElementType elementType : {
+        ElementType::Float16, ElementType::Float32, ElementType::Float64,
+        ElementType::Int8, ElementType::Int16, ElementType::Int32, ElementType::Int64,
+        ElementType::Uint8, ElementType::Uint16, ElementType::Uint32, ElementType::Uint64,
+        ElementType::Bool8,
+    })
+    {
+        if (GetNpyDescrFromElementType(elementType).substr(1) == typeCode)
+        {
+            return elementType;
+        }
+    }
+    return ElementType::Undefined;
+}
+
+std::string_view GetSafetensorsDtypeFromElementType(ElementType dataType) noexcept
+{
+    size_t index = static_cast<size_t>(dataType);
+    return g_safetensorsElementTypeDtypes[index < std::size(g_safetensorsElementTypeDtypes) ? index : 0];
+}
+
+// Returns the element type of a safetensors dtype string, or undefined if unsupported.
+ElementType GetElementTypeFromSafetensorsDtype(std::string_view dtype) noexcept
+{
+    for (size_t i = 1; i < std::size(g_safetensorsElementTypeDtypes); ++i)
+    {
+        if (dtype == g_safetensorsElementTypeDtypes[i])
+        {
+            return ElementType(i);
+        }
+    }
+    return ElementType::Undefined;
+}
+
+bool IsFractionalElementType(ElementType dataType) noexcept
+{
+    size_t index = static_cast<size_t>(dataType);
+    return g_isFractionalElementType[index < std::size(g_isFractionalElementType) ? index : 0];
+}
+
+bool IsSignedElementType(ElementType dataType) noexcept
+{
+    size_t index = static_cast<size_t>(dataType);
+    return g_isSignedElementType[index < std::size(g_isSignedElementType) ? index : 0];
+}
+
+NumberSubstructure const& GetElementTypeSubstructure(ElementType dataType) noexcept
+{
+    size_t index = static_cast<size_t>(dataType);
+    return g_elementTypeSubstructures[index < std::size(g_elementTypeSubstructures) ? index : 0];
+}
+
+// Read data type and cast to double.
+// The caller passes a data pointer of the given type.
+/*static*/ double ReadToDouble(ElementType dataType, const void* data)
+{
+    double value = 0;
+    switch (dataType)
+    {
+    case ElementType::Float32:          value = *reinterpret_cast<const float*>(data);              break;
+    case ElementType::Uint8:            value = *reinterpret_cast<const uint8_t*>(data);            break;
+    case ElementType::Int8:             value = *reinterpret_cast<const int8_t*>(data);             break;
+    case ElementType::Uint16:           value = *reinterpret_cast<const uint16_t*>(data);           break;
+    case ElementType::Int16:            value = *reinterpret_cast<const int16_t*>(data);            break;
+    case ElementType::Int32:            value = *reinterpret_cast<const int32_t*>(data);            break;
+    case ElementType::Int64:            value = double(*reinterpret_cast<const int64_t*>(data));    break;
+    case ElementType::StringChar8:      value = 0; /* no numeric value for strings */               break;
+    case ElementType::Bool8:            value = *reinterpret_cast<const bool*>(data);               break;
+    case ElementType::Float16:          value = *reinterpret_cast<const float16_t*>(data);          break;
+    case ElementType::Bfloat16:         value = *reinterpret_cast<const bfloat16_t*>(data);         break;
+    case ElementType::Float64:          value = *reinterpret_cast<const double*>(data);             break;
+    case ElementType::Uint32:           value = *reinterpret_cast<const uint32_t*>(data);           break;
+    case ElementType::Uint64:           value = double(*reinterpret_cast<const uint64_t*>(data));   break;
+    case ElementType::Complex64:        throw std::invalid_argument("Complex64 type is not supported.");
+    case ElementType::Complex128:       throw std::invalid_argument("Complex128 type is not supported.");
+    case ElementType::Fixed24f12i12:    value = *reinterpret_cast<const Fixed24f12i12*>(data);      break;
+    case ElementType::Fixed32f16i16:    value = *reinterpret_cast<const Fixed32f16i16*>(data);      break;
+    case ElementType::Fixed32f24i8:     value = *reinterpret_cast<const Fixed32f24i8*>(data);       break;
+    case ElementType::Float8m3e4s1:     value = *reinterpret_cast<const float8m3e4s1_t*>(data);     break;
+    case ElementType::Float8m2e5s1:     value = *reinterpret_cast<const float8m2e5s1_t*>(data);     break;
+    default:                            assert(false);                                              break;
+    }
+
+    return value;
+}
+
+// Read data type and cast to int64.
+// The caller passes a data pointer of the given type.
+/*static*/ int64_t ReadToInt64(ElementType dataType, const void* data)
+{
+    int64_t value = 0;
+    switch (dataType)
+    {
+    case ElementType::Float32:          value = int64_t(*reinterpret_cast<const float*>(data));         break;
+    case ElementType::Uint8:            value = int64_t(*reinterpret_cast<const uint8_t*>(data));       break;
+    case ElementType::Int8:             value = int64_t(*reinterpret_cast<const int8_t*>(data));        break;
+    case ElementType::Uint16:           value = int64_t(*reinterpret_cast<const uint16_t*>(data));      break;
+    case ElementType::Int16:            value = int64_t(*reinterpret_cast<const int16_t*>(data));       break;
+    case ElementType::Int32:            value = int64_t(*reinterpret_cast<const int32_t*>(data));       break;
+    case ElementType::Int64:            value = int64_t(*reinterpret_cast<const int64_t*>(data));       break;
+    case ElementType::StringChar8:      value = int64_t(0); /* no numeric value for strings */          break;
+    case ElementType::Bool8:            value = int64_t(*reinterpret_cast<const bool*>(data));          break;
+    case ElementType::Float16:          value = int64_t(*reinterpret_cast<const float16_t*>(data));     break;
+    case ElementType::Bfloat16:         value = int64_t(*reinterpret_cast<const bfloat16_t*>(data));    break;
+    case ElementType::Float64:          value = int64_t(*reinterpret_cast<const double*>(data));        break;
+    case ElementType::Uint32:           value = int64_t(*reinterpret_cast<const uint32_t*>(data));      break;
+    case ElementType::Uint64:           value = int64_t(*reinterpret_cast<const uint64_t*>(data));      break;
+    case ElementType::Complex64:        throw std::invalid_argument("Complex64 type is not supported.");
+    case ElementType::Complex128:       throw std::invalid_argument("Complex128 type is not supported.");
+    case ElementType::Fixed24f12i12:    value = int64_t(*reinterpret_cast<const Fixed24f12i12*>(data)); break;
+    case ElementType::Fixed32f16i16:    value = int64_t(*reinterpret_cast<const Fixed32f16i16*>(data)); break;
+    case ElementType::Fixed32f24i8:;    value = int64_t(*reinterpret_cast<const Fixed32f24i8*>(data));  break;
+    case ElementType::Float8m3e4s1:     value = int64_t(double(*reinterpret_cast<const float8m3e4s1_t*>(data))); break;
+    case ElementType::Float8m2e5s1:     value = int64_t(double(*reinterpret_cast<const float8m2e5s1_t*>(data))); break;
+    default:                            assert(false);                                              break;
+    }
+
+    return value;
+}
+
+// Read the raw bits, returned as int64.
+// Useful for Unit Last Place comparisons.
+/*static*/ int64_t ReadRawBitValue(ElementType dataType, const void* data)
+{
+    int64_t value = 0;
+    switch (dataType)
+    {
+    case ElementType::Float32:          value = int64_t(*reinterpret_cast<const int32_t*>(data));   break;
+    case ElementType::Uint8:            value = int64_t(*reinterpret_cast<const uint8_t*>(data));   break;
+    case ElementType::Int8:             value = int64_t(*reinterpret_cast<const int8_t*>(data));    break;
+    case ElementType::Uint16:           value = int64_t(*reinterpret_cast<const uint16_t*>(data));  break;
+    case ElementType::Int16:            value = int64_t(*reinterpret_cast<const int16_t*>(data));   break;
+    case ElementType::Int32:            value = int64_t(*reinterpret_cast<const int32_t*>(data));   break;
+    case ElementType::Int64:            value = int64_t(*reinterpret_cast<const int64_t*>(data));   break;
+    case ElementType::StringChar8:      value = int64_t(0); /* no numeric value for strings */      break;
+    case ElementType::Bool8:            value = int64_t(*reinterpret_cast<const bool*>(data));      break;
+    case ElementType::Float16:          value = int64_t(*reinterpret_cast<const int16_t*>(data));   break;
+    case ElementType::Bfloat16:         value = int64_t(*reinterpret_cast<const int16_t*>(data));   break;
+    case ElementType::Float64:          value = int64_t(*reinterpret_cast<const int64_t*>(data));   break;
+    case ElementType::Uint32:           value = int64_t(*reinterpret_cast<const uint32_t*>(data));  break;
+    case ElementType::Uint64:           value = int64_t(*reinterpret_cast<const uint64_t*>(data));  break;
+    case ElementType::Complex64:        throw std::invalid_argument("Complex64 type is not supported.");
+    case ElementType::Complex128:       throw std::invalid_argument("Complex128 type is not supported.");
+    case ElementType::Fixed24f12i12:    value = int64_t(*reinterpret_cast<const int24_t*>(data));   break;
+    case ElementType::Fixed32f16i16:    value = int64_t(*reinterpret_cast<const int32_t*>(data));   break;
+    case ElementType::Fixed32f24i8:;    value = int64_t(*reinterpret_cast<const int32_t*>(data));   break;
+    case ElementType::Float8m3e4s1:     value = int64_t(*reinterpret_cast<const int8_t*>(data));    break;
+    case ElementType::Float8m2e5s1:     value = int64_t(*reinterpret_cast<const int8_t*>(data));    break;
+    default:                            assert(false);                                              break;
+    }
+
+    return value;
+}
+
+// Rounds directly from float64 to bfloat16, ties to even, since rounding through float32 first
+// could round twice (bfloat16_t only takes float32).
+uint16_t RoundToBfloat16(double value) noexcept
+{
+    return FloatNumberDefinitions::ConvertRawFloatType<FloatNumberDefinitions::Float64, FloatNumberDefinitions::Float16f7e8s1>(std::bit_cast<uint64_t>(value));
+}
+
+// The caller passes a data pointer of the given type.
+void WriteFromDouble(ElementType dataType, double value, /*out*/ void* data)
+{
+    switch (dataType)
+    {
+    case ElementType::Float32:          *reinterpret_cast<float*>(data) = float(value);             break;
+    case ElementType::Uint8:            *reinterpret_cast<uint8_t*>(data) = uint8_t(value);         break;
+    case ElementType::Int8:             *reinterpret_cast<int8_t*>(data) = int8_t(value);           break;
+    case ElementType::Uint16:           *reinterpret_cast<uint16_t*>(data) = uint16_t(value);       break;
+    case ElementType::Int16:            *reinterpret_cast<int16_t*>(data) = int16_t(value);         break;
+    case ElementType::Int32:            *reinterpret_cast<int32_t*>(data) = int32_t(value);         break;
+    case ElementType::Int64:            *reinterpret_cast<int64_t*>(data) = int64_t(value);         break;
+    case ElementType::StringChar8:      /* no change value for strings */                           break;
+    case ElementType::Bool8:            *reinterpret_cast<bool*>(data) = bool(value);               break;
+    case ElementType::Float16:          *reinterpret_cast<uint16_t*>(data) = half_float::detail::float2half<std::round_to_nearest, double>(value); break;
+    case ElementType::Bfloat16:         *reinterpret_cast<uint16_t*>(data) = RoundToBfloat16(value); break;
+    case ElementType::Float64:          *reinterpret_cast<double*>(data) = value;                   break;
+    case ElementType::Uint32:           *reinterpret_cast<uint32_t*>(data) = uint32_t(value);       break;
+    case ElementType::Uint64:           *reinterpret_cast<uint64_t*>(data) = uint64_t(value);       break;
+    case ElementType::Complex64:        throw std::invalid_argument("Complex64 type is not supported.");
+    case ElementType::Complex128:       throw std::invalid_argument("Complex128 type is not supported.");
+    case ElementType::Fixed24f12i12:    *reinterpret_cast<Fixed24f12i12*>(data) = float(value);     break;
+    case ElementType::Fixed32f16i16:    *reinterpret_cast<Fixed32f16i16*>(data) = float(value);     break;
+    case ElementType::Fixed32f24i8:;    *reinterpret_cast<Fixed32f24i8*>(data) = float(value);      break;
+    case ElementType::Float8m3e4s1:     *reinterpret_cast<float8m3e4s1_t*>(data) = value;           break;
+    case ElementType::Float8m2e5s1:     *reinterpret_cast<float8m2e5s1_t*>(data) = value;           break;
+    default:                            assert(false);                                              break;
+    }
+
+    // Use half_float::detail::float2half explicitly rather than the half constructor.
+    // Otherwise values do not round-trip as expected.
+    //
+    // e.g. If you print float16 0x2C29, you get 0.0650024, but if you try to parse
+    // 0.0650024, you get 0x2C28 instead. Then printing 0x2C28 shows 0.0649414,
+    // but trying to parse 0.0649414 returns 0x2C27. Rounding to nearest fixes this.
+}
+
+// The caller passes a data pointer of the given type.
+void WriteFromInt64(ElementType dataType, int64_t value, /*out*/ void* data)
+{
+    switch (dataType)
+    {
+    case ElementType::Float32:       *reinterpret_cast<float*>(data) = float(value);                    break;
+    case ElementType::Uint8:         *reinterpret_cast<uint8_t*>(data) = uint8_t(value);                break;
+    case ElementType::Int8:          *reinterpret_cast<int8_t*>(data) = int8_t(value);                  break;
+    case ElementType::Uint16:        *reinterpret_cast<uint16_t*>(data) = uint16_t(value);              break;
+    case ElementType::Int16:         *reinterpret_cast<int16_t*>(data) = int16_t(value);                break;
+    case ElementType::Int32:         *reinterpret_cast<int32_t*>(data) = int32_t(value);                break;
+    case ElementType::Int64:         *reinterpret_cast<int64_t*>(data) = int64_t(value);                break;
+    case ElementType::StringChar8:   /* no change value for strings */                                  break;
+    case ElementType::Bool8:         *reinterpret_cast<bool*>(data) = bool(value);                      break;
+    case ElementType::Float16:       *reinterpret_cast<uint16_t*>(data) = half_float::detail::float2half<std::round_to_nearest, double>(double(value)); break;
+    case ElementType::Bfloat16:      *reinterpret_cast<uint16_t*>(data) = RoundToBfloat16(double(value)); break;
+    case ElementType::Float64:       *reinterpret_cast<double*>(data) = double(value);                  break;
+    case ElementType::Uint32:        *reinterpret_cast<uint32_t*>(data) = uint32_t(value);              break;
+    case ElementType::Uint64:        *reinterpret_cast<uint64_t*>(data) = uint64_t(value);              break;
+    case ElementType::Complex64:     throw std::invalid_argument("Complex64 type is not supported.");
+    case ElementType::Complex128:    throw std::invalid_argument("Complex128 type is not supported.");
+    case ElementType::Fixed24f12i12: *reinterpret_cast<Fixed24f12i12*>(data) = float(value);            break;
+    case ElementType::Fixed32f16i16: *reinterpret_cast<Fixed32f16i16*>(data) = float(value);            break;
+    case ElementType::Fixed32f24i8:  *reinterpret_cast<Fixed32f24i8*>(data) = float(value);             break;
+    case ElementType::Float8m3e4s1:  *reinterpret_cast<float8m3e4s1_t*>(data) = double(value);          break;
+    case ElementType::Float8m2e5s1:  *reinterpret_cast<float8m2e5s1_t*>(data) = double(value);          break;
+    default:                         assert(false);                                                     break;
+    }
+}
+
+// Converts an array of T to ValueType by way of IntermediateType, matching the expressions of the
+// single element readers and writers below, which the bulk forms must give identical results to.
+template <typename ValueType, typename IntermediateType, typename T>
+void ReadArray(const void* data, /*out*/ ValueType* values, size_t count)
+{
+    const T* input = reinterpret_cast<const T*>(data);
+    for (size_t i = 0; i < count; ++i)
+    {
+        values[i] = ValueType(IntermediateType(input[i]));
+    }
+}
+
+template <typename T, typename IntermediateType, typename ValueType>
+void WriteArray(const ValueType* values, /*out*/ void* data, size_t count)
+{
+    T* output = reinterpret_cast<T*>(data);
+    for (size_t i = 0; i < count; ++i)
+    {
+        output[i] = IntermediateType(values[i]);
+    }
+}
+
+static_assert(sizeof(Fixed24f12i12) == 3, "Arrays of fixed12_12 must be packed like the file data.");
+
+// Bulk ReadToDouble, switching on the type once rather than per element.
+void ReadToDoubles(ElementType dataType, const void* data, /*out*/ double* values, size_t count)
+{
+    switch (dataType)
+    {
+    case ElementType::Float32:          ReadArray<double, float, float>(data, values, count);                   break;
+    case ElementType::Uint8:            ReadArray<double, uint8_t, uint8_t>(data, values, count);               break;
+    case ElementType::Int8:             ReadArray<double, int8_t, int8_t>(data, values, count);                 break;
+    case ElementType::Uint16:           ReadArray<double, uint16_t, uint16_t>(data, values, count);             break;
+    case ElementType::Int16:            ReadArray<double, int16_t, int16_t>(data, values, count);               break;
+    case ElementType::Int32:            ReadArray<double, int32_t, int32_t>(data, values, count);               break;
+    case ElementType::Int64:            ReadArray<double, int64_t, int64_t>(data, values, count);               break;
+    case ElementType::Bool8:            ReadArray<double, bool, bool>(data, values, count);                     break;
+    case ElementType::Float16:          ReadArray<double, float, float16_t>(data, values, count);               break;
+    case ElementType::Bfloat16:         ReadArray<double, float, bfloat16_t>(data, values, count);              break;
+    case ElementType::Float64:          ReadArray<double, double, double>(data, values, count);                 break;
+    case ElementType::Uint32:           ReadArray<double, uint32_t, uint32_t>(data, values, count);             break;
+    case ElementType::Uint64:           ReadArray<double, uint64_t, uint64_t>(data, values, count);             break;
+    case ElementType::Fixed24f12i12:    ReadArray<double, float, Fixed24f12i12>(data, values, count);           break;
+    case ElementType::Fixed32f16i16:    ReadArray<double, float, Fixed32f16i16>(data, values, count);           break;
+    case ElementType::Fixed32f24i8:     ReadArray<double, float, Fixed32f24i8>(data, values, count);            break;
+    case ElementType::Float8m3e4s1:     ReadArray<double, double, float8m3e4s1_t>(data, values, count);         break;
+    case ElementType::Float8m2e5s1:     ReadArray<double, double, float8m2e5s1_t>(data, values, count);         break;
+    default:
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = ReadToDouble(dataType, reinterpret_cast<const uint8_t*>(data) + i * GetSizeOfTypeInBytes(dataType));
+        }
+        break;
+    }
+}
+
+// Bulk ReadToInt64.
+void ReadToInt64s(ElementType dataType, const void* data, /*out*/ int64_t* values, size_t count)
+{
+    switch (dataType)
+    {
+    case ElementType::Float32:          ReadArray<int64_t, float, float>(data, values, count);                  break;
+    case ElementType::Uint8:            ReadArray<int64_t, uint8_t, uint8_t>(data, values, count);              break;
+    case ElementType::Int8:             ReadArray<int64_t, int8_t, int8_t>(data, values, count);                break;
+    case ElementType::Uint16:           ReadArray<int64_t, uint16_t, uint16_t>(data, values, count);            break;
+    case ElementType::Int16:            ReadArray<int64_t, int16_t, int16_t>(data, values, count);              break;
+    case ElementType::Int32:            ReadArray<int64_t, int32_t, int32_t>(data, values, count);              break;
+    case ElementType::Int64:            ReadArray<int64_t, int64_t, int64_t>(data, values, count);              break;
+    case ElementType::Bool8:            ReadArray<int64_t, bool, bool>(data, values, count);                    break;
+    case ElementType::Float16:          ReadArray<int64_t, float, float16_t>(data, values, count);              break;
+    case ElementType::Bfloat16:         ReadArray<int64_t, float, bfloat16_t>(data, values, count);             break;
+    case ElementType::Float64:          ReadArray<int64_t, double, double>(data, values, count);                break;
+    case ElementType::Uint32:           ReadArray<int64_t, uint32_t, uint32_t>(data, values, count);            break;
+    case ElementType::Uint64:           ReadArray<int64_t, uint64_t, uint64_t>(data, values, count);            break;
+    case ElementType::Fixed24f12i12:    ReadArray<int64_t, float, Fixed24f12i12>(data, values, count);          break;
+    case ElementType::Fixed32f16i16:    ReadArray<int64_t, float, Fixed32f16i16>(data, values, count);          break;
+    case ElementType::Fixed32f24i8:     ReadArray<int64_t, float, Fixed32f24i8>(data, values, count);           break;
+    case ElementType::Float8m3e4s1:     ReadArray<int64_t, double, float8m3e4s1_t>(data, values, count);        break;
+    case ElementType::Float8m2e5s1:     ReadArray<int64_t, double, float8m2e5s1_t>(data, values, count);        break;
+    default:
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = ReadToInt64(dataType, reinterpret_cast<const uint8_t*>(data) + i * GetSizeOfTypeInBytes(dataType));
+        }
+        break;
+    }
+}
+
+// Bulk WriteFromDouble.
+void WriteFromDoubles(ElementType dataType, const double* values, /*out*/ void* data, size_t count)
+{
+    switch (dataType)
+    {
+    case ElementType::Float32:          WriteArray<float, float>(values, data, count);                          break;
+    case ElementType::Uint8:            WriteArray<uint8_t, uint8_t>(values, data, count);                      break;
+    case ElementType::Int8:             WriteArray<int8_t, int8_t>(values, data, count);                        break;
+    case ElementType::Uint16:           WriteArray<uint16_t, uint16_t>(values, data, count);                    break;
+    case ElementType::Int16:            WriteArray<int16_t, int16_t>(values, data, count);                      break;
+    case ElementType::Int32:            WriteArray<int32_t, int32_t>(values, data, count);                      break;
+    case ElementType::Int64:            WriteArray<int64_t, int64_t>(values, data, count);                      break;
+    case ElementType::Bool8:            WriteArray<bool, bool>(values, data, count);                            break;
+    case ElementType::Float64:          WriteArray<double, double>(values, data, count);                        break;
+    case ElementType::Uint32:           WriteArray<uint32_t, uint32_t>(values, data, count);                    break;
+    case ElementType::Uint64:           WriteArray<uint64_t, uint64_t>(values, data, count);                    break;
+    case ElementType::Fixed24f12i12:    WriteArray<Fixed24f12i12, float>(values, data, count);                  break;
+    case ElementType::Fixed32f16i16:    WriteArray<Fixed32f16i16, float>(values, data, count);                  break;
+    case ElementType::Fixed32f24i8:     WriteArray<Fixed32f24i8, float>(values, data, count);                   break;
+    case ElementType::Float8m3e4s1:     WriteArray<float8m3e4s1_t, double>(values, data, count);                break;
+    case ElementType::Float8m2e5s1:     WriteArray<float8m2e5s1_t, double>(values, data, count);                break;
+    case ElementType::Float16:
+        for (size_t i = 0; i < count; ++i)
+        {
+            reinterpret_cast<uint16_t*>(data)[i] = half_float::detail::float2half<std::round_to_nearest, double>(values[i]);
+        }
+        break;
+    case ElementType::Bfloat16:
+        for (size_t i = 0; i < count; ++i)
+        {
+            reinterpret_cast<uint16_t*>(data)[i] = RoundToBfloat16(values[i]);
+        }
+        break;
+    default:
+        for (size_t i = 0; i < count; ++i)
+        {
+            WriteFromDouble(dataType, values[i], reinterpret_cast<uint8_t*>(data) + i * GetSizeOfTypeInBytes(dataType));
+        }
+        break;
+    }
+}
+
+// Bulk WriteFromInt64.
+void WriteFromInt64s(ElementType dataType, const int64_t* values, /*out*/ void* data, size_t count)
+{
+    switch (dataType)
+    {
+    case ElementType::Float32:          WriteArray<float, float>(values, data, count);                          break;
+    case ElementType::Uint8:            WriteArray<uint8_t, uint8_t>(values, data, count);                      break;
+    case ElementType::Int8:             WriteArray<int8_t, int8_t>(values, data, count);                        break;
+    case ElementType::Uint16:           WriteArray<uint16_t, uint16_t>(values, data, count);                    break;
+    case ElementType::Int16:            WriteArray<int16_t, int16_t>(values, data, count);                      break;
+    case ElementType::Int32:            WriteArray<int32_t, int32_t>(values, data, count);                      break;
+    case ElementType::Int64:            WriteArray<int64_t, int64_t>(values, data, count);                      break;
+    case ElementType::Bool8:            WriteArray<bool, bool>(values, data, count);                            break;
+    case ElementType::Float64:          WriteArray<double, double>(values, data, count);                        break;
+    case ElementType::Uint32:           WriteArray<uint32_t, uint32_t>(values, data, count);                    break;
+    case ElementType::Uint64:           WriteArray<uint64_t, uint64_t>(values, data, count);                    break;
+    case ElementType::Fixed24f12i12:    WriteArray<Fixed24f12i12, float>(values, data, count);                  break;
+    case ElementType::Fixed32f16i16:    WriteArray<Fixed32f16i16, float>(values, data, count);                  break;
+    case ElementType::Fixed32f24i8:     WriteArray<Fixed32f24i8, float>(values, data, count);                   break;
+    case ElementType::Float8m3e4s1:     WriteArray<float8m3e4s1_t, double>(values, data, count);                break;
+    case ElementType::Float8m2e5s1:     WriteArray<float8m2e5s1_t, double>(values, data, count);                break;
+    case ElementType::Float16:
+        for (size_t i = 0; i < count; ++i)
+        {
+            reinterpret_cast<uint16_t*>(data)[i] = half_float::detail::float2half<std::round_to_nearest, double>(double(values[i]));
+        }
+        break;
+    case ElementType::Bfloat16:
+        for (size_t i = 0; i < count; ++i)
+        {
+            reinterpret_cast<uint16_t*>(data)[i] = RoundToBfloat16(double(values[i]));
+        }
+        break;
+    default:
+        for (size_t i = 0; i < count; ++i)
+        {
+            WriteFromInt64(dataType, values[i], reinterpret_cast<uint8_t*>(data) + i * GetSizeOfTypeInBytes(dataType));
+        }
+        break;
+    }
+}
+
+// Just copy a single element from the input to output.
+void CastElementType(ElementType dataType, void const* inputData, /*out*/ void* outputData)
+{
+    switch (dataType)
+    {
+    case ElementType::Float32:       *reinterpret_cast<uint32_t*>(outputData)   = *reinterpret_cast<const uint32_t*>(inputData);    break;
+    case ElementType::Uint8:         *reinterpret_cast<uint8_t*>(outputData)    = *reinterpret_cast<const uint8_t*>(inputData);     break;
+    case ElementType::Int8:          *reinterpret_cast<uint8_t*>(outputData)    = *reinterpret_cast<const uint8_t*>(inputData);     break;
+    case ElementType::Uint16:        *reinterpret_cast<uint16_t*>(outputData)   = *reinterpret_cast<const uint16_t*>(inputData);    break;
+    case ElementType::Int16:         *reinterpret_cast<uint16_t*>(outputData)   = *reinterpret_cast<const uint16_t*>(inputData);    break;
+    case ElementType::Int32:         *reinterpret_cast<uint32_t*>(outputData)   = *reinterpret_cast<const uint32_t*>(inputData);    break;
+    case ElementType::Int64:         *reinterpret_cast<uint64_t*>(outputData)   = *reinterpret_cast<const uint64_t*>(inputData);    break;
+    case ElementType::StringChar8:   /* no change value for strings */                                                              break;
+    case ElementType::Bool8:         *reinterpret_cast<uint8_t*>(outputData)    = *reinterpret_cast<const uint8_t*>(inputData);     break;
+    case ElementType::Float16:       *reinterpret_cast<uint16_t*>(outputData)   = *reinterpret_cast<const uint16_t*>(inputData);    break;
+    case ElementType::Bfloat16:      *reinterpret_cast<uint16_t*>(outputData)   = *reinterpret_cast<const uint16_t*>(inputData);    break;
+    case ElementType::Float64:       *reinterpret_cast<uint64_t*>(outputData)   = *reinterpret_cast<const uint64_t*>(inputData);    break;
+    case ElementType::Uint32:        *reinterpret_cast<uint32_t*>(outputData)   = *reinterpret_cast<const uint32_t*>(inputData);    break;
+    case ElementType::Uint64:        *reinterpret_cast<uint64_t*>(outputData)   = *reinterpret_cast<const uint64_t*>(inputData);    break;
+    case ElementType::Complex64:     throw std::invalid_argument("Complex64 type is not supported.");
+    case ElementType::Complex128:    throw std::invalid_argument("Complex128 type is not supported.");
+    case ElementType::Fixed24f12i12: *reinterpret_cast<Fixed24f12i12*>(outputData) = *reinterpret_cast<const Fixed24f12i12*>(inputData);  break;
+    case ElementType::Fixed32f16i16: *reinterpret_cast<uint32_t*>(outputData)   = *reinterpret_cast<const uint32_t*>(inputData);    break;
+    case ElementType::Fixed32f24i8:  *reinterpret_cast<uint32_t*>(outputData)   = *reinterpret_cast<const uint32_t*>(inputData);    break;
+    case ElementType::Float8m3e4s1:  *reinterpret_cast<uint8_t*>(outputData)    = *reinterpret_cast<const uint8_t*>(inputData);     break;
+    case ElementType::Float8m2e5s1:  *reinterpret_cast<uint8_t*>(outputData)    = *reinterpret_cast<const uint8_t*>(inputData);     break;
+    default:                         assert(false);                                                                                 break;
+    }
+}
+
+// Cast copy a single element from the input type to output type.
+void CastElementType(
+    ElementType inputDataType,
+    ElementType outputDataType,
+    void const* inputData,
+    /*out*/ void* outputData
+)
+{
+    if (inputDataType == outputDataType)
+    {
+        CastElementType(inputDataType, inputData, outputData);
+    }
+    else if (IsFractionalElementType(inputDataType))
+    {
+        double value = ReadToDouble(inputDataType, inputData);
+        if (IsFractionalElementType(outputDataType))
+        {
+            WriteFromDouble(outputDataType, value, outputData);
+        }
+        else
+        {
+            WriteFromInt64(outputDataType, static_cast<int64_t>(value), outputData);
+        }
+    }
+    else // !IsFractionalElementType(inputDataType)
+    {
+        int64_t value = ReadToInt64(inputDataType, inputData);
+        if (IsFractionalElementType(outputDataType))
+        {
+            WriteFromDouble(outputDataType, static_cast<double>(value), outputData);
+        }
+        else
+        {
+            WriteFromInt64(outputDataType, value, outputData);
+        }
+    }
+}
+
+// Cast copy a contiguous array of elements from the input type to output type, with the same
+// results as CastElementType. Common conversions which reduce to bit operations avoid the
+// per-element dispatch through double.
+void CastElementTypes(
+    ElementType inputDataType,
+    ElementType outputDataType,
+    void const* inputData,
+    /*out*/ void* outputData,
+    size_t elementCount
+)
+{
+    if (inputDataType == outputDataType)
+    {
+        memcpy(outputData, inputData, elementCount * GetSizeOfTypeInBytes(inputDataType));
+    }
+    else if (inputDataType == ElementType::Float32 && outputDataType == ElementType::Bfloat16)
+    {
+        // bfloat16 keeps the top 16 bits of float32, rounded to nearest even like bfloat16_t.
+        const uint32_t* input = reinterpret_cast<const uint32_t*>(inputData);
+        uint16_t* output = reinterpret_cast<uint16_t*>(outputData);
+        for (size_t i = 0; i < elementCount; ++i)
+        {
+            output[i] = FloatNumberDefinitions::ConvertRawFloatType<FloatNumberDefinitions::Float32, FloatNumberDefinitions::Float16f7e8s1>(input[i]);
+        }
+    }
+    else if (inputDataType == ElementType::Bfloat16 && outputDataType == ElementType::Float32)
+    {
+        const uint16_t* input = reinterpret_cast<const uint16_t*>(inputData);
+        uint32_t* output = reinterpret_cast<uint32_t*>(outputData);
+        for (size_t i = 0; i < elementCount; ++i)
+        {
+            output[i] = uint32_t(input[i]) << 16;
+        }
+    }
+    else if (inputDataType == ElementType::Float32 && outputDataType == ElementType::Float16)
+    {
+        const float* input = reinterpret_cast<const float*>(inputData);
+        uint16_t* output = reinterpret_cast<uint16_t*>(outputData);
+        for (size_t i = 0; i < elementCount; ++i)
+        {
+            output[i] = half_float::detail::float2half<std::round_to_nearest, float>(input[i]);
+        }
+    }
+    else if (inputDataType == ElementType::Float16 && outputDataType == ElementType::Float32)
+    {
+        const uint16_t* input = reinterpret_cast<const uint16_t*>(inputData);
+        float* output = reinterpret_cast<float*>(outputData);
+        for (size_t i = 0; i < elementCount; ++i)
+        {
+            output[i] = half_float::detail::half2float<float>(input[i]);
+        }
+    }
+    else if (inputDataType == ElementType::Float32 && outputDataType == ElementType::Float64)
+    {
+        const float* input = reinterpret_cast<const float*>(inputData);
+        double* output = reinterpret_cast<double*>(outputData);
+        for (size_t i = 0; i < elementCount; ++i)
+        {
+            output[i] = input[i];
+        }
+    }
+    else if (inputDataType == ElementType::Float16 && outputDataType == ElementType::Float64)
+    {
+        const uint16_t* input = reinterpret_cast<const uint16_t*>(inputData);
+        double* output = reinterpret_cast<double*>(outputData);
+        for (size_t i = 0; i < elementCount; ++i)
+        {
+            output[i] = half_float::detail::half2float<double>(input[i]);
+        }
+    }
+    else
+    {
+        // Convert a block at a time through double (or int64 between integer types) just like
+        // CastElementType, but switching on the types once per block rather than per element.
+        constexpr size_t blockElementCount = 256;
+        double values[blockElementCount];
+        int64_t integerValues[blockElementCount];
+        const uint8_t* input = reinterpret_cast<const uint8_t*>(inputData);
+        uint8_t* output = reinterpret_cast<uint8_t*>(outputData);
+        const size_t inputByteSize = GetSizeOfTypeInBytes(inputDataType);
+        const size_t outputByteSize = GetSizeOfTypeInBytes(outputDataType);
+        const bool isFractionalInput = IsFractionalElementType(inputDataType);
+        const bool isFractionalOutput = IsFractionalElementType(outputDataType);
+        for (size_t i = 0; i < elementCount; i += blockElementCount)
+        {
+            const size_t count = std::min(blockElementCount, elementCount - i);
+            const uint8_t* blockInput = input + i * inputByteSize;
+            uint8_t* blockOutput = output + i * outputByteSize;
+            if (isFractionalInput)
+            {
+                ReadToDoubles(inputDataType, blockInput, /*out*/ values, count);
+                if (!isFractionalOutput)
+                {
+                    std::transform(values, values + count, integerValues, [](double value) { return static_cast<int64_t>(value); });
+                }
+            }
+            else
+            {
+                ReadToInt64s(inputDataType, blockInput, /*out*/ integerValues, count);
+                if (isFractionalOutput)
+                {
+                    std::transform(integerValues, integerValues + count, values, [](int64_t value) { return static_cast<double>(value); });
+                }
+            }
+
+            if (isFractionalOutput)
+            {
+                WriteFromDoubles(outputDataType, values, /*out*/ blockOutput, count);
+            }
+            else
+            {
+                WriteFromInt64s(outputDataType, integerValues, /*out*/ blockOutput, count);
+            }
+        }
+    }
+}
+
+// Range and precision of a narrower type that elements are rounded to, for classifying and scaling
+// conversion errors, and for quantizing.
+struct ConversionTarget
+{
+    ElementType elementType;
+    double minimum;             // Least finite value
+    double maximum;             // Greatest finite value
+    double fixedUlp;            // Of integers and fixed point, the value of the lowest bit
+    int32_t fractionBitCount;
+    int32_t minimumExponent;    // Of normal floats, below which subnormals share one ulp
+    bool isFloat;
+    RoundingError::Target rounding;
+
+    explicit ConversionTarget(ElementType targetElementType)
+    {
+        const NumberSubstructure& substructure = GetElementTypeSubstructure(targetElementType);
+        const int32_t exponentBitCount = int32_t(substructure.exponent.end - substructure.exponent.begin);
+        elementType = targetElementType;
+        fractionBitCount = int32_t(substructure.fraction.end - substructure.fraction.begin);
+        isFloat = (exponentBitCount > 0);
+        minimumExponent = isFloat ? 2 - (1 << (exponentBitCount - 1)) : 0; // 1 - bias
+
+        // Narrow types are small enough to find the range of by decoding every finite bit pattern,
+        // while wider ones are integers or fixed point, with the usual two's complement range.
+        const uint32_t bitCount = GetSizeOfTypeInBits(targetElementType);
+        NumberUnion number = {};
+        if (bitCount <= 16)
+        {
+            minimum = std::numeric_limits<double>::infinity();
+            maximum = -std::numeric_limits<double>::infinity();
+            for (uint32_t bits = 0; bits < (1u << bitCount); ++bits)
+            {
+                number.ui32 = bits;
+                const double value = ReadToDouble(targetElementType, number.buffer);
+                if (std::isfinite(value))
+                {
+                    minimum = std::min(minimum, value);
+                    maximum = std::max(maximum, value);
+                }
+            }
+        }
+        else
+        {
+            const uint64_t allBits = ~uint64_t(0) >> (64 - bitCount);
+            const bool isSigned = IsSignedElementType(targetElementType);
+            number.ui64 = isSigned ? (allBits >> 1) + 1 : 0;
+            minimum = ReadToDouble(targetElementType, number.buffer);
+            number.ui64 = isSigned ? allBits >> 1 : allBits;
+            maximum = ReadToDouble(targetElementType, number.buffer);
+        }
+        number.ui64 = 1;
+        fixedUlp = ReadToDouble(targetElementType, number.buffer);
+
+        rounding.minimum = minimum;
+        rounding.maximum = maximum;
+        rounding.exponentMask = isFloat ? 0x7FF0000000000000 : 0;
+        rounding.minimumPowerOfTwo = isFloat ? std::ldexp(1.0, minimumExponent) : fixedUlp;
+        rounding.ulpScale = isFloat ? std::ldexp(1.0, -fractionBitCount) : 1.0;
+    }
+};
+
+// Cast from input type to output type, returning direct reference to the output data.
+template <typename T>
+T& CastNumberType(NumberUnionAndType const& input, _Inout_ NumberUnionAndType& output)
+{
+    CastElementType(input.elementType, output.elementType, input.numberUnion.buffer, output.numberUnion.buffer);
+    return CastReferenceAs<T>(output.numberUnion.buffer);
+}
+
+// Cast from input type to output type, returning value.
+template <typename T>
+T CastNumberType(NumberUnionAndType const& input, ElementType outputElementType)
+{
+    NumberUnion output;
+    CastElementType(input.elementType, outputElementType, input.numberUnion.buffer, output.buffer);
+    return CastReferenceAs<T>(output.buffer);
+}
+
+// Cast from input type to output type, returning value.
+NumberUnionAndType CastNumberType(NumberUnionAndType const& input, ElementType outputElementType)
+{
+    NumberUnionAndType output;
+    output.elementType = outputElementType;
+    output.printingFlags = input.printingFlags;
+    CastElementType(input.elementType, outputElementType, input.numberUnion.buffer, output.numberUnion.buffer);
+    return output;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::string_view GetNumericOperationNameFromNumericOperationType(NumericOperationType numericOperationType) noexcept
+{
+    size_t index = static_cast<size_t>(numericOperationType);
+    return g_numericOperationTypeNames[index < std::size(g_numericOperationTypeNames) ? index : 0];
+}
+
+void AppendFormattedRawInteger(
+    /*inout*/ std::string& stringValue,
+    uint32_t radix, // 2 or 16
+    Range bitRange,
+    uint64_t value
+)
+{
+    const uint32_t bitOffset = uint32_t(bitRange.begin);
+    const uint32_t bitCount = uint32_t(bitRange.end - bitOffset);
+    const uint64_t valueMask = (bitCount >= 64) ? ~uint64_t(0) : (uint64_t(1) << bitCount) - 1;
+    value >>= bitOffset;
+    value &= valueMask;
+
+    switch (radix)
+    {
+    case 2: // binary
+        {
+            stringValue.append("0b"sv);
+            uint32_t index = bitCount;
+            while (index > 0)
+            {
+                --index;
+                bool isBitSet = value & (uint64_t(1) << index);
+                stringValue.push_back('0' + isBitSet);
+            }
+        }
+        break;
+
+    case 10: // decimal
+        {
+            uint64_t maxValue = (uint64_t(1) << bitCount) - 1;
+            uint32_t digitCount = static_cast<uint32_t>(floor(log10(maxValue) + 1));
+            AppendFormatted(/*inout*/ stringValue, "%.*lld", digitCount, value);
+        }
+        break;
+
+    case 16: // hexadecimal
+        {
+            uint32_t digitCount = (bitCount + 3) / 4u;
+            AppendFormatted(/*inout*/ stringValue, "0x%.*llX", digitCount, value);
+        }
+        break;
+
+    default: // arbitrary radix. Using 'itoa' is dubious with unbounded buffer sizes.
+        {
+            uint64_t maxValue = (uint64_t(1) << bitCount) - 1;
+            uint32_t digitCount = static_cast<uint32_t>(floor((log(maxValue) / log(radix)) + 1));
+
+            if (radix == 8)
+            {
+                stringValue.append("0o"sv);
+            }
+
+            size_t oldSize = stringValue.size();
+            size_t newSize = oldSize + digitCount;
+            size_t index = newSize;
+            stringValue.resize(newSize);
+
+            while (index > oldSize)
+            {
+                --index;
+                uint32_t remainder = static_cast<uint32_t>(value % radix); // Note std::div doesn't support uint64_t.
+                value /= radix;
+                char32_t wc = remainder <= 10 ? ('0' + remainder) : ('A' + remainder - 10);
+                stringValue[index] = static_cast<char>(wc);
+            }
+        }
+        break;
+
+    }
+}
+
+void AppendFormattedRawInteger(
+    /*inout*/ std::string& stringValue, 
+    std::string_view name,
+    uint32_t radix, // 2 or 16
+    Range bitRange,
+    uint64_t value
+)
+{
+    // Print nothing if there are no bits (such as an exponent field for an integer).
+    if (bitRange.begin == bitRange.end)
+    {
+        return;
+    }
+
+    // Separate preceding text with a space.
+    if (!stringValue.empty())
+    {
+        char c = stringValue.back();
+        if (c != ' ' && c != '(' && c != '[' && c != '{')
+        {
+            stringValue.push_back(' ');
+        }
+    }
+    stringValue.append(name);
+    stringValue.push_back(':');
+    AppendFormattedRawInteger(/*inout*/ stringValue, radix, bitRange, value);
+}
+
+// Overload accepting value as number.
+void AppendFormattedNumericValue(
+    /*inout*/ std::string& output,
+    ElementType elementType,
+    double floatValue,
+    int64_t integerValue,
+    NumericPrintingFlags printingFlags
+)
+{
+    // Print the numeric component, per typical human-readable value.
+
+    if (IsFractionalElementType(elementType))
+    {
+        if (ComparedMaskedFlags(printingFlags, NumericPrintingFlags::ShowFloatMask, NumericPrintingFlags::ShowFloatHex))
+        {
+            AppendFormatted(/*inout*/ output, "%a", floatValue);
+        }
+        else // NumericPrintingFlags::ShowDecimalFloat
+        {
+            // Same as "%.24g", but without the printf overhead, which matters when dumping files.
+            AppendCharacters(/*inout*/ output, floatValue, std::chars_format::general, 24);
+        }
+    }
+    else if (IsSignedElementType(elementType))
+    {
+        AppendCharacters(/*inout*/ output, integerValue);
+    }
+    else // unsigned
+    {
+        AppendCharacters(/*inout*/ output, static_cast<uint64_t>(integerValue));
+    }
+}
+
+// Overload accepting value as raw bits.
+void AppendFormattedNumericValue(
+    /*inout*/ std::string& output,
+    ElementType elementType,
+    int64_t rawBitValue,
+    NumericPrintingFlags printingFlags
+)
+{
+    // Print the raw part of the value.
+
+    uint32_t rawDisplayRadix = 16;
+    if (ComparedMaskedFlags(printingFlags, NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawBinary))
+    {
+        rawDisplayRadix = 2;
+    }
+    else if (ComparedMaskedFlags(printingFlags, NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawHex))
+    {
+        rawDisplayRadix = 16;
+    }
+    else if (ComparedMaskedFlags(printingFlags, NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawDecimal))
+    {
+        rawDisplayRadix = 10;
+    }
+    else if (ComparedMaskedFlags(printingFlags, NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawOctal))
+    {
+        rawDisplayRadix = 8;
+    }
+
+    // Print raw data, as binary or hex.
+    if (ComparedMaskedFlags(printingFlags, NumericPrintingFlags::ShowRawFieldsMask, NumericPrintingFlags::ShowRawFields))
+    {
+        NumberSubstructure const& numberSubstructure = GetElementTypeSubstructure(elementType);
+        AppendFormattedRawInteger(/*inout*/ output, "int"sv, rawDisplayRadix, numberSubstructure.integer, rawBitValue);
+        AppendFormattedRawInteger(/*inout*/ output, "frac"sv, rawDisplayRadix, numberSubstructure.fraction, rawBitValue);
+        AppendFormattedRawInteger(/*inout*/ output, "exp"sv, rawDisplayRadix, numberSubstructure.exponent, rawBitValue);
+        AppendFormattedRawInteger(/*inout*/ output, "sign"sv, rawDisplayRadix, numberSubstructure.sign, rawBitValue);
+    }
+    else
+    {
+        const uint32_t sizeOfTypeInBits = GetSizeOfTypeInBits(elementType);
+        AppendFormattedRawInteger(/*inout*/ output, rawDisplayRadix, { 0, sizeOfTypeInBits }, rawBitValue);
+    }
+}
+
+// Overload accepting value as arbitrary data.
+void AppendFormattedNumericValue(
+    /*inout*/ std::string& stringValue,
+    ElementType elementType,
+    const void* binaryData,
+    std::string_view leftFlank,
+    std::string_view rightFlank,
+    NumericPrintingFlags valueFlags
+)
+{
+    const int64_t rawBitValue = ReadRawBitValue(elementType, binaryData);
+    const double floatValue = ReadToDouble(elementType, binaryData);
+
+    const char* elementTypeName = GetTypeNameFromElementType(elementType).data();
+    bool showNumericType = (valueFlags & NumericPrintingFlags::ShowNumericType) != 0;
+    bool showNumericValue = (valueFlags & NumericPrintingFlags::ShowNumericValue) != 0;
+    bool showBinaryValue = (valueFlags & NumericPrintingFlags::ShowBinaryValue) != 0;
+
+    // Print formatted string. e.g.
+    //
+    //      float32 15361 (0x46700400)
+
+    if (showNumericType)
+    {
+        AppendFormatted(/*inout*/ stringValue, "%10s ", elementTypeName);
+    }
+
+    // Print numeric component.
+    if (showNumericValue)
+    {
+        AppendFormattedNumericValue(/*inout*/ stringValue, elementType, floatValue, rawBitValue, valueFlags);
+    }
+
+    if (showBinaryValue)
+    {
+        if (showNumericValue)
+        {
+            stringValue.append(leftFlank);
+        }
+        AppendFormattedNumericValue(/*inout*/ stringValue, elementType, rawBitValue, valueFlags);
+        if (showNumericValue)
+        {
+            stringValue.append(rightFlank);
+        }
+    }
+}
+
+void SprintNumericType(
+    /*inout*/ std::string& output,
+    ElementType elementType,
+    const void* binaryData,
+    std::string_view leftFlank,
+    std::string_view rightFlank,
+    NumericPrintingFlags numericPrintingFlags = NumericPrintingFlags::Default,
+    ElementType originalElementType = ElementType::Undefined
+)
+{
+    output.append((elementType == originalElementType) ? " -> " : "    ");
+    AppendFormattedNumericValue(/*inout*/ output, elementType, binaryData, leftFlank, rightFlank, numericPrintingFlags);
+    output.append("\n");
+}
+
+void PrintBytes(/*inout*/ std::string& stringOutput, const void* binaryData, size_t binaryDataByteSize)
+{
+    stringOutput.append("         bytes ");
+
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(binaryData);
+    for (size_t i = 0; i < binaryDataByteSize; ++i)
+    {
+        AppendFormatted(/*inout*/ stringOutput, "%02X ", bytes[i]);
+    }
+
+    stringOutput.append("\n");
+}
+
+void SprintAllNumericTypesToBinary(
+    /*inout*/ std::string& stringOutput,
+    NumberUnion const& numberUnion,
+    NumericPrintingFlags numericPrintingFlags = NumericPrintingFlags::Default,
+    ElementType numberElementType = ElementType::Undefined
+)
+{
+    constexpr std::string_view leftFlank = "";
+    constexpr std::string_view rightFlank = "";
+
+    NumberUnionAndType input = {.numberUnion = numberUnion, .elementType = numberElementType};
+    NumberUnionAndType output = {.numberUnion = numberUnion, .elementType = numberElementType};
+    numericPrintingFlags = numericPrintingFlags & ~NumericPrintingFlags::ShowNumericValue;
+
+    output = CastNumberType(input, ElementType::Uint8 ); SprintNumericType(/*inout*/ stringOutput, ElementType::Uint8,  &output.numberUnion.ui8,  leftFlank, rightFlank, numericPrintingFlags, numberElementType);
+    output = CastNumberType(input, ElementType::Uint16); SprintNumericType(/*inout*/ stringOutput, ElementType::Uint16, &output.numberUnion.ui16, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
+    output = CastNumberType(input, ElementType::Uint32); SprintNumericType(/*inout*/ stringOutput, ElementType::Uint32, &output.numberUnion.ui32, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
+    output = CastNumberType(input, ElementType::Uint64); SprintNumericType(/*inout*/ stringOutput, ElementType::Uint64, &output.numberUnion.ui64, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
+
+    output = CastNumberType(input, ElementType::Int8 ); SprintNumericType(/*inout*/ stringOutput, ElementType::Int8,  &output.numberUnion.i8,  leftFlank, rightFlank, numericPrintingFlags, numberElementType);
+    output = CastNumberType(input, ElementType::Int16); SprintNumericType(/*inout*/ stringOutput, ElementType::Int16, &output.numberUnion.i16, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
+    output = CastNumberType(input, ElementType::Int32); SprintNumericType(/*inout*/ stringOutput, ElementType::Int32, &output.numberUnion.i32, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
+    output = CastNumberType(input, ElementType::Int64); SprintNumericType(/*inout*/ stringOutput, ElementType::Int64, &output.numberUnion.i64, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
+
+    output = CastNumberType(input, ElementType::Float16 ); SprintNumericType(/*inout*/ stringOutput, ElementType::Float16,  &output.numberUnion.f16, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
+    output = CastNumberType(input, ElementType::Bfloat16); SprintNumericType(/*inout*/ stringOutput, ElementType::Bfloat16, &output.numberUnion.f16m7e8s1, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
+    output = CastNumberType(input, ElementType::Float32 ); SprintNumericType(/*inout*/ stringOutput, ElementType::Float32,  &output.numberUnion.f32, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
+    output = CastNumberType(input, ElementType::Float64 ); SprintNumericType(/*inout*/ stringOutput, ElementType::Float64,  &output.numberUnion.f64, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
+
+    output = CastNumberType(input, ElementType::Fixed24f12i12); SprintNumericType(/*inout*/ stringOutput, ElementType::Fixed24f12i12, &output.numberUnion.x24f12i12, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
+    output = CastNumberType(input, ElementType::Fixed32f16i16); SprintNumericType(/*inout*/ stringOutput, ElementType::Fixed32f16i16, &output.numberUnion.x32f16i16, leftFlank, rightFlank, numericPrintingFlags, numberElementType);
+    output = CastNumberType(input, ElementType::Fixed32f24i8 ); SprintNumericType(/*inout*/ stringOutput, ElementType::Fixed32f24i8,  &output.numberUnion.x32f24i8,  leftFlank, rightFlank, numericPrintingFlags, numberElementType);
+}
+
+void SprintAllNumericTypesFromBinary(
+    /*inout*/ std::string& stringOutput,
+    int64_t value,
+    NumericPrintingFlags numericPrintingFlags = NumericPrintingFlags::Default,
+    ElementType originalElementType = ElementType::Undefined
+)
+{
+    constexpr std::string_view leftFlank = " <- ";
+    constexpr std::string_view rightFlank = "";
+
+    NumberUnion numberUnion = {};
+    numberUnion.i64 = value;
+
+    numericPrintingFlags = numericPrintingFlags & ~NumericPrintingFlags::ShowBinaryValue;
+
+    SprintNumericType(/*inout*/ stringOutput, ElementType::Uint8,  &numberUnion.ui8,  leftFlank, rightFlank, numericPrintingFlags, originalElementType);
+    SprintNumericType(/*inout*/ stringOutput, ElementType::Uint16, &numberUnion.ui16, leftFlank, rightFlank, numericPrintingFlags, originalElementType);
+    SprintNumericType(/*inout*/ stringOutput, ElementType::Uint32, &numberUnion.ui32, leftFlank, rightFlank, numericPrintingFlags, originalElementType);
+    SprintNumericType(/*inout*/ stringOutput, ElementType::Uint64, &numberUnion.ui64, leftFlank, rightFlank, numericPrintingFlags, originalElementType);
+
+    SprintNumericType(/*inout*/ stringOutput, ElementType::Int8,   &numberUnion.i8,  leftFlank, rightFlank, numericPrintingFlags, originalElementType);
+    SprintNumericType(/*inout*/ stringOutput, ElementType::Int16,  &numberUnion.i16, leftFlank, rightFlank, numericPrintingFlags, originalElementType);
+    SprintNumericType(/*inout*/ stringOutput, ElementType::Int32,  &numberUnion.i32, leftFlank, rightFlank, numericPrintingFlags, originalElementType);
+    SprintNumericType(/*inout*/ stringOutput, ElementType::Int64,  &numberUnion.i64, leftFlank, rightFlank, numericPrintingFlags, originalElementType);
+
+    SprintNumericType(/*inout*/ stringOutput, ElementType::Float16,  &numberUnion.f16, leftFlank, rightFlank, numericPrintingFlags, originalElementType);
+    SprintNumericType(/*inout*/ stringOutput, ElementType::Bfloat16, &numberUnion.f16m7e8s1,      leftFlank, rightFlank, numericPrintingFlags, originalElementType);
+    SprintNumericType(/*inout*/ stringOutput, ElementType::Float32,  &numberUnion.f32, leftFlank, rightFlank, numericPrintingFlags, originalElementType);
+    SprintNumericType(/*inout*/ stringOutput, ElementType::Float64,  &numberUnion.f64, leftFlank, rightFlank, numericPrintingFlags, originalElementType);
+
+    SprintNumericType(/*inout*/ stringOutput, ElementType::Fixed24f12i12, &numberUnion.x24f12i12, leftFlank, rightFlank, numericPrintingFlags, originalElementType);
+    SprintNumericType(/*inout*/ stringOutput, ElementType::Fixed32f16i16, &numberUnion.x32f16i16, leftFlank, rightFlank, numericPrintingFlags, originalElementType);
+    SprintNumericType(/*inout*/ stringOutput, ElementType::Fixed32f24i8,  &numberUnion.x32f24i8,  leftFlank, rightFlank, numericPrintingFlags, originalElementType);
+}
+
+void SprintAllPrintingFormats(
+    /*inout*/ std::string& stringOutput,
+    double valueFloat,
+    int64_t valueInteger,
+    ElementType elementType = ElementType::Undefined
+)
+{
+    // Print the number in various representations.
+
+    const char* elementTypeName = GetTypeNameFromElementType(elementType).data();
+
+    stringOutput.append("          type ");
+    stringOutput.append(elementTypeName);
+    stringOutput.append("\n");
+
+    stringOutput.append("       decimal ");
+    AppendFormattedNumericValue(/*inout*/ stringOutput, elementType, valueFloat, valueInteger, NumericPrintingFlags::Default);
+    stringOutput.append("\n");
+
+    stringOutput.append("      floathex ");
+    AppendFormattedNumericValue(/*inout*/ stringOutput, elementType, valueFloat, valueInteger, NumericPrintingFlags::ShowFloatHex);
+    stringOutput.append("\n");
+
+    stringOutput.append("       raw hex ");
+    AppendFormattedNumericValue(/*inout*/ stringOutput, elementType, valueInteger, NumericPrintingFlags::ShowRawHex);
+    stringOutput.append("\n");
+
+    stringOutput.append("       raw oct ");
+    AppendFormattedNumericValue(/*inout*/ stringOutput, elementType, valueInteger, NumericPrintingFlags::ShowRawOctal);
+    stringOutput.append("\n");
+
+    stringOutput.append("       raw bin ");
+    AppendFormattedNumericValue(/*inout*/ stringOutput, elementType, valueInteger, NumericPrintingFlags::ShowRawBinary);
+    stringOutput.append("\n");
+
+    stringOutput.append("    fields bin ");
+    AppendFormattedNumericValue(/*inout*/ stringOutput, elementType, valueInteger, NumericPrintingFlags::ShowRawBinaryFields);
+    stringOutput.append("\n");
+}
+
+// Parse a decimal string directly to the element type, rounding once (to nearest even) rather than
+// parsing to float64 and then narrowing, which rounds twice. Returns false if the string is not
+// decimal (e.g. hexadecimal "0x1.8p1") or the type is not supported, so the caller can use strtod.
+bool ParseDecimalToElementType(std::string_view valueString, ElementType elementType, /*out*/ void* data)
+{
+    using namespace DecimalParser;
+    using namespace FloatNumberDefinitions;
+
+    DecimalNumber decimalNumber;
+    if (ParseDecimalNumber(valueString, /*out*/ decimalNumber) == 0)
+    {
+        return false;
+    }
+
+    switch (elementType)
+    {
+    case ElementType::Float32:       *reinterpret_cast<uint32_t*>(data) = RoundToFloat<Float32>(decimalNumber);         break;
+    case ElementType::Float16:       *reinterpret_cast<uint16_t*>(data) = RoundToFloat<Float16f10e5s1>(decimalNumber);  break;
+    case ElementType::Bfloat16:      *reinterpret_cast<uint16_t*>(data) = RoundToFloat<Float16f7e8s1>(decimalNumber);   break;
+    case ElementType::Float8m3e4s1:  *reinterpret_cast<uint8_t*>(data)  = RoundToFloat<Float8f3e4s1>(decimalNumber);    break;
+    case ElementType::Float8m2e5s1:  *reinterpret_cast<uint8_t*>(data)  = RoundToFloat<Float8f2e5s1>(decimalNumber);    break;
+    case ElementType::Fixed24f12i12: reinterpret_cast<Fixed24f12i12*>(data)->SetRawBits(int32_t(RoundToFixed<24, 12>(decimalNumber))); break;
+    case ElementType::Fixed32f16i16: reinterpret_cast<Fixed32f16i16*>(data)->SetRawBits(int32_t(RoundToFixed<32, 16>(decimalNumber))); break;
+    case ElementType::Fixed32f24i8:  reinterpret_cast<Fixed32f24i8*>(data)->SetRawBits(int32_t(RoundToFixed<32, 24>(decimalNumber)));  break;
+    default:                         return false;
+    }
+
+    return true;
+}
+
+void ParseNumber(
+    std::string_view valueStringView,
+    ElementType preferredElementType,
+    bool parseAsRawData,
+    _Out_ NumberUnionAndType& number
+)
+{
+    number = {};
+    number.elementType = preferredElementType;
+
+    // Try to read the number as the preferred element type, or if undefined,
+    // try to read the numbers as float64 and int64.
+
+    const bool isUndefinedType = (preferredElementType == ElementType::Undefined);
+    const bool isFractionalType = IsFractionalElementType(preferredElementType);
+
+    // Decimal strings for fractional types are rounded directly to the target precision.
+    if (isFractionalType && !parseAsRawData && ParseDecimalToElementType(valueStringView, preferredElementType, /*out*/ &number.numberUnion))
+    {
+        return;
+    }
+
+    // The C parsing functions need null termination, which a token viewed within the larger
+    // command string lacks (especially one memory mapped from a file), so copy it locally.
+    char valueStringBuffer[128];
+    std::string valueStringLong;
+    _Null_terminated_ const char* valueString = valueStringBuffer;
+    if (valueStringView.size() < std::size(valueStringBuffer))
+    {
+        std::copy(valueStringView.begin(), valueStringView.end(), valueStringBuffer);
+        valueStringBuffer[valueStringView.size()] = '\0';
+    }
+    else
+    {
+        valueStringLong.assign(valueStringView);
+        valueString = valueStringLong.c_str();
+    }
+
+    char* valueStringEnd = nullptr;
+    const double valueFloat = strtod(valueString, &valueStringEnd);
+    const bool wasFloatValueParsed = (valueStringEnd > valueString);
+    const bool wasDecimalPresent = wasFloatValueParsed && (std::find(valueString, const_cast<char const*>(valueStringEnd), '.') != valueStringEnd);
+    const bool isValueFloatZero = (valueFloat == 0);
+
+    // Read as signed or unsigned value.
+    int64_t valueInt = 0;
+    if (preferredElementType == ElementType::Undefined
+    ||  (IsSignedElementType(preferredElementType) && !parseAsRawData)
+    ||  valueString[0] == '-')
+    {
+        valueInt = strtoll(valueString, &valueStringEnd, 0);
+    }
+    else
+    {
+        valueInt = strtoull(valueString, &valueStringEnd, 0);
+    }
+
+    // Parse binary or octal numbers, e.g. 0b1101, 0o123. 'strtol' doesn't recognize these.
+    if (valueInt == 0 && valueString[0] == '0')
+    {
+        uint32_t radix = 0;
+        if (valueString[1] == 'b') radix = 2;
+        if (valueString[1] == 'o') radix = 8;
+
+        if (radix != 0)
+        {
+            valueInt = strtoull(valueString + 2, &valueStringEnd, radix);
+        }
+    }
+
+    // If the type wasn't given, deduce from whether the number had a fraction.
+    if (isUndefinedType)
+    {
+        // Treat as floating point if a decimal was present.
+        if (wasDecimalPresent)
+        {
+            if (parseAsRawData)
+            {
+                number.numberUnion.i64 = valueInt;
+            }
+            else
+            {
+                number.numberUnion.f64 = valueFloat;
+            }
+            number.elementType = ElementType::Float64;
+        }
+        else if (valueInt <= INT32_MAX && valueInt >= -INT32_MAX)
+        {
+            number.numberUnion.i32 = static_cast<int32_t>(valueInt);
+            number.elementType = ElementType::Int32;
+        }
+        else if (valueInt <= UINT32_MAX)
+        {
+            number.numberUnion.ui32 = static_cast<uint32_t>(valueInt);
+            number.elementType = ElementType::Uint32;
+        }
+        else // Treat as 64-bit integer.
+        {
+            number.numberUnion.i64 = valueInt;
+            number.elementType = ElementType::Int64;
+        }
+    }
+    else if (isFractionalType)
+    {
+        if (parseAsRawData)
+        {
+            number.numberUnion.i64 = valueInt;
+        }
+        else if (isValueFloatZero)
+        {
+            WriteFromInt64(preferredElementType, valueInt, /*out*/ &number.numberUnion);
+        }
+        else
+        {
+            WriteFromDouble(preferredElementType, valueFloat, /*out*/ &number.numberUnion);
+        }
+    }
+    else // integer
+    {
+        WriteFromInt64(preferredElementType, valueInt, /*out*/ &number.numberUnion);
+    }
+}
+
+// Parses a long list of numbers delimited by spaces, line breaks, or commas (like a text file of
+// numbers) into one typed buffer, viewed like a binary file. The text is split into chunks ending at
+// delimiters, which are counted and then parsed in parallel straight to their final offsets, using the
+// same rules as ParseNumber. Without a preferred type, the list takes the widest type deduced.
+NumberFileView ParseNumberList(
+    std::string_view text,
+    ElementType preferredElementType,
+    bool parseAsRawData,
+    NumericPrintingFlags numericPrintingFlags
+)
+{
+    auto isDelimiter = [](char ch)->bool
+    {
+        return Tokenizer::IsSpace(ch) || ch == ',';
+    };
+
+    // Split at delimiters so that no number straddles two chunks. Use several chunks per thread
+    // so that threads finishing early can take more, but keep chunks large enough to be worthwhile.
+    constexpr size_t minimumChunkSize = 1 << 20;
+    const size_t chunkSize = std::max(minimumChunkSize, text.size() / (size_t(GetParallelThreadCount()) * 4) + 1);
+    std::vector<std::string_view> chunks;
+    for (size_t chunkBegin = 0; chunkBegin < text.size(); /*below*/)
+    {
+        size_t chunkEnd = std::min(chunkBegin + chunkSize, text.size());
+        for (/*above*/; chunkEnd < text.size() && !isDelimiter(text[chunkEnd]); ++chunkEnd)
+        { }
+        chunks.push_back(text.substr(chunkBegin, chunkEnd - chunkBegin));
+        chunkBegin = chunkEnd;
+    }
+
+    auto forEachNumberString = [&](std::string_view chunk, auto&& onNumberString)
+    {
+        const size_t chunkSize = chunk.size();
+        for (size_t i = 0; /*below*/; /*below*/)
+        {
+            for (/*above*/; i < chunkSize && isDelimiter(chunk[i]); ++i)
+            { }
+            if (i >= chunkSize)
+            {
+                break;
+            }
+
+            size_t j = i + 1;
+            for (/*above*/; j < chunkSize && !isDelimiter(chunk[j]); ++j)
+            { }
+
+            onNumberString(chunk.substr(i, j - i));
+            i = j;
+        }
+    };
+
+    // Count the numbers of each chunk, and without a type, deduce each number's type too.
+    const bool isUndefinedType = (preferredElementType == ElementType::Undefined);
+    std::vector<uint64_t> chunkOffsets(chunks.size() + 1);
+    std::vector<uint32_t> chunkTypeMasks(chunks.size());
+    ParallelFor(chunks.size(), [&](size_t chunkIndex)
+    {
+        uint64_t count = 0;
+        uint32_t typeMask = 0;
+        NumberUnionAndType number;
+        forEachNumberString(chunks[chunkIndex], [&](std::string_view numberString)
+        {
+            ++count;
+            if (isUndefinedType)
+            {
+                ParseNumber(numberString, ElementType::Undefined, parseAsRawData, /*out*/ number);
+                typeMask |= 1u << uint32_t(number.elementType);
+            }
+        });
+        chunkOffsets[chunkIndex + 1] = count;
+        chunkTypeMasks[chunkIndex] = typeMask;
+    });
+
+    // Deduced types are float64 if any had a fraction, else any single integer type, but mixed
+    // integer types widen to int64 (rather than by promotion priority, which could truncate).
+    ElementType elementType = preferredElementType;
+    if (isUndefinedType)
+    {
+        uint32_t typeMask = 0;
+        for (uint32_t chunkTypeMask : chunkTypeMasks)
+        {
+            typeMask |= chunkTypeMask;
+        }
+        elementType = (typeMask & (1u << uint32_t(ElementType::Float64))) ? ElementType::Float64
+                    : (std::popcount(typeMask) == 1) ? ElementType(std::countr_zero(typeMask))
+                    : (typeMask != 0) ? ElementType::Int64
+                    : ElementType::Undefined;
+    }
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+        chunkOffsets[i + 1] += chunkOffsets[i];
+    }
+
+    // Parse each chunk straight into its elements of the shared buffer.
+    const uint64_t elementCount = chunkOffsets.back();
+    const uint32_t elementByteSize = GetSizeOfTypeInBytes(elementType);
+    auto buffer = std::make_shared<std::vector<uint64_t>>(size_t((elementCount * elementByteSize + sizeof(uint64_t) - 1) / sizeof(uint64_t)));
+    uint8_t* elements = reinterpret_cast<uint8_t*>(buffer->data());
+    ParallelFor(chunks.size(), [&](size_t chunkIndex)
+    {
+        uint8_t* element = elements + chunkOffsets[chunkIndex] * elementByteSize;
+        NumberUnionAndType number;
+        forEachNumberString(chunks[chunkIndex], [&](std::string_view numberString)
+        {
+            ParseNumber(numberString, elementType, parseAsRawData, /*out*/ number);
+            memcpy(element, number.numberUnion.buffer, elementByteSize);
+            element += elementByteSize;
+        });
+    });
+
+    NumberFileView fileView = {};
+    fileView.data = elements;
+    fileView.storage = std::move(buffer);
+    fileView.elementCount = elementCount;
+    fileView.elementType = elementType;
+    fileView.elementStride = 1;
+    fileView.rowElementCount = UINT64_MAX;
+    fileView.rowStride = UINT64_MAX;
+    fileView.printingFlags = numericPrintingFlags;
+    return fileView;
+}
+
+// Reads a run of file view elements as a contiguous array of its element type (or float32 for block
+// quantized views), returning a pointer to them. Contiguous little-endian elements are returned in place,
+// while others are gathered from their strides (like one channel of interleaved pixels), byte swapped,
+// unpacked, or dequantized into the buffer, which must hold count 64-bit elements.
+const uint8_t* ReadNumberFileViewElements(const NumberFileView& fileView, uint64_t elementIndex, size_t count, /*out*/ uint8_t* buffer)
+{
+    if (fileView.blockQuantizedType != 0)
+    {
+        // Dequantize whole blocks straight to the output, and only partial ones via a temporary block.
+        const Gguf::TypeInfo typeInfo = Gguf::GetTypeInfo(fileView.blockQuantizedType);
+        float block[Gguf::maximumBlockElementCount];
+        float* output = reinterpret_cast<float*>(buffer);
+        size_t elementInBlock = size_t(elementIndex % typeInfo.blockElementCount);
+        const uint8_t* blockData = fileView.data + elementIndex / typeInfo.blockElementCount * typeInfo.blockByteSize;
+        for (size_t i = 0; i < count; blockData += typeInfo.blockByteSize, elementInBlock = 0)
+        {
+            const size_t blockCount = std::min(typeInfo.blockElementCount - elementInBlock, count - i);
+            if (blockCount == typeInfo.blockElementCount)
+            {
+                Gguf::DequantizeBlocks(fileView.blockQuantizedType, blockData, 1, /*out*/ output + i);
+            }
+            else
+            {
+                Gguf::DequantizeBlocks(fileView.blockQuantizedType, blockData, 1, /*out*/ block);
+                memcpy(output + i, block + elementInBlock, blockCount * sizeof(float));
+            }
+            i += blockCount;
+        }
+        return buffer;
+    }
+
+    const uint32_t elementByteSize = fileView.isInt24 ? 3 : GetSizeOfTypeInBytes(fileView.elementType);
+    const bool isContiguous = fileView.elementStride == 1 && fileView.rowStride == fileView.rowElementCount;
+    const uint8_t* elementData = fileView.data + elementIndex * elementByteSize;
+
+    // 24-bit elements are gathered into the upper half, to unpack into the lower half without overlap.
+    uint8_t* gatherBuffer = fileView.isInt24 ? buffer + count * sizeof(uint32_t) : buffer;
+    if (!isContiguous && count > 0)
+    {
+        uint64_t row = elementIndex / fileView.rowElementCount;
+        uint64_t column = elementIndex % fileView.rowElementCount;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint64_t sourceIndex = row * fileView.rowStride + column * fileView.elementStride;
+            memcpy(gatherBuffer + i * elementByteSize, fileView.data + sourceIndex * elementByteSize, elementByteSize);
+            if (++column >= fileView.rowElementCount)
+            {
+                column = 0;
+                ++row;
+            }
+        }
+        elementData = gatherBuffer;
+    }
+    if (fileView.isBigEndian)
+    {
+        SwapByteOrder(elementData, /*out*/ gatherBuffer, count, elementByteSize);
+        elementData = gatherBuffer;
+    }
+    if (fileView.isInt24)
+    {
+        UnpackInt24ToInt32(elementData, /*out*/ reinterpret_cast<int32_t*>(buffer), count);
+        elementData = buffer;
+    }
+    return elementData;
+}
+
+void DecodeNumberFileView(const NumberFileView& fileView, uint64_t elementIndex, _Out_ Span<NumberUnionAndType> numbers)
+{
+    assert(fileView.text.empty()); // Text is only read sequentially, by ParseNumberTextView.
+    const ElementType elementType = (fileView.blockQuantizedType != 0) ? ElementType::Float32 : fileView.elementType;
+    const uint32_t elementByteSize = GetSizeOfTypeInBytes(elementType);
+    constexpr size_t batchSize = 256;
+    alignas(uint64_t) uint8_t buffer[batchSize * sizeof(uint64_t)];
+
+    for (size_t i = 0; i < numbers.size(); /*below*/)
+    {
+        const size_t count = std::min(batchSize, numbers.size() - i);
+        const uint8_t* elementData = ReadNumberFileViewElements(fileView, elementIndex + i, count, /*out*/ buffer);
+        for (size_t j = 0; j < count; ++j, ++i)
+        {
+            NumberUnionAndType& number = numbers[i];
+            number.numberUnion = {};
+            memcpy(number.numberUnion.buffer, elementData, elementByteSize); // File data is little-endian.
+            number.elementType = elementType;
+            number.printingFlags = fileView.printingFlags;
+            elementData += elementByteSize;
+        }
+    }
+}
+
+// Parses the next numbers of a text view, continuing from the given offset into its text.
+void ParseNumberTextView(const NumberFileView& fileView, /*inout*/ size_t& textOffset, _Out_ Span<NumberUnionAndType> numbers)
+{
+    std::string_view text = fileView.text.substr(textOffset);
+    char const* const textEnd = text.data() + text.size();
+    for (size_t i = 0; i < numbers.size(); /*below*/)
+    {
+        std::string_view token = Tokenizer::GetToken(text);
+        assert(!token.empty());
+        char const* tokenEnd = token.data() + token.size();
+        text = std::string_view{tokenEnd, size_t(textEnd - tokenEnd)};
+        if (token == ",")
+        {
+            continue;
+        }
+
+        ParseNumber(token, fileView.textElementType, fileView.parseAsRawData, /*out*/ numbers[i]);
+        numbers[i].printingFlags = fileView.printingFlags;
+        ++i;
+    }
+    textOffset = text.data() - fileView.text.data();
+}
+
+// Streams a sequence of operands in bounded chunks, in command line order, copying the literal
+// numbers within the range and decoding the elements of any file views positioned among them.
+class OperandCursor
+{
+public:
+    OperandCursor(Span<const NumberUnionAndType> numbers, Range numberRange, Span<const NumberFileView> fileViews)
+    :   numbers_(numbers),
+        numberRange_(numberRange),
+        fileViews_(fileViews),
+        numberIndex_(numberRange.begin)
+    {
+    }
+
+    bool IsAtEnd() const noexcept
+    {
+        return numberIndex_ >= numberRange_.end && fileViewIndex_ >= fileViews_.size();
+    }
+
+    // Appends up to maximumCount operands, returning the count appended (zero at the end).
+    size_t Read(/*inout*/ std::vector<NumberUnionAndType>& chunk, size_t maximumCount)
+    {
+        const size_t oldChunkSize = chunk.size();
+        size_t remainingCount = maximumCount;
+
+        while (remainingCount > 0 && !IsAtEnd())
+        {
+            // Files positioned before the next literal number come first.
+            if (fileViewIndex_ < fileViews_.size() && fileViews_[fileViewIndex_].numberIndex <= numberIndex_)
+            {
+                const NumberFileView& fileView = fileViews_[fileViewIndex_];
+                const size_t count = size_t(std::min<uint64_t>(remainingCount, fileView.elementCount - fileElementIndex_));
+                const size_t chunkSize = chunk.size();
+                chunk.resize(chunkSize + count);
+                Span<NumberUnionAndType> chunkNumbers(chunk.data() + chunkSize, count);
+                if (fileView.text.empty())
+                {
+                    DecodeNumberFileView(fileView, fileElementIndex_, /*out*/ chunkNumbers);
+                }
+                else
+                {
+                    ParseNumberTextView(fileView, /*inout*/ textOffset_, /*out*/ chunkNumbers);
+                }
+                remainingCount -= count;
+                fileElementIndex_ += count;
+                if (fileElementIndex_ >= fileView.elementCount)
+                {
+                    ++fileViewIndex_;
+                    fileElementIndex_ = 0;
+                    textOffset_ = 0;
+                }
+            }
+            else
+            {
+                size_t numberEnd = numberRange_.end;
+                if (fileViewIndex_ < fileViews_.size())
+                {
+                    numberEnd = std::min(numberEnd, fileViews_[fileViewIndex_].numberIndex);
+                }
+                const size_t count = std::min<size_t>(remainingCount, numberEnd - numberIndex_);
+                chunk.insert(chunk.end(), numbers_.begin() + numberIndex_, numbers_.begin() + numberIndex_ + count);
+                remainingCount -= count;
+                numberIndex_ += count;
+            }
+        }
+
+        return chunk.size() - oldChunkSize;
+    }
+
+private:
+    Span<const NumberUnionAndType> numbers_;
+    Range numberRange_;
+    Span<const NumberFileView> fileViews_;
+    size_t numberIndex_ = 0;
+    size_t fileViewIndex_ = 0;
+    uint64_t fileElementIndex_ = 0;
+    size_t textOffset_ = 0; // Within the text of a text view.
+};
+
+// Bounds the operands held in memory at once when streaming from files.
+constexpr size_t g_operandChunkSize = 65536;
+
+// When set (by main), output is written incrementally once it grows large rather than accumulated
+// entirely in memory, which matters for huge operand lists. Tests leave it null to see all output.
+FILE* g_outputFile = nullptr;
+
+void FlushOutputIfLarge(/*inout*/ std::string& stringOutput)
+{
+    constexpr size_t flushThreshold = 1 << 20;
+    if (g_outputFile != nullptr && stringOutput.size() >= flushThreshold)
+    {
+        std::fwrite(stringOutput.data(), 1, stringOutput.size(), g_outputFile);
+        stringOutput.clear();
+    }
+}
+
+void SprintAllNumbers(/*inout*/ std::string& stringOutput, Span<const NumberUnionAndType> numbers)
+{
+    constexpr std::string_view leftFlank = " (";
+    constexpr std::string_view rightFlank = ")";
+
+    for (NumberUnionAndType const& number : numbers)
+    {
+        if (number.elementType != ElementType::Undefined)
+        {
+            stringOutput.append("    ");
+            AppendFormattedNumericValue(/*inout*/ stringOutput, number.elementType, &number.numberUnion, leftFlank, rightFlank, number.printingFlags);
+            stringOutput.append("\n");
+            FlushOutputIfLarge(/*inout*/ stringOutput);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+T Truncate(T t) { return static_cast<T>(std::trunc(t)); }
+template<> uint8_t Truncate(uint8_t t) { return t; }
+template<> uint16_t Truncate(uint16_t t) { return t; }
+template<> uint32_t Truncate(uint32_t t) { return t; }
+template<> uint64_t Truncate(uint64_t t) { return t; }
+template<> int8_t Truncate(int8_t t) { return t; }
+template<> int16_t Truncate(int16_t t) { return t; }
+template<> int32_t Truncate(int32_t t) { return t; }
+template<> int64_t Truncate(int64_t t) { return t; }
+template<> Fixed24f12i12 Truncate(Fixed24f12i12 t) { t.Truncate(); return t; }
+template<> Fixed32f16i16 Truncate(Fixed32f16i16 t) { t.Truncate(); return t; }
+template<> Fixed32f24i8 Truncate(Fixed32f24i8 t) { t.Truncate(); return t; }
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct INumericOperationPerformer
+{
+    virtual void Add(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) = 0;
+    virtual void Subtract(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) = 0;
+    virtual void Multiply(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) = 0;
+    virtual void Divide(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) = 0;
+    virtual void Dot(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) = 0;
+    virtual void Truncate(Span<const NumberUnionAndType> numbers, _Out_ Span<NumberUnionAndType> results) = 0;
+};
+
+template <typename T>
+class NumericOperationPerformer : public INumericOperationPerformer
+{
+    void Add(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) override
+    {
+        T result = T(0);
+        NumberUnionAndType intermediate = finalResult; // Intermediate needed for casting.
+
+        for (NumberUnionAndType const& n : numbers)
+        {
+            result += CastNumberType<T>(n, /*inout*/ intermediate);
+        }
+        CastReferenceAs<T>(finalResult) = result;
+    }
+
+    void Subtract(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) override
+    {
+        T result = T(0);
+        NumberUnionAndType intermediate = finalResult;
+
+        if (!numbers.empty())
+        {
+            result = CastNumberType<T>(numbers.front(), /*inout*/ intermediate);
+
+            numbers.PopFront();
+            for (NumberUnionAndType const& n : numbers)
+            {
+                result -= CastNumberType<T>(n, /*inout*/ intermediate);
+            }
+        }
+        CastReferenceAs<T>(finalResult) = result;
+    };
+
+    void Multiply(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) override
+    {
+        T result = T(1);
+        NumberUnionAndType intermediate = finalResult;
+
+        for (auto& n : numbers)
+        {
+            result *= CastNumberType<T>(n, /*inout*/ intermediate);
+        }
+        CastReferenceAs<T>(finalResult) = result;
+    };
+
+    void Divide(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) override
+    {
+        T result = T(0);
+        NumberUnionAndType intermediate = finalResult;
+
+        if (!numbers.empty())
+        {
+            result = CastNumberType<T>(numbers.front(), /*inout*/ intermediate);
+
+            numbers.PopFront();
+            for (NumberUnionAndType const& n : numbers)
+            {
+                result /= CastNumberType<T>(n, /*inout*/ intermediate);
+            }
+        }
+        CastReferenceAs<T>(finalResult) = result;
+    };
+
+    void Dot(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) override
+    {
+        T result = T(0); 
+        size_t i = 0;
+        size_t numberCount = numbers.size();
+        size_t evenNumberCount = numbers.size() & ~size_t(1);
+        NumberUnionAndType intermediate1 = finalResult;
+        NumberUnionAndType intermediate2 = finalResult;
+
+        for (i = 0; i < evenNumberCount; i += 2)
+        {
+            T product = CastNumberType<T>(numbers[i],     /*out*/ intermediate1)
+                      * CastNumberType<T>(numbers[i + 1], /*out*/ intermediate2);
+            result += product;
+        }
+        if (i < numberCount)
+        {
+            result += CastNumberType<T>(numbers[i], /*out*/ intermediate1);
+        }
+        CastReferenceAs<T>(finalResult) = result;
+
+    #if 0 // Experimental rounding.
+        constexpr uint64_t mantissaMaskLowBits = (0x1ui64 << 42) - 1;
+        constexpr uint64_t mantissaMaskHighBits = ~mantissaMaskLowBits;
+        constexpr uint64_t mantissaEvenBit = 0x1ui64 << 42;
+        constexpr uint64_t mantissaMaskRoundingBit = 1ui64 << (42 - 1);
+
+        // Round halves to evens
+        NumberUnion result;
+        result.f64 = double(0);
+        size_t i = 0;
+        size_t numberCount = numbers.size();
+        size_t evenNumberCount = numbers.size() & ~size_t(1);
+
+        for (i = 0; i < evenNumberCount; i += 2)
+        {
+            NumberUnion product;
+            product.f64 = double(CastAs<T>(numbers[i])) * double(CastAs<T>(numbers[i + 1]));
+
+            if ((product.ui64 & mantissaMaskLowBits) == mantissaMaskRoundingBit)
+            {
+                product.ui64 += (product.ui64 & mantissaEvenBit) ? -int64_t(mantissaMaskRoundingBit) : mantissaMaskRoundingBit;
+            }
+            result.f64 += product.f64;
+            if ((result.ui64 & mantissaMaskLowBits) == mantissaMaskRoundingBit)
+            {
+                result.ui64 += (result.ui64 & mantissaEvenBit) ? -int64_t(mantissaMaskRoundingBit) : mantissaMaskRoundingBit;
+            }
+        }
+        if (i < numberCount)
+        {
+            result.f64 += CastAs<T>(numbers[i]);
+            if ((result.ui64 & mantissaMaskLowBits) == mantissaMaskRoundingBit)
+            {
+                result.ui64 += (result.ui64 & mantissaEvenBit) ? -int64_t(mantissaMaskRoundingBit) : mantissaMaskRoundingBit;
+            }
+        }
+        CastAs<T>(finalResult) = T(float(result.f64));
+
+        // Round halves towards infinity
+        NumberUnion result;
+        result.f64 = double(0);
+        size_t i = 0;
+        size_t numberCount = numbers.size();
+        size_t evenNumberCount = numbers.size() & ~size_t(1);
+
+        for (i = 0; i < evenNumberCount; i += 2)
+        {
+            NumberUnion product;
+            product.f64 = double(CastAs<T>(numbers[i])) * double(CastAs<T>(numbers[i + 1]));
+            product.ui64 += (0x1ui64 << 41);
+            product.ui64 &= ~((0x1ui64 << 42) - 1);
+            result.f64 += product.f64;
+            result.ui64 += (0x1ui64 << 41);
+            result.ui64 &= ~((0x1ui64 << 42) - 1);
+        }
+        if (i < numberCount)
+        {
+            result.f64 += CastAs<T>(numbers[i]);
+            result.ui64 += (0x1ui64 << 41);
+            result.ui64 &= ~((0x1ui64 << 42) - 1);
+        }
+        CastAs<T>(finalResult) = T(float(result.f64));
+    #endif
+    }
+
+    void Truncate(Span<const NumberUnionAndType> numbers, _Out_ Span<NumberUnionAndType> results) override
+    {
+        assert(numbers.size() == results.size());
+        const size_t count = numbers.size();
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            NumberUnionAndType intermediate = results[i];
+            T result = CastNumberType<T>(numbers[i], /*inout*/ intermediate);
+            result = ::Truncate(result);
+            CastReferenceAs<T>(results[i]) = result;
+        }
+    }
+};
+
+// Declare singletons since they are stateless anyway.
+NumericOperationPerformer<float> g_numericOperationPerformerFloat32;
+NumericOperationPerformer<double> g_numericOperationPerformerFloat64;
+NumericOperationPerformer<float16_t> g_numericOperationPerformerFloat16;
+NumericOperationPerformer<float16m7e8s1_t> g_numericOperationPerformerFloat16m7e8s1;
+NumericOperationPerformer<uint8_t> g_numericOperationPerformerUint8;
+NumericOperationPerformer<uint16_t> g_numericOperationPerformerUint16;
+NumericOperationPerformer<uint32_t> g_numericOperationPerformerUint32;
+NumericOperationPerformer<uint64_t> g_numericOperationPerformerUint64;
+NumericOperationPerformer<int8_t> g_numericOperationPerformerInt8;
+NumericOperationPerformer<int16_t> g_numericOperationPerformerInt16;
+NumericOperationPerformer<int32_t> g_numericOperationPerformerInt32;
+NumericOperationPerformer<int64_t> g_numericOperationPerformerInt64;
+NumericOperationPerformer<Fixed24f12i12> g_numericOperationPerformerFixed24f12i12;
+NumericOperationPerformer<Fixed32f16i16> g_numericOperationPerformerFixed32f16i16;
+NumericOperationPerformer<Fixed32f24i8> g_numericOperationPerformerFixed32f24i8;
+
+// Float8 has too few bits to compute in directly, so operations are computed in float32, and the
+// result is converted once (rounding to nearest even and saturating like any float8 conversion).
+template <ElementType elementType>
+class Float8OperationPerformer : public INumericOperationPerformer
+{
+    using Operation = void (INumericOperationPerformer::*)(Span<const NumberUnionAndType>, NumberUnionAndType&);
+
+    void Add(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) override
+    {
+        Compute(&INumericOperationPerformer::Add, numbers, /*out*/ finalResult);
+    }
+
+    void Subtract(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) override
+    {
+        Compute(&INumericOperationPerformer::Subtract, numbers, /*out*/ finalResult);
+    }
+
+    void Multiply(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) override
+    {
+        Compute(&INumericOperationPerformer::Multiply, numbers, /*out*/ finalResult);
+    }
+
+    void Divide(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) override
+    {
+        Compute(&INumericOperationPerformer::Divide, numbers, /*out*/ finalResult);
+    }
+
+    void Dot(Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult) override
+    {
+        Compute(&INumericOperationPerformer::Dot, numbers, /*out*/ finalResult);
+    }
+
+    void Truncate(Span<const NumberUnionAndType> numbers, _Out_ Span<NumberUnionAndType> results) override
+    {
+        assert(numbers.size() == results.size());
+        for (size_t i = 0; i < numbers.size(); ++i)
+        {
+            NumberUnionAndType intermediate = {};
+            intermediate.elementType = ElementType::Float32;
+            WriteResult(std::trunc(CastNumberType<float>(numbers[i], /*inout*/ intermediate)), /*out*/ results[i]);
+        }
+    }
+
+    void Compute(Operation operation, Span<const NumberUnionAndType> numbers, _Out_ NumberUnionAndType& finalResult)
+    {
+        NumberUnionAndType wideResult = {};
+        wideResult.elementType = ElementType::Float32;
+        (g_numericOperationPerformerFloat32.*operation)(numbers, /*out*/ wideResult);
+        WriteResult(wideResult.numberUnion.f32, /*out*/ finalResult);
+    }
+
+    static void WriteResult(float value, _Out_ NumberUnionAndType& result)
+    {
+        CastElementTypes(ElementType::Float32, elementType, &value, /*out*/ result.numberUnion.buffer, 1);
+    }
+};
+
+Float8OperationPerformer<ElementType::Float8m3e4s1> g_numericOperationPerformerFloat8m3e4s1;
+Float8OperationPerformer<ElementType::Float8m2e5s1> g_numericOperationPerformerFloat8m2e5s1;
+
+ElementType GetPromotedOutputElementType(Span<const NumberUnionAndType> numbers)
+{
+    // Determine the output element type based on the priority of each pair of types.
+    // If all data types are identical or there is only one, the result is simply the first input type.
+
+    ElementType outputElementType = ElementType::Undefined;
+    if (!numbers.empty())
+    {
+        outputElementType = numbers.front().elementType;
+        numbers.PopFront();
+
+        for (auto& number : numbers)
+        {
+            ElementType inputElementType = number.elementType;
+            outputElementType = g_elementTypePriorityTable[size_t(inputElementType)] > g_elementTypePriorityTable[size_t(outputElementType)]
+                ? inputElementType
+                : outputElementType;
+        }
+    }
+
+    return outputElementType;
+}
+
+size_t GetNumericOperationResultCount(NumericOperationType numericOperationType, size_t numberCount)
+{
+    switch (numericOperationType)
+    {
+    case NumericOperationType::Nop:
+    case NumericOperationType::Truncate:
+        return numberCount;
+
+    case NumericOperationType::Nothing:
+        return 0;
+
+    // case NumericOperationType::Add:
+    // case NumericOperationType::Subtract:
+    // case NumericOperationType::Multiply:
+    // case NumericOperationType::Divide:
+    default:
+        return 1;
+    }
+}
+
+// Returns the respective operation performer based on data type, or null if the type has no arithmetic.
+INumericOperationPerformer* GetNumericOperationPerformer(ElementType elementType)
+{
+    switch (elementType)
+    {
+    case ElementType::Undefined:        return nullptr;
+    case ElementType::Float32:          return &g_numericOperationPerformerFloat32;
+    case ElementType::Uint8:            return &g_numericOperationPerformerUint8;
+    case ElementType::Int8:             return &g_numericOperationPerformerInt8;
+    case ElementType::Uint16:           return &g_numericOperationPerformerUint16;
+    case ElementType::Int16:            return &g_numericOperationPerformerInt16;
+    case ElementType::Int32:            return &g_numericOperationPerformerInt32;
+    case ElementType::Int64:            return &g_numericOperationPerformerInt64;
+    case ElementType::StringChar8:      return nullptr;
+    case ElementType::Bool8:            return nullptr;
+    case ElementType::Float16:          return &g_numericOperationPerformerFloat16;
+    case ElementType::Float64:          return &g_numericOperationPerformerFloat64;
+    case ElementType::Uint32:           return &g_numericOperationPerformerUint32;
+    case ElementType::Uint64:           return &g_numericOperationPerformerUint64;
+    case ElementType::Complex64:        return nullptr;
+    case ElementType::Complex128:       return nullptr;
+    case ElementType::Float16m7e8s1:    return &g_numericOperationPerformerFloat16m7e8s1;
+    case ElementType::Fixed24f12i12:    return &g_numericOperationPerformerFixed24f12i12;
+    case ElementType::Fixed32f16i16:    return &g_numericOperationPerformerFixed32f16i16;
+    case ElementType::Fixed32f24i8:     return &g_numericOperationPerformerFixed32f24i8;
+    case ElementType::Float8m3e4s1:     return &g_numericOperationPerformerFloat8m3e4s1;
+    case ElementType::Float8m2e5s1:     return &g_numericOperationPerformerFloat8m2e5s1;
+    default: assert(false); return nullptr;
+    }
+}
+
+// Fill in any undefined result element types based on the inputs.
+void ResolveNumericOperationResultTypes(
+    Span<const NumberUnionAndType> numbers,
+    _Inout_ Span<NumberUnionAndType> results // in for initial element type
+)
+{
+    const size_t resultCount = results.size();
+    ElementType promotedElementType = GetPromotedOutputElementType(numbers);
+    for (size_t i = 0; i < resultCount; ++i)
+    {
+        auto& result = results[i];
+        if (result.elementType == ElementType::Undefined)
+        {
+            result.elementType = (resultCount > 1) ? numbers[i].elementType : promotedElementType;
+        }
+    }
+}
+
+// Computes the operation into results already sized and typed, reusable across calls.
+void ExecuteNumericOperation(
+    NumericOperationType numericOperationType,
+    INumericOperationPerformer* performer,
+    Span<const NumberUnionAndType> numbers,
+    _Inout_ Span<NumberUnionAndType> results
+)
+{
+    if (performer == nullptr)
+    {
+        return;
+    }
+
+    for (auto& result : results)
+    {
+        result.numberUnion = {};
+    }
+
+    switch (numericOperationType)
+    {
+    case NumericOperationType::Nothing:     /*no output*/ break;
+    case NumericOperationType::Nop:         std::copy(numbers.begin(), numbers.end(), results.begin()); break;
+    case NumericOperationType::Add:         performer->Add(numbers, /*out*/ results.front()); break;
+    case NumericOperationType::Subtract:    performer->Subtract(numbers, /*out*/ results.front()); break;
+    case NumericOperationType::Multiply:    performer->Multiply(numbers, /*out*/ results.front()); break;
+    case NumericOperationType::Divide:      performer->Divide(numbers, /*out*/ results.front()); break;
+    case NumericOperationType::Dot:         performer->Dot(numbers, /*out*/ results.front()); break;
+    case NumericOperationType::Truncate:    performer->Truncate(numbers, /*out*/ results); break;
+    case NumericOperationType::None:
+    default: assert(false);
+    }
+}
+
+void PerformNumericOperation(
+    NumericOperationType numericOperationType,
+    Span<const NumberUnionAndType> numbers,
+    _Inout_ std::vector<NumberUnionAndType>& results // in for initial element type
+)
+{
+    size_t resultCount = GetNumericOperationResultCount(numericOperationType, numbers.size());
+    results.resize(resultCount);
+    if (resultCount <= 0)
+    {
+        return;
+    }
+
+    ResolveNumericOperationResultTypes(numbers, /*inout*/ MakeSpan(results));
+    INumericOperationPerformer* performer = GetNumericOperationPerformer(results.front().elementType);
+    ExecuteNumericOperation(numericOperationType, performer, numbers, /*inout*/ MakeSpan(results));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Elementwise operations yield one result per operand, rather than reducing them to one.
+bool IsElementwiseNumericOperation(NumericOperationType numericOperationType) noexcept
+{
+    return numericOperationType == NumericOperationType::Nop
+        || numericOperationType == NumericOperationType::Truncate;
+}
+
+// A compiled form of the parsed operations, with each step's performer, output type, and
+// result storage resolved once up front, so the plan can be executed repeatedly without
+// reparsing or reallocating, such as for batch evaluation over new input values.
+//
+// Steps with operands from binary files are streamed in bounded chunks instead. Reductions
+// still store their single result, but elementwise results are only passed to the caller.
+struct OperationPlanStep
+{
+    NumericOperationType numericOperationType;
+    INumericOperationPerformer* performer; // Null if the output type has no arithmetic.
+    ElementType outputElementType;
+    Range numberRange;   // Inputs within OperationPlan::numbers.
+    Range fileViewRange; // Inputs within OperationPlan::fileViews, interleaved by their numberIndex.
+    Range resultRange;   // Outputs within OperationPlan::results.
+
+    bool IsStreamed() const noexcept { return fileViewRange.begin != fileViewRange.end; }
+};
+
+struct OperationPlan
+{
+    std::vector<OperationPlanStep> steps;
+    std::vector<NumberUnionAndType> numbers;
+    std::vector<NumberFileView> fileViews;
+    std::vector<NumberUnionAndType> results;
+
+    Span<const NumberUnionAndType> GetNumbers(const OperationPlanStep& step) const
+    {
+        return {numbers.data() + step.numberRange.begin, numbers.data() + step.numberRange.end};
+    }
+
+    Span<NumberUnionAndType> GetResults(const OperationPlanStep& step)
+    {
+        return {results.data() + step.resultRange.begin, results.data() + step.resultRange.end};
+    }
+
+    OperandCursor GetOperandCursor(const OperationPlanStep& step) const
+    {
+        Span<const NumberFileView> stepFileViews(fileViews.data() + step.fileViewRange.begin, fileViews.data() + step.fileViewRange.end);
+        return OperandCursor(MakeSpan(numbers), step.numberRange, stepFileViews);
+    }
+};
+
+void CompileOperationPlan(
+    Span<const NumericOperationAndRange> operations,
+    std::vector<NumberUnionAndType>&& numbers,
+    std::vector<NumberFileView>&& fileViews,
+    _Out_ OperationPlan& plan
+)
+{
+    plan.steps.clear();
+    plan.results.clear();
+    plan.numbers = std::move(numbers);
+    plan.fileViews = std::move(fileViews);
+    plan.steps.reserve(operations.size());
+
+    // Lower each operation to a step, gathering the file views which belong to it.
+    // Like numbers, any files before the first operation are not part of any operation.
+    size_t fileViewIndex = 0;
+    size_t resultIndex = 0;
+    const size_t fileViewCount = plan.fileViews.size();
+    for (size_t operationIndex = 0; operationIndex < operations.size(); ++operationIndex)
+    {
+        auto& operation = operations[operationIndex];
+        OperationPlanStep step = {};
+        step.numericOperationType = operation.numericOperationType;
+        step.outputElementType = operation.outputElementType;
+        step.numberRange = operation.range;
+
+        for (/*above*/; fileViewIndex < fileViewCount && plan.fileViews[fileViewIndex].operationIndex <= operationIndex; ++fileViewIndex)
+        { }
+        step.fileViewRange.begin = fileViewIndex;
+        for (/*above*/; fileViewIndex < fileViewCount && plan.fileViews[fileViewIndex].operationIndex == operationIndex + 1; ++fileViewIndex)
+        { }
+        step.fileViewRange.end = fileViewIndex;
+
+        // Streamed elementwise results are not stored, whereas reductions still have just one.
+        const size_t numberCount = step.IsStreamed() ? 0 : operation.range.end - operation.range.begin;
+        step.resultRange.begin = resultIndex;
+        resultIndex += GetNumericOperationResultCount(operation.numericOperationType, numberCount);
+        step.resultRange.end = resultIndex;
+
+        plan.steps.push_back(step);
+    }
+
+    // Size all the results before resolving types, so the spans stay valid.
+    plan.results.resize(resultIndex);
+
+    for (auto& step : plan.steps)
+    {
+        Span<const NumberUnionAndType> stepNumbers = plan.GetNumbers(step);
+        Span<NumberUnionAndType> stepResults = plan.GetResults(step);
+
+        if (!step.IsStreamed())
+        {
+            if (!stepResults.empty())
+            {
+                stepResults.front().elementType = step.outputElementType;
+                stepResults.front().printingFlags = stepNumbers.empty() ? NumericPrintingFlags::Default : stepNumbers.front().printingFlags;
+                ResolveNumericOperationResultTypes(stepNumbers, /*inout*/ stepResults);
+                step.outputElementType = stepResults.front().elementType;
+                step.performer = GetNumericOperationPerformer(step.outputElementType);
+            }
+            continue;
+        }
+
+        // Promote the output type across the literal numbers and the file element types together.
+        std::vector<NumberUnionAndType> firstOperand;
+        plan.GetOperandCursor(step).Read(/*inout*/ firstOperand, 1);
+        if (firstOperand.empty()) // Only empty files (like a truncated image), so take the first file's type.
+        {
+            const NumberFileView& fileView = plan.fileViews[step.fileViewRange.begin];
+            firstOperand.push_back({});
+            firstOperand.front().elementType = fileView.elementType;
+            firstOperand.front().printingFlags = fileView.printingFlags;
+        }
+        if (step.outputElementType == ElementType::Undefined)
+        {
+            if (IsElementwiseNumericOperation(step.numericOperationType))
+            {
+                step.outputElementType = firstOperand.front().elementType;
+            }
+            else
+            {
+                std::vector<NumberUnionAndType> operandTypes(stepNumbers.begin(), stepNumbers.end());
+                for (size_t i = step.fileViewRange.begin; i < step.fileViewRange.end; ++i)
+                {
+                    operandTypes.emplace_back().elementType = plan.fileViews[i].elementType;
+                }
+                step.outputElementType = GetPromotedOutputElementType(MakeSpan(operandTypes));
+            }
+        }
+
+        if (!stepResults.empty())
+        {
+            stepResults.front().elementType = step.outputElementType;
+            stepResults.front().printingFlags = firstOperand.front().printingFlags;
+        }
+        step.performer = GetNumericOperationPerformer(step.outputElementType);
+    }
+}
+
+// Replaces the input values of a compiled plan. The element types must match those the plan was
+// compiled with, since the result types and performers depend on them, else false is returned.
+bool SetOperationPlanNumbers(_Inout_ OperationPlan& plan, Span<const NumberUnionAndType> numbers)
+{
+    if (numbers.size() != plan.numbers.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0, count = numbers.size(); i < count; ++i)
+    {
+        if (numbers[i].elementType != plan.numbers[i].elementType)
+        {
+            return false;
+        }
+    }
+
+    std::copy(numbers.begin(), numbers.end(), plan.numbers.begin());
+    return true;
+}
+
+// Passes the operands of a step to the given function, in chunks if streamed from files.
+template <typename OperandsFunction>
+void ForEachOperationPlanOperandChunk(const OperationPlan& plan, const OperationPlanStep& step, OperandsFunction&& onOperands)
+{
+    if (!step.IsStreamed())
+    {
+        onOperands(plan.GetNumbers(step));
+        return;
+    }
+
+    OperandCursor cursor = plan.GetOperandCursor(step);
+    std::vector<NumberUnionAndType> chunk;
+    while (cursor.Read(/*inout*/ chunk, g_operandChunkSize) > 0)
+    {
+        onOperands(MakeSpan(chunk));
+        chunk.clear();
+    }
+}
+
+// Executes one step and passes its results to the given function, in chunks for elementwise
+// operations streamed from files.
+template <typename ResultsFunction>
+void ExecuteOperationPlanStep(_Inout_ OperationPlan& plan, const OperationPlanStep& step, ResultsFunction&& onResults)
+{
+    if (!step.IsStreamed())
+    {
+        ExecuteNumericOperation(step.numericOperationType, step.performer, plan.GetNumbers(step), /*inout*/ plan.GetResults(step));
+        onResults(plan.GetResults(step));
+        return;
+    }
+
+    OperandCursor cursor = plan.GetOperandCursor(step);
+    std::vector<NumberUnionAndType> chunk;
+    chunk.reserve(g_operandChunkSize + 3);
+
+    if (IsElementwiseNumericOperation(step.numericOperationType))
+    {
+        std::vector<NumberUnionAndType> results;
+        while (cursor.Read(/*inout*/ chunk, g_operandChunkSize) > 0)
+        {
+            results.resize(chunk.size());
+            for (size_t i = 0, count = chunk.size(); i < count; ++i)
+            {
+                results[i].elementType = step.outputElementType;
+                results[i].printingFlags = chunk[i].printingFlags;
+            }
+            ExecuteNumericOperation(step.numericOperationType, step.performer, MakeSpan(chunk), /*inout*/ MakeSpan(results));
+            onResults(MakeSpan(results));
+            chunk.clear();
+        }
+        return;
+    }
+
+    Span<NumberUnionAndType> stepResults = plan.GetResults(step);
+    if (stepResults.empty())
+    {
+        onResults(Span<const NumberUnionAndType>(stepResults.begin(), stepResults.end()));
+        return;
+    }
+
+    // Reduce chunk by chunk, with the running result entering the front of each next chunk, which
+    // yields the same result as one long list for add, subtract, multiply, and divide. Dot pairs
+    // consecutive operands, so the running result enters as result*1, and any odd trailing operand
+    // is carried forward so pairs never straddle chunks.
+    NumberUnionAndType& result = stepResults.front();
+    const bool isDot = (step.numericOperationType == NumericOperationType::Dot);
+    NumberUnionAndType one = result;
+    WriteFromInt64(one.elementType, 1, /*out*/ &one.numberUnion);
+
+    NumberUnionAndType carriedOperand = {};
+    bool hasCarriedOperand = false;
+    bool hasRunningResult = false;
+    do
+    {
+        chunk.clear();
+        if (hasRunningResult)
+        {
+            chunk.push_back(result);
+            if (isDot)
+            {
+                chunk.push_back(one);
+            }
+        }
+        const size_t prefixCount = chunk.size();
+        if (hasCarriedOperand)
+        {
+            chunk.push_back(carriedOperand);
+            hasCarriedOperand = false;
+        }
+
+        cursor.Read(/*inout*/ chunk, g_operandChunkSize);
+        if (isDot && !cursor.IsAtEnd() && (chunk.size() - prefixCount) % 2 != 0)
+        {
+            carriedOperand = chunk.back();
+            chunk.pop_back();
+            hasCarriedOperand = true;
+        }
+
+        ExecuteNumericOperation(step.numericOperationType, step.performer, MakeSpan(chunk), /*inout*/ Span<NumberUnionAndType>(&result, 1));
+        hasRunningResult = true;
+    } while (!cursor.IsAtEnd() || hasCarriedOperand);
+
+    onResults(Span<const NumberUnionAndType>(stepResults.begin(), stepResults.end()));
+}
+
+// Executes every step in order, passing each step's results to the given function.
+template <typename ResultsFunction>
+void ExecuteOperationPlan(_Inout_ OperationPlan& plan, ResultsFunction&& onResults)
+{
+    for (auto& step : plan.steps)
+    {
+        ExecuteOperationPlanStep(/*inout*/ plan, step, onResults);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void PrintUsage()
+{
+    std::puts(
+        "Usage:\n"
+        "   binums 12.75  // floating point value in various formats\n"
+        "   binums 0b1101  // read binary integer\n"
+        "   binums float32 raw 0x40490FDB  // read raw floating point bits\n"
+        "   binums float16 raw 0x5140  // read raw floating point bits\n"
+        "   binums fields hex 7 12.75 -13 bin 7 12.75 -13  // see fields of numbers\n"
+        "   binums int8 fields 13 -13  // see fields of numbers\n"
+        "   binums uint32 add 1.5 3.25  // perform operation\n"
+        "   binums float32 add float16 2 3  // read float16, compute in float32\n"
+        "   binums uint32 mul 3 2 add 3 2 subtract 3 2 dot 1 2 3 4\n"
+        "   binums 0x1.5p5  // floating point hexadecimal\n"
+        "   binums fixed12_12 sub 3.5 2  // fixed point arithmetic\n"
+        "   binums @commands.txt  // read command from file (or - for stdin)\n"
+        "   binums float32 add textfile numbers.txt  // read numbers from text file\n"
+        "   binums file weights.bin float16 [offset] [count]  // read numbers from binary file\n"
+        "   binums dump weights.bin float16 bfloat16 [offset] [size]  // show file bytes as types\n"
+        "   binums convert in.bin float32 out.bin bfloat16 [direct]  // convert binary file type\n"
+        "   binums convert in.npy out.npy float16  // convert numpy array file type\n"
+        "   binums tensors model.safetensors  // list tensors of a model file\n"
+        "   binums file model.safetensors tensor embed.weight  // read numbers of one tensor\n"
+        "   binums convert model.safetensors out.safetensors bfloat16  // convert all tensors\n"
+        "   binums convert model.gguf tensor output.weight out.npy float32  // dequantize a tensor\n"
+        "   binums tensors model.onnx  // list initializers of an ONNX model\n"
+        "   binums convert song.wav out.npy float32  // convert 24-bit PCM samples\n"
+        "   binums float32 add file render.pfm rows 0 16 channel 1  // read green of 16 rows\n"
+        "   binums stats model.safetensors tensor embed.weight  // count, extremes, mean, variance\n"
+        "   binums stats model.safetensors  // each tensor, then all tensors of each type\n"
+        "   binums histogram activations.npy  // count floats per power of two exponent\n"
+        "   binums histogram weights.bin float16 values top 20  // most frequent values, entropy\n"
+        "   binums quantiles activations.npy  // p50 to p99.99 of absolute values, for clipping\n"
+        "   binums qerror weights.bin float32  // error of converting to each narrower type\n"
+        "   binums ulpdiff out.bin ref.bin float16 maxulp 2 [stop]  // ulp distances, pass/fail\n"
+        "   binums compare out.bin ref.bin float16 rtol=1e-3 atol=1e-5  // allclose, worst pairs\n"
+        "   binums nanscan ckpt1.safetensors ckpt2.safetensors first 5  // first NaN/inf positions\n"
+        "   binums census activations.npy  // overflow, underflow, subnormal counts per narrower type\n"
+        "   binums quantize weights.npy float8e4m3 axis 0 scales scales.npy out weights8.npy  // per channel scales\n"
+        "   binums batch inputs.txt float32 mul 0 0 add 0 1  // rerun operations per line of numbers\n"
+        "\n"
+        "Options:\n"
+        "   bin hex dec oct - display raw bits as binary/hex/decimal/octal\n"
+        "   floathex floatdec - display floating values as hex or decimal (default)\n"
+        "   raw num - read input as raw bit data or as number (default)\n"
+        "   textfile filename - read numbers delimited by spaces, lines, or commas\n"
+        "   file filename [tensor name] [type] [byteoffset] [count] - read raw numbers from binary file\n"
+        "      (or .npy, .safetensors, .gguf, .onnx, .wav, .pgm, .ppm, or .pfm; int24 for packed 24-bit integers)\n"
+        "      [rows first [count]] [columns first [count]] [channel index] - select a region of [rows, columns, channels]\n"
+        "   fields nofields - show numeric component bitfields\n"
+        "   add subtract multiply divide dot nop - apply operation to following numbers\n"
+        "   float8e4m3 float8e5m2 float16 bfloat16 float32 float64 - set floating point data type\n"
+        "   uint8 uint16 uint32 uint64 int8 int16 int32 int64 - set integer data type\n"
+        "   fixed12_12 fixed16_16 fixed8_24 - set fixed precision data type\n"
+        "\n"
+        "Dwayne Robinson, 2019-02-14..2022-11-17, No Copyright\n"
+        "https://github.com/fdwr/BiNums\n"
+    );
+}
+
+// Commands over whole files, given as the first parameter instead of operations.
+enum class CommandType : uint32_t
+{
+    Dump,
+    Convert,
+    Tensors,
+    Stats,
+    Histogram,
+    Quantiles,
+    QuantizationError,
+    UlpDifference,
+    Compare,
+    NanScan,
+    Census,
+    Quantize,
+    Batch,
+};
+
+// Every command keyword and alias, mapped to the typed token it sets.
+enum class KeywordType : uint8_t
+{
+    Command,            // value = CommandType
+    NumericOperation,   // value = NumericOperationType
+    ElementType,        // value = ElementType
+    PrintingFlags,      // value = NumericPrintingFlags to set, mask = NumericPrintingFlags to clear
+    ParseAsRawData,     // value = bool
+    TextFile,           // Followed by the file name of numbers to read.
+    File,               // Followed by the binary file name, element type, byte offset, and element count.
+    OpenParenthesis,
+    CloseParenthesis,
+    Comma,
+};
+
+struct Keyword
+{
+    std::string_view name;
+    KeywordType type;
+    uint32_t value;
+    uint32_t mask;
+};
+
+constexpr Keyword MakeKeyword(std::string_view name, NumericOperationType numericOperationType)
+{
+    return {name, KeywordType::NumericOperation, uint32_t(numericOperationType), 0};
+}
+
+constexpr Keyword MakeKeyword(std::string_view name, ElementType elementType)
+{
+    return {name, KeywordType::ElementType, uint32_t(elementType), 0};
+}
+
+constexpr Keyword MakeKeyword(std::string_view name, NumericPrintingFlags mask, NumericPrintingFlags flags)
+{
+    return {name, KeywordType::PrintingFlags, uint32_t(flags), uint32_t(mask)};
+}
+
+constexpr Keyword MakeKeyword(std::string_view name, CommandType commandType)
+{
+    return {name, KeywordType::Command, uint32_t(commandType), 0};
+}
+
+constexpr Keyword MakeKeyword(std::string_view name, KeywordType keywordType, uint32_t value = 0)
+{
+    return {name, keywordType, value, 0};
+}
+
+constexpr Keyword g_keywords[] =
+{
+    MakeKeyword("dump", CommandType::Dump),
+    MakeKeyword("convert", CommandType::Convert),
+    MakeKeyword("tensors", CommandType::Tensors),
+    MakeKeyword("stats", CommandType::Stats),
+    MakeKeyword("histogram", CommandType::Histogram),
+    MakeKeyword("quantiles", CommandType::Quantiles),
+    MakeKeyword("qerror", CommandType::QuantizationError),
+    MakeKeyword("ulpdiff", CommandType::UlpDifference),
+    MakeKeyword("compare", CommandType::Compare),
+    MakeKeyword("nanscan", CommandType::NanScan),
+    MakeKeyword("census", CommandType::Census),
+    MakeKeyword("quantize", CommandType::Quantize),
+    MakeKeyword("batch", CommandType::Batch),
+
+    MakeKeyword("nop", NumericOperationType::Nop),
+    MakeKeyword("nothing", NumericOperationType::Nothing),
+    MakeKeyword("add", NumericOperationType::Add),
+    MakeKeyword("sub", NumericOperationType::Subtract),
+    MakeKeyword("subtract", NumericOperationType::Subtract),
+    MakeKeyword("mul", NumericOperationType::Multiply),
+    MakeKeyword("multiply", NumericOperationType::Multiply),
+    MakeKeyword("div", NumericOperationType::Divide),
+    MakeKeyword("divide", NumericOperationType::Divide),
+    MakeKeyword("dot", NumericOperationType::Dot),
+    MakeKeyword("dotproduct", NumericOperationType::Dot),
+    MakeKeyword("trunc", NumericOperationType::Truncate),
+    MakeKeyword("truncate", NumericOperationType::Truncate),
+
+    MakeKeyword("raw", KeywordType::ParseAsRawData, true),
+    MakeKeyword("num", KeywordType::ParseAsRawData, false),
+    MakeKeyword("number", KeywordType::ParseAsRawData, false),
+    MakeKeyword("textfile", KeywordType::TextFile),
+    MakeKeyword("file", KeywordType::File),
+
+    MakeKeyword("undefined", ElementType::Undefined),
+    MakeKeyword("i8", ElementType::Int8),
+    MakeKeyword("int8", ElementType::Int8),
+    MakeKeyword("ui8", ElementType::Uint8),
+    MakeKeyword("uint8", ElementType::Uint8),
+    MakeKeyword("i16", ElementType::Int16),
+    MakeKeyword("int16", ElementType::Int16),
+    MakeKeyword("ui16", ElementType::Uint16),
+    MakeKeyword("uint16", ElementType::Uint16),
+    MakeKeyword("i32", ElementType::Int32),
+    MakeKeyword("int32", ElementType::Int32),
+    MakeKeyword("int", ElementType::Int32),
+    MakeKeyword("ui32", ElementType::Uint32),
+    MakeKeyword("uint32", ElementType::Uint32),
+    MakeKeyword("uint", ElementType::Uint32),
+    MakeKeyword("i64", ElementType::Int64),
+    MakeKeyword("int64", ElementType::Int64),
+    MakeKeyword("ui64", ElementType::Uint64),
+    MakeKeyword("uint64", ElementType::Uint64),
+    MakeKeyword("f16", ElementType::Float16),
+    MakeKeyword("float16", ElementType::Float16),
+    MakeKeyword("f16m7e8s1", ElementType::Float16m7e8s1),
+    MakeKeyword("bfloat16", ElementType::Float16m7e8s1),
+    MakeKeyword("f8e4m3", ElementType::Float8m3e4s1),
+    MakeKeyword("float8e4m3", ElementType::Float8m3e4s1),
+    MakeKeyword("float8f3e4s1", ElementType::Float8m3e4s1),
+    MakeKeyword("f8e5m2", ElementType::Float8m2e5s1),
+    MakeKeyword("float8e5m2", ElementType::Float8m2e5s1),
+    MakeKeyword("float8f2e5s1", ElementType::Float8m2e5s1),
+    MakeKeyword("f32", ElementType::Float32),
+    MakeKeyword("float32", ElementType::Float32),
+    MakeKeyword("float", ElementType::Float32),
+    MakeKeyword("f64", ElementType::Float64),
+    MakeKeyword("float64", ElementType::Float64),
+    MakeKeyword("double", ElementType::Float64),
+    MakeKeyword("fixed12_12", ElementType::Fixed24f12i12),
+    MakeKeyword("fixed16_16", ElementType::Fixed32f16i16),
+    MakeKeyword("fixed8_24", ElementType::Fixed32f24i8),
+
+    MakeKeyword("bin", NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawBinary),
+    MakeKeyword("binary", NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawBinary),
+    MakeKeyword("showrawbinary", NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawBinary),
+    MakeKeyword("hex", NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawHex),
+    MakeKeyword("hexademical", NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawHex),
+    MakeKeyword("showrawhexadecimal", NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawHex),
+    MakeKeyword("dec", NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawDecimal),
+    MakeKeyword("decimal", NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawDecimal),
+    MakeKeyword("showrawdecimal", NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawDecimal),
+    MakeKeyword("oct", NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawOctal),
+    MakeKeyword("octal", NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawOctal),
+    MakeKeyword("showrawoctal", NumericPrintingFlags::ShowDataMask, NumericPrintingFlags::ShowRawOctal),
+    MakeKeyword("floathex", NumericPrintingFlags::ShowFloatMask, NumericPrintingFlags::ShowFloatHex),
+    MakeKeyword("showfloathexadecimal", NumericPrintingFlags::ShowFloatMask, NumericPrintingFlags::ShowFloatHex),
+    MakeKeyword("floatdec", NumericPrintingFlags::ShowFloatMask, NumericPrintingFlags::ShowFloatDecimal),
+    MakeKeyword("showfloatdecimal", NumericPrintingFlags::ShowFloatMask, NumericPrintingFlags::ShowFloatDecimal),
+    MakeKeyword("fields", NumericPrintingFlags::ShowRawFieldsMask, NumericPrintingFlags::ShowRawFields),
+    MakeKeyword("showrawfields", NumericPrintingFlags::ShowRawFieldsMask, NumericPrintingFlags::ShowRawFields),
+    MakeKeyword("nofields", NumericPrintingFlags::ShowRawFieldsMask, NumericPrintingFlags::HideRawFields),
+    MakeKeyword("hiderawfields", NumericPrintingFlags::ShowRawFieldsMask, NumericPrintingFlags::HideRawFields),
+
+    MakeKeyword("(", KeywordType::OpenParenthesis),
+    MakeKeyword(")", KeywordType::CloseParenthesis),
+    MakeKeyword(",", KeywordType::Comma),
+};
+
+constexpr auto g_keywordHashTable = Tokenizer::PerfectHashTable<2048>::Make(g_keywords);
+
+// Reads the header of a memory mapped .npy file, for its element type, byte order, and data offset.
+int ReadNpyFileHeader(
+    const MappedFile& file,
+    std::string_view fileName,
+    /*out*/ Npy::Header& header,
+    /*out*/ ElementType& elementType,
+    /*out*/ bool& isBigEndian,
+    /*out*/ std::string& errorMessage
+)
+{
+    elementType = ElementType::Undefined;
+    isBigEndian = false;
+    if (!Npy::ParseHeader(file.data(), file.size(), /*out*/ header))
+    {
+        errorMessage = GetFormatted("Could not parse the npy header of file: \"%.*s\"", int(fileName.size()), fileName.data());
+        return EXIT_FAILURE;
+    }
+    elementType = GetElementTypeFromNpyDescr(header.descr, /*out*/ isBigEndian);
+    if (elementType == ElementType::Undefined)
+    {
+        errorMessage = GetFormatted("Unsupported npy dtype \"%s\" in file: \"%.*s\"", header.descr.c_str(), int(fileName.size()), fileName.data());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+// A typed array within a file, like one tensor of a .safetensors model or the array of an .npy file.
+struct FileTensor
+{
+    std::string name;
+    std::string dtype;              // Type name in the file's own format, for messages
+    ElementType elementType;        // Undefined if the format's type is unsupported (or for raw files)
+    uint32_t blockQuantizedType = 0; // ggml type of GGUF blocks decoded to float32 elements, else zero.
+    bool isInt24 = false;           // Packed 24-bit integers (like 24-bit PCM audio) decoded to int32 elements.
+    bool isBigEndian = false;       // Like 16-bit PPM samples, else little-endian.
+    std::vector<uint64_t> shape;
+    bool isFortranOrder = false;    // Only .npy files may be column major.
+    uint64_t dataOffset = 0;        // Byte offset in the file
+    uint64_t byteCount = 0;
+};
+
+// Returns the element type of a ggml tensor type, which is float32 for block quantized types
+// that can be dequantized, or undefined if unsupported.
+ElementType GetElementTypeFromGgufType(uint32_t type) noexcept
+{
+    switch (Gguf::TensorType(type))
+    {
+    case Gguf::TensorType::F32:     return ElementType::Float32;
+    case Gguf::TensorType::F16:     return ElementType::Float16;
+    case Gguf::TensorType::BF16:    return ElementType::Bfloat16;
+    case Gguf::TensorType::F64:     return ElementType::Float64;
+    case Gguf::TensorType::I8:      return ElementType::Int8;
+    case Gguf::TensorType::I16:     return ElementType::Int16;
+    case Gguf::TensorType::I32:     return ElementType::Int32;
+    case Gguf::TensorType::I64:     return ElementType::Int64;
+    default: return Gguf::IsDequantizable(type) ? ElementType::Float32 : ElementType::Undefined;
+    }
+}
+
+// Returns the element type of an ONNX TensorProto data type, or undefined if unsupported. The first
+// sixteen types share the ElementType enum values.
+ElementType GetElementTypeFromOnnxDataType(int32_t dataType) noexcept
+{
+    constexpr int32_t onnxFloat8e4m3fn = 17, onnxFloat8e5m2 = 19;
+    if (dataType == onnxFloat8e4m3fn)
+    {
+        return ElementType::Float8m3e4s1;
+    }
+    if (dataType == onnxFloat8e5m2)
+    {
+        return ElementType::Float8m2e5s1;
+    }
+    const ElementType elementType = ElementType(dataType);
+    return (dataType > 0 && dataType <= int32_t(ElementType::Bfloat16) && IsFileElementType(elementType)) ? elementType : ElementType::Undefined;
+}
+
+// Name of packed 24-bit integers in file type parameters. They are not a full element type, instead
+// decoded to int32 as they are read.
+constexpr std::string_view g_int24TypeName = "int24";
+
+// Returns the element type of WAV samples, or undefined for unsupported depths like 12-bit. 24-bit
+// samples decode to int32.
+ElementType GetElementTypeFromWavFormat(Wav::Format format, uint32_t bitsPerSample) noexcept
+{
+    if (format == Wav::Format::Float)
+    {
+        return (bitsPerSample == 32) ? ElementType::Float32 : (bitsPerSample == 64) ? ElementType::Float64 : ElementType::Undefined;
+    }
+    switch (bitsPerSample)
+    {
+    case 8:  return ElementType::Uint8; // 8-bit PCM alone is unsigned, centered on 128.
+    case 16: return ElementType::Int16;
+    case 24: return ElementType::Int32;
+    case 32: return ElementType::Int32;
+    default: return ElementType::Undefined;
+    }
+}
+
+// Reads the arrays of a memory mapped .npy, .safetensors, .gguf, .onnx, .wav, or .pgm/.ppm/.pfm file,
+// or a single untyped array spanning a whole raw binary file.
+int ReadFileTensors(
+    const MappedFile& file,
+    std::string_view fileName,
+    /*out*/ std::vector<FileTensor>& tensors,
+    /*out*/ std::string& errorMessage
+)
+{
+    tensors.clear();
+    if (Npy::IsNpy(file.data(), file.size()))
+    {
+        Npy::Header npyHeader;
+        ElementType npyElementType;
+        bool isNpyBigEndian;
+        if (ReadNpyFileHeader(file, fileName, /*out*/ npyHeader, /*out*/ npyElementType, /*out*/ isNpyBigEndian, /*out*/ errorMessage) != EXIT_SUCCESS)
+        {
+            return EXIT_FAILURE;
+        }
+        // A file cut short (like an interrupted download) would otherwise read as fewer elements.
+        const uint64_t byteCount = npyHeader.GetElementCount() * GetSizeOfTypeInBytes(npyElementType);
+        const uint64_t fileByteCount = file.size() - npyHeader.dataOffset;
+        if (byteCount > fileByteCount)
+        {
+            errorMessage = GetFormatted(
+                "Expected %llu bytes of npy data for the shape, but only %llu follow the header in file: \"%.*s\"",
+                static_cast<unsigned long long>(byteCount),
+                static_cast<unsigned long long>(fileByteCount),
+                int(fileName.size()),
+                fileName.data()
+            );
+            return EXIT_FAILURE;
+        }
+        tensors.push_back({"", npyHeader.descr, npyElementType, 0, false, isNpyBigEndian, npyHeader.shape, npyHeader.isFortranOrder, npyHeader.dataOffset, byteCount});
+    }
+    else if (Safetensors::IsSafetensors(file.data(), file.size()))
+    {
+        Safetensors::Header header;
+        if (!Safetensors::ParseHeader(file.data(), file.size(), /*out*/ header))
+        {
+            errorMessage = GetFormatted("Could not parse the safetensors header of file: \"%.*s\"", int(fileName.size()), fileName.data());
+            return EXIT_FAILURE;
+        }
+        tensors.reserve(header.tensors.size());
+        for (auto& tensorInfo : header.tensors)
+        {
+            FileTensor& tensor = tensors.emplace_back();
+            tensor.name = std::move(tensorInfo.name);
+            tensor.elementType = GetElementTypeFromSafetensorsDtype(tensorInfo.dtype);
+            tensor.dtype = std::move(tensorInfo.dtype);
+            tensor.shape = std::move(tensorInfo.shape);
+            tensor.dataOffset = header.dataOffset + tensorInfo.dataBegin;
+            tensor.byteCount = tensorInfo.dataEnd - tensorInfo.dataBegin;
+        }
+    }
+    else if (Gguf::IsGguf(file.data(), file.size()))
+    {
+        Gguf::Header header;
+        if (!Gguf::ParseHeader(file.data(), file.size(), /*out*/ header))
+        {
+            errorMessage = GetFormatted("Could not parse the GGUF header of file: \"%.*s\"", int(fileName.size()), fileName.data());
+            return EXIT_FAILURE;
+        }
+        tensors.reserve(header.tensors.size());
+        for (auto& tensorInfo : header.tensors)
+        {
+            const Gguf::TypeInfo typeInfo = Gguf::GetTypeInfo(tensorInfo.type);
+            FileTensor& tensor = tensors.emplace_back();
+            tensor.name = std::move(tensorInfo.name);
+            tensor.dtype = typeInfo.name.empty() ? GetFormatted("type%u", tensorInfo.type) : std::string(typeInfo.name);
+            tensor.elementType = GetElementTypeFromGgufType(tensorInfo.type);
+            tensor.blockQuantizedType = (typeInfo.blockElementCount > 1) ? tensorInfo.type : 0;
+            tensor.dataOffset = header.dataOffset + tensorInfo.dataBegin;
+            tensor.byteCount = tensorInfo.GetByteCount();
+            tensor.shape = std::move(tensorInfo.shape);
+        }
+    }
+    else if (Wav::IsWav(file.data(), file.size()))
+    {
+        Wav::Header header;
+        if (!Wav::ParseHeader(file.data(), file.size(), /*out*/ header))
+        {
+            errorMessage = GetFormatted("Could not parse the WAV header of file: \"%.*s\"", int(fileName.size()), fileName.data());
+            return EXIT_FAILURE;
+        }
+        // Frames are rows of interleaved channel samples.
+        FileTensor& tensor = tensors.emplace_back();
+        const bool isFloat = (header.format == Wav::Format::Float);
+        tensor.dtype = GetFormatted(isFloat ? "float%u" : "pcm%u", header.bitsPerSample);
+        tensor.elementType = GetElementTypeFromWavFormat(header.format, header.bitsPerSample);
+        tensor.isInt24 = (!isFloat && header.bitsPerSample == 24);
+        tensor.shape = {header.GetFrameCount(), header.channelCount};
+        tensor.dataOffset = header.dataOffset;
+        tensor.byteCount = header.GetFrameCount() * header.blockAlign;
+        if (header.blockAlign != header.channelCount * ((header.bitsPerSample + 7u) / 8u))
+        {
+            tensor.elementType = ElementType::Undefined; // Padded samples, like 20 bits in 4 bytes.
+        }
+    }
+    else if (Pnm::IsPnm(file.data(), file.size()))
+    {
+        Pnm::Header header;
+        if (!Pnm::ParseHeader(file.data(), file.size(), /*out*/ header))
+        {
+            errorMessage = GetFormatted("Could not parse the PNM header of file: \"%.*s\"", int(fileName.size()), fileName.data());
+            return EXIT_FAILURE;
+        }
+        // Pixels are [height, width, channels], with PFM rows in file order (bottom to top).
+        FileTensor& tensor = tensors.emplace_back();
+        tensor.elementType = header.isFloat ? ElementType::Float32 : (header.sampleByteSize > 1) ? ElementType::Uint16 : ElementType::Uint8;
+        tensor.isBigEndian = header.isBigEndian;
+        tensor.dtype = header.isFloat ? (header.isBigEndian ? ">f4" : "<f4") : (header.sampleByteSize > 1) ? ">u2" : "|u1";
+        tensor.shape = {header.height, header.width, header.channelCount};
+        tensor.dataOffset = header.dataOffset;
+        tensor.byteCount = std::min<uint64_t>(header.GetByteCount(), file.size() - header.dataOffset);
+    }
+    else if (fileName.size() >= 5 && fileName.substr(fileName.size() - 5) == ".onnx") // ONNX lacks any magic number.
+    {
+        std::vector<Onnx::TensorInfo> initializers;
+        if (!Onnx::ParseInitializers(file.data(), file.size(), /*out*/ initializers))
+        {
+            errorMessage = GetFormatted("Could not parse the ONNX model of file: \"%.*s\"", int(fileName.size()), fileName.data());
+            return EXIT_FAILURE;
+        }
+        tensors.reserve(initializers.size());
+        for (auto& initializer : initializers)
+        {
+            const std::string_view dataTypeName = Onnx::GetDataTypeName(initializer.dataType);
+            FileTensor& tensor = tensors.emplace_back();
+            tensor.name = std::move(initializer.name);
+            tensor.dtype = dataTypeName.empty() ? GetFormatted("type%d", initializer.dataType) : std::string(dataTypeName);
+            tensor.elementType = GetElementTypeFromOnnxDataType(initializer.dataType);
+            tensor.shape = std::move(initializer.shape);
+            tensor.dataOffset = initializer.dataOffset;
+            tensor.byteCount = initializer.byteCount;
+
+            // Only data stored contiguously in the file can be read in place.
+            if (initializer.dataLocation == Onnx::DataLocation::Varints || initializer.dataLocation == Onnx::DataLocation::External)
+            {
+                tensor.dtype.append(initializer.dataLocation == Onnx::DataLocation::Varints ? " varints" : " external");
+                tensor.elementType = ElementType::Undefined;
+            }
+        }
+    }
+    else
+    {
+        tensors.push_back({"", "", ElementType::Undefined, 0, false, false, {}, false, 0, file.size()});
+    }
+    return EXIT_SUCCESS;
+}
+
+// Finds the named tensor, or the only tensor if no name is given, checking that any explicit element
+// type matches the size of the file's type. The element type is returned in the tensor, falling back
+// to the explicit or default type for raw files. An explicit int24 is passed as int32 with isExplicitInt24.
+int SelectFileTensor(
+    const MappedFile& file,
+    std::string_view fileName,
+    std::string_view tensorName,
+    ElementType explicitElementType,
+    bool isExplicitInt24,
+    ElementType defaultElementType,
+    /*out*/ FileTensor& tensor,
+    /*out*/ std::string& errorMessage
+)
+{
+    std::vector<FileTensor> tensors;
+    if (ReadFileTensors(file, fileName, /*out*/ tensors, /*out*/ errorMessage) != EXIT_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+
+    auto match = tensors.begin();
+    if (!tensorName.empty())
+    {
+        match = std::find_if(tensors.begin(), tensors.end(), [=](const FileTensor& t) { return t.name == tensorName; });
+        if (match == tensors.end())
+        {
+            errorMessage = GetFormatted("No tensor \"%.*s\" in file: \"%.*s\"", int(tensorName.size()), tensorName.data(), int(fileName.size()), fileName.data());
+            return EXIT_FAILURE;
+        }
+    }
+    else if (tensors.size() != 1)
+    {
+        errorMessage = GetFormatted("Expected a tensor name for file with %zu tensors: \"%.*s\"", tensors.size(), int(fileName.size()), fileName.data());
+        return EXIT_FAILURE;
+    }
+    tensor = std::move(*match);
+
+    if (tensor.dtype.empty())
+    {
+        tensor.elementType = (explicitElementType != ElementType::Undefined) ? explicitElementType : defaultElementType;
+        tensor.isInt24 = isExplicitInt24;
+    }
+    else if (tensor.elementType == ElementType::Undefined)
+    {
+        errorMessage = GetFormatted("Unsupported dtype \"%s\" of tensor \"%s\" in file: \"%.*s\"", tensor.dtype.c_str(), tensor.name.c_str(), int(fileName.size()), fileName.data());
+        return EXIT_FAILURE;
+    }
+    else if (explicitElementType != ElementType::Undefined)
+    {
+        if (GetSizeOfTypeInBytes(explicitElementType) != GetSizeOfTypeInBytes(tensor.elementType)
+        ||  (tensor.blockQuantizedType != 0 && explicitElementType != tensor.elementType)
+        ||  isExplicitInt24 != tensor.isInt24)
+        {
+            const std::string_view explicitTypeName = isExplicitInt24 ? g_int24TypeName : GetTypeNameFromElementType(explicitElementType);
+            errorMessage = GetFormatted("Element type %.*s does not match dtype \"%s\" of file: \"%.*s\"", int(explicitTypeName.size()), explicitTypeName.data(), tensor.dtype.c_str(), int(fileName.size()), fileName.data());
+            return EXIT_FAILURE;
+        }
+        tensor.elementType = explicitElementType; // Reinterpret, like bfloat16 stored as uint16.
+    }
+    return EXIT_SUCCESS;
+}
+
+// file <filename> [tensor <name>] [rows <first> [count]] [columns <first> [count]] [channel <index>]
+//      [elementType] [byteOffset] [elementCount]
+// .npy, .safetensors, .gguf, .onnx, .wav, and image files default to the element type of their header, with
+// the offset relative to the data of the (selected) array. Rows, columns, and channels select a
+// region of a tensor in place instead of an offset and count.
+//
+// Reads the parameters following the file keyword, advancing past them, and maps the selected elements
+// as a file view (leaving its operand position to the caller).
+int ReadFileViewParameters(
+    /*inout*/ std::string_view& arguments,
+    std::string_view keywordName,
+    ElementType defaultElementType,
+    /*out*/ NumberFileView& fileView,
+    /*out*/ std::string& errorMessage
+)
+{
+    char const* end = arguments.data() + arguments.size();
+    auto advancePast = [&](std::string_view token)
+    {
+        char const* tokenEnd = token.data() + token.size();
+        arguments = std::string_view{tokenEnd, size_t(end - tokenEnd)};
+    };
+    auto isIntegerToken = [](std::string_view token)->bool
+    {
+        return !token.empty() && isdigit(token.front());
+    };
+
+    std::string_view fileNameWord = Tokenizer::GetWord(arguments);
+    advancePast(fileNameWord);
+    std::string fileName(Tokenizer::Unquote(fileNameWord));
+    if (fileName.empty())
+    {
+        errorMessage = GetFormatted("Expected a file name after \"%.*s\"", int(keywordName.size()), keywordName.data());
+        return EXIT_FAILURE;
+    }
+
+    std::string tensorName;
+    std::string_view token = Tokenizer::GetToken(arguments);
+    if (token == "tensor")
+    {
+        advancePast(token);
+        std::string_view tensorNameWord = Tokenizer::GetWord(arguments);
+        advancePast(tensorNameWord);
+        tensorName = Tokenizer::Unquote(tensorNameWord);
+        token = Tokenizer::GetToken(arguments);
+    }
+
+    // Selections of the first, middle, and last dimensions, as a first index and count.
+    constexpr std::string_view selectionNames[3] = {"rows", "columns", "channel"};
+    uint64_t selections[3][2] = {{0, UINT64_MAX}, {0, UINT64_MAX}, {0, UINT64_MAX}};
+    bool hasSelection = false;
+    for (size_t dimension; (dimension = std::find(std::begin(selectionNames), std::end(selectionNames), token) - std::begin(selectionNames)) < 3; )
+    {
+        advancePast(token);
+        token = Tokenizer::GetToken(arguments);
+        if (!isIntegerToken(token))
+        {
+            errorMessage = GetFormatted("Expected an index after \"%s\"", selectionNames[dimension].data());
+            return EXIT_FAILURE;
+        }
+        NumberUnionAndType number;
+        ParseNumber(token, ElementType::Uint64, /*parseAsRawData*/ false, /*out*/ number);
+        selections[dimension][0] = number.numberUnion.ui64;
+        advancePast(token);
+        token = Tokenizer::GetToken(arguments);
+        if (dimension == 2)
+        {
+            selections[dimension][1] = 1;
+        }
+        else if (isIntegerToken(token))
+        {
+            ParseNumber(token, ElementType::Uint64, /*parseAsRawData*/ false, /*out*/ number);
+            selections[dimension][1] = number.numberUnion.ui64;
+            advancePast(token);
+            token = Tokenizer::GetToken(arguments);
+        }
+        hasSelection = true;
+    }
+
+    ElementType fileElementType = ElementType::Undefined;
+    bool isFileInt24 = false;
+    const Keyword* typeKeyword = g_keywordHashTable.Find(token, g_keywords);
+    if (typeKeyword != nullptr && typeKeyword->type == KeywordType::ElementType)
+    {
+        fileElementType = ElementType(typeKeyword->value);
+        advancePast(token);
+        token = Tokenizer::GetToken(arguments);
+    }
+    else if (token == g_int24TypeName)
+    {
+        fileElementType = ElementType::Int32;
+        isFileInt24 = true;
+        advancePast(token);
+        token = Tokenizer::GetToken(arguments);
+    }
+
+    NumberUnionAndType byteOffset = {}, elementCount = {};
+    elementCount.numberUnion.ui64 = UINT64_MAX;
+    if (isIntegerToken(token) && !hasSelection)
+    {
+        ParseNumber(token, ElementType::Uint64, /*parseAsRawData*/ false, /*out*/ byteOffset);
+        advancePast(token);
+        token = Tokenizer::GetToken(arguments);
+        if (isIntegerToken(token))
+        {
+            ParseNumber(token, ElementType::Uint64, /*parseAsRawData*/ false, /*out*/ elementCount);
+            advancePast(token);
+        }
+    }
+
+    auto file = std::make_shared<MappedFile>();
+    if (!file->Open(fileName.c_str()))
+    {
+        errorMessage = GetFormatted("Could not read file: \"%s\"", fileName.c_str());
+        return EXIT_FAILURE;
+    }
+
+    FileTensor tensor;
+    if (SelectFileTensor(*file, fileName, tensorName, fileElementType, isFileInt24, defaultElementType, /*out*/ tensor, /*out*/ errorMessage) != EXIT_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+    fileElementType = tensor.elementType;
+    const uint64_t dataOffset = tensor.dataOffset;
+    const uint64_t dataByteSize = tensor.byteCount;
+
+    // Block quantized tensors are read in whole blocks, each decoding to several elements.
+    const uint32_t elementByteSize = tensor.isInt24 ? 3 : GetSizeOfTypeInBytes(fileElementType);
+    Gguf::TypeInfo blockInfo = {"", 1, elementByteSize};
+    if (tensor.blockQuantizedType != 0)
+    {
+        blockInfo = Gguf::GetTypeInfo(tensor.blockQuantizedType);
+        if (byteOffset.numberUnion.ui64 % blockInfo.blockByteSize != 0)
+        {
+            errorMessage = GetFormatted("Offset %llu is not a multiple of the %u byte blocks of file: \"%s\"", (unsigned long long)byteOffset.numberUnion.ui64, blockInfo.blockByteSize, fileName.c_str());
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!IsFileElementType(fileElementType))
+    {
+        errorMessage = GetFormatted("Expected a numeric element type for file: \"%s\"", fileName.c_str());
+        return EXIT_FAILURE;
+    }
+    if (byteOffset.numberUnion.ui64 > dataByteSize)
+    {
+        errorMessage = GetFormatted("Offset %llu is beyond the end of file: \"%s\"", (unsigned long long)byteOffset.numberUnion.ui64, fileName.c_str());
+        return EXIT_FAILURE;
+    }
+    file->AdviseSequential();
+
+    fileView = {};
+    fileView.data = file->data() + dataOffset + byteOffset.numberUnion.ui64;
+    fileView.elementCount = std::min<uint64_t>(elementCount.numberUnion.ui64, (dataByteSize - byteOffset.numberUnion.ui64) / blockInfo.blockByteSize * blockInfo.blockElementCount);
+    fileView.elementStride = 1;
+    fileView.rowElementCount = UINT64_MAX;
+    fileView.rowStride = UINT64_MAX;
+
+    // View the tensor as [rows, columns, channels], where the last dimension holds the channels
+    // (like the colors of a pixel or the samples of an audio frame) and any between are columns.
+    if (hasSelection)
+    {
+        const std::vector<uint64_t>& shape = tensor.shape;
+        if (shape.empty() || tensor.blockQuantizedType != 0 || tensor.isFortranOrder)
+        {
+            errorMessage = GetFormatted("Expected a row major tensor to select rows, columns, or a channel of file: \"%s\"", fileName.c_str());
+            return EXIT_FAILURE;
+        }
+        uint64_t dimensions[3] = {shape.front(), 1, (shape.size() >= 2) ? shape.back() : 1};
+        for (size_t i = 1; i + 1 < shape.size(); ++i)
+        {
+            dimensions[1] *= shape[i];
+        }
+        // Truncated files (like a partial capture) have fewer whole rows than their header claims.
+        const uint64_t rowByteSize = dimensions[1] * dimensions[2] * elementByteSize;
+        dimensions[0] = std::min(dimensions[0], rowByteSize > 0 ? dataByteSize / rowByteSize : 0);
+
+        for (size_t i = 0; i < 3; ++i)
+        {
+            if (selections[i][0] >= dimensions[i])
+            {
+                errorMessage = GetFormatted("Index %llu is beyond the %llu %s of file: \"%s\"", (unsigned long long)selections[i][0], (unsigned long long)dimensions[i], i == 2 ? "channels" : selectionNames[i].data(), fileName.c_str());
+                return EXIT_FAILURE;
+            }
+            selections[i][1] = std::min(selections[i][1], dimensions[i] - selections[i][0]);
+        }
+
+        const bool isOneChannel = (selections[2][1] < dimensions[2]);
+        fileView.data = file->data() + dataOffset + ((selections[0][0] * dimensions[1] + selections[1][0]) * dimensions[2] + selections[2][0]) * elementByteSize;
+        fileView.elementStride = isOneChannel ? dimensions[2] : 1;
+        fileView.rowElementCount = isOneChannel ? selections[1][1] : selections[1][1] * dimensions[2];
+        fileView.rowStride = dimensions[1] * dimensions[2];
+        fileView.elementCount = selections[0][1] * fileView.rowElementCount;
+    }
+
+    fileView.elementType = fileElementType;
+    fileView.blockQuantizedType = tensor.blockQuantizedType;
+    fileView.isInt24 = tensor.isInt24;
+    fileView.isBigEndian = tensor.isBigEndian;
+    fileView.storage = std::move(file);
+    return EXIT_SUCCESS;
+}
+
+// <fileA> [tensor <name>] ... <fileB> [tensor <name>] ... [elementType] [byteOffset] [elementCount]
+//
+// Reads the parameters of two files to compare elementwise. A headerless first file without its own
+// element type takes the second's, so "a.bin b.bin float16" reads both as float16. The views must
+// have the same element type (after dequantizing any block quantized tensor to float32) and count.
+int ReadFileViewPairParameters(
+    /*inout*/ std::string_view& arguments,
+    std::string_view keywordName,
+    /*out*/ NumberFileView& fileViewA,
+    /*out*/ NumberFileView& fileViewB,
+    /*out*/ std::string& errorMessage
+)
+{
+    // Find where the first file's parameters end, trying a placeholder type if it has none of its own.
+    std::string_view remainingArguments = arguments;
+    std::string untypedErrorMessage;
+    const bool isFirstTyped = ReadFileViewParameters(/*inout*/ remainingArguments, keywordName, ElementType::Undefined, /*out*/ fileViewA, /*out*/ untypedErrorMessage) == EXIT_SUCCESS;
+    if (!isFirstTyped)
+    {
+        remainingArguments = arguments;
+        if (ReadFileViewParameters(/*inout*/ remainingArguments, keywordName, ElementType::Uint8, /*out*/ fileViewA, /*out*/ errorMessage) != EXIT_SUCCESS)
+        {
+            return EXIT_FAILURE;
+        }
+    }
+    if (ReadFileViewParameters(/*inout*/ remainingArguments, keywordName, isFirstTyped ? fileViewA.elementType : ElementType::Undefined, /*out*/ fileViewB, /*out*/ errorMessage) != EXIT_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+    if (!isFirstTyped)
+    {
+        std::string_view firstArguments = arguments;
+        if (ReadFileViewParameters(/*inout*/ firstArguments, keywordName, fileViewB.elementType, /*out*/ fileViewA, /*out*/ errorMessage) != EXIT_SUCCESS)
+        {
+            return EXIT_FAILURE;
+        }
+    }
+    arguments = remainingArguments;
+
+    for (NumberFileView* fileView : {&fileViewA, &fileViewB})
+    {
+        if (fileView->blockQuantizedType != 0)
+        {
+            fileView->elementType = ElementType::Float32; // Use the dequantized values.
+        }
+    }
+    if (fileViewA.elementType != fileViewB.elementType)
+    {
+        const std::string_view typeNameA = GetTypeNameFromElementType(fileViewA.elementType), typeNameB = GetTypeNameFromElementType(fileViewB.elementType);
+        errorMessage = GetFormatted("Expected files of the same element type, not %.*s and %.*s", int(typeNameA.size()), typeNameA.data(), int(typeNameB.size()), typeNameB.data());
+        return EXIT_FAILURE;
+    }
+    if (fileViewA.elementCount != fileViewB.elementCount)
+    {
+        errorMessage = GetFormatted("Expected files of the same element count, not %llu and %llu", static_cast<unsigned long long>(fileViewA.elementCount), static_cast<unsigned long long>(fileViewB.elementCount));
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+// Returns a view of every element of a tensor of a mapped file, where block quantized tensors are
+// read as their float32 elements.
+NumberFileView MakeTensorFileView(const std::shared_ptr<MappedFile>& file, const FileTensor& tensor)
+{
+    Gguf::TypeInfo blockInfo = {"", 1, tensor.isInt24 ? 3 : GetSizeOfTypeInBytes(tensor.elementType)};
+    if (tensor.blockQuantizedType != 0)
+    {
+        blockInfo = Gguf::GetTypeInfo(tensor.blockQuantizedType);
+    }
+    NumberFileView fileView = {};
+    fileView.storage = file;
+    fileView.data = file->data() + tensor.dataOffset;
+    fileView.elementCount = tensor.byteCount / blockInfo.blockByteSize * blockInfo.blockElementCount;
+    fileView.elementType = tensor.elementType;
+    fileView.blockQuantizedType = tensor.blockQuantizedType;
+    fileView.isInt24 = tensor.isInt24;
+    fileView.isBigEndian = tensor.isBigEndian;
+    fileView.elementStride = 1;
+    fileView.rowElementCount = UINT64_MAX;
+    fileView.rowStride = UINT64_MAX;
+    return fileView;
+}
+
+int ParseOperations(
+    std::string_view operationString,
+    _Out_ std::vector<NumericOperationAndRange>& operations,
+    _Out_ std::vector<NumberUnionAndType>& numbers,
+    _Out_ std::vector<NumberFileView>& fileViews,
+    /*out*/ std::string& errorMessage
+)
+{
+    NumberUnionAndType numberUnionAndType;
+    bool parseAsRawData = false;
+    ElementType preferredElementType = ElementType::Undefined;
+    NumericPrintingFlags numericPrintingFlags = NumericPrintingFlags::Default;
+    bool isWithinParentheses = false;
+
+    operations.clear();
+    numbers.clear();
+    fileViews.clear();
+    char const* end = operationString.data() + operationString.size();
+
+    auto isNumberToken = [](std::string_view token)->bool
+    {
+        return (!token.empty() && isdigit(token.front()))
+            || (token.size() >= 2 && token.front() == '-' && isdigit(token[1]));
+    };
+
+    while (!operationString.empty())
+    {
+        std::string_view param = Tokenizer::GetToken(operationString);
+        if (param.empty())
+        {
+            break; // Only trailing spaces remained.
+        }
+        char const* paramEnd = param.data() + param.size();
+        operationString = std::string_view{paramEnd, size_t(end - paramEnd)};
+
+        NumericOperationAndRange numericOperationAndRange = {};
+
+        // Check if ordinary number or operator.
+        if (isNumberToken(param))
+        {
+            // Find the whole run of numbers (and commas), up to the next keyword.
+            size_t runNumberCount = 0;
+            char const* runEnd = param.data();
+            for (std::string_view runString{param.data(), size_t(end - param.data())}; /*below*/; /*below*/)
+            {
+                std::string_view token = Tokenizer::GetToken(runString);
+                if (!isNumberToken(token) && token != ",")
+                {
+                    break;
+                }
+                runNumberCount += (token != ",");
+                runEnd = token.data() + token.size();
+                runString = std::string_view{runEnd, size_t(end - runEnd)};
+            }
+            std::string_view runText{param.data(), size_t(runEnd - param.data())};
+            operationString = std::string_view{runEnd, size_t(end - runEnd)};
+
+            // Long runs of numbers (like a command file of millions of operands) are not parsed up
+            // front, but viewed like a file and parsed as streamed, so they need no memory per number.
+            if (runNumberCount >= g_operandChunkSize)
+            {
+                NumberFileView fileView = {};
+                fileView.elementCount = runNumberCount;
+                fileView.elementType = preferredElementType;
+                fileView.printingFlags = numericPrintingFlags;
+                fileView.numberIndex = numbers.size();
+                fileView.operationIndex = operations.size();
+                fileView.text = runText;
+                fileView.textElementType = preferredElementType;
+                fileView.parseAsRawData = parseAsRawData;
+
+                // Without a type, each number's type is deduced, and operations promote to the widest.
+                if (preferredElementType == ElementType::Undefined)
+                {
+                    size_t textOffset = 0;
+                    for (uint64_t i = 0; i < fileView.elementCount; ++i)
+                    {
+                        ParseNumberTextView(fileView, /*inout*/ textOffset, /*out*/ Span<NumberUnionAndType>(&numberUnionAndType, 1));
+                        if (g_elementTypePriorityTable[size_t(numberUnionAndType.elementType)] > g_elementTypePriorityTable[size_t(fileView.elementType)])
+                        {
+                            fileView.elementType = numberUnionAndType.elementType;
+                        }
+                    }
+                }
+                fileViews.push_back(std::move(fileView));
+            }
+            else
+            {
+                for (std::string_view token; !(token = Tokenizer::GetToken(runText)).empty(); /*below*/)
+                {
+                    char const* tokenEnd = token.data() + token.size();
+                    runText = std::string_view{tokenEnd, size_t(runEnd - tokenEnd)};
+                    if (token != ",")
+                    {
+                        ParseNumber(token, preferredElementType, parseAsRawData, /*out*/ numberUnionAndType);
+                        numberUnionAndType.printingFlags = numericPrintingFlags;
+                        numbers.push_back(numberUnionAndType);
+                    }
+                }
+            }
+        }
+        else
+        {
+            const Keyword* keyword = g_keywordHashTable.Find(param, g_keywords);
+            if (keyword == nullptr)
+            {
+                errorMessage = GetFormatted("Unknown parameter: \"%.*s\"", int(param.size()), param.data());
+                return EXIT_FAILURE;
+            }
+
+            switch (keyword->type)
+            {
+            case KeywordType::Command:
+                errorMessage = GetFormatted("\"%.*s\" must be the first parameter", int(param.size()), param.data());
+                return EXIT_FAILURE;
+
+            case KeywordType::NumericOperation:
+                numericOperationAndRange.numericOperationType = NumericOperationType(keyword->value);
+                break;
+
+            case KeywordType::ElementType:
+                preferredElementType = ElementType(keyword->value);
+                break;
+
+            case KeywordType::PrintingFlags:
+                numericPrintingFlags = SetFlags(numericPrintingFlags, NumericPrintingFlags(keyword->mask), NumericPrintingFlags(keyword->value));
+                break;
+
+            case KeywordType::ParseAsRawData:
+                parseAsRawData = bool(keyword->value);
+                break;
+
+            case KeywordType::TextFile:
+                {
+                    std::string_view fileNameWord = Tokenizer::GetWord(operationString);
+                    char const* fileNameWordEnd = fileNameWord.data() + fileNameWord.size();
+                    operationString = std::string_view{fileNameWordEnd, size_t(end - fileNameWordEnd)};
+
+                    std::string fileName(Tokenizer::Unquote(fileNameWord));
+                    if (fileName.empty())
+                    {
+                        errorMessage = GetFormatted("Expected a file name after \"%.*s\"", int(param.size()), param.data());
+                        return EXIT_FAILURE;
+                    }
+
+                    MappedFile textFile;
+                    if (!textFile.Open(fileName.c_str()))
+                    {
+                        errorMessage = GetFormatted("Could not read text file: \"%s\"", fileName.c_str());
+                        return EXIT_FAILURE;
+                    }
+                    NumberFileView fileView = ParseNumberList(textFile.GetStringView(), preferredElementType, parseAsRawData, numericPrintingFlags);
+                    fileView.numberIndex = numbers.size();
+                    fileView.operationIndex = operations.size();
+                    fileViews.push_back(std::move(fileView));
+                }
+                break;
+
+            case KeywordType::File:
+                {
+                    NumberFileView fileView;
+                    if (ReadFileViewParameters(/*inout*/ operationString, param, preferredElementType, /*out*/ fileView, /*out*/ errorMessage) != EXIT_SUCCESS)
+                    {
+                        return EXIT_FAILURE;
+                    }
+                    fileView.printingFlags = numericPrintingFlags;
+                    fileView.numberIndex = numbers.size();
+                    fileView.operationIndex = operations.size();
+                    fileViews.push_back(std::move(fileView));
+                }
+                break;
+
+            case KeywordType::OpenParenthesis:
+                if (isWithinParentheses)
+                {
+                    errorMessage = GetFormatted("Nested parentheses not supported");
+                    return EXIT_FAILURE;
+                }
+                isWithinParentheses = true;
+                break;
+
+            case KeywordType::CloseParenthesis:
+                if (!isWithinParentheses)
+                {
+                    errorMessage = GetFormatted("Closing parenthesis without opening parenthesis");
+                    return EXIT_FAILURE;
+                }
+                isWithinParentheses = false;
+                break;
+
+            case KeywordType::Comma:
+                // Ignore commas.
+                break;
+            }
+        }
+
+        // Append any new numeric operations.
+        if (numericOperationAndRange.numericOperationType != NumericOperationType::None)
+        {
+            if (isWithinParentheses)
+            {
+                errorMessage = GetFormatted("Operations are not supported inside parentheses");
+            }
+
+            const size_t numberCount = numbers.size();
+            if (!operations.empty())
+            {
+                operations.back().range.end = numberCount;
+            }
+            numericOperationAndRange.range.begin = numberCount;
+            numericOperationAndRange.range.end = numberCount;
+            numericOperationAndRange.outputElementType = preferredElementType;
+            operations.push_back(numericOperationAndRange);
+        }
+    }
+
+    if (isWithinParentheses)
+    {
+        errorMessage = GetFormatted("Unclosed parentheses");
+        return EXIT_FAILURE;
+    }
+
+    const size_t numberCount = numbers.size();
+    if (!operations.empty())
+    {
+        operations.back().range.end = numberCount;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// File commands.
+
+// Returns the next token, advancing past it.
+std::string_view ReadToken(/*inout*/ std::string_view& s)
+{
+    std::string_view token = Tokenizer::GetToken(s);
+    s.remove_prefix(token.data() + token.size() - s.data());
+    return token;
+}
+
+// Returns the next space delimited word (like a file name), advancing past it.
+std::string_view ReadWord(/*inout*/ std::string_view& s)
+{
+    std::string_view word = Tokenizer::GetWord(s);
+    s.remove_prefix(word.data() + word.size() - s.data());
+    return word;
+}
+
+// Appends one row of a dump, showing the raw bytes and their interpretation as each element type.
+// e.g.
+//
+//          00000000: 00 3E 00 C0 00 34 FF 7B  00 3C 00 00 00 00 00 00  |.>...4.{.<......|
+//           float16: 1.5 -2 0.25 65504 1 0 0 0
+void AppendDumpRow(
+    /*inout*/ std::string& output,
+    const uint8_t* rowData,
+    size_t rowByteCount,
+    size_t fullRowByteCount, // Only the last row may be partial.
+    uint64_t rowOffset,
+    Span<const ElementType> elementTypes,
+    NumericPrintingFlags numericPrintingFlags
+)
+{
+    constexpr char hexDigits[] = "0123456789ABCDEF";
+
+    AppendFormatted(/*inout*/ output, "    %08llX:", static_cast<unsigned long long>(rowOffset));
+    for (size_t i = 0; i < fullRowByteCount; ++i)
+    {
+        if (i > 0 && i % 8 == 0)
+        {
+            output.push_back(' ');
+        }
+        if (i < rowByteCount)
+        {
+            const char hexPair[3] = {' ', hexDigits[rowData[i] >> 4], hexDigits[rowData[i] & 15]};
+            output.append(hexPair, 3);
+        }
+        else
+        {
+            output.append("   ");
+        }
+    }
+
+    output.append("  |");
+    for (size_t i = 0; i < rowByteCount; ++i)
+    {
+        const char ch = static_cast<char>(rowData[i]);
+        output.push_back((ch >= 0x20 && ch < 0x7F) ? ch : '.');
+    }
+    output.append("|\n");
+
+    for (ElementType elementType : elementTypes)
+    {
+        const uint32_t elementByteSize = GetSizeOfTypeInBytes(elementType);
+        AppendFormatted(/*inout*/ output, "%12s:", GetTypeNameFromElementType(elementType).data());
+        for (size_t i = 0; i + elementByteSize <= rowByteCount; i += elementByteSize)
+        {
+            NumberUnion value;
+            memcpy(value.buffer, rowData + i, elementByteSize);
+            output.push_back(' ');
+            AppendFormattedNumericValue(/*inout*/ output, elementType, &value, "", "", numericPrintingFlags);
+        }
+        output.push_back('\n');
+    }
+}
+
+// dump <filename> [tensor <name>] [type...] [byteoffset] [bytecount]
+//
+// Shows the bytes of a binary file like xxd, along with their values as each of the given types.
+// Blocks of rows are formatted in parallel into separate buffers, which are emitted in order.
+// A tensor of a model or array file limits the range to its data, shown as its type by default (or as
+// bytes for block quantized types).
+int DumpFile(std::string_view arguments, /*out*/ std::string& stringOutput)
+{
+    std::string fileName(Tokenizer::Unquote(ReadWord(/*inout*/ arguments)));
+    if (fileName.empty())
+    {
+        stringOutput = GetFormatted("Expected a file name after \"dump\"");
+        return EXIT_FAILURE;
+    }
+
+    std::vector<ElementType> elementTypes;
+    NumericPrintingFlags numericPrintingFlags = NumericPrintingFlags::ShowNumericValue;
+    uint64_t byteRange[2] = {0, UINT64_MAX}; // Offset and count.
+    size_t byteRangeIndex = 0;
+    std::string tensorName;
+
+    for (std::string_view token; !(token = ReadToken(/*inout*/ arguments)).empty(); )
+    {
+        const Keyword* keyword = g_keywordHashTable.Find(token, g_keywords);
+        if (token == "tensor" && tensorName.empty())
+        {
+            tensorName = Tokenizer::Unquote(ReadWord(/*inout*/ arguments));
+            if (tensorName.empty())
+            {
+                stringOutput = GetFormatted("Expected a tensor name after \"tensor\"");
+                return EXIT_FAILURE;
+            }
+        }
+        else if (isdigit(token.front()) && byteRangeIndex < std::size(byteRange))
+        {
+            NumberUnionAndType number;
+            ParseNumber(token, ElementType::Uint64, /*parseAsRawData*/ false, /*out*/ number);
+            byteRange[byteRangeIndex++] = number.numberUnion.ui64;
+        }
+        else if (keyword != nullptr && keyword->type == KeywordType::ElementType && IsFileElementType(ElementType(keyword->value)))
+        {
+            elementTypes.push_back(ElementType(keyword->value));
+        }
+        else if (keyword != nullptr && keyword->type == KeywordType::PrintingFlags)
+        {
+            numericPrintingFlags = SetFlags(numericPrintingFlags, NumericPrintingFlags(keyword->mask), NumericPrintingFlags(keyword->value));
+        }
+        else
+        {
+            stringOutput = GetFormatted("Unknown parameter: \"%.*s\"", int(token.size()), token.data());
+            return EXIT_FAILURE;
+        }
+    }
+
+    MappedFile file;
+    if (!file.Open(fileName.c_str()))
+    {
+        stringOutput = GetFormatted("Could not read file: \"%s\"", fileName.c_str());
+        return EXIT_FAILURE;
+    }
+
+    uint64_t dataOffset = 0, dataByteCount = file.size();
+    if (!tensorName.empty())
+    {
+        FileTensor tensor;
+        if (SelectFileTensor(file, fileName, tensorName, ElementType::Undefined, /*isExplicitInt24*/ false, ElementType::Undefined, /*out*/ tensor, /*out*/ stringOutput) != EXIT_SUCCESS)
+        {
+            return EXIT_FAILURE;
+        }
+        if (elementTypes.empty())
+        {
+            elementTypes.push_back((tensor.blockQuantizedType != 0 || tensor.isInt24 || tensor.isBigEndian) ? ElementType::Uint8 : tensor.elementType);
+        }
+        dataOffset = tensor.dataOffset;
+        dataByteCount = tensor.byteCount;
+    }
+
+    if (byteRange[0] > dataByteCount)
+    {
+        stringOutput = GetFormatted("Offset %llu is beyond the end of file: \"%s\"", static_cast<unsigned long long>(byteRange[0]), fileName.c_str());
+        return EXIT_FAILURE;
+    }
+    file.AdviseSequential();
+
+    byteRange[0] += dataOffset; // Rows show file offsets.
+    const uint8_t* data = file.data() + byteRange[0];
+    const size_t byteCount = size_t(std::min<uint64_t>(byteRange[1], dataByteCount - (byteRange[0] - dataOffset)));
+
+    // Rows hold a whole number of elements of every type (e.g. 24 bytes for fixed12_12 and float16).
+    size_t rowByteCount = 1;
+    for (ElementType elementType : elementTypes)
+    {
+        rowByteCount = std::lcm(rowByteCount, size_t(GetSizeOfTypeInBytes(elementType)));
+    }
+    constexpr size_t minimumRowByteCount = 16;
+    rowByteCount *= (minimumRowByteCount + rowByteCount - 1) / rowByteCount;
+
+    // Format batches of blocks in parallel, keeping only one batch of output in memory at a time.
+    constexpr size_t rowsPerBlock = 1024;
+    const size_t rowCount = (byteCount + rowByteCount - 1) / rowByteCount;
+    const size_t blockCount = (rowCount + rowsPerBlock - 1) / rowsPerBlock;
+    const size_t blocksPerBatch = size_t(GetParallelThreadCount()) * 4;
+    std::vector<std::string> blockOutputs(blocksPerBatch);
+
+    for (size_t batchBlockBegin = 0; batchBlockBegin < blockCount; batchBlockBegin += blocksPerBatch)
+    {
+        const size_t batchBlockCount = std::min(blocksPerBatch, blockCount - batchBlockBegin);
+        ParallelFor(batchBlockCount, [&](size_t batchBlockIndex)
+        {
+            std::string& blockOutput = blockOutputs[batchBlockIndex];
+            blockOutput.clear();
+
+            const size_t rowBegin = (batchBlockBegin + batchBlockIndex) * rowsPerBlock;
+            const size_t rowEnd = std::min(rowBegin + rowsPerBlock, rowCount);
+            for (size_t row = rowBegin; row < rowEnd; ++row)
+            {
+                const size_t rowOffset = row * rowByteCount;
+                AppendDumpRow(
+                    /*inout*/ blockOutput,
+                    data + rowOffset,
+                    std::min(rowByteCount, byteCount - rowOffset),
+                    rowByteCount,
+                    byteRange[0] + rowOffset,
+                    MakeSpan(elementTypes),
+                    numericPrintingFlags
+                );
+            }
+        });
+
+        for (size_t i = 0; i < batchBlockCount; ++i)
+        {
+            stringOutput.append(blockOutputs[i]);
+            FlushOutputIfLarge(/*inout*/ stringOutput);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+// Reads the file type keyword following a file name, for commands taking typed files.
+const Keyword* ReadFileElementType(/*inout*/ std::string_view& arguments)
+{
+    std::string_view token = ReadToken(/*inout*/ arguments);
+    const Keyword* keyword = g_keywordHashTable.Find(token, g_keywords);
+    if (keyword == nullptr || keyword->type != KeywordType::ElementType || !IsFileElementType(ElementType(keyword->value)))
+    {
+        return nullptr;
+    }
+    return keyword;
+}
+
+// convert <model.safetensors> <output.safetensors> <type>
+//
+// Converts every floating point tensor of a safetensors model to the given type, copying other tensors
+// unchanged and keeping the metadata. Tensors are split into slices, and each batch of slices (across
+// however many tensors fill one output buffer) is converted in parallel, idle threads stealing slices
+// from busy ones. The input is read through its memory map, so a scan runs at page cache bandwidth.
+int ConvertSafetensorsFile(
+    /*inout*/ MappedFile& inputFile,
+    const std::string& inputFileName,
+    const std::string& outputFileName,
+    ElementType outputElementType,
+    /*out*/ std::string& stringOutput
+)
+{
+    const std::string_view outputDtype = GetSafetensorsDtypeFromElementType(outputElementType);
+    if (outputDtype.empty())
+    {
+        stringOutput = GetFormatted("Element type %s has no safetensors dtype", GetTypeNameFromElementType(outputElementType).data());
+        return EXIT_FAILURE;
+    }
+    Safetensors::Header header;
+    if (!Safetensors::ParseHeader(inputFile.data(), inputFile.size(), /*out*/ header))
+    {
+        stringOutput = GetFormatted("Could not parse the safetensors header of file: \"%s\"", inputFileName.c_str());
+        return EXIT_FAILURE;
+    }
+    inputFile.AdviseSequential();
+
+    // Plan each tensor, laying out the output tensors contiguously in input order.
+    struct TensorConversion
+    {
+        ElementType inputElementType;
+        ElementType outputElementType;
+        uint64_t elementCount;
+        const uint8_t* input;
+    };
+    std::vector<TensorConversion> conversions;
+    std::vector<Safetensors::TensorInfo>& outputTensors = header.tensors;
+    uint64_t outputDataByteCount = 0, convertedElementCount = 0;
+    size_t convertedTensorCount = 0;
+    for (auto& tensor : outputTensors)
+    {
+        const ElementType inputElementType = GetElementTypeFromSafetensorsDtype(tensor.dtype);
+        const uint64_t inputByteCount = tensor.dataEnd - tensor.dataBegin;
+        TensorConversion conversion = {ElementType::Uint8, ElementType::Uint8, inputByteCount, inputFile.data() + header.dataOffset + tensor.dataBegin};
+        if (IsFractionalElementType(inputElementType))
+        {
+            conversion.inputElementType = inputElementType;
+            conversion.outputElementType = outputElementType;
+            conversion.elementCount = inputByteCount / GetSizeOfTypeInBytes(inputElementType);
+            tensor.dtype = outputDtype;
+            convertedElementCount += conversion.elementCount;
+            ++convertedTensorCount;
+        }
+        tensor.dataBegin = outputDataByteCount;
+        outputDataByteCount += conversion.elementCount * GetSizeOfTypeInBytes(conversion.outputElementType);
+        tensor.dataEnd = outputDataByteCount;
+        conversions.push_back(conversion);
+    }
+
+    // Every write goes through the cache, since tensor sizes rarely keep batches aligned for direct I/O.
+    constexpr size_t bufferByteSize = size_t(1) << 24;
+    constexpr size_t sliceElementCount = g_operandChunkSize;
+    FileIo::Writer outputFile;
+    if (!outputFile.Open(outputFileName.c_str(), {bufferByteSize, 4, /*useDirectIo*/ false}))
+    {
+        stringOutput = GetFormatted("Could not write file: \"%s\"", outputFileName.c_str());
+        return EXIT_FAILURE;
+    }
+    const std::string outputHeader = Safetensors::MakeHeader(outputTensors, header.metadata);
+    for (size_t offset = 0; offset < outputHeader.size(); offset += bufferByteSize)
+    {
+        const size_t byteCount = std::min(bufferByteSize, outputHeader.size() - offset);
+        memcpy(outputFile.GetBuffer(), outputHeader.data() + offset, byteCount);
+        outputFile.Write(byteCount);
+    }
+
+    struct TensorSlice
+    {
+        size_t tensorIndex;
+        uint64_t elementBegin;
+        size_t elementCount;
+        size_t outputOffset; // Within the batch
+    };
+    std::vector<TensorSlice> slices;
+    size_t tensorIndex = 0;
+    uint64_t elementBegin = 0;
+    while (tensorIndex < conversions.size())
+    {
+        // Gather slices until the output buffer is full.
+        slices.clear();
+        size_t batchByteCount = 0;
+        for (; tensorIndex < conversions.size(); ++tensorIndex, elementBegin = 0)
+        {
+            const TensorConversion& conversion = conversions[tensorIndex];
+            const size_t outputElementByteSize = GetSizeOfTypeInBytes(conversion.outputElementType);
+            while (elementBegin < conversion.elementCount)
+            {
+                const size_t elementCount = size_t(std::min<uint64_t>(sliceElementCount, conversion.elementCount - elementBegin));
+                if (batchByteCount + elementCount * outputElementByteSize > bufferByteSize)
+                {
+                    break;
+                }
+                slices.push_back({tensorIndex, elementBegin, elementCount, batchByteCount});
+                batchByteCount += elementCount * outputElementByteSize;
+                elementBegin += elementCount;
+            }
+            if (elementBegin < conversion.elementCount)
+            {
+                break; // Continue this tensor in the next batch.
+            }
+        }
+        if (slices.empty())
+        {
+            continue;
+        }
+
+        uint8_t* output = outputFile.GetBuffer();
+        ParallelFor(slices.size(), [&](size_t sliceIndex)
+        {
+            const TensorSlice& slice = slices[sliceIndex];
+            const TensorConversion& conversion = conversions[slice.tensorIndex];
+            CastElementTypes(
+                conversion.inputElementType,
+                conversion.outputElementType,
+                conversion.input + slice.elementBegin * GetSizeOfTypeInBytes(conversion.inputElementType),
+                /*out*/ output + slice.outputOffset,
+                slice.elementCount
+            );
+        });
+        outputFile.Write(batchByteCount);
+    }
+
+    if (!outputFile.Close())
+    {
+        stringOutput = GetFormatted("Could not write file: \"%s\"", outputFileName.c_str());
+        return EXIT_FAILURE;
+    }
+
+    AppendFormatted(
+        /*inout*/ stringOutput,
+        "Converted %llu elements in %zu tensors to %s, copying %zu other tensors\n",
+        static_cast<unsigned long long>(convertedElementCount),
+        convertedTensorCount,
+        GetTypeNameFromElementType(outputElementType).data(),
+        conversions.size() - convertedTensorCount
+    );
+    return EXIT_SUCCESS;
+}
+
+// convert <input filename> [tensor <name>] [input type] <output filename> <output type> [direct]
+//
+// Converts a raw binary file of one element type to another, in fixed size chunks so memory stays
+// constant for any file size. Several chunk reads and writes stay in flight (via io_uring where
+// available) while the current chunk is converted. "direct" bypasses the OS file cache.
+//
+// .npy, .safetensors, .gguf, .onnx, .wav, and image input files may omit the input type, taking it
+// from the header (swapping any big-endian data), and .npy and .wav output files are written with a header (keeping the input shape, or the
+// channels and sample rate, if it had them). A whole .safetensors model without a tensor name is
+// converted by ConvertSafetensorsFile. Block quantized GGUF tensors are dequantized slice by slice,
+// so only a chunk is ever expanded. Either file may be int24, packed 24-bit integers like 24-bit PCM,
+// which are unpacked to int32 and packed back (truncating) via SIMD shuffles. Values are never scaled.
+int ConvertFile(std::string_view arguments, /*out*/ std::string& stringOutput)
+{
+    ElementType elementTypes[2] = {};
+    bool isInt24[2] = {};
+    std::string fileNames[2];
+    std::string tensorName;
+    for (size_t i = 0; i < 2; ++i)
+    {
+        fileNames[i] = Tokenizer::Unquote(ReadWord(/*inout*/ arguments));
+        if (fileNames[i].empty())
+        {
+            stringOutput = GetFormatted("Expected a file name after \"convert\"");
+            return EXIT_FAILURE;
+        }
+        std::string_view remainingArguments = arguments;
+        if (i == 0 && ReadToken(/*inout*/ arguments) == "tensor")
+        {
+            tensorName = Tokenizer::Unquote(ReadWord(/*inout*/ arguments));
+            remainingArguments = arguments;
+        }
+        arguments = remainingArguments;
+        const Keyword* keyword = ReadFileElementType(/*inout*/ arguments);
+        if (keyword != nullptr)
+        {
+            elementTypes[i] = ElementType(keyword->value);
+        }
+        else
+        {
+            arguments = remainingArguments;
+            if (ReadToken(/*inout*/ arguments) == g_int24TypeName)
+            {
+                elementTypes[i] = ElementType::Int32;
+                isInt24[i] = true;
+            }
+            else
+            {
+                arguments = remainingArguments; // Not a type, so leave it for the next file name.
+            }
+        }
+    }
+
+    // Read the input header, if any, for the element type and data range.
+    FileTensor inputTensor;
+    uint16_t channelCount = 1;
+    uint32_t sampleRate = 48000; // Only for .wav output from other formats.
+    {
+        MappedFile inputHeaderFile;
+        if (!inputHeaderFile.Open(fileNames[0].c_str()))
+        {
+            stringOutput = GetFormatted("Could not read file: \"%s\"", fileNames[0].c_str());
+            return EXIT_FAILURE;
+        }
+        if (tensorName.empty() && Safetensors::IsSafetensors(inputHeaderFile.data(), inputHeaderFile.size()))
+        {
+            if (elementTypes[0] != ElementType::Undefined)
+            {
+                stringOutput = GetFormatted("Expected a tensor name for input type %s of file: \"%s\"", GetTypeNameFromElementType(elementTypes[0]).data(), fileNames[0].c_str());
+                return EXIT_FAILURE;
+            }
+            if (elementTypes[1] == ElementType::Undefined)
+            {
+                stringOutput = GetFormatted("Expected a numeric element type for file: \"%s\"", fileNames[1].c_str());
+                return EXIT_FAILURE;
+            }
+            return ConvertSafetensorsFile(/*inout*/ inputHeaderFile, fileNames[0], fileNames[1], elementTypes[1], /*out*/ stringOutput);
+        }
+        if (SelectFileTensor(inputHeaderFile, fileNames[0], tensorName, elementTypes[0], isInt24[0], ElementType::Undefined, /*out*/ inputTensor, /*out*/ stringOutput) != EXIT_SUCCESS)
+        {
+            return EXIT_FAILURE;
+        }
+        elementTypes[0] = inputTensor.elementType;
+        isInt24[0] = inputTensor.isInt24;
+        Wav::Header wavHeader;
+        if (Wav::ParseHeader(inputHeaderFile.data(), inputHeaderFile.size(), /*out*/ wavHeader))
+        {
+            channelCount = wavHeader.channelCount;
+            sampleRate = wavHeader.sampleRate;
+        }
+    }
+    const uint64_t inputDataOffset = inputTensor.dataOffset;
+    const uint64_t inputDataByteCount = inputTensor.byteCount;
+    for (size_t i = 0; i < 2; ++i)
+    {
+        if (elementTypes[i] == ElementType::Undefined)
+        {
+            stringOutput = GetFormatted("Expected a numeric element type for file: \"%s\"", fileNames[i].c_str());
+            return EXIT_FAILURE;
+        }
+    }
+
+    bool useDirectIo = false;
+    for (std::string_view token; !(token = ReadToken(/*inout*/ arguments)).empty(); )
+    {
+        if (token == "direct")
+        {
+            useDirectIo = true;
+        }
+        else
+        {
+            stringOutput = GetFormatted("Unknown parameter: \"%.*s\"", int(token.size()), token.data());
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Chunks of 2^20 elements are whole multiples of the direct I/O alignment for every type size.
+    constexpr size_t chunkElementCount = size_t(1) << 20;
+    constexpr size_t sliceElementCount = g_operandChunkSize; // Per thread within a chunk.
+    const size_t inputElementByteSize = isInt24[0] ? 3 : GetSizeOfTypeInBytes(elementTypes[0]);
+    const size_t outputElementByteSize = isInt24[1] ? 3 : GetSizeOfTypeInBytes(elementTypes[1]);
+    const uint32_t blockQuantizedType = inputTensor.blockQuantizedType;
+    Gguf::TypeInfo inputBlockInfo = {"", 1, uint32_t(inputElementByteSize)};
+    if (blockQuantizedType != 0)
+    {
+        inputBlockInfo = Gguf::GetTypeInfo(blockQuantizedType);
+    }
+    static_assert(sliceElementCount % Gguf::maximumBlockElementCount == 0);
+
+    // Quantized blocks rarely fill whole pages, so those inputs are read through the cache.
+    FileIo::Reader inputFile;
+    const size_t inputChunkByteSize = chunkElementCount / inputBlockInfo.blockElementCount * inputBlockInfo.blockByteSize;
+    if (!inputFile.Open(fileNames[0].c_str(), {inputChunkByteSize, 4, useDirectIo && blockQuantizedType == 0}, inputDataOffset, inputDataByteCount))
+    {
+        stringOutput = GetFormatted("Could not read file: \"%s\"", fileNames[0].c_str());
+        return EXIT_FAILURE;
+    }
+    FileIo::Writer outputFile;
+    if (!outputFile.Open(fileNames[1].c_str(), {chunkElementCount * outputElementByteSize, 4, useDirectIo}))
+    {
+        stringOutput = GetFormatted("Could not write file: \"%s\"", fileNames[1].c_str());
+        return EXIT_FAILURE;
+    }
+
+    // Write the .npy or .wav header as its own chunk, padded so the data chunks stay aligned for direct I/O.
+    const std::string_view outputFileName = fileNames[1];
+    const std::string_view outputExtension = outputFileName.substr(std::min(outputFileName.size(), outputFileName.find_last_of('.')));
+    const std::string_view outputTypeName = isInt24[1] ? g_int24TypeName : GetTypeNameFromElementType(elementTypes[1]);
+    std::string header;
+    if (outputExtension == ".npy")
+    {
+        if (isInt24[1])
+        {
+            stringOutput = GetFormatted("Element type int24 has no npy dtype for file: \"%s\"", fileNames[1].c_str());
+            return EXIT_FAILURE;
+        }
+        std::vector<uint64_t> shape = {inputDataByteCount / inputElementByteSize};
+        if (!inputTensor.dtype.empty())
+        {
+            shape = inputTensor.shape;
+        }
+        header = Npy::MakeHeader(GetNpyDescrFromElementType(elementTypes[1]), inputTensor.isFortranOrder, shape, FileIo::alignment);
+    }
+    else if (outputExtension == ".wav")
+    {
+        const uint64_t outputByteCount = inputDataByteCount / inputBlockInfo.blockByteSize * inputBlockInfo.blockElementCount * outputElementByteSize;
+        const ElementType outputElementType = elementTypes[1];
+        const bool isWavElementType = isInt24[1] || outputElementType == ElementType::Uint8 || outputElementType == ElementType::Int16
+                                   || outputElementType == ElementType::Int32 || outputElementType == ElementType::Float32 || outputElementType == ElementType::Float64;
+        if (!isWavElementType)
+        {
+            stringOutput = GetFormatted("Element type %.*s has no WAV sample format for file: \"%s\"", int(outputTypeName.size()), outputTypeName.data(), fileNames[1].c_str());
+            return EXIT_FAILURE;
+        }
+        if (outputByteCount > UINT32_MAX - FileIo::alignment)
+        {
+            stringOutput = GetFormatted("Output is too large for a WAV file: \"%s\"", fileNames[1].c_str());
+            return EXIT_FAILURE;
+        }
+        const bool isFloat = (outputElementType == ElementType::Float32 || outputElementType == ElementType::Float64);
+        header = Wav::MakeHeader(
+            isFloat ? Wav::Format::Float : Wav::Format::Pcm,
+            channelCount,
+            sampleRate,
+            uint16_t(outputElementByteSize * 8),
+            uint32_t(outputByteCount),
+            FileIo::alignment
+        );
+    }
+    if (!header.empty())
+    {
+        memcpy(outputFile.GetBuffer(), header.data(), header.size());
+        outputFile.Write(header.size());
+    }
+
+    uint64_t totalElementCount = 0;
+    const uint8_t* input;
+    for (size_t byteCount; (byteCount = inputFile.ReadNext(/*out*/ input)) != 0; )
+    {
+        // Any partial element (or block) at the end is ignored.
+        const size_t elementCount = byteCount / inputBlockInfo.blockByteSize * inputBlockInfo.blockElementCount;
+        uint8_t* output = outputFile.GetBuffer();
+        ParallelFor((elementCount + sliceElementCount - 1) / sliceElementCount, [&](size_t sliceIndex)
+        {
+            const size_t sliceBegin = sliceIndex * sliceElementCount;
+            const size_t sliceEnd = std::min(sliceBegin + sliceElementCount, elementCount);
+            const uint8_t* sliceInput = input + sliceBegin / inputBlockInfo.blockElementCount * inputBlockInfo.blockByteSize;
+            uint8_t* sliceOutput = output + sliceBegin * outputElementByteSize;
+            const size_t sliceLength = sliceEnd - sliceBegin;
+            if (isInt24[0] && elementTypes[1] == ElementType::Float32 && !isInt24[1])
+            {
+                UnpackInt24ToFloat32(sliceInput, /*out*/ reinterpret_cast<float*>(sliceOutput), sliceLength, 1.0f);
+                return;
+            }
+
+            std::vector<float> dequantizedInput;
+            std::vector<int32_t> unpackedInput;
+            std::vector<uint8_t> swappedInput;
+            if (inputTensor.isBigEndian)
+            {
+                swappedInput.resize(sliceLength * inputElementByteSize);
+                SwapByteOrder(sliceInput, /*out*/ swappedInput.data(), sliceLength, uint32_t(inputElementByteSize));
+                sliceInput = swappedInput.data();
+            }
+            else if (blockQuantizedType != 0)
+            {
+                dequantizedInput.resize(sliceLength);
+                Gguf::DequantizeBlocks(blockQuantizedType, sliceInput, dequantizedInput.size() / inputBlockInfo.blockElementCount, /*out*/ dequantizedInput.data());
+                sliceInput = reinterpret_cast<const uint8_t*>(dequantizedInput.data());
+            }
+            else if (isInt24[0])
+            {
+                unpackedInput.resize(sliceLength);
+                UnpackInt24ToInt32(sliceInput, /*out*/ unpackedInput.data(), sliceLength);
+                sliceInput = reinterpret_cast<const uint8_t*>(unpackedInput.data());
+            }
+
+            if (isInt24[1])
+            {
+                std::vector<int32_t> packedOutput(sliceLength);
+                CastElementTypes(elementTypes[0], ElementType::Int32, sliceInput, /*out*/ packedOutput.data(), sliceLength);
+                PackInt32ToInt24(packedOutput.data(), /*out*/ sliceOutput, sliceLength);
+            }
+            else
+            {
+                CastElementTypes(elementTypes[0], elementTypes[1], sliceInput, /*out*/ sliceOutput, sliceLength);
+            }
+        });
+        outputFile.Write(elementCount * outputElementByteSize);
+        totalElementCount += elementCount;
+    }
+
+    const bool readSucceeded = inputFile.Close();
+    const bool writeSucceeded = outputFile.Close();
+    if (!readSucceeded || !writeSucceeded)
+    {
+        stringOutput = GetFormatted("Could not %s file: \"%s\"", readSucceeded ? "write" : "read", fileNames[readSucceeded].c_str());
+        return EXIT_FAILURE;
+    }
+
+    AppendFormatted(
+        /*inout*/ stringOutput,
+        "Converted %llu elements from %s to %.*s\n",
+        static_cast<unsigned long long>(totalElementCount),
+        (blockQuantizedType != 0) ? inputTensor.dtype.c_str() : isInt24[0] ? g_int24TypeName.data() : GetTypeNameFromElementType(elementTypes[0]).data(),
+        int(outputTypeName.size()),
+        outputTypeName.data()
+    );
+    return EXIT_SUCCESS;
+}
+
+// tensors <filename>
+//
+// Lists the arrays of an .npy, .safetensors, .gguf, .onnx, .wav, or image file, with their types, shapes, and
+// byte ranges. Big-endian arrays show their numpy dtype, like ">u2".
+int ListFileTensors(std::string_view arguments, /*out*/ std::string& stringOutput)
+{
+    std::string fileName(Tokenizer::Unquote(ReadWord(/*inout*/ arguments)));
+    if (fileName.empty())
+    {
+        stringOutput = GetFormatted("Expected a file name after \"tensors\"");
+        return EXIT_FAILURE;
+    }
+    MappedFile file;
+    if (!file.Open(fileName.c_str()))
+    {
+        stringOutput = GetFormatted("Could not read file: \"%s\"", fileName.c_str());
+        return EXIT_FAILURE;
+    }
+    std::vector<FileTensor> tensors;
+    if (ReadFileTensors(file, fileName, /*out*/ tensors, /*out*/ stringOutput) != EXIT_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+
+    uint64_t totalByteCount = 0;
+    for (const FileTensor& tensor : tensors)
+    {
+        const std::string_view typeName = tensor.isInt24 ? g_int24TypeName
+                                         : (tensor.elementType != ElementType::Undefined && tensor.blockQuantizedType == 0 && !tensor.isBigEndian) ? GetTypeNameFromElementType(tensor.elementType)
+                                         : tensor.dtype.empty() ? std::string_view("untyped") : std::string_view(tensor.dtype);
+        AppendFormatted(/*inout*/ stringOutput, "%s %.*s [", tensor.name.empty() ? "-" : tensor.name.c_str(), int(typeName.size()), typeName.data());
+        for (size_t i = 0; i < tensor.shape.size(); ++i)
+        {
+            AppendFormatted(/*inout*/ stringOutput, i > 0 ? ",%llu" : "%llu", static_cast<unsigned long long>(tensor.shape[i]));
+        }
+        AppendFormatted(
+            /*inout*/ stringOutput,
+            "] bytes %llu..%llu\n",
+            static_cast<unsigned long long>(tensor.dataOffset),
+            static_cast<unsigned long long>(tensor.dataOffset + tensor.byteCount)
+        );
+        totalByteCount += tensor.byteCount;
+        FlushOutputIfLarge(/*inout*/ stringOutput);
+    }
+    AppendFormatted(/*inout*/ stringOutput, "%zu tensors, %llu bytes\n", tensors.size(), static_cast<unsigned long long>(totalByteCount));
+    return EXIT_SUCCESS;
+}
+
+// Summary of a run of elements. Slices summarized independently (on any thread) are merged in
+// order, combining their variances with Chan's parallel update, so results do not depend on the
+// thread count. The sum, mean, and variance are of the finite values only.
+struct ElementStatistics
+{
+    uint64_t count = 0;
+    uint64_t finiteCount = 0;
+    uint64_t nanCount = 0;
+    uint64_t infinityCount = 0;
+    uint64_t zeroCount = 0;
+    uint64_t subnormalCount = 0;
+    double minimum = std::numeric_limits<double>::infinity(); // Of finite values
+    double maximum = -std::numeric_limits<double>::infinity();
+    double sum = 0;
+    double mean = 0;
+    double squaredDeviationSum = 0; // From the mean, which is the variance times the finite count
+
+    void Merge(const ElementStatistics& other) noexcept
+    {
+        if (other.finiteCount > 0)
+        {
+            const double combinedCount = double(finiteCount + other.finiteCount);
+            const double delta = other.mean - mean;
+            mean += delta * (double(other.finiteCount) / combinedCount);
+            squaredDeviationSum += other.squaredDeviationSum + delta * delta * (double(finiteCount) * double(other.finiteCount) / combinedCount);
+        }
+        count += other.count;
+        finiteCount += other.finiteCount;
+        nanCount += other.nanCount;
+        infinityCount += other.infinityCount;
+        zeroCount += other.zeroCount;
+        subnormalCount += other.subnormalCount;
+        minimum = std::min(minimum, other.minimum);
+        maximum = std::max(maximum, other.maximum);
+        sum += other.sum;
+    }
+};
+
+// Masks of the fields of a type's raw bits, from its substructure, to classify elements without
+// decoding them. Every float, integer, and fixed point type shares the same branchless tests.
+template <typename T>
+struct ElementFieldMasks
+{
+    T fraction;
+    T exponent;
+    T sign;
+    T magnitude;            // All bits but a float's sign, since a lone integer sign bit is the most negative value rather than -0.
+    T nanFractionMinimum;   // Least fraction of a NaN, given an all ones exponent
+    uint32_t exponentShift;
+    bool isFloat;
+    bool hasInfinity;
+
+    explicit ElementFieldMasks(ElementType elementType) noexcept
+    {
+        auto getFieldMask = [](Range range) -> T
+        {
+            const uint32_t bitCount = uint32_t(range.end - range.begin);
+            return (bitCount > 0) ? T((~uint64_t(0) >> (64 - bitCount)) << range.begin) : T(0);
+        };
+        const NumberSubstructure& substructure = GetElementTypeSubstructure(elementType);
+        fraction = getFieldMask(substructure.fraction);
+        exponent = getFieldMask(substructure.exponent);
+        sign = getFieldMask(substructure.sign);
+        exponentShift = substructure.exponent.begin;
+        isFloat = (exponent != 0);
+        magnitude = isFloat ? T(~sign) : T(~T(0));
+        // float8e4m3 spends the all ones exponent on finite values, except for the all ones fraction NaN.
+        hasInfinity = isFloat && (elementType != ElementType::Float8m3e4s1);
+        nanFractionMinimum = hasInfinity ? T(1) : fraction;
+    }
+};
+
+// Counts zeros, subnormals, infinities, and NaNs from the raw bits.
+template <typename T>
+void CountElementClasses(const T* elements, size_t count, ElementType elementType, /*inout*/ ElementStatistics& statistics)
+{
+    const ElementFieldMasks<T> masks(elementType);
+    const bool isFloat = masks.isFloat, hasInfinity = masks.hasInfinity;
+
+    uint64_t zeroCount = 0, subnormalCount = 0, infinityCount = 0, nanCount = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const T bits = elements[i];
+        const T exponent = bits & masks.exponent;
+        const T fraction = bits & masks.fraction;
+        const bool isMaximumExponent = isFloat & (exponent == masks.exponent);
+        zeroCount += ((bits & masks.magnitude) == 0);
+        subnormalCount += isFloat & (exponent == 0) & (fraction != 0);
+        infinityCount += isMaximumExponent & hasInfinity & (fraction == 0);
+        nanCount += isMaximumExponent & (fraction >= masks.nanFractionMinimum);
+    }
+    statistics.zeroCount += zeroCount;
+    statistics.subnormalCount += subnormalCount;
+    statistics.infinityCount += infinityCount;
+    statistics.nanCount += nanCount;
+}
+
+// Summarizes the finite values in several lanes, which compilers keep in vector registers, then
+// sums squared deviations from the slice's own mean in a second pass while the values are cached.
+ElementStatistics SummarizeValues(const double* values, size_t count)
+{
+    constexpr size_t laneCount = 4;
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+    uint64_t finiteCounts[laneCount] = {};
+    double sums[laneCount] = {};
+    double minimums[laneCount] = {infinity, infinity, infinity, infinity};
+    double maximums[laneCount] = {-infinity, -infinity, -infinity, -infinity};
+
+    // Only finite values subtract from themselves to zero, so infinities and NaN are skipped.
+    auto accumulate = [&](size_t lane, double value)
+    {
+        const bool isFinite = (value - value == 0);
+        finiteCounts[lane] += isFinite;
+        sums[lane] += isFinite ? value : 0.0;
+        minimums[lane] = (isFinite && value < minimums[lane]) ? value : minimums[lane];
+        maximums[lane] = (isFinite && value > maximums[lane]) ? value : maximums[lane];
+    };
+    size_t i = 0;
+    for (/*above*/; i + laneCount <= count; i += laneCount)
+    {
+        for (size_t lane = 0; lane < laneCount; ++lane)
+        {
+            accumulate(lane, values[i + lane]);
+        }
+    }
+    for (/*above*/; i < count; ++i)
+    {
+        accumulate(0, values[i]);
+    }
+
+    ElementStatistics statistics;
+    statistics.count = count;
+    for (size_t lane = 0; lane < laneCount; ++lane)
+    {
+        statistics.finiteCount += finiteCounts[lane];
+        statistics.sum += sums[lane];
+        statistics.minimum = std::min(statistics.minimum, minimums[lane]);
+        statistics.maximum = std::max(statistics.maximum, maximums[lane]);
+    }
+    if (statistics.finiteCount == 0)
+    {
+        return statistics;
+    }
+    statistics.mean = statistics.sum / double(statistics.finiteCount);
+
+    double squaredDeviationSums[laneCount] = {};
+    for (i = 0; i + laneCount <= count; i += laneCount)
+    {
+        for (size_t lane = 0; lane < laneCount; ++lane)
+        {
+            const double value = values[i + lane];
+            const double deviation = (value - value == 0) ? value - statistics.mean : 0.0;
+            squaredDeviationSums[lane] += deviation * deviation;
+        }
+    }
+    for (/*above*/; i < count; ++i)
+    {
+        const double value = values[i];
+        const double deviation = (value - value == 0) ? value - statistics.mean : 0.0;
+        squaredDeviationSums[0] += deviation * deviation;
+    }
+    for (double squaredDeviationSum : squaredDeviationSums)
+    {
+        statistics.squaredDeviationSum += squaredDeviationSum;
+    }
+    return statistics;
+}
+
+// A file view for a whole file command, named by its tensor when the command covers every tensor of
+// a model, else unnamed, with any reason the tensor cannot be viewed (like an unsupported dtype).
+struct NamedFileView
+{
+    std::string name;
+    NumberFileView fileView;
+    std::string errorMessage;
+};
+
+// Reads the file parameters of a whole file command like ReadFileViewParameters. But given no tensor
+// name for a file of several tensors (like a model), every tensor is viewed whole, by its name. Block
+// quantized views take the element type of their dequantized float32 elements.
+int ReadFileViewsParameters(
+    /*inout*/ std::string_view& arguments,
+    std::string_view keywordName,
+    /*out*/ std::vector<NamedFileView>& fileViews,
+    /*out*/ std::string& errorMessage
+)
+{
+    fileViews.clear();
+    std::string_view remainingArguments = arguments;
+    std::string fileName(Tokenizer::Unquote(ReadWord(/*inout*/ remainingArguments)));
+    auto file = std::make_shared<MappedFile>();
+    std::vector<FileTensor> tensors;
+    std::string tensorsErrorMessage;
+    if (!fileName.empty()
+    &&  Tokenizer::GetToken(remainingArguments) != "tensor"
+    &&  file->Open(fileName.c_str())
+    &&  ReadFileTensors(*file, fileName, /*out*/ tensors, /*out*/ tensorsErrorMessage) == EXIT_SUCCESS
+    &&  tensors.size() > 1)
+    {
+        arguments = remainingArguments;
+        for (const FileTensor& tensor : tensors)
+        {
+            NamedFileView& namedView = fileViews.emplace_back();
+            namedView.name = tensor.name;
+            if (tensor.elementType == ElementType::Undefined)
+            {
+                namedView.errorMessage = GetFormatted("Unsupported dtype \"%s\"", tensor.dtype.c_str());
+                continue;
+            }
+            namedView.fileView = MakeTensorFileView(file, tensor);
+        }
+    }
+    else
+    {
+        // Anything else reads the same as the file keyword, reporting its own errors.
+        if (ReadFileViewParameters(/*inout*/ arguments, keywordName, ElementType::Undefined, /*out*/ fileViews.emplace_back().fileView, /*out*/ errorMessage) != EXIT_SUCCESS)
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    for (NamedFileView& namedView : fileViews)
+    {
+        if (namedView.fileView.blockQuantizedType != 0)
+        {
+            namedView.fileView.elementType = ElementType::Float32;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+// Runs a whole file command's summary over its file views. For every tensor of a model, each tensor
+// is summarized on its own under its name, and then all the tensors of each element type together as
+// a total. Tensors the command cannot summarize (like integers for a float histogram) show why, and
+// are left out of the totals.
+template <typename SummarizeFunction>
+int RunFileViewsCommand(Span<const NamedFileView> fileViews, /*out*/ std::string& stringOutput, SummarizeFunction&& summarize)
+{
+    if (fileViews.size() == 1 && fileViews.front().name.empty())
+    {
+        return summarize(Span<const NumberFileView>(&fileViews.front().fileView, 1), /*out*/ stringOutput);
+    }
+
+    // Group the views by element type, in order of first appearance.
+    std::vector<std::vector<NumberFileView>> groups;
+    for (const NamedFileView& namedView : fileViews)
+    {
+        AppendFormatted(/*inout*/ stringOutput, "%-11s%s\n", "tensor", namedView.name.c_str());
+        const NumberFileView& fileView = namedView.fileView;
+        std::string tensorOutput = namedView.errorMessage;
+        if (tensorOutput.empty() && summarize(Span<const NumberFileView>(&fileView, 1), /*out*/ tensorOutput) == EXIT_SUCCESS)
+        {
+            auto group = std::find_if(groups.begin(), groups.end(), [&](const std::vector<NumberFileView>& groupViews)
+            {
+                return groupViews.front().elementType == fileView.elementType && groupViews.front().isInt24 == fileView.isInt24;
+            });
+            if (group == groups.end())
+            {
+                group = groups.emplace(groups.end());
+            }
+            group->push_back(fileView);
+        }
+        else
+        {
+            tensorOutput.push_back('\n'); // Error messages lack a line break.
+        }
+        stringOutput.append(tensorOutput);
+        stringOutput.push_back('\n');
+        FlushOutputIfLarge(/*inout*/ stringOutput);
+    }
+
+    for (const std::vector<NumberFileView>& groupViews : groups)
+    {
+        AppendFormatted(/*inout*/ stringOutput, "%-11s%zu tensors\n", "total", groupViews.size());
+        summarize(MakeSpan(groupViews), /*out*/ stringOutput);
+        stringOutput.push_back('\n');
+    }
+    return groups.empty() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// The slices of one or more file views of the same element type as one sequence, each slice being up
+// to g_operandChunkSize consecutive elements of one view, so several tensors are processed as one.
+class FileViewSlices
+{
+public:
+    struct Slice
+    {
+        const NumberFileView* fileView;
+        uint64_t elementIndex;
+        size_t count;
+    };
+
+    explicit FileViewSlices(Span<const NumberFileView> fileViews)
+    :   fileViews_(fileViews)
+    {
+        sliceEnds_.reserve(fileViews.size());
+        for (const NumberFileView& fileView : fileViews)
+        {
+            sliceCount_ += (fileView.elementCount + g_operandChunkSize - 1) / g_operandChunkSize;
+            elementCount_ += fileView.elementCount;
+            sliceEnds_.push_back(sliceCount_);
+        }
+    }
+
+    size_t size() const noexcept { return size_t(sliceCount_); }
+    uint64_t GetElementCount() const noexcept { return elementCount_; }
+
+    Slice operator[](size_t sliceIndex) const
+    {
+        const size_t viewIndex = std::upper_bound(sliceEnds_.begin(), sliceEnds_.end(), uint64_t(sliceIndex)) - sliceEnds_.begin();
+        const uint64_t viewSliceBegin = (viewIndex > 0) ? sliceEnds_[viewIndex - 1] : 0;
+        const NumberFileView& fileView = fileViews_[viewIndex];
+        const uint64_t elementIndex = (sliceIndex - viewSliceBegin) * g_operandChunkSize;
+        return {&fileView, elementIndex, size_t(std::min<uint64_t>(g_operandChunkSize, fileView.elementCount - elementIndex))};
+    }
+
+private:
+    Span<const NumberFileView> fileViews_;
+    std::vector<uint64_t> sliceEnds_; // Per view, the end of its slices in the sequence.
+    uint64_t sliceCount_ = 0;
+    uint64_t elementCount_ = 0;
+};
+
+// Summarizes file views of the same element type together, for the stats command.
+int ComputeFileViewStatistics(Span<const NumberFileView> fileViews, /*out*/ std::string& stringOutput)
+{
+    const ElementType elementType = fileViews.front().elementType;
+    const uint32_t elementByteSize = GetSizeOfTypeInBytes(elementType);
+    const FileViewSlices slices(fileViews);
+    std::vector<ElementStatistics> sliceStatistics(slices.size());
+    ParallelFor(sliceStatistics.size(), [&](size_t sliceIndex)
+    {
+        const FileViewSlices::Slice slice = slices[sliceIndex];
+        const size_t count = slice.count;
+        std::vector<uint64_t> buffer(count);
+        const uint8_t* elements = ReadNumberFileViewElements(*slice.fileView, slice.elementIndex, count, /*out*/ reinterpret_cast<uint8_t*>(buffer.data()));
+
+        std::vector<double> values(count);
+        CastElementTypes(elementType, ElementType::Float64, elements, /*out*/ values.data(), count);
+        ElementStatistics& statistics = sliceStatistics[sliceIndex];
+        statistics = SummarizeValues(values.data(), count);
+
+        switch (elementByteSize)
+        {
+        case 1: CountElementClasses(reinterpret_cast<const uint8_t*>(elements), count, elementType, /*inout*/ statistics); break;
+        case 2: CountElementClasses(reinterpret_cast<const uint16_t*>(elements), count, elementType, /*inout*/ statistics); break;
+        case 4: CountElementClasses(reinterpret_cast<const uint32_t*>(elements), count, elementType, /*inout*/ statistics); break;
+        case 8: CountElementClasses(reinterpret_cast<const uint64_t*>(elements), count, elementType, /*inout*/ statistics); break;
+        default: // 24-bit fixed point, which has only zeros.
+            statistics.zeroCount += std::count(values.begin(), values.end(), 0.0);
+            break;
+        }
+    });
+
+    ElementStatistics statistics;
+    for (const ElementStatistics& slice : sliceStatistics)
+    {
+        statistics.Merge(slice);
+    }
+
+    auto appendCount = [&](const char* name, uint64_t count)
+    {
+        AppendFormatted(/*inout*/ stringOutput, "%-11s%llu\n", name, static_cast<unsigned long long>(count));
+    };
+    auto appendValue = [&](const char* name, double value)
+    {
+        AppendFormatted(/*inout*/ stringOutput, "%-11s", name);
+        AppendCharacters(/*inout*/ stringOutput, value);
+        stringOutput.push_back('\n');
+    };
+    // The extremes are values of the elements themselves, so show them in the element type.
+    auto appendElementValue = [&](const char* name, double value)
+    {
+        AppendFormatted(/*inout*/ stringOutput, "%-11s", name);
+        NumberUnion number = {};
+        CastElementType(ElementType::Float64, elementType, &value, /*out*/ number.buffer);
+        AppendFormattedNumericValue(/*inout*/ stringOutput, elementType, number.buffer, " (", ")", NumericPrintingFlags::Default & ~NumericPrintingFlags::ShowNumericType);
+        stringOutput.push_back('\n');
+    };
+
+    const std::string_view typeName = fileViews.front().isInt24 ? g_int24TypeName : GetTypeNameFromElementType(elementType);
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%.*s\n", "type", int(typeName.size()), typeName.data());
+    appendCount("elements", statistics.count);
+    appendCount("finite", statistics.finiteCount);
+    appendCount("nan", statistics.nanCount);
+    appendCount("infinity", statistics.infinityCount);
+    appendCount("zero", statistics.zeroCount);
+    appendCount("subnormal", statistics.subnormalCount);
+    if (statistics.finiteCount > 0)
+    {
+        appendElementValue("minimum", statistics.minimum);
+        appendElementValue("maximum", statistics.maximum);
+        appendValue("absmaximum", std::max(std::abs(statistics.minimum), std::abs(statistics.maximum)));
+    }
+    const double variance = statistics.squaredDeviationSum / double(statistics.finiteCount); // Population variance, like numpy.var
+    appendValue("sum", statistics.sum);
+    appendValue("mean", (statistics.finiteCount > 0) ? statistics.mean : std::numeric_limits<double>::quiet_NaN());
+    appendValue("variance", variance);
+    appendValue("stddev", std::sqrt(variance));
+    return EXIT_SUCCESS;
+}
+
+// stats <filename> [tensor <name>] [rows <first> [count]] [columns <first> [count]] [channel <index>]
+//       [elementType] [byteOffset] [elementCount]
+//
+// Summarizes the elements of a file (with the same parameters as the file keyword) in one parallel
+// pass: the count of each class of value, and the extremes, sum, mean, and variance of the finite
+// values (so one infinity does not hide the range of the rest). Given a model without a tensor
+// name, each tensor is summarized, and then the tensors of each type in total.
+int ComputeFileStatistics(std::string_view arguments, /*out*/ std::string& stringOutput)
+{
+    std::vector<NamedFileView> fileViews;
+    if (ReadFileViewsParameters(/*inout*/ arguments, "stats", /*out*/ fileViews, /*out*/ stringOutput) != EXIT_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+    std::string_view token = ReadToken(/*inout*/ arguments);
+    if (!token.empty())
+    {
+        stringOutput = GetFormatted("Unknown parameter: \"%.*s\"", int(token.size()), token.data());
+        return EXIT_FAILURE;
+    }
+    return RunFileViewsCommand(MakeSpan(fileViews), /*out*/ stringOutput, ComputeFileViewStatistics);
+}
+
+// Counts the bin of every element of file views of the same type, where getBin maps the raw bits of an element
+// (of type T, the size of binElementType, which elements are cast to first if the view's type
+// differs) to a bin index under binCount. Each worker thread counts the slices it runs into
+// 32-bit sub-histograms of its own, so memory grows with threads rather than slices. Small
+// histograms use one per lane, so that neighboring elements in the same bin do not stall on
+// incrementing the same counter, while large ones (with few repeats anyway) keep just one to stay
+// cached. The threads' counts are merged at the end, in parallel across bins.
+// For float bin types, the greatest non-NaN magnitude bits can be found in the same pass too.
+template <typename T, typename BinFunction>
+std::vector<uint64_t> ComputeFileViewHistogram(
+    Span<const NumberFileView> fileViews,
+    ElementType binElementType,
+    size_t binCount,
+    BinFunction&& getBin,
+    /*out*/ T* maximumMagnitude = nullptr
+)
+{
+    constexpr size_t maximumLaneCount = 4;
+    const size_t laneCount = (binCount <= (size_t(1) << 16)) ? maximumLaneCount : 1;
+    const FileViewSlices slices(fileViews);
+    const size_t sliceCount = slices.size();
+    const ElementFieldMasks<T> masks(binElementType);
+
+    struct alignas(64) ThreadState
+    {
+        std::vector<uint64_t> buffer;
+        std::vector<uint64_t> castBuffer;
+        std::vector<uint32_t> laneHistograms;
+        uint64_t pendingCount = 0;
+        T maximumMagnitude = 0;
+    };
+    std::vector<ThreadState> threadStates(GetParallelForThreadCount(sliceCount));
+    std::vector<uint64_t> histogram(binCount);
+    std::mutex histogramMutex;
+
+    ParallelForWithThreadIndex(sliceCount, [&](size_t sliceIndex, size_t threadIndex)
+    {
+        ThreadState& state = threadStates[threadIndex];
+        if (state.laneHistograms.empty())
+        {
+            state.buffer.resize(g_operandChunkSize);
+            state.castBuffer.resize((binElementType != fileViews.front().elementType) ? g_operandChunkSize : 0);
+            state.laneHistograms.resize(laneCount * binCount);
+        }
+        std::vector<uint32_t>& laneHistograms = state.laneHistograms;
+
+        const FileViewSlices::Slice slice = slices[sliceIndex];
+        const size_t count = slice.count;
+        const uint8_t* elementData = ReadNumberFileViewElements(*slice.fileView, slice.elementIndex, count, /*out*/ reinterpret_cast<uint8_t*>(state.buffer.data()));
+        if (!state.castBuffer.empty())
+        {
+            CastElementTypes(slice.fileView->elementType, binElementType, elementData, /*out*/ state.castBuffer.data(), count);
+            elementData = reinterpret_cast<const uint8_t*>(state.castBuffer.data());
+        }
+        const T* elements = reinterpret_cast<const T*>(elementData);
+
+        size_t i = 0;
+        if (laneCount == maximumLaneCount)
+        {
+            for (/*above*/; i + maximumLaneCount <= count; i += maximumLaneCount)
+            {
+                for (size_t lane = 0; lane < maximumLaneCount; ++lane)
+                {
+                    ++laneHistograms[lane * binCount + getBin(elements[i + lane])];
+                }
+            }
+        }
+        for (/*above*/; i < count; ++i)
+        {
+            ++laneHistograms[getBin(elements[i])];
+        }
+        if (maximumMagnitude != nullptr)
+        {
+            for (i = 0; i < count; ++i)
+            {
+                const T magnitude = elements[i] & masks.magnitude;
+                state.maximumMagnitude = (magnitude <= masks.exponent) ? std::max(state.maximumMagnitude, magnitude) : state.maximumMagnitude;
+            }
+        }
+
+        // Lane counters are 32-bit, so are flushed into the shared histogram before overflowing,
+        // which with over 4 billion elements per thread is rare enough to just lock for.
+        state.pendingCount += count;
+        if (state.pendingCount > UINT32_MAX - g_operandChunkSize)
+        {
+            std::lock_guard<std::mutex> lock(histogramMutex);
+            for (size_t lane = 0; lane < laneCount; ++lane)
+            {
+                for (size_t bin = 0; bin < binCount; ++bin)
+                {
+                    histogram[bin] += laneHistograms[lane * binCount + bin];
+                }
+            }
+            std::fill(laneHistograms.begin(), laneHistograms.end(), 0u);
+            state.pendingCount = 0;
+        }
+    });
+
+    constexpr size_t mergeBinCount = 4096;
+    ParallelFor((binCount + mergeBinCount - 1) / mergeBinCount, [&](size_t mergeIndex)
+    {
+        const size_t binBegin = mergeIndex * mergeBinCount, binEnd = std::min(binBegin + mergeBinCount, binCount);
+        for (const ThreadState& state : threadStates)
+        {
+            for (size_t lane = 0; lane < laneCount && !state.laneHistograms.empty(); ++lane)
+            {
+                for (size_t bin = binBegin; bin < binEnd; ++bin)
+                {
+                    histogram[bin] += state.laneHistograms[lane * binCount + bin];
+                }
+            }
+        }
+    });
+    if (maximumMagnitude != nullptr)
+    {
+        *maximumMagnitude = T(0);
+        for (const ThreadState& state : threadStates)
+        {
+            *maximumMagnitude = std::max(*maximumMagnitude, state.maximumMagnitude);
+        }
+    }
+    return histogram;
+}
+
+// Counts elements by their exponent field, with bins for each exponent value and then zero and
+// NaN. So the lowest exponent bin holds the subnormals, and the highest holds the infinities (or
+// for float8e4m3, its largest finite binade).
+template <typename T>
+std::vector<uint64_t> ComputeExponentHistogram(Span<const NumberFileView> fileViews)
+{
+    const ElementType elementType = fileViews.front().elementType;
+    const ElementFieldMasks<T> masks(elementType);
+    const uint32_t exponentFieldMask = uint32_t(masks.exponent >> masks.exponentShift);
+    const uint32_t zeroBin = exponentFieldMask + 1, nanBin = exponentFieldMask + 2;
+    return ComputeFileViewHistogram<T>(
+        fileViews,
+        elementType,
+        exponentFieldMask + 3,
+        [=](T bits) -> uint32_t
+        {
+            const uint32_t exponent = uint32_t(bits >> masks.exponentShift) & exponentFieldMask;
+            const T fraction = bits & masks.fraction;
+            const bool isZero = (exponent == 0) & (fraction == 0);
+            const bool isNan = (exponent == exponentFieldMask) & (fraction >= masks.nanFractionMinimum);
+            return isZero ? zeroBin : isNan ? nanBin : exponent;
+        }
+    );
+}
+
+// Appends the distinct value count, the empirical entropy, and the most frequent values of a
+// histogram of every bit pattern of 8 or 16-bit elements.
+void AppendValueHistogram(/*inout*/ std::string& stringOutput, Span<const uint64_t> histogram, ElementType elementType, uint64_t elementCount, size_t topCount)
+{
+    uint64_t distinctCount = 0;
+    double entropy = 0;
+    for (uint64_t count : histogram)
+    {
+        if (count > 0)
+        {
+            const double probability = double(count) / double(elementCount);
+            entropy -= probability * std::log2(probability);
+            ++distinctCount;
+        }
+    }
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%llu\n", "distinct", static_cast<unsigned long long>(distinctCount));
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%.6f bits\n", "entropy", entropy + 0.0); // Adding zero avoids printing -0.
+
+    // Most frequent first, and lower bit patterns first among equals.
+    std::vector<uint32_t> bins(histogram.size());
+    std::iota(bins.begin(), bins.end(), 0u);
+    topCount = size_t(std::min<uint64_t>(topCount, distinctCount));
+    std::partial_sort(
+        bins.begin(),
+        bins.begin() + topCount,
+        bins.end(),
+        [&](uint32_t a, uint32_t b) { return histogram[a] > histogram[b] || (histogram[a] == histogram[b] && a < b); }
+    );
+    for (size_t i = 0; i < topCount; ++i)
+    {
+        const uint64_t count = histogram[bins[i]];
+        NumberUnion number = {};
+        number.ui32 = bins[i];
+        AppendFormatted(/*inout*/ stringOutput, "%-11llu%.4f%%  ", static_cast<unsigned long long>(count), 100.0 * double(count) / double(elementCount));
+        AppendFormattedNumericValue(/*inout*/ stringOutput, elementType, number.buffer, " (", ")", NumericPrintingFlags::Default & ~NumericPrintingFlags::ShowNumericType);
+        stringOutput.push_back('\n');
+    }
+}
+
+// Histograms file views of the same element type together, for the histogram command.
+int ComputeFileViewsHistogram(Span<const NumberFileView> fileViews, bool isValueHistogram, uint64_t topCount, /*out*/ std::string& stringOutput)
+{
+    const uint64_t elementCount = FileViewSlices(fileViews).GetElementCount();
+    const ElementType elementType = fileViews.front().elementType;
+    if (isValueHistogram)
+    {
+        std::vector<uint64_t> histogram;
+        switch (fileViews.front().isInt24 ? 0 : GetSizeOfTypeInBytes(elementType))
+        {
+        case 1: histogram = ComputeFileViewHistogram<uint8_t>(fileViews, elementType, 1u << 8, [](uint8_t bits) -> uint32_t { return bits; }); break;
+        case 2: histogram = ComputeFileViewHistogram<uint16_t>(fileViews, elementType, 1u << 16, [](uint16_t bits) -> uint32_t { return bits; }); break;
+        default:
+            {
+                const std::string_view typeName = fileViews.front().isInt24 ? g_int24TypeName : GetTypeNameFromElementType(elementType);
+                stringOutput = GetFormatted("Expected an 8 or 16-bit element type for a value histogram, not %.*s", int(typeName.size()), typeName.data());
+                return EXIT_FAILURE;
+            }
+        }
+        const std::string_view typeName = GetTypeNameFromElementType(elementType);
+        AppendFormatted(/*inout*/ stringOutput, "%-11s%.*s\n", "type", int(typeName.size()), typeName.data());
+        AppendFormatted(/*inout*/ stringOutput, "%-11s%llu\n", "elements", static_cast<unsigned long long>(elementCount));
+        AppendValueHistogram(/*inout*/ stringOutput, MakeSpan(histogram), elementType, elementCount, size_t(std::min<uint64_t>(topCount, histogram.size())));
+        return EXIT_SUCCESS;
+    }
+
+    const Range exponentRange = GetElementTypeSubstructure(elementType).exponent;
+    std::vector<uint64_t> histogram;
+    switch (exponentRange.end > exponentRange.begin ? GetSizeOfTypeInBytes(elementType) : 0)
+    {
+    case 1: histogram = ComputeExponentHistogram<uint8_t>(fileViews); break;
+    case 2: histogram = ComputeExponentHistogram<uint16_t>(fileViews); break;
+    case 4: histogram = ComputeExponentHistogram<uint32_t>(fileViews); break;
+    case 8: histogram = ComputeExponentHistogram<uint64_t>(fileViews); break;
+    default:
+        {
+            const std::string_view typeName = fileViews.front().isInt24 ? g_int24TypeName : GetTypeNameFromElementType(elementType);
+            stringOutput = GetFormatted("Expected a floating point element type for a histogram, not %.*s", int(typeName.size()), typeName.data());
+            return EXIT_FAILURE;
+        }
+    }
+
+    const std::string_view typeName = GetTypeNameFromElementType(elementType);
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%.*s\n", "type", int(typeName.size()), typeName.data());
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%llu\n", "elements", static_cast<unsigned long long>(elementCount));
+
+    // Show the non-empty bins from the smallest magnitudes to the largest, as the power of two
+    // each binade starts at.
+    const uint32_t exponentCount = uint32_t(histogram.size()) - 2;
+    const int32_t exponentBias = int32_t(exponentCount / 2) - 1;
+    const bool hasInfinity = (elementType != ElementType::Float8m3e4s1);
+    auto appendBin = [&](const char* name, uint64_t count)
+    {
+        if (count > 0)
+        {
+            const double percentage = 100.0 * double(count) / double(elementCount);
+            AppendFormatted(/*inout*/ stringOutput, "%-11s%-14llu%.4f%%\n", name, static_cast<unsigned long long>(count), percentage);
+        }
+    };
+    appendBin("zero", histogram[exponentCount]);
+    appendBin("subnormal", histogram[0]);
+    for (uint32_t exponent = 1; exponent < exponentCount - (hasInfinity ? 1 : 0); ++exponent)
+    {
+        appendBin(GetFormatted("2^%d", int32_t(exponent) - exponentBias).c_str(), histogram[exponent]);
+    }
+    if (hasInfinity)
+    {
+        appendBin("infinity", histogram[exponentCount - 1]);
+    }
+    appendBin("nan", histogram[exponentCount + 1]);
+    return EXIT_SUCCESS;
+}
+
+// histogram <filename> [tensor <name>] [rows <first> [count]] [columns <first> [count]] [channel <index>]
+//           [elementType] [byteOffset] [elementCount] [values [top <count>]]
+//
+// Counts the floating point elements of a file in each binade (power of two range of magnitudes),
+// along with the zeros, subnormals, infinities, and NaNs, to see the dynamic range that a narrower
+// type (like float8) would need to cover. Or with "values", counts every bit pattern of 8 or 16-bit
+// elements exactly (like float16 or a quantized int8 tensor), showing the most frequent.
+int ComputeFileHistogram(std::string_view arguments, /*out*/ std::string& stringOutput)
+{
+    std::vector<NamedFileView> fileViews;
+    if (ReadFileViewsParameters(/*inout*/ arguments, "histogram", /*out*/ fileViews, /*out*/ stringOutput) != EXIT_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+
+    bool isValueHistogram = false;
+    uint64_t topCount = 10;
+    for (std::string_view token; !(token = ReadToken(/*inout*/ arguments)).empty(); )
+    {
+        if (token == "values")
+        {
+            isValueHistogram = true;
+        }
+        else if (token == "top")
+        {
+            token = ReadToken(/*inout*/ arguments);
+            if (token.empty() || !isdigit(token.front()))
+            {
+                stringOutput = GetFormatted("Expected a count after \"top\"");
+                return EXIT_FAILURE;
+            }
+            NumberUnionAndType number;
+            ParseNumber(token, ElementType::Uint64, /*parseAsRawData*/ false, /*out*/ number);
+            topCount = number.numberUnion.ui64;
+        }
+        else
+        {
+            stringOutput = GetFormatted("Unknown parameter: \"%.*s\"", int(token.size()), token.data());
+            return EXIT_FAILURE;
+        }
+    }
+    return RunFileViewsCommand(MakeSpan(fileViews), /*out*/ stringOutput, [&](Span<const NumberFileView> views, /*out*/ std::string& output) { return ComputeFileViewsHistogram(views, isValueHistogram, topCount, /*out*/ output); });
+}
+
+// Estimates the quantiles of file views of the same element type together, for the quantiles command.
+int EstimateFileViewQuantiles(Span<const NumberFileView> fileViews, /*out*/ std::string& stringOutput)
+{
+    const uint64_t elementCount = FileViewSlices(fileViews).GetElementCount();
+    // Count the elements in bins, and find the absolute value of each bin (NaN for NaN bins), being
+    // the value itself for bins of a single bit pattern, else the midpoint of the bin.
+    const ElementType elementType = fileViews.front().elementType;
+    const uint32_t elementByteSize = fileViews.front().isInt24 ? 3 : GetSizeOfTypeInBytes(elementType);
+    std::vector<uint64_t> histogram;
+    std::vector<double> binValues;
+    double maximum = 0; // Bins of 8 and 16-bit elements are exact, so only wider elements set it.
+    if (elementByteSize <= 2)
+    {
+        histogram = (elementByteSize == 1)
+                  ? ComputeFileViewHistogram<uint8_t>(fileViews, elementType, 1u << 8, [](uint8_t bits) -> uint32_t { return bits; })
+                  : ComputeFileViewHistogram<uint16_t>(fileViews, elementType, 1u << 16, [](uint16_t bits) -> uint32_t { return bits; });
+        binValues.resize(histogram.size());
+        for (uint32_t bin = 0; bin < binValues.size(); ++bin)
+        {
+            NumberUnion number = {};
+            number.ui32 = bin;
+            binValues[bin] = std::abs(ReadToDouble(elementType, number.buffer));
+        }
+    }
+    else if (elementType == ElementType::Float32 && !fileViews.front().isInt24)
+    {
+        constexpr uint32_t infinityBin = 0x7F80, binCount = 0x8000;
+        uint32_t maximumBits = 0;
+        histogram = ComputeFileViewHistogram<uint32_t>(
+            fileViews,
+            ElementType::Float32,
+            binCount,
+            [](uint32_t bits) -> uint32_t
+            {
+                // Every NaN goes in the last bin, including those sharing the top bits of infinity.
+                const uint32_t magnitude = bits & 0x7FFFFFFF;
+                return (magnitude > 0x7F800000) ? binCount - 1 : magnitude >> 16;
+            },
+            /*out*/ &maximumBits
+        );
+        binValues.resize(binCount);
+        for (uint32_t bin = 0; bin < binCount; ++bin)
+        {
+            // The first bin shows as zero, since it holds only zeros and the tiniest subnormals.
+            const uint32_t bits = (bin == 0 || bin >= infinityBin) ? (bin << 16) : (bin << 16) | 0x8000;
+            float value;
+            memcpy(&value, &bits, sizeof(value));
+            binValues[bin] = value;
+        }
+        float maximumValue;
+        memcpy(&maximumValue, &maximumBits, sizeof(maximumValue));
+        maximum = maximumValue;
+    }
+    else
+    {
+        // Likewise but with the 11 exponent bits of float64, so values beyond float32 keep their magnitude.
+        constexpr uint32_t infinityBin = 0x3FF80, binCount = 0x40000;
+        constexpr uint32_t binShift = 45;
+        uint64_t maximumBits = 0;
+        histogram = ComputeFileViewHistogram<uint64_t>(
+            fileViews,
+            ElementType::Float64,
+            binCount,
+            [](uint64_t bits) -> uint32_t
+            {
+                const uint64_t magnitude = bits & 0x7FFFFFFFFFFFFFFF;
+                return (magnitude > 0x7FF0000000000000) ? binCount - 1 : uint32_t(magnitude >> binShift);
+            },
+            /*out*/ &maximumBits
+        );
+        binValues.resize(binCount);
+        for (uint32_t bin = 0; bin < binCount; ++bin)
+        {
+            const uint64_t bits = (bin == 0 || bin >= infinityBin) ? (uint64_t(bin) << binShift) : (uint64_t(bin) << binShift) | (uint64_t(1) << (binShift - 1));
+            memcpy(&binValues[bin], &bits, sizeof(double));
+        }
+        memcpy(&maximum, &maximumBits, sizeof(maximum));
+    }
+
+    std::vector<uint32_t> bins;
+    uint64_t valueCount = 0;
+    for (uint32_t bin = 0; bin < histogram.size(); ++bin)
+    {
+        if (histogram[bin] > 0 && !std::isnan(binValues[bin]))
+        {
+            bins.push_back(bin);
+            valueCount += histogram[bin];
+        }
+    }
+    std::sort(bins.begin(), bins.end(), [&](uint32_t a, uint32_t b) { return binValues[a] < binValues[b]; });
+
+    const std::string_view typeName = fileViews.front().isInt24 ? g_int24TypeName : GetTypeNameFromElementType(elementType);
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%.*s\n", "type", int(typeName.size()), typeName.data());
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%llu\n", "elements", static_cast<unsigned long long>(elementCount));
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%llu\n", "nan", static_cast<unsigned long long>(elementCount - valueCount));
+    if (valueCount == 0)
+    {
+        return EXIT_SUCCESS;
+    }
+
+    // Each percentile is the least value which at least that fraction of the values do not exceed
+    // (the nearest rank method), given in parts per ten thousand to keep the ranks exact.
+    struct Percentile
+    {
+        const char* name;
+        uint64_t partsPerTenThousand;
+    };
+    constexpr Percentile percentiles[] =
+    {
+        {"p50", 5000},
+        {"p90", 9000},
+        {"p99", 9900},
+        {"p99.9", 9990},
+        {"p99.99", 9999},
+        {"maximum", 10000},
+    };
+    uint64_t cumulativeCount = 0;
+    size_t binIndex = 0;
+    for (const Percentile& percentile : percentiles)
+    {
+        const uint64_t rank = std::max<uint64_t>((valueCount * percentile.partsPerTenThousand + 9999) / 10000, 1);
+        while (cumulativeCount + histogram[bins[binIndex]] < rank)
+        {
+            cumulativeCount += histogram[bins[binIndex++]];
+        }
+        AppendFormatted(/*inout*/ stringOutput, "%-11s", percentile.name);
+        const bool isExactMaximum = (percentile.partsPerTenThousand == 10000 && elementByteSize > 2);
+        AppendCharacters(/*inout*/ stringOutput, isExactMaximum ? maximum : binValues[bins[binIndex]]);
+        stringOutput.push_back('\n');
+    }
+    return EXIT_SUCCESS;
+}
+
+// quantiles <filename> [tensor <name>] [rows <first> [count]] [columns <first> [count]] [channel <index>]
+//           [elementType] [byteOffset] [elementCount]
+//
+// Estimates percentiles of the absolute values of a file's elements in one pass with bounded memory,
+// like for choosing the clipping threshold before converting to float8 or int8. 8 and 16-bit elements
+// are counted exactly by bit pattern. Wider elements are counted by the exponent and top 7 fraction
+// bits of their magnitude (as float32 for float32 elements, else as float64 to keep the range), a
+// log-linear histogram whose estimates stay within 0.4% of the true value even far out in the tail,
+// where rank based sketches are least precise. The maximum is exact, found in the same pass.
+int EstimateFileQuantiles(std::string_view arguments, /*out*/ std::string& stringOutput)
+{
+    std::vector<NamedFileView> fileViews;
+    if (ReadFileViewsParameters(/*inout*/ arguments, "quantiles", /*out*/ fileViews, /*out*/ stringOutput) != EXIT_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+    std::string_view token = ReadToken(/*inout*/ arguments);
+    if (!token.empty())
+    {
+        stringOutput = GetFormatted("Unknown parameter: \"%.*s\"", int(token.size()), token.data());
+        return EXIT_FAILURE;
+    }
+    return RunFileViewsCommand(MakeSpan(fileViews), /*out*/ stringOutput, EstimateFileViewQuantiles);
+}
+
+// Analyzes the conversion errors of file views of the same element type together, for the qerror command.
+int AnalyzeFileViewConversionErrors(Span<const NumberFileView> fileViews, /*out*/ std::string& stringOutput)
+{
+    constexpr ElementType targetElementTypes[] =
+    {
+        ElementType::Float16, ElementType::Bfloat16, ElementType::Float8m3e4s1, ElementType::Float8m2e5s1,
+        ElementType::Fixed24f12i12, ElementType::Fixed32f16i16, ElementType::Fixed32f24i8,
+        ElementType::Int8, ElementType::Uint8, ElementType::Int16, ElementType::Uint16, ElementType::Int32, ElementType::Uint32,
+    };
+    const ElementType elementType = fileViews.front().elementType;
+    std::vector<ConversionTarget> targets;
+    for (ElementType targetElementType : targetElementTypes)
+    {
+        if (targetElementType != elementType && GetSizeOfTypeInBytes(targetElementType) <= GetSizeOfTypeInBytes(elementType))
+        {
+            targets.emplace_back(targetElementType);
+        }
+    }
+
+    const FileViewSlices slices(fileViews);
+    const uint64_t sliceCount = slices.size();
+    const uint64_t elementCount = slices.GetElementCount();
+    std::vector<RoundingError::Summary> sliceErrors(static_cast<size_t>(sliceCount) * targets.size());
+    std::vector<uint64_t> sliceFiniteCounts(static_cast<size_t>(sliceCount));
+    ParallelFor(static_cast<size_t>(sliceCount), [&](size_t sliceIndex)
+    {
+        const FileViewSlices::Slice slice = slices[sliceIndex];
+        const size_t count = slice.count;
+        std::vector<uint64_t> buffer(count);
+        const uint8_t* elements = ReadNumberFileViewElements(*slice.fileView, slice.elementIndex, count, /*out*/ reinterpret_cast<uint8_t*>(buffer.data()));
+        const size_t elementByteSize = GetSizeOfTypeInBytes(elementType);
+
+        // Values beyond a target's range are zeroed before converting, since they only count as saturated,
+        // and casting them to integers is undefined.
+        constexpr size_t blockElementCount = 1024;
+        double values[blockElementCount], inRangeValues[blockElementCount], roundedValues[blockElementCount];
+        uint32_t targetElements[blockElementCount];
+        for (size_t blockBegin = 0; blockBegin < count; blockBegin += blockElementCount)
+        {
+            const size_t blockCount = std::min(blockElementCount, count - blockBegin);
+            CastElementTypes(elementType, ElementType::Float64, elements + blockBegin * elementByteSize, /*out*/ values, blockCount);
+            sliceFiniteCounts[sliceIndex] += std::count_if(values, values + blockCount, [](double value) { return std::isfinite(value); });
+            for (size_t targetIndex = 0; targetIndex < targets.size(); ++targetIndex)
+            {
+                const ConversionTarget& target = targets[targetIndex];
+                for (size_t i = 0; i < blockCount; ++i)
+                {
+                    inRangeValues[i] = (values[i] >= target.minimum && values[i] <= target.maximum) ? values[i] : 0.0;
+                }
+                CastElementTypes(ElementType::Float64, target.elementType, inRangeValues, /*out*/ targetElements, blockCount);
+                CastElementTypes(target.elementType, ElementType::Float64, targetElements, /*out*/ roundedValues, blockCount);
+                RoundingError::Accumulate(values, roundedValues, blockCount, target.rounding, /*inout*/ sliceErrors[sliceIndex * targets.size() + targetIndex]);
+            }
+        }
+    });
+
+    std::vector<RoundingError::Summary> errors(targets.size());
+    for (size_t sliceIndex = 0; sliceIndex < sliceCount; ++sliceIndex)
+    {
+        for (size_t targetIndex = 0; targetIndex < targets.size(); ++targetIndex)
+        {
+            errors[targetIndex].Merge(sliceErrors[sliceIndex * targets.size() + targetIndex]);
+        }
+    }
+    const uint64_t finiteCount = std::accumulate(sliceFiniteCounts.begin(), sliceFiniteCounts.end(), uint64_t(0));
+
+    const std::string_view typeName = fileViews.front().isInt24 ? g_int24TypeName : GetTypeNameFromElementType(elementType);
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%.*s\n", "type", int(typeName.size()), typeName.data());
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%llu\n", "elements", static_cast<unsigned long long>(elementCount));
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%llu\n", "nonfinite", static_cast<unsigned long long>(elementCount - finiteCount));
+    AppendFormatted(/*inout*/ stringOutput, "%-14s%-14s%-14s%-14s%-14s%-11s%s\n", "target", "maxabserror", "maxrelerror", "rmse", "maxulperror", "saturated", "flushed");
+    for (size_t targetIndex = 0; targetIndex < targets.size(); ++targetIndex)
+    {
+        const RoundingError::Summary& error = errors[targetIndex];
+        const double rootMeanSquareError = (error.count > 0) ? std::sqrt(error.squaredErrorSum / double(error.count)) : 0.0;
+        AppendFormatted(
+            /*inout*/ stringOutput,
+            "%-14s%-14.6g%-14.6g%-14.6g%-14.6g%-11llu%llu\n",
+            GetTypeNameFromElementType(targets[targetIndex].elementType).data(),
+            error.maximumAbsoluteError,
+            error.maximumRelativeError,
+            rootMeanSquareError,
+            error.maximumUlpError,
+            static_cast<unsigned long long>(finiteCount - error.count),
+            static_cast<unsigned long long>(error.flushedCount)
+        );
+    }
+    return EXIT_SUCCESS;
+}
+
+// qerror <filename> [tensor <name>] [rows <first> [count]] [columns <first> [count]] [channel <index>]
+//        [elementType] [byteOffset] [elementCount]
+//
+// Converts every element of a file to each type no wider than its own (float16, bfloat16, float8,
+// fixed point, and integers), showing the largest absolute, relative, and ulp errors, the root mean
+// square error, and how many values saturate or flush to zero. Values are converted the same way as
+// the convert command (floats rounding to nearest even), so the errors are those of converting the
+// file. Each slice of the file is decoded once a block at a time, then converted to every target
+// and back while the block is still cached.
+int AnalyzeFileConversionErrors(std::string_view arguments, /*out*/ std::string& stringOutput)
+{
+    std::vector<NamedFileView> fileViews;
+    if (ReadFileViewsParameters(/*inout*/ arguments, "qerror", /*out*/ fileViews, /*out*/ stringOutput) != EXIT_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+    std::string_view token = ReadToken(/*inout*/ arguments);
+    if (!token.empty())
+    {
+        stringOutput = GetFormatted("Unknown parameter: \"%.*s\"", int(token.size()), token.data());
+        return EXIT_FAILURE;
+    }
+    return RunFileViewsCommand(MakeSpan(fileViews), /*out*/ stringOutput, AnalyzeFileViewConversionErrors);
+}
+
+// Returns how the bits of an element type are ordered for ulp distances.
+Ulp::Layout GetUlpLayout(ElementType elementType) noexcept
+{
+    const ElementFieldMasks<uint64_t> masks(elementType);
+    Ulp::Layout layout = {};
+    layout.elementByteSize = GetSizeOfTypeInBytes(elementType);
+    layout.signMask = masks.isFloat ? masks.sign : 0;
+    layout.nanMagnitudeMinimum = masks.isFloat ? masks.exponent | masks.nanFractionMinimum : 0;
+    layout.isSigned = !masks.isFloat && IsSignedElementType(elementType);
+    return layout;
+}
+
+// Ulp distances between the elements of two files, merged across slices in order.
+struct UlpDistanceSummary
+{
+    uint64_t count = 0;                 // Of pairs compared, being all but NaN mismatches
+    uint64_t nanMismatchCount = 0;      // Of pairs where only one is NaN
+    uint64_t failureCount = 0;          // Of pairs beyond the tolerance, including NaN mismatches
+    uint64_t firstFailureIndex = UINT64_MAX;
+    uint64_t maximumDistance = 0;
+    uint64_t maximumIndex = 0;          // First element at the maximum distance
+    double distanceSum = 0;
+
+    void Merge(const UlpDistanceSummary& other) noexcept
+    {
+        count += other.count;
+        nanMismatchCount += other.nanMismatchCount;
+        failureCount += other.failureCount;
+        firstFailureIndex = std::min(firstFailureIndex, other.firstFailureIndex);
+        if (other.maximumDistance > maximumDistance)
+        {
+            maximumDistance = other.maximumDistance;
+            maximumIndex = other.maximumIndex;
+        }
+        distanceSum += other.distanceSum;
+    }
+};
+
+// ulpdiff <fileA> [tensor <name>] ... <fileB> [tensor <name>] ... [elementType] [byteOffset] [elementCount]
+//         [maxulp <count>] [stop]
+//
+// Compares two files of the same element type by the distance in units in the last place between
+// each pair of elements, being the count of representable values between them, showing the maximum
+// and mean distance and how many pairs fall in each power of two bucket of distances. Two NaNs are
+// equal, while a NaN paired with a number is counted apart. With maxulp, pairs further apart (or NaN
+// mismatches) fail the comparison, returning failure for scripts to gate on, and stop ends the
+// comparison at the first failing element.
+int CompareFileUlpDistances(std::string_view arguments, /*out*/ std::string& stringOutput)
+{
+    NumberFileView fileViewA, fileViewB;
+    if (ReadFileViewPairParameters(/*inout*/ arguments, "ulpdiff", /*out*/ fileViewA, /*out*/ fileViewB, /*out*/ stringOutput) != EXIT_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+
+    bool isGating = false, isStopping = false;
+    uint64_t tolerance = UINT64_MAX;
+    for (std::string_view token; !(token = ReadToken(/*inout*/ arguments)).empty(); )
+    {
+        if (token == "maxulp")
+        {
+            token = ReadToken(/*inout*/ arguments);
+            if (token.empty() || !isdigit(token.front()))
+            {
+                stringOutput = GetFormatted("Expected a count after \"maxulp\"");
+                return EXIT_FAILURE;
+            }
+            NumberUnionAndType number;
+            ParseNumber(token, ElementType::Uint64, /*parseAsRawData*/ false, /*out*/ number);
+            tolerance = number.numberUnion.ui64;
+            isGating = true;
+        }
+        else if (token == "stop")
+        {
+            isStopping = true;
+        }
+        else
+        {
+            stringOutput = GetFormatted("Unknown parameter: \"%.*s\"", int(token.size()), token.data());
+            return EXIT_FAILURE;
+        }
+    }
+    if (isStopping && !isGating)
+    {
+        tolerance = 0; // Stop at the first difference.
+        isGating = true;
+    }
+
+    const ElementType elementType = fileViewA.elementType;
+    const Ulp::Layout layout = GetUlpLayout(elementType);
+    const bool hasNan = (layout.nanMagnitudeMinimum != 0);
+
+    // Slices after a failure are skipped when stopping, while all before it still run, so the first
+    // failure found is the same for any thread count.
+    constexpr uint32_t bucketCount = 65; // By bit width of the distance, 0 for equal elements.
+    std::atomic<uint64_t> bucketCounts[bucketCount] = {};
+    std::atomic<uint64_t> firstFailureIndex = UINT64_MAX;
+    const uint64_t sliceCount = (fileViewA.elementCount + g_operandChunkSize - 1) / g_operandChunkSize;
+    std::vector<UlpDistanceSummary> sliceSummaries(static_cast<size_t>(sliceCount));
+    ParallelFor(sliceSummaries.size(), [&](size_t sliceIndex)
+    {
+        const uint64_t elementIndex = uint64_t(sliceIndex) * g_operandChunkSize;
+        if (isStopping && elementIndex > firstFailureIndex.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        const size_t count = size_t(std::min<uint64_t>(g_operandChunkSize, fileViewA.elementCount - elementIndex));
+        std::vector<uint64_t> bufferA(count), bufferB(count);
+        const uint8_t* elementsA = ReadNumberFileViewElements(fileViewA, elementIndex, count, /*out*/ reinterpret_cast<uint8_t*>(bufferA.data()));
+        const uint8_t* elementsB = ReadNumberFileViewElements(fileViewB, elementIndex, count, /*out*/ reinterpret_cast<uint8_t*>(bufferB.data()));
+
+        constexpr size_t blockElementCount = 4096;
+        uint64_t distances[blockElementCount];
+        uint32_t sliceBucketCounts[bucketCount] = {};
+        UlpDistanceSummary& summary = sliceSummaries[sliceIndex];
+        for (size_t blockBegin = 0; blockBegin < count && !(isStopping && summary.failureCount > 0); blockBegin += blockElementCount)
+        {
+            const size_t blockCount = std::min(blockElementCount, count - blockBegin);
+            const size_t byteOffset = blockBegin * layout.elementByteSize;
+            Ulp::ComputeUlpDistances(elementsA + byteOffset, elementsB + byteOffset, blockCount, layout, /*out*/ distances);
+            for (size_t i = 0; i < blockCount; ++i)
+            {
+                const uint64_t distance = distances[i];
+                const bool isNanMismatch = hasNan && distance == Ulp::nanMismatch;
+                if (isNanMismatch || distance > tolerance)
+                {
+                    summary.firstFailureIndex = std::min(summary.firstFailureIndex, elementIndex + blockBegin + i);
+                    summary.failureCount += isGating;
+                }
+                if (isNanMismatch)
+                {
+                    ++summary.nanMismatchCount;
+                    continue;
+                }
+                ++summary.count;
+                summary.distanceSum += double(distance);
+                ++sliceBucketCounts[std::bit_width(distance)];
+                if (distance > summary.maximumDistance)
+                {
+                    summary.maximumDistance = distance;
+                    summary.maximumIndex = elementIndex + blockBegin + i;
+                }
+            }
+        }
+
+        for (uint32_t i = 0; i < bucketCount; ++i)
+        {
+            bucketCounts[i].fetch_add(sliceBucketCounts[i], std::memory_order_relaxed);
+        }
+        if (isStopping && summary.failureCount > 0)
+        {
+            for (uint64_t index = firstFailureIndex.load(std::memory_order_relaxed);
+                 summary.firstFailureIndex < index && !firstFailureIndex.compare_exchange_weak(index, summary.firstFailureIndex, std::memory_order_relaxed);
+                 /*updated by compare_exchange_weak*/)
+            {
+            }
+        }
+    });
+
+    UlpDistanceSummary summary;
+    for (const UlpDistanceSummary& slice : sliceSummaries)
+    {
+        summary.Merge(slice);
+    }
+
+    const std::string_view typeName = GetTypeNameFromElementType(elementType);
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%.*s\n", "type", int(typeName.size()), typeName.data());
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%llu\n", "elements", static_cast<unsigned long long>(fileViewA.elementCount));
+
+    // Once stopped, the counts cover only part of the files, so show just where the failure is.
+    const bool hasFailed = isGating && summary.failureCount > 0;
+    if (!(isStopping && hasFailed))
+    {
+        AppendFormatted(/*inout*/ stringOutput, "%-11s%llu\n", "nandiffer", static_cast<unsigned long long>(summary.nanMismatchCount));
+        AppendFormatted(/*inout*/ stringOutput, "%-11s%llu\n", "maxulp", static_cast<unsigned long long>(summary.maximumDistance));
+        AppendFormatted(/*inout*/ stringOutput, "%-11s%llu\n", "maxindex", static_cast<unsigned long long>(summary.maximumIndex));
+        AppendFormatted(/*inout*/ stringOutput, "%-11s", "meanulp");
+        AppendCharacters(/*inout*/ stringOutput, (summary.count > 0) ? summary.distanceSum / double(summary.count) : 0.0);
+        stringOutput.push_back('\n');
+
+        // Show the non-empty buckets, as the power of two each starts at.
+        for (uint32_t i = 0; i < bucketCount; ++i)
+        {
+            const uint64_t count = bucketCounts[i].load(std::memory_order_relaxed);
+            if (count > 0)
+            {
+                const double percentage = 100.0 * double(count) / double(fileViewA.elementCount);
+                const std::string name = (i == 0) ? "0" : GetFormatted("2^%u", i - 1);
+                AppendFormatted(/*inout*/ stringOutput, "%-11s%-14llu%.4f%%\n", name.c_str(), static_cast<unsigned long long>(count), percentage);
+            }
+        }
+        if (isGating)
+        {
+            AppendFormatted(/*inout*/ stringOutput, "%-11s%llu\n", "failures", static_cast<unsigned long long>(summary.failureCount));
+        }
+    }
+    if (hasFailed)
+    {
+        AppendFormatted(/*inout*/ stringOutput, "%-11s%llu\n", "first", static_cast<unsigned long long>(summary.firstFailureIndex));
+    }
+    if (isGating)
+    {
+        AppendFormatted(/*inout*/ stringOutput, "%-11s%s\n", "result", hasFailed ? "fail" : "pass");
+    }
+    return hasFailed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// An element pair beyond the tolerance of a comparison.
+struct ToleranceMismatch
+{
+    uint64_t index = UINT64_MAX;
+    uint64_t bitsA = 0;         // Raw elements, to show in their own type
+    uint64_t bitsB = 0;
+    double absoluteError = 0;   // NaN when either is NaN
+    double toleranceRatio = 0;  // Of the absolute error to the allowed error, infinite for NaN and infinity mismatches
+
+    // Ranks by how many times over the tolerance the error is, then by the error, then by index, so
+    // the worst pairs are the same however the slices are merged.
+    bool IsWorseThan(const ToleranceMismatch& other) const noexcept
+    {
+        const double error = std::isnan(absoluteError) ? std::numeric_limits<double>::infinity() : absoluteError;
+        const double otherError = std::isnan(other.absoluteError) ? std::numeric_limits<double>::infinity() : other.absoluteError;
+        if (toleranceRatio != other.toleranceRatio)
+        {
+            return toleranceRatio > other.toleranceRatio;
+        }
+        if (error != otherError)
+        {
+            return error > otherError;
+        }
+        return index < other.index;
+    }
+};
+
+// Keeps the worst count mismatches in a heap whose front is the least bad of them, to be replaced
+// first.
+void PushWorstMismatch(/*inout*/ std::vector<ToleranceMismatch>& worstMismatches, size_t worstCount, const ToleranceMismatch& mismatch)
+{
+    auto isWorse = [](const ToleranceMismatch& a, const ToleranceMismatch& b) { return a.IsWorseThan(b); };
+    if (worstMismatches.size() < worstCount)
+    {
+        worstMismatches.push_back(mismatch);
+        std::push_heap(worstMismatches.begin(), worstMismatches.end(), isWorse);
+    }
+    else if (worstCount > 0 && mismatch.IsWorseThan(worstMismatches.front()))
+    {
+        std::pop_heap(worstMismatches.begin(), worstMismatches.end(), isWorse);
+        worstMismatches.back() = mismatch;
+        std::push_heap(worstMismatches.begin(), worstMismatches.end(), isWorse);
+    }
+}
+
+// compare <fileA> [tensor <name>] ... <fileB> [tensor <name>] ... [elementType] [byteOffset] [elementCount]
+//         [rtol <relative>] [atol <absolute>] [equalnan] [top <count>] [stop]
+//
+// Checks whether the elements of two files are close like numpy.allclose, being within
+// atol + rtol * abs(b), where b is the reference, and with the same defaults (rtol 1e-5, atol 1e-8).
+// Infinities are close only to the same infinity, and NaNs to nothing, unless equalnan makes them
+// close to each other. Failing pairs are counted, and the top count worst (by how many times over
+// the tolerance) are shown with both values and their absolute, relative, and ulp errors, or with
+// stop, just the first failing pair. The files are streamed a slice at a time, each keeping a
+// bounded heap of its worst pairs merged into a shared one, so memory stays small for any file size.
+int CompareFileTolerances(std::string_view arguments, /*out*/ std::string& stringOutput)
+{
+    NumberFileView fileViewA, fileViewB;
+    if (ReadFileViewPairParameters(/*inout*/ arguments, "compare", /*out*/ fileViewA, /*out*/ fileViewB, /*out*/ stringOutput) != EXIT_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+
+    double relativeTolerance = 1e-5, absoluteTolerance = 1e-8;
+    bool isEqualNan = false, isStopping = false;
+    uint64_t worstCount = 10;
+    for (std::string_view token; !(token = ReadToken(/*inout*/ arguments)).empty(); )
+    {
+        if (token == "rtol" || token == "atol" || token == "top")
+        {
+            // Accept either "rtol 1e-3" or "rtol=1e-3".
+            const std::string_view name = token;
+            std::string_view remainingArguments = arguments;
+            token = ReadToken(/*inout*/ remainingArguments);
+            if (token == "=")
+            {
+                arguments = remainingArguments;
+            }
+            token = ReadToken(/*inout*/ arguments);
+            if (token.empty() || !(isdigit(token.front()) || token.front() == '.'))
+            {
+                stringOutput = GetFormatted("Expected a number after \"%.*s\"", int(name.size()), name.data());
+                return EXIT_FAILURE;
+            }
+            NumberUnionAndType number;
+            ParseNumber(token, (name == "top") ? ElementType::Uint64 : ElementType::Float64, /*parseAsRawData*/ false, /*out*/ number);
+            if (name == "rtol")
+            {
+                relativeTolerance = number.numberUnion.f64;
+            }
+            else if (name == "atol")
+            {
+                absoluteTolerance = number.numberUnion.f64;
+            }
+            else
+            {
+                worstCount = number.numberUnion.ui64;
+            }
+        }
+        else if (token == "equalnan")
+        {
+            isEqualNan = true;
+        }
+        else if (token == "stop")
+        {
+            isStopping = true;
+        }
+        else
+        {
+            stringOutput = GetFormatted("Unknown parameter: \"%.*s\"", int(token.size()), token.data());
+            return EXIT_FAILURE;
+        }
+    }
+
+    const ElementType elementType = fileViewA.elementType;
+    const uint32_t elementByteSize = GetSizeOfTypeInBytes(elementType);
+    const size_t heapCount = size_t(worstCount);
+
+    // Slices after a failure are skipped when stopping, while all before it still run, so the first
+    // failure found is the same for any thread count.
+    std::mutex mergeMutex;
+    uint64_t failureCount = 0;
+    std::atomic<uint64_t> firstFailureIndex = UINT64_MAX;
+    ToleranceMismatch firstMismatch;
+    std::vector<ToleranceMismatch> worstMismatches;
+    const uint64_t sliceCount = (fileViewA.elementCount + g_operandChunkSize - 1) / g_operandChunkSize;
+    ParallelFor(static_cast<size_t>(sliceCount), [&](size_t sliceIndex)
+    {
+        const uint64_t elementIndex = uint64_t(sliceIndex) * g_operandChunkSize;
+        if (isStopping && elementIndex > firstFailureIndex.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        const size_t count = size_t(std::min<uint64_t>(g_operandChunkSize, fileViewA.elementCount - elementIndex));
+        std::vector<uint64_t> bufferA(count), bufferB(count);
+        const uint8_t* elementsA = ReadNumberFileViewElements(fileViewA, elementIndex, count, /*out*/ reinterpret_cast<uint8_t*>(bufferA.data()));
+        const uint8_t* elementsB = ReadNumberFileViewElements(fileViewB, elementIndex, count, /*out*/ reinterpret_cast<uint8_t*>(bufferB.data()));
+
+        constexpr size_t blockElementCount = 4096;
+        std::vector<double> valuesA(blockElementCount), valuesB(blockElementCount);
+        std::vector<ToleranceMismatch> sliceWorstMismatches;
+        uint64_t sliceFailureCount = 0;
+        ToleranceMismatch sliceFirstMismatch;
+        for (size_t blockBegin = 0; blockBegin < count && !(isStopping && sliceFailureCount > 0); blockBegin += blockElementCount)
+        {
+            const size_t blockCount = std::min(blockElementCount, count - blockBegin);
+            const size_t byteOffset = blockBegin * elementByteSize;
+            CastElementTypes(elementType, ElementType::Float64, elementsA + byteOffset, /*out*/ valuesA.data(), blockCount);
+            CastElementTypes(elementType, ElementType::Float64, elementsB + byteOffset, /*out*/ valuesB.data(), blockCount);
+            for (size_t i = 0; i < blockCount; ++i)
+            {
+                const double a = valuesA[i], b = valuesB[i];
+                const double absoluteError = std::abs(a - b);
+                const double allowedError = absoluteTolerance + relativeTolerance * std::abs(b);
+                const bool isFinite = std::isfinite(a) && std::isfinite(b);
+                const bool isClose = isFinite
+                    ? absoluteError <= allowedError
+                    : a == b || (isEqualNan && std::isnan(a) && std::isnan(b));
+                if (isClose)
+                {
+                    continue;
+                }
+
+                ToleranceMismatch mismatch;
+                mismatch.index = elementIndex + blockBegin + i;
+                memcpy(&mismatch.bitsA, elementsA + byteOffset + i * elementByteSize, elementByteSize);
+                memcpy(&mismatch.bitsB, elementsB + byteOffset + i * elementByteSize, elementByteSize);
+                mismatch.absoluteError = absoluteError;
+                mismatch.toleranceRatio = isFinite ? absoluteError / allowedError : std::numeric_limits<double>::infinity();
+                if (sliceFailureCount++ == 0)
+                {
+                    sliceFirstMismatch = mismatch;
+                }
+                PushWorstMismatch(/*inout*/ sliceWorstMismatches, heapCount, mismatch);
+            }
+        }
+
+        if (sliceFailureCount > 0)
+        {
+            std::lock_guard<std::mutex> lock(mergeMutex);
+            failureCount += sliceFailureCount;
+            if (sliceFirstMismatch.index < firstFailureIndex.load(std::memory_order_relaxed))
+            {
+                firstMismatch = sliceFirstMismatch;
+                firstFailureIndex.store(sliceFirstMismatch.index, std::memory_order_relaxed);
+            }
+            for (const ToleranceMismatch& mismatch : sliceWorstMismatches)
+            {
+                PushWorstMismatch(/*inout*/ worstMismatches, heapCount, mismatch);
+            }
+        }
+    });
+
+    const std::string_view typeName = GetTypeNameFromElementType(elementType);
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%.*s\n", "type", int(typeName.size()), typeName.data());
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%llu\n", "elements", static_cast<unsigned long long>(fileViewA.elementCount));
+    AppendFormatted(/*inout*/ stringOutput, "%-11s", "rtol");
+    AppendCharacters(/*inout*/ stringOutput, relativeTolerance);
+    AppendFormatted(/*inout*/ stringOutput, "\n%-11s", "atol");
+    AppendCharacters(/*inout*/ stringOutput, absoluteTolerance);
+    stringOutput.push_back('\n');
+
+    // Once stopped, the count covers only part of the files, so show just the first failing pair.
+    const bool hasFailed = (failureCount > 0);
+    if (!isStopping)
+    {
+        AppendFormatted(/*inout*/ stringOutput, "%-11s%llu\n", "failures", static_cast<unsigned long long>(failureCount));
+    }
+    if (hasFailed)
+    {
+        AppendFormatted(/*inout*/ stringOutput, "%-11s%llu\n", "first", static_cast<unsigned long long>(firstMismatch.index));
+        if (isStopping)
+        {
+            worstMismatches.assign(1, firstMismatch);
+        }
+        else
+        {
+            std::sort_heap(worstMismatches.begin(), worstMismatches.end(), [](const ToleranceMismatch& a, const ToleranceMismatch& b) { return a.IsWorseThan(b); });
+        }
+
+        const Ulp::Layout layout = GetUlpLayout(elementType);
+        AppendFormatted(/*inout*/ stringOutput, "%-14s%-14s%-14s%-14s%s\n", "index", "abserror", "relerror", "ulperror", "values");
+        for (const ToleranceMismatch& mismatch : worstMismatches)
+        {
+            NumberUnion numberA, numberB;
+            numberA.ui64 = mismatch.bitsA;
+            numberB.ui64 = mismatch.bitsB;
+            const double b = ReadToDouble(elementType, numberB.buffer);
+            uint64_t ulpDistance;
+            Ulp::ComputeUlpDistances(numberA.buffer, numberB.buffer, 1, layout, /*out*/ &ulpDistance);
+            const bool isNanMismatch = (layout.nanMagnitudeMinimum != 0 && ulpDistance == Ulp::nanMismatch);
+
+            AppendFormatted(
+                /*inout*/ stringOutput,
+                "%-14llu%-14.6g%-14.6g",
+                static_cast<unsigned long long>(mismatch.index),
+                mismatch.absoluteError,
+                std::abs(mismatch.absoluteError / b)
+            );
+            if (isNanMismatch)
+            {
+                AppendFormatted(/*inout*/ stringOutput, "%-14s", "nan");
+            }
+            else
+            {
+                AppendFormatted(/*inout*/ stringOutput, "%-14llu", static_cast<unsigned long long>(ulpDistance));
+            }
+            AppendFormattedNumericValue(/*inout*/ stringOutput, elementType, numberA.buffer, " (", ")", NumericPrintingFlags::Default & ~NumericPrintingFlags::ShowNumericType);
+            stringOutput.append(" vs ");
+            AppendFormattedNumericValue(/*inout*/ stringOutput, elementType, numberB.buffer, " (", ")", NumericPrintingFlags::Default & ~NumericPrintingFlags::ShowNumericType);
+            stringOutput.push_back('\n');
+        }
+    }
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%s\n", "result", hasFailed ? "fail" : "pass");
+    return hasFailed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// Calls function with the FloatNumberDefinitions::Details of a float element type (an empty
+// instance, for its constants), returning false for types that are not floats.
+template <typename Function>
+bool VisitFloatDefinition(ElementType elementType, Function&& function)
+{
+    using namespace FloatNumberDefinitions;
+    switch (elementType)
+    {
+    case ElementType::Float8m3e4s1: function(Float8f3e4s1{}); return true;
+    case ElementType::Float8m2e5s1: function(Float8f2e5s1{}); return true;
+    case ElementType::Float16:      function(Float16f10e5s1{}); return true;
+    case ElementType::Bfloat16:     function(Float16f7e8s1{}); return true;
+    case ElementType::Float32:      function(Float32{}); return true;
+    case ElementType::Float64:      function(Float64{}); return true;
+    default: return false;
+    }
+}
+
+// Returns the layout of a float type's bits for finding non-finite values, from its definition's
+// masks, where the least non-finite magnitude is infinity or else the lowest NaN. Returns false for
+// types that cannot be non-finite, like integers and fixed point.
+bool GetNonfiniteLayout(ElementType elementType, /*out*/ Nonfinite::Layout& layout) noexcept
+{
+    return VisitFloatDefinition(elementType, [&](auto definition)
+    {
+        using Definition = decltype(definition);
+        layout = {
+            uint32_t(sizeof(typename Definition::baseIntegerType)),
+            uint64_t(Definition::fractionAndExponentMask),
+            uint64_t(Definition::hasInfinity ? Definition::exponentMask : Definition::minimumNanBitValue),
+        };
+    });
+}
+
+// nanscan <file> [file ...] [elementType] [first <count>]
+//
+// Finds the first NaN and infinity positions of every float tensor of each file, like the
+// checkpoints of a diverged training run, comparing bits rather than decoding values. The element
+// type applies to raw files. Slices of all files are scanned in parallel, with each file stopping
+// at its first count (10 by default) non-finite values.
+int ScanFilesForNonfinite(std::string_view arguments, /*out*/ std::string& stringOutput)
+{
+    std::vector<std::string> fileNames;
+    ElementType explicitElementType = ElementType::Undefined;
+    uint64_t hitLimit = 10;
+    for (std::string_view word; !(word = ReadWord(/*inout*/ arguments)).empty(); )
+    {
+        const Keyword* typeKeyword = g_keywordHashTable.Find(word, g_keywords);
+        if (typeKeyword != nullptr && typeKeyword->type == KeywordType::ElementType)
+        {
+            explicitElementType = ElementType(typeKeyword->value);
+            Nonfinite::Layout layout;
+            if (!GetNonfiniteLayout(explicitElementType, /*out*/ layout))
+            {
+                stringOutput = GetFormatted("Expected a float element type, not %.*s", int(word.size()), word.data());
+                return EXIT_FAILURE;
+            }
+        }
+        else if (word == "first")
+        {
+            word = ReadWord(/*inout*/ arguments);
+            if (word.empty() || !isdigit(word.front()))
+            {
+                stringOutput = GetFormatted("Expected a count after \"first\"");
+                return EXIT_FAILURE;
+            }
+            NumberUnionAndType number;
+            ParseNumber(word, ElementType::Uint64, /*parseAsRawData*/ false, /*out*/ number);
+            hitLimit = std::max<uint64_t>(number.numberUnion.ui64, 1);
+        }
+        else
+        {
+            fileNames.emplace_back(Tokenizer::Unquote(word));
+        }
+    }
+    if (fileNames.empty())
+    {
+        stringOutput = GetFormatted("Expected a file name after \"nanscan\"");
+        return EXIT_FAILURE;
+    }
+
+    // Map every float tensor of every file as a view, and split the views into slices.
+    struct ScanView
+    {
+        NumberFileView fileView;
+        Nonfinite::Layout layout;
+        std::string tensorName;
+    };
+    struct ScanTask
+    {
+        size_t fileIndex;
+        size_t viewIndex;
+        uint64_t elementIndex;
+    };
+    std::vector<ScanView> views;
+    std::vector<ScanTask> tasks;
+    std::vector<uint64_t> fileElementCounts(fileNames.size());
+    for (size_t fileIndex = 0; fileIndex < fileNames.size(); ++fileIndex)
+    {
+        const std::string& fileName = fileNames[fileIndex];
+        auto file = std::make_shared<MappedFile>();
+        if (!file->Open(fileName.c_str()))
+        {
+            stringOutput = GetFormatted("Could not read file: \"%s\"", fileName.c_str());
+            return EXIT_FAILURE;
+        }
+        std::vector<FileTensor> tensors;
+        if (ReadFileTensors(*file, fileName, /*out*/ tensors, /*out*/ stringOutput) != EXIT_SUCCESS)
+        {
+            return EXIT_FAILURE;
+        }
+        file->AdviseSequential();
+
+        for (FileTensor& tensor : tensors)
+        {
+            if (tensor.dtype.empty())
+            {
+                if (explicitElementType == ElementType::Undefined)
+                {
+                    stringOutput = GetFormatted("Expected a float element type for raw file: \"%s\"", fileName.c_str());
+                    return EXIT_FAILURE;
+                }
+                tensor.elementType = explicitElementType;
+            }
+
+            // Block quantized tensors decode to float32, whose scales may have overflowed.
+            ScanView view = {};
+            if (tensor.isInt24 || !GetNonfiniteLayout(tensor.elementType, /*out*/ view.layout))
+            {
+                continue;
+            }
+            view.fileView = MakeTensorFileView(file, tensor);
+            view.tensorName = std::move(tensor.name);
+            const NumberFileView& fileView = view.fileView;
+
+            for (uint64_t elementIndex = 0; elementIndex < fileView.elementCount; elementIndex += g_operandChunkSize)
+            {
+                tasks.push_back({fileIndex, views.size(), elementIndex});
+            }
+            fileElementCounts[fileIndex] += fileView.elementCount;
+            views.push_back(std::move(view));
+        }
+    }
+
+    // Each slice keeps its own first hits, and once the completed slices of a file hold enough
+    // before some slice, any later slice of that file is skipped. So the hits shown are the same
+    // for any thread count.
+    struct NonfiniteHit
+    {
+        size_t viewIndex;
+        uint64_t elementIndex;
+        uint64_t bits;
+    };
+    std::vector<std::vector<NonfiniteHit>> taskHits(tasks.size());
+    std::vector<std::map<size_t, size_t>> fileTaskHitCounts(fileNames.size());
+    std::vector<std::atomic<size_t>> fileCutoffTasks(fileNames.size());
+    for (std::atomic<size_t>& cutoffTask : fileCutoffTasks)
+    {
+        cutoffTask.store(SIZE_MAX, std::memory_order_relaxed);
+    }
+    std::mutex mergeMutex;
+    ParallelFor(tasks.size(), [&](size_t taskIndex)
+    {
+        const ScanTask& task = tasks[taskIndex];
+        if (taskIndex > fileCutoffTasks[task.fileIndex].load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        const ScanView& view = views[task.viewIndex];
+        const NumberFileView& fileView = view.fileView;
+        const size_t count = size_t(std::min<uint64_t>(g_operandChunkSize, fileView.elementCount - task.elementIndex));
+
+        // Little-endian elements are read in place, so only others need a buffer.
+        const bool isInPlace = (fileView.blockQuantizedType == 0 && !fileView.isBigEndian);
+        std::unique_ptr<uint64_t[]> buffer(isInPlace ? nullptr : new uint64_t[count]);
+        const uint8_t* elements = ReadNumberFileViewElements(fileView, task.elementIndex, count, /*out*/ reinterpret_cast<uint8_t*>(buffer.get()));
+
+        std::vector<NonfiniteHit>& hits = taskHits[taskIndex];
+        for (size_t i = 0; hits.size() < hitLimit && (i = Nonfinite::FindNext(elements, i, count, view.layout)) < count; ++i)
+        {
+            NonfiniteHit hit = {task.viewIndex, task.elementIndex + i, 0};
+            memcpy(&hit.bits, elements + i * view.layout.elementByteSize, view.layout.elementByteSize);
+            hits.push_back(hit);
+        }
+
+        if (!hits.empty())
+        {
+            std::lock_guard<std::mutex> lock(mergeMutex);
+            std::map<size_t, size_t>& taskHitCounts = fileTaskHitCounts[task.fileIndex];
+            taskHitCounts[taskIndex] = hits.size();
+            uint64_t hitCount = 0;
+            for (auto [hitTaskIndex, taskHitCount] : taskHitCounts)
+            {
+                hitCount += taskHitCount;
+                if (hitCount >= hitLimit)
+                {
+                    fileCutoffTasks[task.fileIndex].store(hitTaskIndex, std::memory_order_relaxed);
+                    break;
+                }
+            }
+        }
+    });
+
+    // Tasks are in file order, so each file's hits are a run of them.
+    size_t nonfiniteFileCount = 0;
+    for (size_t fileIndex = 0, taskIndex = 0; fileIndex < fileNames.size(); ++fileIndex)
+    {
+        std::vector<NonfiniteHit> hits;
+        for (/*above*/; taskIndex < tasks.size() && tasks[taskIndex].fileIndex == fileIndex; ++taskIndex)
+        {
+            hits.insert(hits.end(), taskHits[taskIndex].begin(), taskHits[taskIndex].end());
+        }
+        // Once the limit is reached, later slices were skipped, so the full count is unknown.
+        const bool isLimited = (hits.size() >= hitLimit);
+        hits.resize(std::min<size_t>(hits.size(), size_t(hitLimit)));
+        nonfiniteFileCount += !hits.empty();
+
+        AppendFormatted(
+            /*inout*/ stringOutput,
+            "%s: %s%zu nonfinite in %llu elements\n",
+            fileNames[fileIndex].c_str(),
+            isLimited ? "first " : "",
+            hits.size(),
+            static_cast<unsigned long long>(fileElementCounts[fileIndex])
+        );
+        for (const NonfiniteHit& hit : hits)
+        {
+            const ScanView& view = views[hit.viewIndex];
+            NumberUnion number = {};
+            number.ui64 = hit.bits;
+            AppendFormatted(/*inout*/ stringOutput, "    %s[%llu] ", view.tensorName.c_str(), static_cast<unsigned long long>(hit.elementIndex));
+            AppendFormattedNumericValue(/*inout*/ stringOutput, view.fileView.elementType, number.buffer, " (", ")", NumericPrintingFlags::Default & ~NumericPrintingFlags::ShowNumericType);
+            stringOutput.push_back('\n');
+        }
+        FlushOutputIfLarge(/*inout*/ stringOutput);
+    }
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%zu of %zu\n", "nonfinite", nonfiniteFileCount, fileNames.size());
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%s\n", "result", nonfiniteFileCount > 0 ? "fail" : "pass");
+    return nonfiniteFileCount > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// Limits of a target type in values, for counting which elements of a source fall outside them.
+struct CensusTarget
+{
+    ElementType elementType;
+    double maximum;             // Greatest finite value
+    double minimum;             // Least finite value
+    double maximumUlp;          // Spacing of values at the extremes
+    double minimumNormal;       // Least positive value with full precision
+    double minimumPositive;     // Least positive value, a subnormal if the type has them
+    bool isMaximumOdd;          // Whether the extremes have an odd last bit, so ties beyond them round away from them
+    bool isMinimumOdd;
+    bool hasInfinity;
+    bool isFloat;
+
+    // Float limits come from the definition's constants, where the largest legal bits of types with
+    // infinity are infinity itself, just above the greatest finite value.
+    explicit CensusTarget(ElementType targetElementType)
+    {
+        elementType = targetElementType;
+        const bool isFloatTarget = VisitFloatDefinition(targetElementType, [&](auto definition)
+        {
+            using Definition = decltype(definition);
+            constexpr int32_t fractionBitCount = int32_t(Definition::fractionBitCount);
+            const uint64_t maximumBits = uint64_t(Definition::maximumLegalBitValue) - (Definition::hasInfinity ? 1 : 0);
+            const uint64_t maximumFraction = maximumBits & uint64_t(Definition::fractionMask);
+            const int32_t maximumExponent = int32_t(maximumBits >> fractionBitCount) - Definition::exponentBias;
+            const int32_t minimumExponent = 1 - Definition::exponentBias;
+            maximum = std::ldexp(double((uint64_t(1) << fractionBitCount) | maximumFraction), maximumExponent - fractionBitCount);
+            minimum = -maximum;
+            maximumUlp = std::ldexp(1.0, maximumExponent - fractionBitCount);
+            minimumNormal = std::ldexp(1.0, minimumExponent);
+            minimumPositive = Definition::hasSubnormals ? std::ldexp(1.0, minimumExponent - fractionBitCount) : minimumNormal;
+            isMaximumOdd = (maximumFraction & 1) != 0;
+            isMinimumOdd = isMaximumOdd;
+            hasInfinity = Definition::hasInfinity;
+        });
+
+        // Integers and fixed point are two's complement (or unsigned), where the greatest value
+        // is odd, and the least even.
+        isFloat = isFloatTarget;
+        if (!isFloat)
+        {
+            const ConversionTarget range(targetElementType);
+            maximum = range.maximum;
+            minimum = range.minimum;
+            maximumUlp = range.fixedUlp;
+            minimumNormal = range.fixedUlp;
+            minimumPositive = range.fixedUlp;
+            isMaximumOdd = true;
+            isMinimumOdd = false;
+            hasInfinity = false;
+        }
+    }
+};
+
+// Returns the least magnitude bits (up to finiteMagnitudeEnd) of a float type whose value is above
+// the given value, or at it if inclusive. Magnitudes order the same as their values, so a binary
+// search of the bits finds it in a few dozen decodes.
+uint64_t FindLeastMagnitudeAbove(ElementType elementType, uint64_t finiteMagnitudeEnd, double value, bool isInclusive)
+{
+    uint64_t low = 0, high = finiteMagnitudeEnd;
+    while (low < high)
+    {
+        NumberUnion number = {};
+        number.ui64 = low + (high - low) / 2;
+        const double magnitude = ReadToDouble(elementType, number.buffer);
+        if (isInclusive ? magnitude >= value : magnitude > value)
+        {
+            high = number.ui64;
+        }
+        else
+        {
+            low = number.ui64 + 1;
+        }
+    }
+    return low;
+}
+
+// Returns the ordinal bands of a source float type's elements which round (to nearest even) to a
+// finite value, zero, or a subnormal of the target.
+RangeCensus::TargetBands GetRangeCensusBands(ElementType sourceElementType, const RangeCensus::Layout& layout, const CensusTarget& target)
+{
+    auto findLeastAbove = [&](double value, bool isInclusive) -> int64_t
+    {
+        return int64_t(FindLeastMagnitudeAbove(sourceElementType, layout.finiteMagnitudeEnd, value, isInclusive));
+    };
+    RangeCensus::TargetBands bands;
+    const double halfUlp = target.maximumUlp / 2;
+    bands.inRange.highInclusive = findLeastAbove(target.maximum + halfUlp, target.isMaximumOdd) - 1;
+    bands.inRange.lowExclusive = -findLeastAbove(-target.minimum + halfUlp, target.isMinimumOdd);
+
+    // Ties round to the even zero, but up to the even least normal value from the odd greatest
+    // subnormal.
+    const int64_t underflowHigh = findLeastAbove(target.minimumPositive / 2, /*isInclusive*/ false) - 1;
+    bands.underflow = {-underflowHigh - 1, underflowHigh};
+    bands.subnormal = bands.underflow;
+    if (target.minimumNormal > target.minimumPositive)
+    {
+        const int64_t subnormalHigh = findLeastAbove(target.minimumNormal - target.minimumPositive / 2, /*isInclusive*/ true) - 1;
+        bands.subnormal = {-subnormalHigh - 1, subnormalHigh};
+    }
+    return bands;
+}
+
+// Counts the range census of file views of the same element type together, for the census command.
+int CountFileViewRangeCensus(Span<const NumberFileView> fileViews, /*out*/ std::string& stringOutput)
+{
+    const ElementType elementType = fileViews.front().elementType;
+    RangeCensus::Layout layout = {};
+    if (fileViews.front().isInt24 || !VisitFloatDefinition(elementType, [&](auto definition)
+        {
+            using Definition = decltype(definition);
+            layout.elementByteSize = uint32_t(sizeof(typename Definition::baseIntegerType));
+            layout.signMask = uint64_t(Definition::signMask);
+            layout.finiteMagnitudeEnd = uint64_t(Definition::hasInfinity ? Definition::exponentMask : Definition::minimumNanBitValue);
+            layout.nanMagnitudeMinimum = uint64_t(Definition::minimumNanBitValue);
+        }))
+    {
+        const std::string_view typeName = fileViews.front().isInt24 ? g_int24TypeName : GetTypeNameFromElementType(elementType);
+        stringOutput = GetFormatted("Expected a float element type, not %.*s", int(typeName.size()), typeName.data());
+        return EXIT_FAILURE;
+    }
+
+    constexpr ElementType targetElementTypes[] =
+    {
+        ElementType::Float16, ElementType::Bfloat16, ElementType::Float8m3e4s1, ElementType::Float8m2e5s1,
+        ElementType::Fixed24f12i12, ElementType::Fixed32f16i16, ElementType::Fixed32f24i8,
+        ElementType::Int8, ElementType::Uint8, ElementType::Int16, ElementType::Uint16, ElementType::Int32, ElementType::Uint32,
+    };
+    std::vector<CensusTarget> targets;
+    std::vector<RangeCensus::TargetBands> targetBands;
+    for (ElementType targetElementType : targetElementTypes)
+    {
+        if (targetElementType != elementType && GetSizeOfTypeInBytes(targetElementType) <= GetSizeOfTypeInBytes(elementType))
+        {
+            targets.emplace_back(targetElementType);
+            targetBands.push_back(GetRangeCensusBands(elementType, layout, targets.back()));
+        }
+    }
+
+    const FileViewSlices slices(fileViews);
+    const uint64_t sliceCount = slices.size();
+    const uint64_t elementCount = slices.GetElementCount();
+    std::vector<RangeCensus::BandCounts> sliceBandCounts(static_cast<size_t>(sliceCount) * targets.size());
+    std::vector<RangeCensus::ClassCounts> sliceClassCounts(static_cast<size_t>(sliceCount));
+    ParallelFor(static_cast<size_t>(sliceCount), [&](size_t sliceIndex)
+    {
+        const FileViewSlices::Slice slice = slices[sliceIndex];
+        const size_t count = slice.count;
+        std::vector<uint64_t> buffer(count);
+        const uint8_t* elements = ReadNumberFileViewElements(*slice.fileView, slice.elementIndex, count, /*out*/ reinterpret_cast<uint8_t*>(buffer.data()));
+        RangeCensus::CountBands(
+            elements,
+            count,
+            layout,
+            targetBands.data(),
+            targetBands.size(),
+            /*inout*/ sliceClassCounts[sliceIndex],
+            /*inout*/ sliceBandCounts.data() + sliceIndex * targets.size()
+        );
+    });
+
+    RangeCensus::ClassCounts classCounts;
+    std::vector<RangeCensus::BandCounts> bandCounts(targets.size());
+    for (size_t sliceIndex = 0; sliceIndex < sliceCount; ++sliceIndex)
+    {
+        const RangeCensus::ClassCounts& sliceClasses = sliceClassCounts[sliceIndex];
+        classCounts.finite += sliceClasses.finite;
+        classCounts.notNan += sliceClasses.notNan;
+        classCounts.zero += sliceClasses.zero;
+        for (size_t targetIndex = 0; targetIndex < targets.size(); ++targetIndex)
+        {
+            const RangeCensus::BandCounts& sliceBands = sliceBandCounts[sliceIndex * targets.size() + targetIndex];
+            bandCounts[targetIndex].inRange += sliceBands.inRange;
+            bandCounts[targetIndex].underflow += sliceBands.underflow;
+            bandCounts[targetIndex].subnormal += sliceBands.subnormal;
+        }
+    }
+
+    const std::string_view typeName = GetTypeNameFromElementType(elementType);
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%.*s\n", "type", int(typeName.size()), typeName.data());
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%llu\n", "elements", static_cast<unsigned long long>(elementCount));
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%llu\n", "nan", static_cast<unsigned long long>(elementCount - classCounts.notNan));
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%llu\n", "infinity", static_cast<unsigned long long>(classCounts.notNan - classCounts.finite));
+    AppendFormatted(/*inout*/ stringOutput, "%-14s%-14s%-14s%-14s%s\n", "target", "overflow", "underflow", "subnormal", "nan");
+    for (size_t targetIndex = 0; targetIndex < targets.size(); ++targetIndex)
+    {
+        // Infinity stays infinite in float targets that have it, becomes NaN in those that do not,
+        // and overflows integers. Zeros are in every underflow band, which is within the subnormal.
+        const CensusTarget& target = targets[targetIndex];
+        const RangeCensus::BandCounts& counts = bandCounts[targetIndex];
+        const bool isInfinityNan = target.isFloat && !target.hasInfinity;
+        const uint64_t overflowableCount = target.isFloat ? classCounts.finite : classCounts.notNan;
+        AppendFormatted(
+            /*inout*/ stringOutput,
+            "%-14s%-14llu%-14llu%-14llu%llu\n",
+            GetTypeNameFromElementType(target.elementType).data(),
+            static_cast<unsigned long long>(overflowableCount - counts.inRange),
+            static_cast<unsigned long long>(counts.underflow - classCounts.zero),
+            static_cast<unsigned long long>(counts.subnormal - counts.underflow),
+            static_cast<unsigned long long>(elementCount - (isInfinityNan ? classCounts.finite : classCounts.notNan))
+        );
+    }
+    return EXIT_SUCCESS;
+}
+
+// census <filename> [tensor <name>] [rows <first> [count]] [columns <first> [count]] [channel <index>]
+//        [elementType] [byteOffset] [elementCount]
+//
+// Counts how many float elements of a file would overflow, round to zero, become subnormal, or
+// become NaN when converted (rounding to nearest even) to each type no wider than their own.
+// Rather than converting to every target like qerror, each element's bits are compared against
+// bands precomputed from every target's limits, in a single pass over the file.
+int CountFileRangeCensus(std::string_view arguments, /*out*/ std::string& stringOutput)
+{
+    std::vector<NamedFileView> fileViews;
+    if (ReadFileViewsParameters(/*inout*/ arguments, "census", /*out*/ fileViews, /*out*/ stringOutput) != EXIT_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+    std::string_view token = ReadToken(/*inout*/ arguments);
+    if (!token.empty())
+    {
+        stringOutput = GetFormatted("Unknown parameter: \"%.*s\"", int(token.size()), token.data());
+        return EXIT_FAILURE;
+    }
+    return RunFileViewsCommand(MakeSpan(fileViews), /*out*/ stringOutput, CountFileViewRangeCensus);
+}
+
+// Groups of elements sharing a quantization scale, as runs of consecutive elements within rows:
+// one group for a whole tensor, one per index of an axis (where each run spans the dimensions
+// after the axis, and every row repeats the same groups), or one per block of the last axis.
+struct QuantizationGroups
+{
+    uint64_t rowLength = 1;
+    uint64_t runLength = 1;         // Up to the row length, with any shorter last run of a row its own group
+    uint64_t rowGroupStride = 0;    // Groups per row for blocks, else zero
+    uint64_t groupCount = 1;
+
+    // Calls onRun(group, runBegin, runEnd) for each run of consecutive elements in [begin, end) of the
+    // same group, dividing only once rather than per element.
+    template <typename RunFunction>
+    void ForEachRun(uint64_t begin, uint64_t end, RunFunction&& onRun) const
+    {
+        uint64_t row = begin / rowLength, column = begin % rowLength;
+        uint64_t runIndex = column / runLength;
+        for (uint64_t i = begin; i < end; /*below*/)
+        {
+            const uint64_t runEndColumn = std::min((runIndex + 1) * runLength, rowLength);
+            const uint64_t runEnd = std::min(i + (runEndColumn - column), end);
+            onRun(row * rowGroupStride + runIndex, i, runEnd);
+            i = runEnd;
+            column = runEndColumn;
+            ++runIndex;
+            if (column == rowLength)
+            {
+                column = 0;
+                runIndex = 0;
+                ++row;
+            }
+        }
+    }
+};
+
+// Writes an array as a .npy file of the given shape, or as raw data for other extensions.
+bool WriteArrayFile(const std::string& fileName, ElementType elementType, const std::vector<uint64_t>& shape, const void* data, size_t byteCount)
+{
+    const std::string_view extension = std::string_view(fileName).substr(std::min(fileName.size(), fileName.find_last_of('.')));
+    std::string contents;
+    if (extension == ".npy")
+    {
+        contents = Npy::MakeHeader(GetNpyDescrFromElementType(elementType), /*isFortranOrder*/ false, shape);
+    }
+    contents.append(reinterpret_cast<const char*>(data), byteCount);
+
+    constexpr size_t bufferByteSize = size_t(1) << 22;
+    FileIo::Writer file;
+    if (!file.Open(fileName.c_str(), {bufferByteSize, 4, /*useDirectIo*/ false}))
+    {
+        return false;
+    }
+    for (size_t offset = 0; offset < contents.size(); offset += bufferByteSize)
+    {
+        const size_t chunkByteCount = std::min(bufferByteSize, contents.size() - offset);
+        memcpy(file.GetBuffer(), contents.data() + offset, chunkByteCount);
+        file.Write(chunkByteCount);
+    }
+    return file.Close();
+}
+
+// quantize <filename> [tensor <name>] [elementType] <float8e4m3 | float8e5m2 | int8 | uint8>
+//          [axis <index> | block <size>] [asymmetric] [scales <file>] [zeropoints <file>] [out <file>]
+//
+// Plans quantization of a tensor, finding the range of each group of elements (the whole tensor,
+// each index of an axis like the output channels of weights, or each block of the last axis) in
+// one parallel pass, and deriving the scale that maps it onto the target's range: amax / 448 for
+// float8 e4m3, amax / 57344 for e5m2, and amax / 127 for int8. Asymmetric int8 (and always uint8)
+// maps [minimum, maximum] onto the whole integer range with a zero point instead. Elements
+// dequantize as (q - zeroPoint) * scale.
+//
+// The scales (and zero points) are listed, or written as float32 (and target type) .npy or raw
+// files, and the quantized tensor is written by a second pass, rounding to nearest even.
+int QuantizeFile(std::string_view arguments, /*out*/ std::string& stringOutput)
+{
+    std::string fileName(Tokenizer::Unquote(ReadWord(/*inout*/ arguments)));
+    if (fileName.empty())
+    {
+        stringOutput = GetFormatted("Expected a file name after \"quantize\"");
+        return EXIT_FAILURE;
+    }
+    std::string tensorName;
+    std::string_view remainingArguments = arguments;
+    if (ReadToken(/*inout*/ arguments) == "tensor")
+    {
+        tensorName = Tokenizer::Unquote(ReadWord(/*inout*/ arguments));
+        remainingArguments = arguments;
+    }
+    arguments = remainingArguments;
+
+    // Either just the target type, or the type of a raw file then the target type.
+    ElementType elementTypes[2] = {};
+    size_t elementTypeCount = 0;
+    for (/*above*/; elementTypeCount < 2; ++elementTypeCount)
+    {
+        remainingArguments = arguments;
+        const Keyword* keyword = ReadFileElementType(/*inout*/ arguments);
+        if (keyword == nullptr)
+        {
+            arguments = remainingArguments;
+            break;
+        }
+        elementTypes[elementTypeCount] = ElementType(keyword->value);
+    }
+    const ElementType targetElementType = (elementTypeCount > 0) ? elementTypes[elementTypeCount - 1] : ElementType::Undefined;
+    const ElementType explicitElementType = (elementTypeCount > 1) ? elementTypes[0] : ElementType::Undefined;
+    if (targetElementType != ElementType::Float8m3e4s1 && targetElementType != ElementType::Float8m2e5s1
+    &&  targetElementType != ElementType::Int8 && targetElementType != ElementType::Uint8)
+    {
+        stringOutput = GetFormatted("Expected a target element type of float8e4m3, float8e5m2, int8, or uint8");
+        return EXIT_FAILURE;
+    }
+
+    bool hasAxis = false, isAsymmetric = (targetElementType == ElementType::Uint8);
+    bool isAxisFromEnd = false;
+    uint64_t axis = 0, blockSize = 0;
+    std::string scalesFileName, zeroPointsFileName, outputFileName;
+    for (std::string_view token; !(token = ReadToken(/*inout*/ arguments)).empty(); )
+    {
+        if (token == "axis" || token == "block")
+        {
+            const std::string_view name = token;
+            token = ReadToken(/*inout*/ arguments);
+            const bool isNegative = (name == "axis" && !token.empty() && token.front() == '-');
+            const std::string_view digits = token.substr(isNegative ? 1 : 0);
+            if (digits.empty() || !isdigit(digits.front()))
+            {
+                stringOutput = GetFormatted("Expected a number after \"%.*s\"", int(name.size()), name.data());
+                return EXIT_FAILURE;
+            }
+            NumberUnionAndType number;
+            ParseNumber(digits, ElementType::Uint64, /*parseAsRawData*/ false, /*out*/ number);
+            if (name == "axis")
+            {
+                hasAxis = true;
+                isAxisFromEnd = isNegative;
+                axis = number.numberUnion.ui64;
+            }
+            else
+            {
+                blockSize = number.numberUnion.ui64;
+                if (blockSize == 0)
+                {
+                    stringOutput = GetFormatted("Expected a block size over zero");
+                    return EXIT_FAILURE;
+                }
+            }
+        }
+        else if (token == "asymmetric")
+        {
+            isAsymmetric = true;
+        }
+        else if (token == "scales" || token == "zeropoints" || token == "out")
+        {
+            std::string& name = (token == "scales") ? scalesFileName : (token == "zeropoints") ? zeroPointsFileName : outputFileName;
+            name = Tokenizer::Unquote(ReadWord(/*inout*/ arguments));
+            if (name.empty())
+            {
+                stringOutput = GetFormatted("Expected a file name after \"%.*s\"", int(token.size()), token.data());
+                return EXIT_FAILURE;
+            }
+        }
+        else
+        {
+            stringOutput = GetFormatted("Unknown parameter: \"%.*s\"", int(token.size()), token.data());
+            return EXIT_FAILURE;
+        }
+    }
+    if (hasAxis && blockSize > 0)
+    {
+        stringOutput = GetFormatted("Expected either an axis or a block size, not both");
+        return EXIT_FAILURE;
+    }
+    if (isAsymmetric && targetElementType != ElementType::Int8 && targetElementType != ElementType::Uint8)
+    {
+        stringOutput = GetFormatted("Expected int8 or uint8 for asymmetric quantization");
+        return EXIT_FAILURE;
+    }
+
+    auto file = std::make_shared<MappedFile>();
+    if (!file->Open(fileName.c_str()))
+    {
+        stringOutput = GetFormatted("Could not read file: \"%s\"", fileName.c_str());
+        return EXIT_FAILURE;
+    }
+    FileTensor tensor;
+    if (SelectFileTensor(*file, fileName, tensorName, explicitElementType, /*isExplicitInt24*/ false, ElementType::Undefined, /*out*/ tensor, /*out*/ stringOutput) != EXIT_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+    if (!IsFileElementType(tensor.elementType))
+    {
+        stringOutput = GetFormatted("Expected a numeric element type for file: \"%s\"", fileName.c_str());
+        return EXIT_FAILURE;
+    }
+    file->AdviseSequential();
+    const NumberFileView fileView = MakeTensorFileView(file, tensor);
+    const ElementType elementType = fileView.elementType;
+    const uint64_t elementCount = fileView.elementCount;
+
+    // Raw files are one dimensional.
+    std::vector<uint64_t> shape = tensor.shape;
+    if (tensor.dtype.empty())
+    {
+        shape = {elementCount};
+    }
+    if ((hasAxis || blockSize > 0) && (shape.empty() || tensor.isFortranOrder))
+    {
+        stringOutput = GetFormatted("Expected a row major tensor for axis or block scales of file: \"%s\"", fileName.c_str());
+        return EXIT_FAILURE;
+    }
+
+    QuantizationGroups groups;
+    groups.rowLength = std::max<uint64_t>(elementCount, 1);
+    groups.runLength = groups.rowLength;
+    std::vector<uint64_t> scalesShape;
+    if (hasAxis)
+    {
+        if (axis >= shape.size() + isAxisFromEnd)
+        {
+            stringOutput = GetFormatted("Axis %s%llu is beyond the %zu dimensions of file: \"%s\"", isAxisFromEnd ? "-" : "", static_cast<unsigned long long>(axis), shape.size(), fileName.c_str());
+            return EXIT_FAILURE;
+        }
+        if (isAxisFromEnd)
+        {
+            axis = shape.size() - axis;
+        }
+        uint64_t innerCount = 1;
+        for (size_t i = size_t(axis) + 1; i < shape.size(); ++i)
+        {
+            innerCount *= shape[i];
+        }
+        groups.groupCount = shape[axis];
+        groups.runLength = std::max<uint64_t>(innerCount, 1);
+        groups.rowLength = std::max<uint64_t>(groups.runLength * groups.groupCount, 1);
+        scalesShape = {groups.groupCount};
+    }
+    else if (blockSize > 0)
+    {
+        groups.rowLength = std::max<uint64_t>(shape.back(), 1);
+        groups.runLength = std::min(blockSize, groups.rowLength);
+        groups.rowGroupStride = (groups.rowLength + groups.runLength - 1) / groups.runLength;
+        groups.groupCount = (elementCount + groups.rowLength - 1) / groups.rowLength * groups.rowGroupStride;
+        scalesShape.assign(shape.begin(), shape.end() - 1);
+        scalesShape.push_back(groups.rowGroupStride);
+    }
+    const size_t groupCount = size_t(groups.groupCount);
+
+    // Each slice reduces into the window of groups it touches, merged under the lock, so per channel
+    // scales of a wide axis need not keep a copy of every group per slice.
+    std::mutex mergeMutex;
+    std::vector<double> minima(groupCount, std::numeric_limits<double>::infinity());
+    std::vector<double> maxima(groupCount, -std::numeric_limits<double>::infinity());
+    uint64_t nonfiniteCount = 0;
+    const uint64_t sliceCount = (elementCount + g_operandChunkSize - 1) / g_operandChunkSize;
+    ParallelFor(static_cast<size_t>(sliceCount), [&](size_t sliceIndex)
+    {
+        const uint64_t elementIndex = uint64_t(sliceIndex) * g_operandChunkSize;
+        const size_t count = size_t(std::min<uint64_t>(g_operandChunkSize, elementCount - elementIndex));
+        std::vector<uint64_t> buffer(count);
+        const uint8_t* elements = ReadNumberFileViewElements(fileView, elementIndex, count, /*out*/ reinterpret_cast<uint8_t*>(buffer.data()));
+        std::vector<double> values(count);
+        CastElementTypes(elementType, ElementType::Float64, elements, /*out*/ values.data(), count);
+
+        uint64_t groupBegin = UINT64_MAX, groupEnd = 0;
+        groups.ForEachRun(elementIndex, elementIndex + count, [&](uint64_t group, uint64_t, uint64_t)
+        {
+            groupBegin = std::min(groupBegin, group);
+            groupEnd = std::max(groupEnd, group + 1);
+        });
+        std::vector<double> sliceMinima(size_t(groupEnd - groupBegin), std::numeric_limits<double>::infinity());
+        std::vector<double> sliceMaxima(size_t(groupEnd - groupBegin), -std::numeric_limits<double>::infinity());
+        uint64_t sliceNonfiniteCount = 0;
+        groups.ForEachRun(elementIndex, elementIndex + count, [&](uint64_t group, uint64_t runBegin, uint64_t runEnd)
+        {
+            double minimum = sliceMinima[group - groupBegin], maximum = sliceMaxima[group - groupBegin];
+            for (uint64_t i = runBegin; i < runEnd; ++i)
+            {
+                const double value = values[i - elementIndex];
+                if (!std::isfinite(value))
+                {
+                    ++sliceNonfiniteCount;
+                    continue;
+                }
+                minimum = std::min(minimum, value);
+                maximum = std::max(maximum, value);
+            }
+            sliceMinima[group - groupBegin] = minimum;
+            sliceMaxima[group - groupBegin] = maximum;
+        });
+
+        std::lock_guard<std::mutex> lock(mergeMutex);
+        nonfiniteCount += sliceNonfiniteCount;
+        for (size_t i = 0; i < sliceMinima.size(); ++i)
+        {
+            minima[groupBegin + i] = std::min(minima[groupBegin + i], sliceMinima[i]);
+            maxima[groupBegin + i] = std::max(maxima[groupBegin + i], sliceMaxima[i]);
+        }
+    });
+
+    // Ranges always include zero, so it stays exact. Scales are stored as float32, and used as
+    // rounded for the quantized data too. Empty or all zero groups get a scale of 1.
+    const CensusTarget targetRange(targetElementType);
+    std::vector<float> scales(groupCount);
+    std::vector<int32_t> zeroPoints(groupCount);
+    for (size_t group = 0; group < groupCount; ++group)
+    {
+        const double lower = std::min(minima[group], 0.0), upper = std::max(maxima[group], 0.0);
+        double scale = isAsymmetric
+            ? (upper - lower) / (targetRange.maximum - targetRange.minimum)
+            : std::max(-lower, upper) / targetRange.maximum;
+        scales[group] = (scale > 0) ? float(scale) : 1.0f;
+        if (isAsymmetric)
+        {
+            const double zeroPoint = std::nearbyint(targetRange.minimum - lower / double(scales[group]));
+            zeroPoints[group] = int32_t(std::clamp(zeroPoint, targetRange.minimum, targetRange.maximum));
+        }
+    }
+
+    if (!scalesFileName.empty() && !WriteArrayFile(scalesFileName, ElementType::Float32, scalesShape, scales.data(), scales.size() * sizeof(float)))
+    {
+        stringOutput = GetFormatted("Could not write file: \"%s\"", scalesFileName.c_str());
+        return EXIT_FAILURE;
+    }
+    if (!zeroPointsFileName.empty())
+    {
+        std::vector<uint8_t> targetZeroPoints(groupCount);
+        CastElementTypes(ElementType::Int32, targetElementType, zeroPoints.data(), /*out*/ targetZeroPoints.data(), groupCount);
+        if (!WriteArrayFile(zeroPointsFileName, targetElementType, scalesShape, targetZeroPoints.data(), targetZeroPoints.size()))
+        {
+            stringOutput = GetFormatted("Could not write file: \"%s\"", zeroPointsFileName.c_str());
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Floats clamp to the target's limits (saturating like float8 e4m3fn), and the conversion rounds
+    // them to nearest even. Integers round and clamp, with NaN as the zero point.
+    if (!outputFileName.empty())
+    {
+        constexpr size_t chunkElementCount = size_t(1) << 20; // Bytes, for the 8-bit targets
+        FileIo::Writer outputFile;
+        if (!outputFile.Open(outputFileName.c_str(), {chunkElementCount, 4, /*useDirectIo*/ false}))
+        {
+            stringOutput = GetFormatted("Could not write file: \"%s\"", outputFileName.c_str());
+            return EXIT_FAILURE;
+        }
+        const std::string_view outputExtension = std::string_view(outputFileName).substr(std::min(outputFileName.size(), outputFileName.find_last_of('.')));
+        if (outputExtension == ".npy")
+        {
+            const std::string header = Npy::MakeHeader(GetNpyDescrFromElementType(targetElementType), tensor.isFortranOrder, shape);
+            memcpy(outputFile.GetBuffer(), header.data(), header.size());
+            outputFile.Write(header.size());
+        }
+
+        for (uint64_t chunkBegin = 0; chunkBegin < elementCount; chunkBegin += chunkElementCount)
+        {
+            const size_t chunkCount = size_t(std::min<uint64_t>(chunkElementCount, elementCount - chunkBegin));
+            uint8_t* output = outputFile.GetBuffer();
+            ParallelFor((chunkCount + g_operandChunkSize - 1) / g_operandChunkSize, [&](size_t sliceIndex)
+            {
+                const size_t sliceBegin = sliceIndex * g_operandChunkSize;
+                const size_t count = std::min<size_t>(g_operandChunkSize, chunkCount - sliceBegin);
+                const uint64_t elementIndex = chunkBegin + sliceBegin;
+                std::vector<uint64_t> buffer(count);
+                const uint8_t* elements = ReadNumberFileViewElements(fileView, elementIndex, count, /*out*/ reinterpret_cast<uint8_t*>(buffer.data()));
+                std::vector<double> values(count);
+                CastElementTypes(elementType, ElementType::Float64, elements, /*out*/ values.data(), count);
+
+                groups.ForEachRun(elementIndex, elementIndex + count, [&](uint64_t group, uint64_t runBegin, uint64_t runEnd)
+                {
+                    const double scale = scales[group], zeroPoint = zeroPoints[group];
+                    for (uint64_t i = runBegin; i < runEnd; ++i)
+                    {
+                        double& value = values[i - elementIndex];
+                        const double scaledValue = value / scale;
+                        if (targetRange.isFloat)
+                        {
+                            value = std::clamp(scaledValue, targetRange.minimum, targetRange.maximum);
+                        }
+                        else
+                        {
+                            value = std::isnan(scaledValue) ? zeroPoint : std::clamp(std::nearbyint(scaledValue) + zeroPoint, targetRange.minimum, targetRange.maximum);
+                        }
+                    }
+                });
+                CastElementTypes(ElementType::Float64, targetElementType, values.data(), /*out*/ output + sliceBegin, count);
+            });
+            outputFile.Write(chunkCount);
+        }
+        if (!outputFile.Close())
+        {
+            stringOutput = GetFormatted("Could not write file: \"%s\"", outputFileName.c_str());
+            return EXIT_FAILURE;
+        }
+    }
+
+    const std::string_view typeName = GetTypeNameFromElementType(elementType);
+    const std::string_view targetTypeName = GetTypeNameFromElementType(targetElementType);
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%.*s\n", "type", int(typeName.size()), typeName.data());
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%llu\n", "elements", static_cast<unsigned long long>(elementCount));
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%llu\n", "nonfinite", static_cast<unsigned long long>(nonfiniteCount));
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%.*s\n", "target", int(targetTypeName.size()), targetTypeName.data());
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%s\n", "scheme", isAsymmetric ? "asymmetric" : "symmetric");
+    AppendFormatted(/*inout*/ stringOutput, "%-11s%zu\n", "groups", groupCount);
+
+    // Many scales (like per block) are better read from the file than listed.
+    if (scalesFileName.empty())
+    {
+        AppendFormatted(/*inout*/ stringOutput, isAsymmetric ? "%-14s%-14s%-14s%-14s%s\n" : "%-14s%-14s%-14s%s\n", "group", "minimum", "maximum", "scale", "zeropoint");
+        for (size_t group = 0; group < groupCount; ++group)
+        {
+            const bool isEmpty = (minima[group] > maxima[group]);
+            AppendFormatted(
+                /*inout*/ stringOutput,
+                "%-14zu%-14.6g%-14.6g%.9g",
+                group,
+                isEmpty ? 0.0 : minima[group],
+                isEmpty ? 0.0 : maxima[group],
+                double(scales[group])
+            );
+            if (isAsymmetric)
+            {
+                AppendFormatted(/*inout*/ stringOutput, "%*s%d", std::max(1, 14 - int(GetFormatted("%.9g", double(scales[group])).size())), "", zeroPoints[group]);
+            }
+            stringOutput.push_back('\n');
+            FlushOutputIfLarge(/*inout*/ stringOutput);
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+// Compiles the operations once, and then reruns them for each line of a text file, where a line's
+// numbers replace the literal numbers of the operations in order (read as their types), printing
+// only the results. So "batch pairs.txt float32 mul 0 0" multiplies each line's pair.
+int EvaluateOperationBatch(std::string_view arguments, /*out*/ std::string& stringOutput)
+{
+    std::string fileName(Tokenizer::Unquote(ReadWord(/*inout*/ arguments)));
+    if (fileName.empty())
+    {
+        stringOutput = GetFormatted("Expected a file name after \"batch\"");
+        return EXIT_FAILURE;
+    }
+
+    std::vector<NumericOperationAndRange> operations;
+    std::vector<NumberUnionAndType> numbers;
+    std::vector<NumberFileView> fileViews;
+    if (ParseOperations(arguments, /*out*/ operations, /*out*/ numbers, /*out*/ fileViews, /*out*/ stringOutput) != EXIT_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+    if (operations.empty())
+    {
+        stringOutput = GetFormatted("Expected operations after the file name");
+        return EXIT_FAILURE;
+    }
+
+    MappedFile inputFile;
+    if (!inputFile.Open(fileName.c_str()))
+    {
+        stringOutput = GetFormatted("Could not read text file: \"%s\"", fileName.c_str());
+        return EXIT_FAILURE;
+    }
+
+    OperationPlan plan;
+    CompileOperationPlan(MakeSpan(operations), std::move(numbers), std::move(fileViews), /*out*/ plan);
+    auto printResults = [&](Span<const NumberUnionAndType> results)
+    {
+        SprintAllNumbers(/*inout*/ stringOutput, results);
+    };
+
+    std::vector<NumberUnionAndType> lineNumbers;
+    std::string_view text = inputFile.GetStringView();
+    for (size_t lineIndex = 0; !text.empty(); ++lineIndex)
+    {
+        const size_t lineLength = std::min(text.find('\n'), text.size());
+        std::string_view line = text.substr(0, lineLength);
+        text.remove_prefix(std::min(lineLength + 1, text.size()));
+
+        lineNumbers.clear();
+        char const* const lineEnd = line.data() + line.size();
+        for (std::string_view token; !(token = Tokenizer::GetToken(line)).empty(); )
+        {
+            char const* tokenEnd = token.data() + token.size();
+            line = std::string_view{tokenEnd, size_t(lineEnd - tokenEnd)};
+            if (token == ",")
+            {
+                continue;
+            }
+
+            // Any extra numbers are still counted, for the error below.
+            const size_t numberIndex = lineNumbers.size();
+            const bool hasPlaceholder = (numberIndex < plan.numbers.size());
+            NumberUnionAndType& number = lineNumbers.emplace_back();
+            ParseNumber(token, hasPlaceholder ? plan.numbers[numberIndex].elementType : ElementType::Undefined, /*parseAsRawData*/ false, /*out*/ number);
+            number.printingFlags = hasPlaceholder ? plan.numbers[numberIndex].printingFlags : NumericPrintingFlags::Default;
+        }
+        if (lineNumbers.empty())
+        {
+            continue; // Skip blank lines.
+        }
+        if (!SetOperationPlanNumbers(/*inout*/ plan, MakeSpan(lineNumbers)))
+        {
+            stringOutput = GetFormatted("Expected %zu numbers on line %zu, not %zu", plan.numbers.size(), lineIndex + 1, lineNumbers.size());
+            return EXIT_FAILURE;
+        }
+
+        ExecuteOperationPlan(/*inout*/ plan, printResults);
+        FlushOutputIfLarge(/*inout*/ stringOutput);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::string ConcatenateCommandLineParameters(int argc, char* argv[])
+{
+    std::string commandLine;
+    for (size_t i = 1; i < size_t(argc); ++i)
+    {
+        if (!commandLine.empty())
+        {
+            commandLine.push_back(' ');
+        }
+        commandLine.append(argv[i]);
+    }
+
+    return commandLine;
+}
+
+int MainImplementation(std::string_view commandLine, /*out*/ std::string& stringOutput)
+{
+    if (commandLine.empty())
+    {
+        PrintUsage();
+        return EXIT_SUCCESS;
+    }
+
+    // Check for a file command, which takes the place of operations.
+    std::string_view commandArguments = commandLine;
+    std::string_view commandName = ReadToken(/*inout*/ commandArguments);
+    const Keyword* commandKeyword = g_keywordHashTable.Find(commandName, g_keywords);
+    if (commandKeyword != nullptr && commandKeyword->type == KeywordType::Command)
+    {
+        switch (CommandType(commandKeyword->value))
+        {
+        case CommandType::Dump: return DumpFile(commandArguments, /*out*/ stringOutput);
+        case CommandType::Convert: return ConvertFile(commandArguments, /*out*/ stringOutput);
+        case CommandType::Tensors: return ListFileTensors(commandArguments, /*out*/ stringOutput);
+        case CommandType::Stats: return ComputeFileStatistics(commandArguments, /*out*/ stringOutput);
+        case CommandType::Histogram: return ComputeFileHistogram(commandArguments, /*out*/ stringOutput);
+        case CommandType::Quantiles: return EstimateFileQuantiles(commandArguments, /*out*/ stringOutput);
+        case CommandType::QuantizationError: return AnalyzeFileConversionErrors(commandArguments, /*out*/ stringOutput);
+        case CommandType::UlpDifference: return CompareFileUlpDistances(commandArguments, /*out*/ stringOutput);
+        case CommandType::Compare: return CompareFileTolerances(commandArguments, /*out*/ stringOutput);
+        case CommandType::NanScan: return ScanFilesForNonfinite(commandArguments, /*out*/ stringOutput);
+        case CommandType::Census: return CountFileRangeCensus(commandArguments, /*out*/ stringOutput);
+        case CommandType::Quantize: return QuantizeFile(commandArguments, /*out*/ stringOutput);
+        case CommandType::Batch: return EvaluateOperationBatch(commandArguments, /*out*/ stringOutput);
+        default: assert(false);
+        }
+    }
+
+    std::vector<NumericOperationAndRange> operations;
+    std::vector<NumberUnionAndType> numbers;
+    std::vector<NumberFileView> fileViews;
+
+    std::string errorMessage;
+    int exitCode = ParseOperations(commandLine, /*out*/ operations, /*out*/ numbers, /*out*/ fileViews, /*out*/ stringOutput);
+    if (exitCode != EXIT_SUCCESS)
+    {
+        return exitCode;
+    }
+
+    // A single number read from a file shows all representations, just like one typed.
+    if (operations.empty() && numbers.empty() && fileViews.size() == 1 && fileViews.front().elementCount == 1)
+    {
+        numbers.resize(1);
+        DecodeNumberFileView(fileViews.front(), 0, /*out*/ MakeSpan(numbers));
+        fileViews.clear();
+    }
+
+    if (!operations.empty())
+    {
+        OperationPlan plan;
+        CompileOperationPlan(MakeSpan(operations), std::move(numbers), std::move(fileViews), /*out*/ plan);
+
+        // Execute and print every operation in order.
+        for (auto& step : plan.steps)
+        {
+            _Null_terminated_ const char* numericOperationName = GetNumericOperationNameFromNumericOperationType(step.numericOperationType).data();
+            auto printNumbers = [&](Span<const NumberUnionAndType> stepNumbers)
+            {
+                SprintAllNumbers(/*inout*/ stringOutput, stepNumbers);
+            };
+
+            // Print the operands.
+            AppendFormatted(/*inout*/ stringOutput, "Operands to %s:\n", numericOperationName);
+            ForEachOperationPlanOperandChunk(plan, step, printNumbers);
+
+            // Print the result.
+            AppendFormatted(/*inout*/ stringOutput, "Result from %s:\n", numericOperationName);
+            ExecuteOperationPlanStep(/*inout*/ plan, step, printNumbers);
+            stringOutput.append("\n");
+        }
+    }
+    else if (!fileViews.empty())
+    {
+        // Stream all the numbers in order, including those from files.
+        OperandCursor cursor(MakeSpan(numbers), Range{0, numbers.size()}, MakeSpan(fileViews));
+        std::vector<NumberUnionAndType> chunk;
+        while (cursor.Read(/*inout*/ chunk, g_operandChunkSize) > 0)
+        {
+            SprintAllNumbers(/*inout*/ stringOutput, MakeSpan(chunk));
+            chunk.clear();
+        }
+    }
+    else if (numbers.size() == 1)
+    {
+        // If exactly one number is given, show it in possible formats.
+        auto& numberUnion = numbers.front();
+        double valueFloat = ReadToDouble(numberUnion.elementType, &numberUnion.numberUnion);
+        int64_t valueInteger = ReadRawBitValue(numberUnion.elementType, &numberUnion.numberUnion);
+
+        stringOutput.append("Representations:\n");
+        SprintAllPrintingFormats(/*inout*/ stringOutput, valueFloat, valueInteger, numberUnion.elementType);
+
+        stringOutput.append("\n" "As raw bits:\n");
+        SprintAllNumericTypesToBinary(/*inout*/ stringOutput, numberUnion.numberUnion, numberUnion.printingFlags, numberUnion.elementType);
+
+        stringOutput.append("\n" "As number:\n");
+        SprintAllNumericTypesFromBinary(/*inout*/ stringOutput, valueInteger, numberUnion.printingFlags, numberUnion.elementType);
+    }
+    else if (!numbers.empty())
+    {
+        // If multiple numbers are given, print them all.
+        SprintAllNumbers(/*inout*/ stringOutput, Span<const NumberUnionAndType>(numbers.data(), numbers.size()));
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -1,21 +1,49 @@
-﻿// BiNums main, separated out from BiNums just so tests and main executable don't have both a main function.
-
-#include "precomp.h"
-
-extern int MainImplementation(std::string_view commandLine, std::string& stringOutput);
-extern std::string ConcatenateCommandLineParameters(int argc, char* argv[]);
-
-int main(int argc, char* argv[])
-{
-    // Standard C/C++ tries to be helpful by chopping up the arguments for us,
-    // but the general parsing function just accepts a string directly, which
-    // could come from other sources (like test cases). So restore the original
-    // back to the original string.
-    std::string commandLine = ConcatenateCommandLineParameters(argc, argv);
-
-    std::string stringOutput;
-    int exitCode = MainImplementation(commandLine, /*out*/ stringOutput);
-    std::fputs(stringOutput.c_str(), stdout);
-
-    return exitCode;
-}
+﻿// BiNums main, separated out from BiNums just so tests and main executable don't have both a main function.
+
+#include "precomp.h"
+
+extern int MainImplementation(std::string_view commandLine, std::string& stringOutput);
+extern std::string ConcatenateCommandLineParameters(int argc, char* argv[]);
+extern FILE* g_outputFile;
+
+int main(int argc, char* argv[])
+{
+    std::string commandLine;
+    std::string_view commandLineView;
+    MappedFile commandFile;
+
+    // A command file (@commands.txt) or stdin (-) given as the only parameter is mapped into
+    // memory and parsed in place, which avoids both the OS argument length limit and a copy.
+    if (argc == 2 && (argv[1][0] == '@' || std::string_view(argv[1]) == "-"))
+    {
+        const bool isStandardInput = (argv[1][0] == '-');
+        if (!(isStandardInput ? commandFile.OpenStandardInput() : commandFile.Open(argv[1] + 1)))
+        {
+            std::printf("Could not read command file: \"%s\"\n", isStandardInput ? "stdin" : argv[1] + 1);
+            return EXIT_FAILURE;
+        }
+        commandLineView = commandFile.GetStringView();
+
+        // Skip any UTF-8 byte order mark, as some editors add one.
+        if (commandLineView.starts_with("\xEF\xBB\xBF"))
+        {
+            commandLineView.remove_prefix(3);
+        }
+    }
+    else
+    {
+        // Standard C/C++ tries to be helpful by chopping up the arguments for us,
+        // but the general parsing function just accepts a string directly, which
+        // could come from other sources (like test cases). So restore the original
+        // back to the original string.
+        commandLine = ConcatenateCommandLineParameters(argc, argv);
+        commandLineView = commandLine;
+    }
+
+    g_outputFile = stdout;
+    std::string stringOutput;
+    int exitCode = MainImplementation(commandLineView, /*out*/ stringOutput);
+    std::fputs(stringOutput.c_str(), stdout);
+
+    return exitCode;
+}
@@ -1,396 +1,1388 @@
-﻿// BiNums, see binary numbers
-
-#include "precomp.h"
-#if _WIN32
-#define NOMINMAX
-#define WIN32_LEAN_AND_MEAN
-#include <Windows.h>
-#endif
-
-extern int MainImplementation(std::string_view commandLine, std::string& stringOutput);
-
-////////////////////////////////////////////////////////////////////////////////
-// Generic functions/classes.
-
-bool StringsMatch(char const* a, char const* b)
-{
-    return strcmp(a, b) == 0;
-}
-
-// TODO: Add VTT codes for Linux.
-struct SetAndSaveConsoleAttribute
-{
-    #ifdef _WIN32
-    CONSOLE_SCREEN_BUFFER_INFO consoleInfo_;
-    HANDLE hConsole_;
-    #endif
-
-    SetAndSaveConsoleAttribute()
-    {
-        #ifdef _WIN32
-        hConsole_ = GetStdHandle(STD_OUTPUT_HANDLE);
-        GetConsoleScreenBufferInfo(hConsole_, &consoleInfo_);
-        #endif
-    }
-
-    SetAndSaveConsoleAttribute(WORD newAttributes) : SetAndSaveConsoleAttribute()
-    {
-        UpdateAttributes(newAttributes);
-    }
-
-    SetAndSaveConsoleAttribute(WORD setAttributes, WORD clearAttributes) : SetAndSaveConsoleAttribute()
-    {
-        UpdateAttributes(setAttributes, clearAttributes);
-    }
-
-    void UpdateForegroundColor(WORD foregroundColor)
-    {
-        UpdateAttributes(foregroundColor & 0x000F, 0x000F);
-    }
-
-    void UpdateAttributes(WORD newAttributes)
-    {
-        #ifdef _WIN32
-        SetConsoleTextAttribute(hConsole_, newAttributes);
-        #endif
-    }
-
-    void UpdateAttributes(WORD setAttributes, WORD clearAttributes)
-    {
-        #ifdef _WIN32
-        SetConsoleTextAttribute(hConsole_, (consoleInfo_.wAttributes & ~clearAttributes) | setAttributes);
-        #endif
-    }
-
-    void Reset()
-    {
-        #ifdef _WIN32
-        SetConsoleTextAttribute(hConsole_, consoleInfo_.wAttributes);
-        #endif
-    }
-
-    ~SetAndSaveConsoleAttribute()
-    {
-        #ifdef _WIN32
-        SetConsoleTextAttribute(hConsole_, consoleInfo_.wAttributes);
-        #endif
-    }
-};
-
-
-struct BiNumsTest
-{
-    bool shouldRegenerateExpectedBaseline = false;
-};
-
-BiNumsTest g_test;
-
-int ParseCommandLineParameters(int argc, char* argv[])
-{
-    for (int i = 1; i < argc; ++i)
-    {
-        char const* argument = argv[i];
-        if (StringsMatch(argument, "/?") || StringsMatch(argument, "-h") || StringsMatch(argument, "-help"))
-        {
-            printf(
-                "Run without any arguments to execute the tests.\n"
-                "Failed test results go into 'TestResults\\'.\n"
-                "\n"
-                "regenerate : regenerate the test cases (use git diff afterward to verify differences)\n"
-            );
-            return EXIT_FAILURE;
-        }
-        else if (StringsMatch(argument, "regenerate"))
-        {
-            g_test.shouldRegenerateExpectedBaseline = true;
-        }
-        else
-        {
-            printf(
-                "Unrecognized parameter: %s\n"
-                "Type -help for help.",
-                argument
-            );
-            return EXIT_FAILURE;
-        }
-    }
-
-    return EXIT_SUCCESS;
-}
-
-void PrintIndentedText(
-    std::string_view text,
-    std::string_view indentPrefix
-    )
-{
-    if (indentPrefix.empty())
-    {
-        fwrite(text.data(), 1, text.size(), stdout);
-    }
-
-    std::string indentedText;
-    for (auto p = text.begin(), end = text.end(); p != end; )
-    {
-        indentedText.append(indentPrefix);
-
-        auto endOfLine = std::find(p, end, '\n');
-        if (endOfLine != end)
-        {
-            ++endOfLine;
-        }
-        indentedText.append(&*p, endOfLine - p);
-        p = endOfLine;
-    }
-    if (indentedText.empty() || indentedText.back() != '\n')
-    {
-        indentedText.push_back('\n');
-    }
-
-    fwrite(indentedText.data(), 1, indentedText.size(), stdout);
-}
-
-bool CompareExpectedVsActual(
-    std::string_view testTitle,
-    std::string_view actual,
-    std::string_view expected
-    )
-{
-    bool stringsMatch = (expected == actual);
-
-    // Display colored OK/FAILED.
-    SetAndSaveConsoleAttribute consoleAttributes;
-    consoleAttributes.UpdateForegroundColor(stringsMatch ? FOREGROUND_GREEN : FOREGROUND_RED);
-    printf(stringsMatch ? "OK    " : "FAILED");
-    consoleAttributes.Reset();
-
-    printf("  %.*s\n", static_cast<int>(testTitle.size()), testTitle.data());
-    if (!stringsMatch)
-    {
-        printf("        ");
-        consoleAttributes.UpdateAttributes(COMMON_LVB_UNDERSCORE);
-        printf("Expected output:\n");
-        consoleAttributes.Reset();
-        PrintIndentedText(expected, "        |");
-
-        printf("        ");
-        consoleAttributes.UpdateAttributes(COMMON_LVB_UNDERSCORE);
-        printf("Actual output:\n");
-        consoleAttributes.Reset();
-        PrintIndentedText(actual, "        |");
-    }
-
-    return stringsMatch;
-}
-
-
-bool VerifyFloatingTypes()
-{
-    constexpr double testNumbersFloat8f3e4s1[] = {
-        0.0f,
-        1.0f,
-       -1.0f,
-        0.5f,
-       -0.5f,
-        224.0f,
-       -224.0f,
-        std::numeric_limits<float>::quiet_NaN(),
-       -std::numeric_limits<float>::quiet_NaN(),
-        // Exclude infinity because this type doesn't have it.
-        // So it would not round-trip successfully.
-        // std::numeric_limits<float>::infinity(),
-        //-std::numeric_limits<float>::infinity()
-    };
-    constexpr double testNumbersFloat8f2e5s1[] = {
-        0.0f,
-        1.0f,
-       -1.0f,
-        0.5f,
-       -0.5f,
-        224.0f, // Maximum value
-       -224.0f, // Maximum value
-        std::numeric_limits<float>::quiet_NaN(),
-       -std::numeric_limits<float>::quiet_NaN(),
-        std::numeric_limits<float>::infinity(),
-       -std::numeric_limits<float>::infinity()
-    };
-    constexpr double testNumbersFloat16[] = {
-        0.0f,
-        1.0f,
-       -1.0f,
-        0.5f,
-       -0.5f,
-        65504.0f, // Maximum precise value
-       -65504.0f, // Maximum precise value
-        std::numeric_limits<float>::quiet_NaN(),
-       -std::numeric_limits<float>::quiet_NaN(),
-        std::numeric_limits<float>::infinity(),
-       -std::numeric_limits<float>::infinity()
-    };
-    constexpr double testNumbersBFloat16[] = {
-        0.0f,
-        1.0f,
-       -1.0f,
-        0.5f,
-       -0.5f,
-        65280.0f, // Maximum value
-       -65280.0f, // Maximum value
-        std::numeric_limits<float>::quiet_NaN(),
-       -std::numeric_limits<float>::quiet_NaN(),
-        std::numeric_limits<float>::infinity(),
-       -std::numeric_limits<float>::infinity()
-    };
-    constexpr double testNumbersFloat32[] = {
-        0.0,
-        1.0,
-       -1.0,
-        0.5,
-       -0.5,
-        65504.0,
-       -65504.0,
-        16777216.0, // Maximum precise value
-       -16777216.0, // Maximum precise value
-        std::numeric_limits<float>::min(),
-       -std::numeric_limits<float>::min(),
-        std::numeric_limits<float>::max(),
-       -std::numeric_limits<float>::max(),
-        std::numeric_limits<float>::quiet_NaN(),
-       -std::numeric_limits<float>::quiet_NaN(),
-        std::numeric_limits<float>::infinity(),
-       -std::numeric_limits<float>::infinity()
-    };
-    constexpr auto& testNumbersFloat64 = testNumbersFloat32;
-
-    bool success = true;
-
-    SetAndSaveConsoleAttribute consoleAttributes;
-
-    auto PrintResult = [&](char const* title, double a, double b)
-    {
-        bool valuesMatch = (a == b) || (std::isnan(a) && std::isnan(b));
-        success &= valuesMatch;
-        consoleAttributes.UpdateForegroundColor(valuesMatch ? FOREGROUND_GREEN : FOREGROUND_RED);
-        printf(
-            valuesMatch ? "OK     - %s - %g == %g\n"
-                        : "FAILED - %s - %g != %g\n",
-            title,
-            a,
-            b
-        );
-        consoleAttributes.Reset();
-    };
-
-    // TODO: Fix FloatNumber to handle atypical NaN case with a single NaN representation.
-    for (double originalValue : testNumbersFloat8f3e4s1)
-    {
-        FloatNumber<uint8_t, 3, 4, true, true, false, true> convertedValue = float(originalValue);
-        float reconvertedValue = convertedValue;
-        PrintResult("float32 to float8m3e4s1", originalValue, reconvertedValue);
-    }
-
-    for (double originalValue : testNumbersFloat8f2e5s1)
-    {
-        FloatNumber<uint8_t, 2, 5, true, true, true, true> convertedValue = float(originalValue);
-        float reconvertedValue = convertedValue;
-        PrintResult("float32 to float8m2e5s1", originalValue, reconvertedValue);
-    }
-
-    for (double originalValue : testNumbersFloat16)
-    {
-        FloatNumber<uint16_t, 10, 5, true, true, true, true> convertedValue = float(originalValue);
-        float reconvertedValue = convertedValue;
-        PrintResult("float32 to float16", originalValue, reconvertedValue);
-    }
-
-    for (double originalValue : testNumbersFloat16)
-    {
-        FloatNumber<uint16_t, 10, 5, true, true, true, true> convertedValue(originalValue);
-        double reconvertedValue = convertedValue;
-        PrintResult("float64 to float16", originalValue, reconvertedValue);
-    }
-
-    for (double originalValue : testNumbersBFloat16)
-    {
-        FloatNumber<uint16_t, 7, 8, true, true, true, true> convertedValue = float(originalValue);
-        float reconvertedValue = convertedValue;
-        PrintResult("float32 to bfloat16", originalValue, reconvertedValue);
-    }
-
-    for (double originalValue : testNumbersBFloat16)
-    {
-        FloatNumber<uint16_t, 10, 5, true, true, true, true> convertedValue = float(originalValue);
-        FloatNumber<uint16_t, 7, 8, true, true, true, true> convertedValue2 = float(convertedValue);
-        FloatNumber<uint16_t, 10, 5, true, true, true, true> convertedValue3 = float(convertedValue2);
-        float reconvertedValue = convertedValue3;
-        PrintResult("float16 to bfloat16", originalValue, reconvertedValue);
-    }
-
-    for (double originalValue : testNumbersFloat32)
-    {
-        FloatNumber<uint32_t, 23, 8, true, true, true, true> convertedValue = float(originalValue);
-        float reconvertedValue = convertedValue;
-        PrintResult("float32 to float32", originalValue, reconvertedValue);
-    }
-
-    for (double originalValue : testNumbersFloat32)
-    {
-        FloatNumber<uint32_t, 23, 8, true, true, true, true> convertedValue(originalValue);
-        double reconvertedValue = convertedValue;
-        PrintResult("float64 to float32", originalValue, reconvertedValue);
-    }
-
-    // The custom float64 should behave identical to double (or std::float64_t).
-    for (double originalValue : testNumbersFloat64)
-    {
-        FloatNumber<uint64_t, 52, 11, true, true, true, true> convertedValue(originalValue);
-        double reconvertedValue = convertedValue;
-        PrintResult("float64 to float64", originalValue, reconvertedValue);
-    }
-
-    return success;
-}
-
-
-int main(int argc, char* argv[])
-{
-    printf("*** This test suite is just a skeleton for now. ***\n\n");
-
-    auto exitCode = ParseCommandLineParameters(argc, argv);
-    if (exitCode != EXIT_SUCCESS)
-    {
-        return exitCode;
-    }
-
-    // Placeholder for real tests, which should be data driven in a test file,
-    // preferably JSON or XML (XML might simpler given all the new lines).
-    std::string stringOutput;
-    exitCode = MainImplementation("uint8 42 int8 -42 uint16 42 int16 -42 uint32 42 int32 -42 uint64 42 int64 -42 fixed12_12 -42.25 fixed16_16 -42.25 fixed8_24 -42.25 float16 -42.25 float32 -42.25 float64 -42.25", stringOutput);
-
-    uint32_t errorCount = 0;
-    auto CheckFailure = [&](bool success)
-    {
-        errorCount += success ? 0 : 1;
-    };
-
-    char const* expectedOutput =
-        "         uint8 42 (0x2A)\n"
-        "          int8 -42 (0xD6)\n"
-        "        uint16 42 (0x002A)\n"
-        "         int16 -42 (0xFFD6)\n"
-        "        uint32 42 (0x0000002A)\n"
-        "         int32 -42 (0xFFFFFFD6)\n"
-        "        uint64 42 (0x000000000000002A)\n"
-        "         int64 -42 (0xFFFFFFFFFFFFFFD6)\n"
-        "    fixed12_12 -42.25 (0xFD5C00)\n"
-        "    fixed16_16 -42.25 (0xFFD5C000)\n"
-        "     fixed8_24 -42.25 (0xD5C00000)\n"
-        "       float16 -42.25 (0xD148)\n"
-        "       float32 -42.25 (0xC2290000)\n"
-        "       float64 -42.25 (0xC045200000000000)\n"
-        ;
-    CheckFailure(CompareExpectedVsActual("All data types", stringOutput, expectedOutput));
-    CheckFailure(CompareExpectedVsActual("Expected failure case to verify output comparison", stringOutput, "Gibberish just to verify failure"));
-
-    CheckFailure(VerifyFloatingTypes());
-
-    return EXIT_SUCCESS;
-}
+﻿// BiNums, see binary numbers
+
+#include "precomp.h"
+#if _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#endif
+
+extern int MainImplementation(std::string_view commandLine, std::string& stringOutput);
+
+////////////////////////////////////////////////////////////////////////////////
+// Generic functions/classes.
+
+bool StringsMatch(char const* a, char const* b)
+{
+    return strcmp(a, b) == 0;
+}
+
+// TODO: Add VTT codes for Linux.
+struct SetAndSaveConsoleAttribute
+{
+    #ifdef _WIN32
+    CONSOLE_SCREEN_BUFFER_INFO consoleInfo_;
+    HANDLE hConsole_;
+    #endif
+
+    SetAndSaveConsoleAttribute()
+    {
+        #ifdef _WIN32
+        hConsole_ = GetStdHandle(STD_OUTPUT_HANDLE);
+        GetConsoleScreenBufferInfo(hConsole_, &consoleInfo_);
+        #endif
+    }
+
+    SetAndSaveConsoleAttribute(WORD newAttributes) : SetAndSaveConsoleAttribute()
+    {
+        UpdateAttributes(newAttributes);
+    }
+
+    SetAndSaveConsoleAttribute(WORD setAttributes, WORD clearAttributes) : SetAndSaveConsoleAttribute()
+    {
+        UpdateAttributes(setAttributes, clearAttributes);
+    }
+
+    void UpdateForegroundColor(WORD foregroundColor)
+    {
+        UpdateAttributes(foregroundColor & 0x000F, 0x000F);
+    }
+
+    void UpdateAttributes(WORD newAttributes)
+    {
+        #ifdef _WIN32
+        SetConsoleTextAttribute(hConsole_, newAttributes);
+        #endif
+    }
+
+    void UpdateAttributes(WORD setAttributes, WORD clearAttributes)
+    {
+        #ifdef _WIN32
+        SetConsoleTextAttribute(hConsole_, (consoleInfo_.wAttributes & ~clearAttributes) | setAttributes);
+        #endif
+    }
+
+    void Reset()
+    {
+        #ifdef _WIN32
+        SetConsoleTextAttribute(hConsole_, consoleInfo_.wAttributes);
+        #endif
+    }
+
+    ~SetAndSaveConsoleAttribute()
+    {
+        #ifdef _WIN32
+        SetConsoleTextAttribute(hConsole_, consoleInfo_.wAttributes);
+        #endif
+    }
+};
+
+
+struct BiNumsTest
+{
+    bool shouldRegenerateExpectedBaseline = false;
+};
+
+BiNumsTest g_test;
+
+int ParseCommandLineParameters(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        char const* argument = argv[i];
+        if (StringsMatch(argument, "/?") || StringsMatch(argument, "-h") || StringsMatch(argument, "-help"))
+        {
+            printf(
+                "Run without any arguments to execute the tests.\n"
+                "Failed test results go into 'TestResults\\'.\n"
+                "\n"
+                "regenerate : regenerate the test cases (use git diff afterward to verify differences)\n"
+            );
+            return EXIT_FAILURE;
+        }
+        else if (StringsMatch(argument, "regenerate"))
+        {
+            g_test.shouldRegenerateExpectedBaseline = true;
+        }
+        else
+        {
+            printf(
+                "Unrecognized parameter: %s\n"
+                "Type -help for help.",
+                argument
+            );
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+void PrintIndentedText(
+    std::string_view text,
+    std::string_view indentPrefix
+    )
+{
+    if (indentPrefix.empty())
+    {
+        fwrite(text.data(), 1, text.size(), stdout);
+    }
+
+    std::string indentedText;
+    for (auto p = text.begin(), end = text.end(); p != end; )
+    {
+        indentedText.append(indentPrefix);
+
+        auto endOfLine = std::find(p, end, '\n');
+        if (endOfLine != end)
+        {
+            ++endOfLine;
+        }
+        indentedText.append(&*p, endOfLine - p);
+        p = endOfLine;
+    }
+    if (indentedText.empty() || indentedText.back() != '\n')
+    {
+        indentedText.push_back('\n');
+    }
+
+    fwrite(indentedText.data(), 1, indentedText.size(), stdout);
+}
+
+bool CompareExpectedVsActual(
+    std::string_view testTitle,
+    std::string_view actual,
+    std::string_view expected
+    )
+{
+    bool stringsMatch = (expected == actual);
+
+    // Display colored OK/FAILED.
+    SetAndSaveConsoleAttribute consoleAttributes;
+    consoleAttributes.UpdateForegroundColor(stringsMatch ? FOREGROUND_GREEN : FOREGROUND_RED);
+    printf(stringsMatch ? "OK    " : "FAILED");
+    consoleAttributes.Reset();
+
+    printf("  %.*s\n", static_cast<int>(testTitle.size()), testTitle.data());
+    if (!stringsMatch)
+    {
+        printf("        ");
+        consoleAttributes.UpdateAttributes(COMMON_LVB_UNDERSCORE);
+        printf("Expected output:\n");
+        consoleAttributes.Reset();
+        PrintIndentedText(expected, "        |");
+
+        printf("        ");
+        consoleAttributes.UpdateAttributes(COMMON_LVB_UNDERSCORE);
+        printf("Actual output:\n");
+        consoleAttributes.Reset();
+        PrintIndentedText(actual, "        |");
+    }
+
+    return stringsMatch;
+}
+
+
+// Views the elements of an array as bytes, for writing test files.
+template <typename ContainerType>
+std::string_view AsBytes(const ContainerType& container)
+{
+    return {reinterpret_cast<char const*>(std::data(container)), std::size(container) * sizeof(*std::data(container))};
+}
+
+// Writes a test file from pieces of bytes, like a header followed by element data.
+void WriteTestFile(char const* fileName, std::initializer_list<std::string_view> pieces)
+{
+    FILE* file = fopen(fileName, "wb");
+    if (file != nullptr)
+    {
+        for (std::string_view piece : pieces)
+        {
+            fwrite(piece.data(), piece.size(), 1, file);
+        }
+        fclose(file);
+    }
+}
+
+bool VerifyFloatingTypes()
+{
+    constexpr double testNumbersFloat8f3e4s1[] = {
+        0.0f,
+        1.0f,
+       -1.0f,
+        0.5f,
+       -0.5f,
+        224.0f,
+       -224.0f,
+        std::numeric_limits<float>::quiet_NaN(),
+       -std::numeric_limits<float>::quiet_NaN(),
+        // Exclude infinity because this type doesn't have it.
+        // So it would not round-trip successfully.
+        // std::numeric_limits<float>::infinity(),
+        //-std::numeric_limits<float>::infinity()
+    };
+    constexpr double testNumbersFloat8f2e5s1[] = {
+        0.0f,
+        1.0f,
+       -1.0f,
+        0.5f,
+       -0.5f,
+        224.0f, // Maximum value
+       -224.0f, // Maximum value
+        std::numeric_limits<float>::quiet_NaN(),
+       -std::numeric_limits<float>::quiet_NaN(),
+        std::numeric_limits<float>::infinity(),
+       -std::numeric_limits<float>::infinity()
+    };
+    constexpr double testNumbersFloat16[] = {
+        0.0f,
+        1.0f,
+       -1.0f,
+        0.5f,
+       -0.5f,
+        65504.0f, // Maximum precise value
+       -65504.0f, // Maximum precise value
+        std::numeric_limits<float>::quiet_NaN(),
+       -std::numeric_limits<float>::quiet_NaN(),
+        std::numeric_limits<float>::infinity(),
+       -std::numeric_limits<float>::infinity()
+    };
+    constexpr double testNumbersBFloat16[] = {
+        0.0f,
+        1.0f,
+       -1.0f,
+        0.5f,
+       -0.5f,
+        65280.0f, // Maximum value
+       -65280.0f, // Maximum value
+        std::numeric_limits<float>::quiet_NaN(),
+       -std::numeric_limits<float>::quiet_NaN(),
+        std::numeric_limits<float>::infinity(),
+       -std::numeric_limits<float>::infinity()
+    };
+    constexpr double testNumbersFloat32[] = {
+        0.0,
+        1.0,
+       -1.0,
+        0.5,
+       -0.5,
+        65504.0,
+       -65504.0,
+        16777216.0, // Maximum precise value
+       -16777216.0, // Maximum precise value
+        std::numeric_limits<float>::min(),
+       -std::numeric_limits<float>::min(),
+        std::numeric_limits<float>::max(),
+       -std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::quiet_NaN(),
+       -std::numeric_limits<float>::quiet_NaN(),
+        std::numeric_limits<float>::infinity(),
+       -std::numeric_limits<float>::infinity()
+    };
+    constexpr auto& testNumbersFloat64 = testNumbersFloat32;
+
+    bool success = true;
+
+    SetAndSaveConsoleAttribute consoleAttributes;
+
+    auto PrintResult = [&](char const* title, double a, double b)
+    {
+        bool valuesMatch = (a == b) || (std::isnan(a) && std::isnan(b));
+        success &= valuesMatch;
+        consoleAttributes.UpdateForegroundColor(valuesMatch ? FOREGROUND_GREEN : FOREGROUND_RED);
+        printf(
+            valuesMatch ? "OK     - %s - %g == %g\n"
+                        : "FAILED - %s - %g != %g\n",
+            title,
+            a,
+            b
+        );
+        consoleAttributes.Reset();
+    };
+
+    // TODO: Fix FloatNumber to handle atypical NaN case with a single NaN representation.
+    for (double originalValue : testNumbersFloat8f3e4s1)
+    {
+        FloatNumber<uint8_t, 3, 4, true, true, false, true> convertedValue = float(originalValue);
+        float reconvertedValue = convertedValue;
+        PrintResult("float32 to float8m3e4s1", originalValue, reconvertedValue);
+    }
+
+    for (double originalValue : testNumbersFloat8f2e5s1)
+    {
+        FloatNumber<uint8_t, 2, 5, true, true, true, true> convertedValue = float(originalValue);
+        float reconvertedValue = convertedValue;
+        PrintResult("float32 to float8m2e5s1", originalValue, reconvertedValue);
+    }
+
+    for (double originalValue : testNumbersFloat16)
+    {
+        FloatNumber<uint16_t, 10, 5, true, true, true, true> convertedValue = float(originalValue);
+        float reconvertedValue = convertedValue;
+        PrintResult("float32 to float16", originalValue, reconvertedValue);
+    }
+
+    for (double originalValue : testNumbersFloat16)
+    {
+        FloatNumber<uint16_t, 10, 5, true, true, true, true> convertedValue(originalValue);
+        double reconvertedValue = convertedValue;
+        PrintResult("float64 to float16", originalValue, reconvertedValue);
+    }
+
+    for (double originalValue : testNumbersBFloat16)
+    {
+        FloatNumber<uint16_t, 7, 8, true, true, true, true> convertedValue = float(originalValue);
+        float reconvertedValue = convertedValue;
+        PrintResult("float32 to bfloat16", originalValue, reconvertedValue);
+    }
+
+    for (double originalValue : testNumbersBFloat16)
+    {
+        FloatNumber<uint16_t, 10, 5, true, true, true, true> convertedValue = float(originalValue);
+        FloatNumber<uint16_t, 7, 8, true, true, true, true> convertedValue2 = float(convertedValue);
+        FloatNumber<uint16_t, 10, 5, true, true, true, true> convertedValue3 = float(convertedValue2);
+        float reconvertedValue = convertedValue3;
+        PrintResult("float16 to bfloat16", originalValue, reconvertedValue);
+    }
+
+    for (double originalValue : testNumbersFloat32)
+    {
+        FloatNumber<uint32_t, 23, 8, true, true, true, true> convertedValue = float(originalValue);
+        float reconvertedValue = convertedValue;
+        PrintResult("float32 to float32", originalValue, reconvertedValue);
+    }
+
+    for (double originalValue : testNumbersFloat32)
+    {
+        FloatNumber<uint32_t, 23, 8, true, true, true, true> convertedValue(originalValue);
+        double reconvertedValue = convertedValue;
+        PrintResult("float64 to float32", originalValue, reconvertedValue);
+    }
+
+    // The custom float64 should behave identical to double (or std::float64_t).
+    for (double originalValue : testNumbersFloat64)
+    {
+        FloatNumber<uint64_t, 52, 11, true, true, true, true> convertedValue(originalValue);
+        double reconvertedValue = convertedValue;
+        PrintResult("float64 to float64", originalValue, reconvertedValue);
+    }
+
+    return success;
+}
+
+
+int main(int argc, char* argv[])
+{
+    printf("*** This test suite is just a skeleton for now. ***\n\n");
+
+    auto exitCode = ParseCommandLineParameters(argc, argv);
+    if (exitCode != EXIT_SUCCESS)
+    {
+        return exitCode;
+    }
+
+    // Placeholder for real tests, which should be data driven in a test file,
+    // preferably JSON or XML (XML might simpler given all the new lines).
+    std::string stringOutput;
+    exitCode = MainImplementation("uint8 42 int8 -42 uint16 42 int16 -42 uint32 42 int32 -42 uint64 42 int64 -42 fixed12_12 -42.25 fixed16_16 -42.25 fixed8_24 -42.25 float16 -42.25 float32 -42.25 float64 -42.25", stringOutput);
+
+    uint32_t errorCount = 0;
+    auto CheckFailure = [&](bool success)
+    {
+        errorCount += success ? 0 : 1;
+    };
+
+    char const* expectedOutput =
+        "         uint8 42 (0x2A)\n"
+        "          int8 -42 (0xD6)\n"
+        "        uint16 42 (0x002A)\n"
+        "         int16 -42 (0xFFD6)\n"
+        "        uint32 42 (0x0000002A)\n"
+        "         int32 -42 (0xFFFFFFD6)\n"
+        "        uint64 42 (0x000000000000002A)\n"
+        "         int64 -42 (0xFFFFFFFFFFFFFFD6)\n"
+        "    fixed12_12 -42.25 (0xFD5C00)\n"
+        "    fixed16_16 -42.25 (0xFFD5C000)\n"
+        "     fixed8_24 -42.25 (0xD5C00000)\n"
+        "       float16 -42.25 (0xD148)\n"
+        "       float32 -42.25 (0xC2290000)\n"
+        "       float64 -42.25 (0xC045200000000000)\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("All data types", stringOutput, expectedOutput));
+    CheckFailure(CompareExpectedVsActual("Expected failure case to verify output comparison", stringOutput, "Gibberish just to verify failure"));
+
+    // Decimal strings should round once directly to the narrow type, not via float64.
+    stringOutput.clear();
+    MainImplementation("float16 2049.0000000000001 bfloat16 0.1 float8e4m3 0.3 464 fixed12_12 0.1", stringOutput);
+    expectedOutput =
+        "       float16 2050 (0x6801)\n"
+        "      bfloat16 0.10009765625 (0x3DCD)\n"
+        "    float8e4m3 0.3125 (0x2A)\n"
+        "    float8e4m3 448 (0x7E)\n"
+        "    fixed12_12 0.10009765625 (0x00019A)\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Decimal rounding to narrow types", stringOutput, expectedOutput));
+
+    // Multiple operations run through a single compiled plan.
+    stringOutput.clear();
+    MainImplementation("float32 add 10 -5 3 fixed12_12 mul 1.5 2.25", stringOutput);
+    expectedOutput =
+        "Operands to add:\n"
+        "       float32 10 (0x41200000)\n"
+        "       float32 -5 (0xC0A00000)\n"
+        "       float32 3 (0x40400000)\n"
+        "Result from add:\n"
+        "       float32 8 (0x41000000)\n"
+        "\n"
+        "Operands to multiply:\n"
+        "    fixed12_12 1.5 (0x001800)\n"
+        "    fixed12_12 2.25 (0x002400)\n"
+        "Result from multiply:\n"
+        "    fixed12_12 3.375 (0x003600)\n"
+        "\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Multiple operations", stringOutput, expectedOutput));
+
+    // A compiled plan reruns with each line's numbers swapped in for the placeholders.
+    {
+        const char* textFileName = "BiNumsTestBatch.txt";
+        WriteTestFile(textFileName, {"1 2 0 1\n3.5 4 10 -2\n\n-1, 0.5, 2 2\r\n"});
+        stringOutput.clear();
+        MainImplementation("batch BiNumsTestBatch.txt float32 mul 0 0 add 0 0", stringOutput);
+        std::string errorOutput; // Errors replace the output.
+        MainImplementation("batch BiNumsTestBatch.txt float32 mul 0 0", errorOutput);
+        stringOutput += errorOutput;
+        remove(textFileName);
+    }
+    expectedOutput =
+        "       float32 2 (0x40000000)\n"
+        "       float32 1 (0x3F800000)\n"
+        "       float32 14 (0x41600000)\n"
+        "       float32 8 (0x41000000)\n"
+        "       float32 -0.5 (0xBF000000)\n"
+        "       float32 4 (0x40800000)\n"
+        "Expected 2 numbers on line 1, not 4"
+        ;
+    CheckFailure(CompareExpectedVsActual("Batch of operations", stringOutput, expectedOutput));
+
+    // Float8 operations compute in float32 and round the result once, saturating on overflow.
+    stringOutput.clear();
+    MainImplementation("float8e4m3 add 1 2 mul 20 30 float8e5m2 div 1 3", stringOutput);
+    expectedOutput =
+        "Operands to add:\n"
+        "    float8e4m3 1 (0x38)\n"
+        "    float8e4m3 2 (0x40)\n"
+        "Result from add:\n"
+        "    float8e4m3 3 (0x44)\n"
+        "\n"
+        "Operands to multiply:\n"
+        "    float8e4m3 20 (0x5A)\n"
+        "    float8e4m3 30 (0x5F)\n"
+        "Result from multiply:\n"
+        "    float8e4m3 448 (0x7E)\n"
+        "\n"
+        "Operands to divide:\n"
+        "    float8e5m2 1 (0x3C)\n"
+        "    float8e5m2 3 (0x42)\n"
+        "Result from divide:\n"
+        "    float8e5m2 0.3125 (0x35)\n"
+        "\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Float8 arithmetic", stringOutput, expectedOutput));
+
+    // Tabs and line breaks separate tokens too, as in command files.
+    stringOutput.clear();
+    MainImplementation("f16\tsub 1.5\r\n0.25  ", stringOutput);
+    expectedOutput =
+        "Operands to subtract:\n"
+        "       float16 1.5 (0x3E00)\n"
+        "       float16 0.25 (0x3400)\n"
+        "Result from subtract:\n"
+        "       float16 1.25 (0x3D00)\n"
+        "\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Whitespace and keyword aliases", stringOutput, expectedOutput));
+
+    // Long runs of numbers are streamed from the command text rather than parsed up front, with
+    // the same promotion and results.
+    {
+        std::string commandLine = "add 2.5";
+        for (size_t i = 0; i < 70000; ++i)
+        {
+            commandLine += " 1,";
+        }
+        commandLine += " -5 nop 7";
+        stringOutput.clear();
+        MainImplementation(commandLine, stringOutput);
+        stringOutput.erase(0, stringOutput.find("Result from add"));
+    }
+    expectedOutput =
+        "Result from add:\n"
+        "       float64 69997.5 (0x40F116D800000000)\n"
+        "\n"
+        "Operands to nop:\n"
+        "         int32 7 (0x00000007)\n"
+        "Result from nop:\n"
+        "         int32 7 (0x00000007)\n"
+        "\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Long run of numbers", stringOutput, expectedOutput));
+
+    // Numbers read from a text file, delimited by commas and line breaks.
+    {
+        const char* textFileName = "BiNumsTestNumbers.txt";
+        WriteTestFile(textFileName, {"1.5, 2.25\n-3\n"});
+        stringOutput.clear();
+        MainImplementation("float16 add textfile BiNumsTestNumbers.txt", stringOutput);
+        remove(textFileName);
+    }
+    expectedOutput =
+        "Operands to add:\n"
+        "       float16 1.5 (0x3E00)\n"
+        "       float16 2.25 (0x4080)\n"
+        "       float16 -3 (0xC200)\n"
+        "Result from add:\n"
+        "       float16 0.75 (0x3A00)\n"
+        "\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Text file of numbers", stringOutput, expectedOutput));
+
+    // Without a type, a text file's numbers share the widest type deduced, here int64 for mixed integers.
+    {
+        const char* textFileName = "BiNumsTestNumbers.txt";
+        WriteTestFile(textFileName, {"-1 3000000000\n"});
+        stringOutput.clear();
+        MainImplementation("textfile BiNumsTestNumbers.txt", stringOutput);
+        remove(textFileName);
+    }
+    expectedOutput =
+        "         int64 -1 (0xFFFFFFFFFFFFFFFF)\n"
+        "         int64 3000000000 (0x00000000B2D05E00)\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Text file of untyped numbers", stringOutput, expectedOutput));
+
+    // Numbers read from a binary file, from a byte offset and limited count.
+    {
+        const char* binaryFileName = "BiNumsTestNumbers.bin";
+        const uint16_t float16Values[] = {0x3E00 /*1.5*/, 0xC000 /*-2*/, 0x3400 /*0.25*/, 0x7BFF /*65504*/};
+        WriteTestFile(binaryFileName, {AsBytes(float16Values)});
+        stringOutput.clear();
+        MainImplementation("float32 add 1 file BiNumsTestNumbers.bin float16 2 2 10", stringOutput);
+        remove(binaryFileName);
+    }
+    expectedOutput =
+        "Operands to add:\n"
+        "       float32 1 (0x3F800000)\n"
+        "       float16 -2 (0xC000)\n"
+        "       float16 0.25 (0x3400)\n"
+        "       float32 10 (0x41200000)\n"
+        "Result from add:\n"
+        "       float32 9.25 (0x41140000)\n"
+        "\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Binary file of numbers", stringOutput, expectedOutput));
+
+    // Dump of a binary file's bytes, interpreted as types.
+    {
+        const char* binaryFileName = "BiNumsTestDump.bin";
+        const uint16_t float16Values[] = {0x3E00 /*1.5*/, 0xC000 /*-2*/, 0x3400 /*0.25*/, 0x7BFF /*65504*/, 0x3C00 /*1*/, 0, 0, 0, 0x6948 /*"Hi"*/};
+        WriteTestFile(binaryFileName, {AsBytes(float16Values)});
+        stringOutput.clear();
+        MainImplementation("dump BiNumsTestDump.bin float16 uint8 0 18", stringOutput);
+        remove(binaryFileName);
+    }
+    expectedOutput =
+        "    00000000: 00 3E 00 C0 00 34 FF 7B  00 3C 00 00 00 00 00 00  |.>...4.{.<......|\n"
+        "     float16: 1.5 -2 0.25 65504 1 0 0 0\n"
+        "       uint8: 0 62 0 192 0 52 255 123 0 60 0 0 0 0 0 0\n"
+        "    00000010: 48 69                                             |Hi|\n"
+        "     float16: 2704\n"
+        "       uint8: 72 105\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Dump binary file", stringOutput, expectedOutput));
+
+    // Conversion of a binary file from one type to another.
+    {
+        const char* inputFileName = "BiNumsTestConvertInput.bin";
+        const char* outputFileName = "BiNumsTestConvertOutput.bin";
+        const float float32Values[] = {1.5f, -2.0f, 3.140625f, 65504.0f, 1e-3f};
+        WriteTestFile(inputFileName, {AsBytes(float32Values)});
+        stringOutput.clear();
+        MainImplementation("convert BiNumsTestConvertInput.bin float32 BiNumsTestConvertOutput.bin float16", stringOutput);
+        MainImplementation("dump BiNumsTestConvertOutput.bin float16", stringOutput);
+        remove(inputFileName);
+        remove(outputFileName);
+    }
+    expectedOutput =
+        "Converted 5 elements from float32 to float16\n"
+        "    00000000: 00 3E 00 C0 48 42 FF 7B  19 14                    |.>..HB.{..|\n"
+        "     float16: 1.5 -2 3.140625 65504 0.00100040435791015625\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Convert binary file", stringOutput, expectedOutput));
+
+    // Conversion to narrower floats rounds to nearest even, including ties and float8 subnormals,
+    // and saturates float8e4m3 rather than overflowing to NaN.
+    {
+        const char* inputFileName = "BiNumsTestConvertInput.bin";
+        const char* outputFileName = "BiNumsTestConvertOutput.bin";
+        const float float32Values[] = {
+            3.4f, 0.0077f, 0.0113f,
+            1.00390625f, 1.01171875f, // bfloat16 ties: 1 + 1/256, 1 + 3/256
+            1.0625f, 1.1875f,         // float8e4m3 ties: 1 + 1/16, 1 + 3/16
+            0.0009765625f, 0.0029296875f, // float8e4m3 subnormal ties: 1/1024, 3/1024
+            500.0f,
+        };
+        WriteTestFile(inputFileName, {AsBytes(float32Values)});
+        stringOutput.clear();
+        MainImplementation("convert BiNumsTestConvertInput.bin float32 BiNumsTestConvertOutput.bin bfloat16", stringOutput);
+        MainImplementation("dump BiNumsTestConvertOutput.bin bfloat16", stringOutput);
+        MainImplementation("convert BiNumsTestConvertInput.bin float32 BiNumsTestConvertOutput.bin float8e4m3", stringOutput);
+        MainImplementation("dump BiNumsTestConvertOutput.bin float8e4m3", stringOutput);
+        remove(inputFileName);
+        remove(outputFileName);
+    }
+    expectedOutput =
+        "Converted 10 elements from float32 to bfloat16\n"
+        "    00000000: 5A 40 FC 3B 39 3C 80 3F  82 3F 88 3F 98 3F 80 3A  |Z@.;9<.?.?.?.?.:|\n"
+        "    bfloat16: 3.40625 0.0076904296875 0.01129150390625 1 1.015625 1.0625 1.1875 0.0009765625\n"
+        "    00000010: 40 3B FA 43                                       |@;.C|\n"
+        "    bfloat16: 0.0029296875 500\n"
+        "Converted 10 elements from float32 to float8e4m3\n"
+        "    00000000: 46 04 06 38 38 38 3A 00  02 7E                    |F..888:..~|\n"
+        "  float8e4m3: 3.5 0.0078125 0.01171875 1 1 1 1.25 0 0.00390625 448\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Convert binary file to bfloat16 and float8 rounding to nearest even", stringOutput, expectedOutput));
+
+    // Conversion of a NumPy file, taking the input type from its header, then reading the result.
+    {
+        const char* inputFileName = "BiNumsTestConvertInput.npy";
+        const char* outputFileName = "BiNumsTestConvertOutput.npy";
+        const std::string header = Npy::MakeHeader("<f4", /*isFortranOrder*/ false, {2, 2});
+        const float float32Values[] = {1.5f, -2.0f, 0.25f, 3.0f};
+        WriteTestFile(inputFileName, {header, AsBytes(float32Values)});
+        stringOutput.clear();
+        MainImplementation("convert BiNumsTestConvertInput.npy BiNumsTestConvertOutput.npy float16", stringOutput);
+        MainImplementation("add file BiNumsTestConvertOutput.npy", stringOutput);
+        remove(inputFileName);
+        remove(outputFileName);
+    }
+    expectedOutput =
+        "Converted 4 elements from float32 to float16\n"
+        "Operands to add:\n"
+        "       float16 1.5 (0x3E00)\n"
+        "       float16 -2 (0xC000)\n"
+        "       float16 0.25 (0x3400)\n"
+        "       float16 3 (0x4200)\n"
+        "Result from add:\n"
+        "       float16 2.75 (0x4180)\n"
+        "\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Convert NumPy file", stringOutput, expectedOutput));
+
+    // Big endian NumPy files are byte swapped as read, and files shorter than their shape are refused.
+    {
+        const char* fileName = "BiNumsTestBigEndian.npy";
+        const char* truncatedFileName = "BiNumsTestTruncated.npy";
+        const std::string header = Npy::MakeHeader(">i4", /*isFortranOrder*/ false, {3});
+        const uint8_t int32Bytes[] = {0xFF, 0xFF, 0xFF, 0xF9, 0x00, 0x00, 0x00, 0x08, 0x01, 0x02, 0x03, 0x04}; // -7 8 0x01020304
+        WriteTestFile(fileName, {header, AsBytes(int32Bytes)});
+        WriteTestFile(truncatedFileName, {header, AsBytes(int32Bytes).substr(0, sizeof(int32Bytes) - 2)});
+        stringOutput.clear();
+        MainImplementation("add file BiNumsTestBigEndian.npy", stringOutput);
+        std::string errorOutput;
+        MainImplementation("add file BiNumsTestTruncated.npy", errorOutput);
+        stringOutput.append(errorOutput);
+        remove(fileName);
+        remove(truncatedFileName);
+    }
+    expectedOutput =
+        "Operands to add:\n"
+        "         int32 -7 (0xFFFFFFF9)\n"
+        "         int32 8 (0x00000008)\n"
+        "         int32 16909060 (0x01020304)\n"
+        "Result from add:\n"
+        "         int32 16909061 (0x01020305)\n"
+        "\n"
+        "Expected 12 bytes of npy data for the shape, but only 10 follow the header in file: \"BiNumsTestTruncated.npy\""
+        ;
+    CheckFailure(CompareExpectedVsActual("Read big endian and truncated NumPy files", stringOutput, expectedOutput));
+
+    // Conversion of every floating point tensor of a safetensors model, then reading one tensor back.
+    {
+        const char* inputFileName = "BiNumsTestConvertInput.safetensors";
+        const char* outputFileName = "BiNumsTestConvertOutput.safetensors";
+        const std::string header = Safetensors::MakeHeader({{"w", "F32", {2}, 0, 8}, {"n", "I32", {1}, 8, 12}}, "");
+        const float float32Values[] = {1.5f, -3.0f};
+        const int32_t int32Values[] = {7};
+        WriteTestFile(inputFileName, {header, AsBytes(float32Values), AsBytes(int32Values)});
+        stringOutput.clear();
+        MainImplementation("convert BiNumsTestConvertInput.safetensors BiNumsTestConvertOutput.safetensors bfloat16", stringOutput);
+        MainImplementation("tensors BiNumsTestConvertOutput.safetensors", stringOutput);
+        MainImplementation("add file BiNumsTestConvertOutput.safetensors tensor w file BiNumsTestConvertOutput.safetensors tensor n", stringOutput);
+        remove(inputFileName);
+        remove(outputFileName);
+    }
+    expectedOutput =
+        "Converted 2 elements in 1 tensors to bfloat16, copying 1 other tensors\n"
+        "w bfloat16 [2] bytes 120..124\n"
+        "n int32 [1] bytes 124..128\n"
+        "2 tensors, 8 bytes\n"
+        "Operands to add:\n"
+        "      bfloat16 1.5 (0x3FC0)\n"
+        "      bfloat16 -3 (0xC040)\n"
+        "         int32 7 (0x00000007)\n"
+        "Result from add:\n"
+        "      bfloat16 5.5 (0x40B0)\n"
+        "\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Convert safetensors file", stringOutput, expectedOutput));
+
+    // Reading a block quantized GGUF tensor, one Q8_0 block of scale 0.5 and quants 0 to 31.
+    {
+        const char* fileName = "BiNumsTestRead.gguf";
+        std::string ggufFile("GGUF\x03\0\0\0" "\x01\0\0\0\0\0\0\0" "\0\0\0\0\0\0\0\0", 24); // Version 3, 1 tensor, 0 metadata
+        ggufFile.append("\x01\0\0\0\0\0\0\0" "q" "\x01\0\0\0" "\x20\0\0\0\0\0\0\0", 21); // Name "q", 1 dimension of 32
+        ggufFile.append("\x08\0\0\0" "\0\0\0\0\0\0\0\0", 12); // Q8_0 at data offset 0
+        ggufFile.resize(64, '\0'); // Aligned to 32 bytes.
+        ggufFile.append("\x00\x38", 2); // float16 0.5
+        for (char i = 0; i < 32; ++i)
+        {
+            ggufFile.push_back(i);
+        }
+        WriteTestFile(fileName, {ggufFile});
+        stringOutput.clear();
+        MainImplementation("tensors BiNumsTestRead.gguf", stringOutput);
+        MainImplementation("add file BiNumsTestRead.gguf tensor q 0 4", stringOutput);
+        remove(fileName);
+    }
+    expectedOutput =
+        "q Q8_0 [32] bytes 64..98\n"
+        "1 tensors, 34 bytes\n"
+        "Operands to add:\n"
+        "       float32 0 (0x00000000)\n"
+        "       float32 0.5 (0x3F000000)\n"
+        "       float32 1 (0x3F800000)\n"
+        "       float32 1.5 (0x3FC00000)\n"
+        "Result from add:\n"
+        "       float32 3 (0x40400000)\n"
+        "\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Read GGUF file", stringOutput, expectedOutput));
+
+    // Reading an ONNX initializer, from a model holding only a graph with one float32 tensor.
+    {
+        const char* fileName = "BiNumsTestRead.onnx";
+        const char onnxFile[] =
+            "\x08\x07"                 // ModelProto.ir_version = 7
+            "\x3A\x13"                 // ModelProto.graph, 19 bytes
+            "\x2A\x11"                 // GraphProto.initializer, 17 bytes
+            "\x08\x02"                 // TensorProto.dims = 2
+            "\x10\x01"                 // TensorProto.data_type = FLOAT
+            "\x42\x01" "w"             // TensorProto.name = "w"
+            "\x4A\x08"                 // TensorProto.raw_data, 8 bytes
+            "\x00\x00\xC0\x3F"         // 1.5
+            "\x00\x00\x40\xC0";        // -3
+        WriteTestFile(fileName, {{onnxFile, sizeof(onnxFile) - 1}});
+        stringOutput.clear();
+        MainImplementation("tensors BiNumsTestRead.onnx", stringOutput);
+        MainImplementation("add file BiNumsTestRead.onnx tensor w", stringOutput);
+        remove(fileName);
+    }
+    expectedOutput =
+        "w float32 [2] bytes 15..23\n"
+        "1 tensors, 8 bytes\n"
+        "Operands to add:\n"
+        "       float32 1.5 (0x3FC00000)\n"
+        "       float32 -3 (0xC0400000)\n"
+        "Result from add:\n"
+        "       float32 -1.5 (0xBFC00000)\n"
+        "\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Read ONNX file", stringOutput, expectedOutput));
+
+    // Reading 24-bit stereo PCM samples from a WAV file, past an odd sized (padded) metadata chunk.
+    {
+        const char* fileName = "BiNumsTestRead.wav";
+        const char wavFile[] =
+            "RIFF" "\x3C\x00\x00\x00" "WAVE"
+            "fmt " "\x10\x00\x00\x00"
+            "\x01\x00" "\x02\x00"       // PCM, 2 channels
+            "\x44\xAC\x00\x00"          // 44100 Hz
+            "\x98\x09\x04\x00"          // 264600 bytes per second
+            "\x06\x00" "\x18\x00"       // 6 bytes per frame, 24 bits per sample
+            "LIST" "\x03\x00\x00\x00" "abc" "\x00"
+            "data" "\x0C\x00\x00\x00"
+            "\x01\x00\x00" "\xFE\xFF\xFF" // 1, -2
+            "\xFF\xFF\x7F" "\x00\x00\x80"; // 8388607, -8388608
+        WriteTestFile(fileName, {{wavFile, sizeof(wavFile) - 1}});
+        stringOutput.clear();
+        MainImplementation("tensors BiNumsTestRead.wav", stringOutput);
+        MainImplementation("add file BiNumsTestRead.wav", stringOutput);
+        remove(fileName);
+    }
+    expectedOutput =
+        "- int24 [2,2] bytes 56..68\n"
+        "1 tensors, 12 bytes\n"
+        "Operands to add:\n"
+        "         int32 1 (0x00000001)\n"
+        "         int32 -2 (0xFFFFFFFE)\n"
+        "         int32 8388607 (0x007FFFFF)\n"
+        "         int32 -8388608 (0xFF800000)\n"
+        "Result from add:\n"
+        "         int32 -2 (0xFFFFFFFE)\n"
+        "\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Read WAV file", stringOutput, expectedOutput));
+
+    // Reading one channel of a row of a 16-bit PPM image, and a big-endian PFM image, whose samples
+    // are both byte swapped.
+    {
+        const char* imageFileName = "BiNumsTestRead.ppm";
+        const char* floatImageFileName = "BiNumsTestRead.pfm";
+        const char ppmFile[] =
+            "P6\n# 2x2 RGB\n2 2\n65535\n"
+            "\x00\x01\x00\x02\x00\x03" "\x00\x04\x00\x05\x00\x06"  // (1,2,3) (4,5,6)
+            "\x00\x07\x00\x08\x00\x09" "\x00\x0A\x00\x0B\x12\x34"; // (7,8,9) (10,11,0x1234)
+        const char pfmFile[] =
+            "Pf\n2 1\n1.0\n"            // Positive scale for big-endian
+            "\x3F\xC0\x00\x00"          // 1.5
+            "\xBE\x80\x00\x00";         // -0.25
+        WriteTestFile(imageFileName, {{ppmFile, sizeof(ppmFile) - 1}});
+        WriteTestFile(floatImageFileName, {{pfmFile, sizeof(pfmFile) - 1}});
+        stringOutput.clear();
+        MainImplementation("tensors BiNumsTestRead.ppm", stringOutput);
+        MainImplementation("uint32 add file BiNumsTestRead.ppm rows 1 channel 2", stringOutput);
+        MainImplementation("add file BiNumsTestRead.pfm", stringOutput);
+        remove(imageFileName);
+        remove(floatImageFileName);
+    }
+    expectedOutput =
+        "- >u2 [2,2,3] bytes 23..47\n"
+        "1 tensors, 24 bytes\n"
+        "Operands to add:\n"
+        "        uint16 9 (0x0009)\n"
+        "        uint16 4660 (0x1234)\n"
+        "Result from add:\n"
+        "        uint32 4669 (0x0000123D)\n"
+        "\n"
+        "Operands to add:\n"
+        "       float32 1.5 (0x3FC00000)\n"
+        "       float32 -0.25 (0xBE800000)\n"
+        "Result from add:\n"
+        "       float32 1.25 (0x3FA00000)\n"
+        "\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Read PPM and PFM files", stringOutput, expectedOutput));
+
+    // The SSSE3 kernels, chosen at runtime where the processor has SSSE3, match the portable paths.
+    {
+        std::vector<uint8_t> bytes(16 * 8 * 3 + 21);
+        for (size_t i = 0; i < bytes.size(); ++i)
+        {
+            bytes[i] = uint8_t(i * 151 + 7);
+        }
+        auto convertBytes = [&]()
+        {
+            const size_t sampleCount = bytes.size() / 3;
+            std::vector<int32_t> integers(sampleCount);
+            std::vector<float> floats(sampleCount);
+            std::vector<uint8_t> packed(sampleCount * 3);
+            std::vector<uint8_t> swapped(bytes.size() * 3);
+            UnpackInt24ToInt32(bytes.data(), /*out*/ integers.data(), sampleCount);
+            UnpackInt24ToFloat32(bytes.data(), /*out*/ floats.data(), sampleCount, 1.0f / 8388608);
+            PackInt32ToInt24(integers.data(), /*out*/ packed.data(), sampleCount);
+            for (uint32_t sizeIndex = 0; sizeIndex < 3; ++sizeIndex)
+            {
+                const uint32_t elementByteSize = 2u << sizeIndex;
+                SwapByteOrder(bytes.data(), /*out*/ swapped.data() + sizeIndex * bytes.size(), bytes.size() / elementByteSize, elementByteSize);
+            }
+            std::string output;
+            output.append(reinterpret_cast<const char*>(integers.data()), integers.size() * sizeof(int32_t));
+            output.append(reinterpret_cast<const char*>(floats.data()), floats.size() * sizeof(float));
+            output.append(packed.begin(), packed.end());
+            output.append(swapped.begin(), swapped.end());
+            return output;
+        };
+        const std::string detectedOutput = convertBytes();
+        const bool useSsse3 = CpuFeatures::UseSsse3();
+        CpuFeatures::UseSsse3() = false;
+        const std::string portableOutput = convertBytes();
+        CpuFeatures::UseSsse3() = useSsse3;
+        CheckFailure(CompareExpectedVsActual("SSSE3 kernels match portable code", detectedOutput == portableOutput ? "same" : "different", "same"));
+    }
+
+    {
+        const char* fileName = "BiNumsTestStats.bin";
+        const uint16_t float16Values[] = {0x3C00, 0xC000, 0x0000, 0x8000, 0x0001, 0x7C00, 0x7E00, 0x4200}; // 1 -2 0 -0 subnormal inf nan 3
+        const uint8_t float8Values[] = {0x7F, 0x7E, 0x00, 0x80, 0x01, 0xFF}; // nan 448 0 -0 subnormal nan
+        WriteTestFile(fileName, {AsBytes(float16Values), AsBytes(float8Values)});
+        stringOutput.clear();
+        MainImplementation("stats BiNumsTestStats.bin float16 0 8", stringOutput);
+        MainImplementation("stats BiNumsTestStats.bin float8e4m3 16", stringOutput);
+        remove(fileName);
+    }
+    expectedOutput =
+        "type       float16\n"
+        "elements   8\n"
+        "finite     6\n"
+        "nan        1\n"
+        "infinity   1\n"
+        "zero       2\n"
+        "subnormal  1\n"
+        "minimum    -2 (0xC000)\n"
+        "maximum    3 (0x4200)\n"
+        "absmaximum 3\n"
+        "sum        2.0000000596046448\n"
+        "mean       0.3333333432674408\n"
+        "variance   2.2222222155994844\n"
+        "stddev     1.490711982778526\n"
+        "type       float8e4m3\n"
+        "elements   6\n"
+        "finite     4\n"
+        "nan        2\n"
+        "infinity   0\n"
+        "zero       2\n"
+        "subnormal  1\n"
+        "minimum    0 (0x00)\n"
+        "maximum    448 (0x7E)\n"
+        "absmaximum 448\n"
+        "sum        448.001953125\n"
+        "mean       112.00048828125\n"
+        "variance   37631.890625715256\n"
+        "stddev     193.98940854004184\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Compute file statistics", stringOutput, expectedOutput));
+
+    // Quantiles of every tensor of a model, and then of each type's tensors in total.
+    {
+        const char* fileName = "BiNumsTestStats.safetensors";
+        const std::string header = Safetensors::MakeHeader({{"a", "F32", {2}, 0, 8}, {"b", "F32", {2}, 8, 16}, {"n", "I32", {1}, 16, 20}}, "");
+        const float float32Values[] = {1.0f, 2.0f, 3.0f, -4.0f};
+        const int32_t int32Values[] = {7};
+        WriteTestFile(fileName, {header, AsBytes(float32Values), AsBytes(int32Values)});
+        stringOutput.clear();
+        MainImplementation("quantiles BiNumsTestStats.safetensors", stringOutput);
+        remove(fileName);
+    }
+    expectedOutput =
+        "tensor     a\n"
+        "type       float32\n"
+        "elements   2\n"
+        "nan        0\n"
+        "p50        1.00390625\n"
+        "p90        2.0078125\n"
+        "p99        2.0078125\n"
+        "p99.9      2.0078125\n"
+        "p99.99     2.0078125\n"
+        "maximum    2\n"
+        "\n"
+        "tensor     b\n"
+        "type       float32\n"
+        "elements   2\n"
+        "nan        0\n"
+        "p50        3.0078125\n"
+        "p90        4.015625\n"
+        "p99        4.015625\n"
+        "p99.9      4.015625\n"
+        "p99.99     4.015625\n"
+        "maximum    4\n"
+        "\n"
+        "tensor     n\n"
+        "type       int32\n"
+        "elements   1\n"
+        "nan        0\n"
+        "p50        7.015625\n"
+        "p90        7.015625\n"
+        "p99        7.015625\n"
+        "p99.9      7.015625\n"
+        "p99.99     7.015625\n"
+        "maximum    7\n"
+        "\n"
+        "total      2 tensors\n"
+        "type       float32\n"
+        "elements   4\n"
+        "nan        0\n"
+        "p50        2.0078125\n"
+        "p90        4.015625\n"
+        "p99        4.015625\n"
+        "p99.9      4.015625\n"
+        "p99.99     4.015625\n"
+        "maximum    4\n"
+        "\n"
+        "total      1 tensors\n"
+        "type       int32\n"
+        "elements   1\n"
+        "nan        0\n"
+        "p50        7.015625\n"
+        "p90        7.015625\n"
+        "p99        7.015625\n"
+        "p99.9      7.015625\n"
+        "p99.99     7.015625\n"
+        "maximum    7\n"
+        "\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Estimate quantiles of every tensor", stringOutput, expectedOutput));
+
+    {
+        const char* fileName = "BiNumsTestHistogram.bin";
+        const uint16_t float16Values[] = {0x3C00, 0xC000, 0x0000, 0x8000, 0x0001, 0x7C00, 0x7E00, 0x4200, 0x3555}; // 1 -2 0 -0 subnormal inf nan 3 0.333
+        WriteTestFile(fileName, {AsBytes(float16Values)});
+        stringOutput.clear();
+        MainImplementation("histogram BiNumsTestHistogram.bin float16", stringOutput);
+        remove(fileName);
+    }
+    expectedOutput =
+        "type       float16\n"
+        "elements   9\n"
+        "zero       2             22.2222%\n"
+        "subnormal  1             11.1111%\n"
+        "2^-2       1             11.1111%\n"
+        "2^0        1             11.1111%\n"
+        "2^1        2             22.2222%\n"
+        "infinity   1             11.1111%\n"
+        "nan        1             11.1111%\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Compute exponent histogram", stringOutput, expectedOutput));
+
+    {
+        const char* fileName = "BiNumsTestValueHistogram.bin";
+        const uint16_t bfloat16Values[] = {0x3F80, 0x4000, 0x3F80, 0x8000, 0x4000, 0x3F80, 0x7FC0, 0x4040}; // 1 2 1 -0 2 1 nan 3
+        WriteTestFile(fileName, {AsBytes(bfloat16Values)});
+        stringOutput.clear();
+        MainImplementation("histogram BiNumsTestValueHistogram.bin bfloat16 values top 3", stringOutput);
+        remove(fileName);
+    }
+    expectedOutput =
+        "type       bfloat16\n"
+        "elements   8\n"
+        "distinct   5\n"
+        "entropy    2.155639 bits\n"
+        "3          37.5000%  1 (0x3F80)\n"
+        "2          25.0000%  2 (0x4000)\n"
+        "1          12.5000%  3 (0x4040)\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Compute value histogram", stringOutput, expectedOutput));
+
+    {
+        const char* fileName = "BiNumsTestQuantiles.bin";
+        int16_t int16Values[100];
+        for (int16_t i = 0; i < 100; ++i)
+        {
+            int16Values[i] = -1 - i; // -1 to -100
+        }
+        const uint32_t float32Values[] = {0x3F800000, 0xC0400000, 0x7FC00000, 0x00000000}; // 1 -3 nan 0
+        const double float64Values[] = {1e300, -2e300, 3}; // Beyond float32
+        WriteTestFile(fileName, {AsBytes(int16Values), AsBytes(float32Values), AsBytes(float64Values)});
+        stringOutput.clear();
+        MainImplementation("quantiles BiNumsTestQuantiles.bin int16 0 100", stringOutput);
+        MainImplementation("quantiles BiNumsTestQuantiles.bin float32 200 4", stringOutput);
+        MainImplementation("quantiles BiNumsTestQuantiles.bin float64 216", stringOutput);
+        remove(fileName);
+    }
+    expectedOutput =
+        "type       int16\n"
+        "elements   100\n"
+        "nan        0\n"
+        "p50        50\n"
+        "p90        90\n"
+        "p99        99\n"
+        "p99.9      100\n"
+        "p99.99     100\n"
+        "maximum    100\n"
+        "type       float32\n"
+        "elements   4\n"
+        "nan        1\n"
+        "p50        1.00390625\n"
+        "p90        3.0078125\n"
+        "p99        3.0078125\n"
+        "p99.9      3.0078125\n"
+        "p99.99     3.0078125\n"
+        "maximum    3\n"
+        "type       float64\n"
+        "elements   3\n"
+        "nan        0\n"
+        "p50        1.0019233314266123e+300\n"
+        "p90        2.0038466628532245e+300\n"
+        "p99        2.0038466628532245e+300\n"
+        "p99.9      2.0038466628532245e+300\n"
+        "p99.99     2.0038466628532245e+300\n"
+        "maximum    2e+300\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Estimate quantiles", stringOutput, expectedOutput));
+
+    {
+        const char* fileName = "BiNumsTestQerror.bin";
+        const int16_t int16Values[] = {1000, -3, 257, 100};
+        WriteTestFile(fileName, {AsBytes(int16Values)});
+        stringOutput.clear();
+        MainImplementation("qerror BiNumsTestQerror.bin int16", stringOutput);
+        remove(fileName);
+    }
+    expectedOutput =
+        "type       int16\n"
+        "elements   4\n"
+        "nonfinite  0\n"
+        "target        maxabserror   maxrelerror   rmse          maxulperror   saturated  flushed\n"
+        "float16       0             0             0             0             0          0\n"
+        "bfloat16      1             0.00389105    0.5           0.5           0          0\n"
+        "float8e4m3    4             0.04          2.38048       0.5           1          0\n"
+        "float8e5m2    24            0.04          12.1758       0.25          0          0\n"
+        "int8          0             0             0             0             2          0\n"
+        "uint8         0             0             0             0             3          0\n"
+        "uint16        0             0             0             0             1          0\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Analyze conversion errors", stringOutput, expectedOutput));
+
+    // qerror converts like the convert command, so its largest error for a target is the largest
+    // difference between a file and the same file converted to the target and back.
+    {
+        const char* fileName = "BiNumsTestQerror.bin";
+        const char* convertedFileName = "BiNumsTestQerrorConverted.bin";
+        const char* roundTripFileName = "BiNumsTestQerrorRoundTrip.bin";
+        const float float32Values[] = {3.4f, 0.0077f, 0.0113f, 1.01171875f, 1.1875f, 0.0029296875f, 316.0f, -0.3f};
+        WriteTestFile(fileName, {AsBytes(float32Values)});
+        stringOutput.clear();
+        MainImplementation("qerror BiNumsTestQerror.bin float32", stringOutput);
+        for (std::string_view targetTypeName : {"bfloat16", "float8e4m3"})
+        {
+            std::string convertOutput;
+            MainImplementation(std::string("convert BiNumsTestQerror.bin float32 BiNumsTestQerrorConverted.bin ").append(targetTypeName), convertOutput);
+            MainImplementation(std::string("convert BiNumsTestQerrorConverted.bin ").append(targetTypeName).append(" BiNumsTestQerrorRoundTrip.bin float32"), convertOutput);
+            MainImplementation("compare BiNumsTestQerror.bin BiNumsTestQerrorRoundTrip.bin float32 rtol 0 atol 0 top 1", stringOutput);
+        }
+        remove(fileName);
+        remove(convertedFileName);
+        remove(roundTripFileName);
+    }
+    expectedOutput =
+        "type       float32\n"
+        "elements   8\n"
+        "nonfinite  0\n"
+        "target        maxabserror   maxrelerror   rmse          maxulperror   saturated  flushed\n"
+        "float16       0.00039053    0.000243353   0.00013915    0.491211      0          0\n"
+        "bfloat16      0.0062499     0.003861      0.00262037    0.5           0          0\n"
+        "float8e4m3    4             0.333333      1.41484       0.5           0          0\n"
+        "float8e5m2    4             0.0526316     1.41484       0.25          0          0\n"
+        "fixed12_12    0.000195324   0.0170962     9.34551e-05   0.800049      0          0\n"
+        "fixed16_16    1.2219e-05    0.00124289    6.62862e-06   0.800781      0          0\n"
+        "fixed8_24     3.35276e-08   4.35424e-06   1.76741e-08   0.5625        1          0\n"
+        "int8          0.4           1             0.201951      0.4           1          4\n"
+        "uint8         0.4           1             0.180504      0.4           2          3\n"
+        "int16         0.4           1             0.188908      0.4           0          4\n"
+        "uint16        0.4           1             0.167114      0.4           1          3\n"
+        "int32         0.4           1             0.188908      0.4           0          4\n"
+        "uint32        0.4           1             0.167114      0.4           1          3\n"
+        "type       float32\n"
+        "elements   8\n"
+        "rtol       0\n"
+        "atol       0\n"
+        "failures   5\n"
+        "first      0\n"
+        "index         abserror      relerror      ulperror      values\n"
+        "0             0.0062499     0.00183483    26214         3.400000095367431640625 (0x4059999A) vs 3.40625 (0x405A0000)\n"
+        "result     fail\n"
+        "type       float32\n"
+        "elements   8\n"
+        "rtol       0\n"
+        "atol       0\n"
+        "failures   8\n"
+        "first      0\n"
+        "index         abserror      relerror      ulperror      values\n"
+        "6             4             0.0125        131072        316 (0x439E0000) vs 320 (0x43A00000)\n"
+        "result     fail\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Conversion errors match converting the file", stringOutput, expectedOutput));
+
+    {
+        const char* fileNameA = "BiNumsTestUlpdiffA.bin";
+        const char* fileNameB = "BiNumsTestUlpdiffB.bin";
+        const uint16_t float16ValuesA[] = {0x3C00, 0x4000, 0x8000, 0x7E00, 0x0001}; // 1 2 -0 nan 2^-24
+        const uint16_t float16ValuesB[] = {0x3C01, 0x4003, 0x0000, 0x7C01, 0x8001}; // +1ulp +3ulp 0 nan -2^-24
+        WriteTestFile(fileNameA, {AsBytes(float16ValuesA)});
+        WriteTestFile(fileNameB, {AsBytes(float16ValuesB)});
+        stringOutput.clear();
+        MainImplementation("ulpdiff BiNumsTestUlpdiffA.bin BiNumsTestUlpdiffB.bin float16", stringOutput);
+        MainImplementation("ulpdiff BiNumsTestUlpdiffA.bin BiNumsTestUlpdiffB.bin float16 maxulp 2", stringOutput);
+        MainImplementation("ulpdiff BiNumsTestUlpdiffA.bin BiNumsTestUlpdiffB.bin float16 stop", stringOutput);
+        remove(fileNameA);
+        remove(fileNameB);
+    }
+    expectedOutput =
+        "type       float16\n"
+        "elements   5\n"
+        "nandiffer  0\n"
+        "maxulp     3\n"
+        "maxindex   1\n"
+        "meanulp    1.2\n"
+        "0          2             40.0000%\n"
+        "2^0        1             20.0000%\n"
+        "2^1        2             40.0000%\n"
+        "type       float16\n"
+        "elements   5\n"
+        "nandiffer  0\n"
+        "maxulp     3\n"
+        "maxindex   1\n"
+        "meanulp    1.2\n"
+        "0          2             40.0000%\n"
+        "2^0        1             20.0000%\n"
+        "2^1        2             40.0000%\n"
+        "failures   1\n"
+        "first      1\n"
+        "result     fail\n"
+        "type       float16\n"
+        "elements   5\n"
+        "first      0\n"
+        "result     fail\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Compare ulp distances", stringOutput, expectedOutput));
+
+    {
+        const char* fileNameA = "BiNumsTestCompareA.bin";
+        const char* fileNameB = "BiNumsTestCompareB.bin";
+        const uint32_t float32ValuesA[] = {0x3F800000, 0x40000000, 0x40400000, 0x7FC00000, 0x7F800000}; // 1 2 3 nan inf
+        const uint32_t float32ValuesB[] = {0x3F800054, 0x40066666, 0x40400000, 0x7FC00000, 0x7F800000}; // 1.00001 2.1 3 nan inf
+        WriteTestFile(fileNameA, {AsBytes(float32ValuesA)});
+        WriteTestFile(fileNameB, {AsBytes(float32ValuesB)});
+        stringOutput.clear();
+        MainImplementation("compare BiNumsTestCompareA.bin BiNumsTestCompareB.bin float32 rtol=1e-3 atol=0", stringOutput);
+        MainImplementation("compare BiNumsTestCompareA.bin BiNumsTestCompareB.bin float32 rtol 1e-3 equalnan top 1", stringOutput);
+        MainImplementation("compare BiNumsTestCompareA.bin float32 0 3 BiNumsTestCompareB.bin float32 0 3 rtol 0.1", stringOutput);
+        remove(fileNameA);
+        remove(fileNameB);
+    }
+    expectedOutput =
+        "type       float32\n"
+        "elements   5\n"
+        "rtol       0.001\n"
+        "atol       0\n"
+        "failures   2\n"
+        "first      1\n"
+        "index         abserror      relerror      ulperror      values\n"
+        "3             nan           nan           0             nan (0x7FC00000) vs nan (0x7FC00000)\n"
+        "1             0.0999999     0.047619      419430        2 (0x40000000) vs 2.099999904632568359375 (0x40066666)\n"
+        "result     fail\n"
+        "type       float32\n"
+        "elements   5\n"
+        "rtol       0.001\n"
+        "atol       1e-08\n"
+        "failures   1\n"
+        "first      1\n"
+        "index         abserror      relerror      ulperror      values\n"
+        "1             0.0999999     0.047619      419430        2 (0x40000000) vs 2.099999904632568359375 (0x40066666)\n"
+        "result     fail\n"
+        "type       float32\n"
+        "elements   3\n"
+        "rtol       0.1\n"
+        "atol       1e-08\n"
+        "failures   0\n"
+        "result     pass\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Compare within tolerances", stringOutput, expectedOutput));
+
+    {
+        const char* fileNameA = "BiNumsTestNanScanA.bin";
+        const char* fileNameB = "BiNumsTestNanScanB.bin";
+        const uint16_t float16ValuesA[] = {0x3C00, 0x7C00, 0x0000, 0xFE00, 0x7BFF, 0xFC00}; // 1 inf 0 -nan 65504 -inf
+        const uint16_t float16ValuesB[] = {0x3C00, 0x4000, 0x4200, 0x4400, 0x7BFF, 0xFBFF}; // 1 2 3 4 65504 -65504
+        WriteTestFile(fileNameA, {AsBytes(float16ValuesA)});
+        WriteTestFile(fileNameB, {AsBytes(float16ValuesB)});
+        stringOutput.clear();
+        MainImplementation("nanscan BiNumsTestNanScanA.bin BiNumsTestNanScanB.bin float16", stringOutput);
+        MainImplementation("nanscan BiNumsTestNanScanA.bin float16 first 2", stringOutput);
+        MainImplementation("nanscan BiNumsTestNanScanB.bin float8e4m3", stringOutput);
+        remove(fileNameA);
+        remove(fileNameB);
+    }
+    expectedOutput =
+        "BiNumsTestNanScanA.bin: 3 nonfinite in 6 elements\n"
+        "    [1] inf (0x7C00)\n"
+        "    [3] -nan (0xFE00)\n"
+        "    [5] -inf (0xFC00)\n"
+        "BiNumsTestNanScanB.bin: 0 nonfinite in 6 elements\n"
+        "nonfinite  1 of 2\n"
+        "result     fail\n"
+        "BiNumsTestNanScanA.bin: first 2 nonfinite in 6 elements\n"
+        "    [1] inf (0x7C00)\n"
+        "    [3] -nan (0xFE00)\n"
+        "nonfinite  1 of 1\n"
+        "result     fail\n"
+        "BiNumsTestNanScanB.bin: 2 nonfinite in 12 elements\n"
+        "    [8] -nan (0xFF)\n"
+        "    [10] -nan (0xFF)\n"
+        "nonfinite  1 of 1\n"
+        "result     fail\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Scan for nonfinite values", stringOutput, expectedOutput));
+
+    {
+        const char* fileName = "BiNumsTestCensus.bin";
+        const uint16_t float16Values[] = {0x3C00, 0x7BFF, 0x0001, 0xB400, 0x7C00, 0x7E00, 0x5C00, 0x8000, 0x211F}; // 1 65504 2^-24 -0.25 inf nan 256 -0 0.01
+        WriteTestFile(fileName, {AsBytes(float16Values)});
+        stringOutput.clear();
+        MainImplementation("census BiNumsTestCensus.bin float16", stringOutput);
+        remove(fileName);
+    }
+    expectedOutput =
+        "type       float16\n"
+        "elements   9\n"
+        "nan        1\n"
+        "infinity   1\n"
+        "target        overflow      underflow     subnormal     nan\n"
+        "bfloat16      0             0             0             1\n"
+        "float8e4m3    1             1             1             2\n"
+        "float8e5m2    1             1             0             1\n"
+        "int8          3             3             0             1\n"
+        "uint8         3             3             0             1\n"
+        "int16         2             3             0             1\n"
+        "uint16        1             3             0             1\n"
+        ;
+    CheckFailure(CompareExpectedVsActual("Count range census", stringOutput, expectedOutput));
+
+    {
+        const char* fileName = "BiNumsTestQuantize.bin";
+        const char* outputFileName = "BiNumsTestQuantizeOut.bin";
+        const float float32Values[] = {1.0f, -2.0f, 0.5f, 4.0f, -8.0f, 3.0f, 0.25f, std::numeric_limits<float>::quiet_NaN()};
+        WriteTestFile(fileName, {AsBytes(float32Values)});
+        stringOutput.clear();
+        MainImplementation("quantize BiNumsTestQuantize.bin float32 int8 block 4", stringOutput);
+        MainImplementation("quantize BiNumsTestQuantize.bin float32 uint8 out BiNumsTestQuantizeOut.bin", stringOutput);
+        uint8_t quantizedValues[8] = {};
+        FILE* binaryFile = fopen(outputFileName, "rb");
+        if (binaryFile != nullptr)
+        {
+            fread(quantizedValues, sizeof(quantizedValues), 1, binaryFile);
+            fclose(binaryFile);
+        }
+        for (uint8_t value : quantizedValues)
+        {
+            stringOutput += std::to_string(value) + ' ';
+        }
+        remove(fileName);
+        remove(outputFileName);
+    }
+    expectedOutput =
+        "type       float32\n"
+        "elements   8\n"
+        "nonfinite  1\n"
+        "target     int8\n"
+        "scheme     symmetric\n"
+        "groups     2\n"
+        "group         minimum       maximum       scale\n"
+        "0             -2            4             0.0314960629\n"
+        "1             -8            3             0.0629921257\n"
+        "type       float32\n"
+        "elements   8\n"
+        "nonfinite  1\n"
+        "target     uint8\n"
+        "scheme     asymmetric\n"
+        "groups     1\n"
+        "group         minimum       maximum       scale         zeropoint\n"
+        "0             -8            4             0.0470588244  170\n"
+        "191 128 181 255 0 234 175 170 "
+        ;
+    CheckFailure(CompareExpectedVsActual("Quantize scales", stringOutput, expectedOutput));
+
+    CheckFailure(VerifyFloatingTypes());
+
+    return EXIT_SUCCESS;
+}
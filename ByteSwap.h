@@ -0,0 +1,86 @@
+//-----------------------------------------------------------------------------
+//
+//  Bulk byte order reversal of 2, 4, and 8 byte elements, for reading
+//  big-endian file data (like 16-bit PPM images or big-endian PFM).
+//
+//  SSSE3 reverses each element with one pshufb per 16 bytes (where the
+//  processor has it, checked at runtime), SSE2 falls back to shifts for 16-bit
+//  elements, and NEON uses vrev. Other sizes and the tails are swapped a byte
+//  at a time.
+//
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "CpuFeatures.h"
+
+#if defined(CPUFEATURES_X86) && (defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__))
+#include <tmmintrin.h>
+#define BYTESWAP_SSSE3 1
+#define BYTESWAP_SSE2 1
+#elif defined(_M_ARM64) || defined(__aarch64__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define BYTESWAP_NEON 1
+#endif
+
+#if defined(BYTESWAP_SSSE3)
+// Reverses 2, 4, or 8 byte elements 16 bytes at a time, returning the byte count reversed.
+CPUFEATURES_TARGET("ssse3") inline size_t SwapByteOrderSsse3(const uint8_t* input, uint8_t* output, size_t byteCount, uint32_t elementByteSize) noexcept
+{
+    const __m128i shuffles[3] =
+    {
+        _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14),
+        _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12),
+        _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8),
+    };
+    const __m128i shuffle = shuffles[elementByteSize / 4];
+    size_t i = 0;
+    for (/*above*/; i + 16 <= byteCount; i += 16)
+    {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_shuffle_epi8(x, shuffle));
+    }
+    return i;
+}
+#endif
+
+// Reverses the bytes of each element, where input and output may be the same buffer (but not
+// otherwise overlap).
+inline void SwapByteOrder(const uint8_t* input, uint8_t* output, size_t elementCount, uint32_t elementByteSize) noexcept
+{
+    const size_t byteCount = elementCount * elementByteSize;
+    size_t i = 0;
+    if (elementByteSize == 2 || elementByteSize == 4 || elementByteSize == 8)
+    {
+    #if defined(BYTESWAP_SSE2)
+        if (CpuFeatures::UseSsse3())
+        {
+            i = SwapByteOrderSsse3(input, output, byteCount, elementByteSize);
+        }
+        for (/*above*/; elementByteSize == 2 && i + 16 <= byteCount; i += 16)
+        {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8)));
+        }
+    #elif defined(BYTESWAP_NEON)
+        for (/*above*/; i + 16 <= byteCount; i += 16)
+        {
+            const uint8x16_t x = vld1q_u8(input + i);
+            const uint8x16_t y = (elementByteSize == 2) ? vrev16q_u8(x) : (elementByteSize == 4) ? vrev32q_u8(x) : vrev64q_u8(x);
+            vst1q_u8(output + i, y);
+        }
+    #endif
+    }
+
+    for (/*above*/; i < byteCount; i += elementByteSize)
+    {
+        for (uint32_t j = 0; j < (elementByteSize + 1) / 2; ++j)
+        {
+            const uint8_t low = input[i + j], high = input[i + elementByteSize - 1 - j];
+            output[i + j] = high;
+            output[i + elementByteSize - 1 - j] = low;
+        }
+    }
+}
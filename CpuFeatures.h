@@ -0,0 +1,48 @@
+//-----------------------------------------------------------------------------
+//
+//  Runtime detection of x86 instruction sets beyond the SSE2 baseline that
+//  builds target, so kernels compiled for them (with a target attribute, as
+//  MSVC needs none) run only on processors having them.
+//
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CPUFEATURES_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#if defined(CPUFEATURES_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CPUFEATURES_TARGET(features) __attribute__((target(features)))
+#else
+#define CPUFEATURES_TARGET(features)
+#endif
+
+namespace CpuFeatures
+{
+    inline bool DetectSsse3() noexcept
+    {
+    #if defined(CPUFEATURES_X86) && defined(_MSC_VER)
+        int registers[4] = {}; // eax, ebx, ecx, edx
+        __cpuid(registers, 1);
+        return (registers[2] & (1 << 9)) != 0;
+    #elif defined(CPUFEATURES_X86)
+        unsigned int eax, ebx, ecx, edx;
+        return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSSE3) != 0;
+    #else
+        return false;
+    #endif
+    }
+
+    // Whether SSSE3 kernels run, detected once. Tests may clear it to compare against the SSE2 paths.
+    inline bool& UseSsse3() noexcept
+    {
+        static bool useSsse3 = DetectSsse3();
+        return useSsse3;
+    }
+}
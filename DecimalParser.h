@@ -0,0 +1,647 @@
+//-----------------------------------------------------------------------------
+//
+//  Decimal string parsing which rounds directly to the target precision.
+//
+//  Parsing to float64 and then narrowing to float16 (or bfloat16, float8,
+//  fixed point) rounds twice, which can yield the wrong nearest value when
+//  the first rounding lands exactly on a halfway point of the narrow type.
+//  e.g. float16 2049.0000000000001 should round up to 2050, but float64
+//  rounds it to 2049 exactly, which then ties down to 2048.
+//
+//  The fast path follows Eisel-Lemire (https://arxiv.org/abs/2101.11408):
+//  multiply the leading 19 decimal digits by a truncated 64-bit power of ten,
+//  and only when the bits below the rounding position are too close to the
+//  halfway point to decide, compare exactly using big integers.
+//
+//  Supported targets must fit within the float32 range (up to ~1e40 and down
+//  to ~1e-46), which covers every type up to float32 and fixed point.
+//
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <cassert>
+#include <iterator>
+#include <string_view>
+#include <algorithm>
+#include <bit>
+#include "FloatNumber.h"
+
+namespace DecimalParser
+{
+    struct DecimalNumber
+    {
+        uint64_t significand = 0;           // Leading (up to 19) significant digits.
+        int32_t exponent = 0;               // Decimal exponent applied to the significand.
+        uint32_t significandDigitCount = 0; // Digits in the significand, excluding leading zeros.
+        bool isNegative = false;
+        bool hasTruncatedDigits = false;    // Nonzero digits beyond those held in the significand.
+        std::string_view digits;            // All digits, including any decimal point, for exact comparison.
+        int32_t digitsExponent = 0;         // Decimal exponent applied to all digits as one integer.
+    };
+
+    // Value equals significand * 2^exponent.
+    struct RoundedNumber
+    {
+        uint64_t significand = 0;
+        int32_t exponent = 0;
+        bool isOverflow = false;
+    };
+
+    // Parse a plain decimal number like "-12.75", ".5", or "6.02e23", returning
+    // the count of characters read. Returns 0 for anything else, such as hexadecimal
+    // floats ("0x1.8p3") or binary integers ("0b1101") which callers read via strtod.
+    inline size_t ParseDecimalNumber(std::string_view s, /*out*/ DecimalNumber& number)
+    {
+        number = {};
+
+        constexpr uint32_t maximumSignificandDigitCount = 19; // 10^19 - 1 fits within uint64_t.
+        char const* const begin = s.data();
+        char const* const end = begin + s.size();
+        char const* p = begin;
+
+        auto isDigit = [](char ch) { return ch >= '0' && ch <= '9'; };
+
+        if (p != end && (*p == '-' || *p == '+'))
+        {
+            number.isNegative = (*p == '-');
+            ++p;
+        }
+
+        // Reject radix prefixes, which strtod/strtoll handle instead.
+        if (end - p >= 2 && p[0] == '0')
+        {
+            char const ch = p[1] | 0x20; // Lowercase.
+            if (ch == 'x' || ch == 'b' || ch == 'o')
+            {
+                return 0;
+            }
+        }
+
+        char const* const digitsBegin = p;
+        bool isFraction = false;
+        uint32_t digitCount = 0;
+        int32_t fractionDigitCount = 0;
+
+        for (; p != end; ++p)
+        {
+            char const ch = *p;
+            if (ch == '.')
+            {
+                if (isFraction)
+                {
+                    break;
+                }
+                isFraction = true;
+                continue;
+            }
+            if (!isDigit(ch))
+            {
+                break;
+            }
+
+            ++digitCount;
+            fractionDigitCount += isFraction;
+            uint32_t const digit = ch - '0';
+
+            if (number.significandDigitCount == 0 && digit == 0)
+            {
+                // Leading zeros only shift the exponent when after the decimal point.
+                number.exponent -= isFraction;
+            }
+            else if (number.significandDigitCount < maximumSignificandDigitCount)
+            {
+                number.significand = number.significand * 10 + digit;
+                number.exponent -= isFraction;
+                ++number.significandDigitCount;
+            }
+            else
+            {
+                // Integer digits beyond the significand scale it up, whereas fraction digits are just dropped.
+                number.exponent += !isFraction;
+                number.hasTruncatedDigits |= (digit != 0);
+            }
+        }
+
+        if (digitCount == 0)
+        {
+            return 0;
+        }
+        number.digits = std::string_view(digitsBegin, p - digitsBegin);
+
+        // Read the optional exponent, only consuming the 'e' if digits follow.
+        int32_t explicitExponent = 0;
+        if (p != end && (*p | 0x20) == 'e')
+        {
+            char const* q = p + 1;
+            bool isExponentNegative = false;
+            if (q != end && (*q == '-' || *q == '+'))
+            {
+                isExponentNegative = (*q == '-');
+                ++q;
+            }
+            if (q != end && isDigit(*q))
+            {
+                for (; q != end && isDigit(*q); ++q)
+                {
+                    // Clamp absurd exponents, which saturate or flush to zero anyway.
+                    explicitExponent = std::min(explicitExponent * 10 + (*q - '0'), 100'000);
+                }
+                explicitExponent = isExponentNegative ? -explicitExponent : explicitExponent;
+                p = q;
+            }
+        }
+
+        number.exponent += explicitExponent;
+        number.digitsExponent = explicitExponent - fractionDigitCount;
+
+        return p - begin;
+    }
+
+    // Minimal unsigned big integer for exact comparisons, sized for the float32 range.
+    class BigInteger
+    {
+    public:
+        static constexpr uint32_t maximumLimbCount = 128; // 4096 bits
+
+        void Assign(uint64_t value)
+        {
+            limbCount_ = 0;
+            for (; value != 0; value >>= 32)
+            {
+                PushLimb(uint32_t(value));
+            }
+        }
+
+        void MultiplyAdd(uint32_t multiplier, uint32_t addend)
+        {
+            uint64_t carry = addend;
+            for (uint32_t i = 0; i < limbCount_; ++i)
+            {
+                uint64_t const product = uint64_t(limbs_[i]) * multiplier + carry;
+                limbs_[i] = uint32_t(product);
+                carry = product >> 32;
+            }
+            if (carry != 0)
+            {
+                PushLimb(uint32_t(carry));
+            }
+        }
+
+        void MultiplyPowerOfFive(uint32_t exponent)
+        {
+            constexpr uint32_t largestPowerOfFive = 1220703125; // 5^13, the largest power fitting in 32 bits.
+            for (; exponent >= 13; exponent -= 13)
+            {
+                MultiplyAdd(largestPowerOfFive, 0);
+            }
+            uint32_t remainingPower = 1;
+            for (; exponent > 0; --exponent)
+            {
+                remainingPower *= 5;
+            }
+            MultiplyAdd(remainingPower, 0);
+        }
+
+        void ShiftLeft(uint32_t bitCount)
+        {
+            if (limbCount_ == 0)
+            {
+                return;
+            }
+
+            uint32_t const limbShift = bitCount / 32;
+            uint32_t const bitShift = bitCount % 32;
+            assert(limbCount_ + limbShift + 1 <= maximumLimbCount);
+
+            if (bitShift != 0)
+            {
+                PushLimb(0);
+                for (uint32_t i = limbCount_ - 1; i > 0; --i)
+                {
+                    limbs_[i] = (limbs_[i] << bitShift) | (limbs_[i - 1] >> (32 - bitShift));
+                }
+                limbs_[0] <<= bitShift;
+                TrimLeadingZeros();
+            }
+            if (limbShift != 0)
+            {
+                std::copy_backward(limbs_, limbs_ + limbCount_, limbs_ + limbCount_ + limbShift);
+                std::fill(limbs_, limbs_ + limbShift, 0u);
+                limbCount_ += limbShift;
+            }
+        }
+
+        // Returns -1, 0, or 1.
+        static int Compare(BigInteger const& a, BigInteger const& b) noexcept
+        {
+            if (a.limbCount_ != b.limbCount_)
+            {
+                return (a.limbCount_ < b.limbCount_) ? -1 : 1;
+            }
+            for (uint32_t i = a.limbCount_; i > 0; --i)
+            {
+                if (a.limbs_[i - 1] != b.limbs_[i - 1])
+                {
+                    return (a.limbs_[i - 1] < b.limbs_[i - 1]) ? -1 : 1;
+                }
+            }
+            return 0;
+        }
+
+    private:
+        void PushLimb(uint32_t limb)
+        {
+            assert(limbCount_ < maximumLimbCount);
+            limbs_[limbCount_++] = limb;
+        }
+
+        void TrimLeadingZeros() noexcept
+        {
+            while (limbCount_ > 0 && limbs_[limbCount_ - 1] == 0)
+            {
+                --limbCount_;
+            }
+        }
+
+        uint32_t limbs_[maximumLimbCount]; // Little-endian order.
+        uint32_t limbCount_ = 0;
+    };
+
+    // Normalized 64-bit mantissas of 10^q, truncated, for q in [-64, 40].
+    // The binary exponent is floor(q * log2(10)) - 63, and entries 1e0..1e27 are exact.
+    constexpr int32_t minimumPowerOfTen = -64;
+    constexpr int32_t maximumPowerOfTen = 40;
+    constexpr uint64_t powersOfTen[] =
+    {
+        0xA87FEA27A539E9A5, // 1e-64
+        0xD29FE4B18E88640E, // 1e-63
+        0x83A3EEEEF9153E89, // 1e-62
+        0xA48CEAAAB75A8E2B, // 1e-61
+        0xCDB02555653131B6, // 1e-60
+        0x808E17555F3EBF11, // 1e-59
+        0xA0B19D2AB70E6ED6, // 1e-58
+        0xC8DE047564D20A8B, // 1e-57
+        0xFB158592BE068D2E, // 1e-56
+        0x9CED737BB6C4183D, // 1e-55
+        0xC428D05AA4751E4C, // 1e-54
+        0xF53304714D9265DF, // 1e-53
+        0x993FE2C6D07B7FAB, // 1e-52
+        0xBF8FDB78849A5F96, // 1e-51
+        0xEF73D256A5C0F77C, // 1e-50
+        0x95A8637627989AAD, // 1e-49
+        0xBB127C53B17EC159, // 1e-48
+        0xE9D71B689DDE71AF, // 1e-47
+        0x9226712162AB070D, // 1e-46
+        0xB6B00D69BB55C8D1, // 1e-45
+        0xE45C10C42A2B3B05, // 1e-44
+        0x8EB98A7A9A5B04E3, // 1e-43
+        0xB267ED1940F1C61C, // 1e-42
+        0xDF01E85F912E37A3, // 1e-41
+        0x8B61313BBABCE2C6, // 1e-40
+        0xAE397D8AA96C1B77, // 1e-39
+        0xD9C7DCED53C72255, // 1e-38
+        0x881CEA14545C7575, // 1e-37
+        0xAA242499697392D2, // 1e-36
+        0xD4AD2DBFC3D07787, // 1e-35
+        0x84EC3C97DA624AB4, // 1e-34
+        0xA6274BBDD0FADD61, // 1e-33
+        0xCFB11EAD453994BA, // 1e-32
+        0x81CEB32C4B43FCF4, // 1e-31
+        0xA2425FF75E14FC31, // 1e-30
+        0xCAD2F7F5359A3B3E, // 1e-29
+        0xFD87B5F28300CA0D, // 1e-28
+        0x9E74D1B791E07E48, // 1e-27
+        0xC612062576589DDA, // 1e-26
+        0xF79687AED3EEC551, // 1e-25
+        0x9ABE14CD44753B52, // 1e-24
+        0xC16D9A0095928A27, // 1e-23
+        0xF1C90080BAF72CB1, // 1e-22
+        0x971DA05074DA7BEE, // 1e-21
+        0xBCE5086492111AEA, // 1e-20
+        0xEC1E4A7DB69561A5, // 1e-19
+        0x9392EE8E921D5D07, // 1e-18
+        0xB877AA3236A4B449, // 1e-17
+        0xE69594BEC44DE15B, // 1e-16
+        0x901D7CF73AB0ACD9, // 1e-15
+        0xB424DC35095CD80F, // 1e-14
+        0xE12E13424BB40E13, // 1e-13
+        0x8CBCCC096F5088CB, // 1e-12
+        0xAFEBFF0BCB24AAFE, // 1e-11
+        0xDBE6FECEBDEDD5BE, // 1e-10
+        0x89705F4136B4A597, // 1e-9
+        0xABCC77118461CEFC, // 1e-8
+        0xD6BF94D5E57A42BC, // 1e-7
+        0x8637BD05AF6C69B5, // 1e-6
+        0xA7C5AC471B478423, // 1e-5
+        0xD1B71758E219652B, // 1e-4
+        0x83126E978D4FDF3B, // 1e-3
+        0xA3D70A3D70A3D70A, // 1e-2
+        0xCCCCCCCCCCCCCCCC, // 1e-1
+        0x8000000000000000, // 1e0
+        0xA000000000000000, // 1e1
+        0xC800000000000000, // 1e2
+        0xFA00000000000000, // 1e3
+        0x9C40000000000000, // 1e4
+        0xC350000000000000, // 1e5
+        0xF424000000000000, // 1e6
+        0x9896800000000000, // 1e7
+        0xBEBC200000000000, // 1e8
+        0xEE6B280000000000, // 1e9
+        0x9502F90000000000, // 1e10
+        0xBA43B74000000000, // 1e11
+        0xE8D4A51000000000, // 1e12
+        0x9184E72A00000000, // 1e13
+        0xB5E620F480000000, // 1e14
+        0xE35FA931A0000000, // 1e15
+        0x8E1BC9BF04000000, // 1e16
+        0xB1A2BC2EC5000000, // 1e17
+        0xDE0B6B3A76400000, // 1e18
+        0x8AC7230489E80000, // 1e19
+        0xAD78EBC5AC620000, // 1e20
+        0xD8D726B7177A8000, // 1e21
+        0x878678326EAC9000, // 1e22
+        0xA968163F0A57B400, // 1e23
+        0xD3C21BCECCEDA100, // 1e24
+        0x84595161401484A0, // 1e25
+        0xA56FA5B99019A5C8, // 1e26
+        0xCECB8F27F4200F3A, // 1e27
+        0x813F3978F8940984, // 1e28
+        0xA18F07D736B90BE5, // 1e29
+        0xC9F2C9CD04674EDE, // 1e30
+        0xFC6F7C4045812296, // 1e31
+        0x9DC5ADA82B70B59D, // 1e32
+        0xC5371912364CE305, // 1e33
+        0xF684DF56C3E01BC6, // 1e34
+        0x9A130B963A6C115C, // 1e35
+        0xC097CE7BC90715B3, // 1e36
+        0xF0BDC21ABB48DB20, // 1e37
+        0x96769950B50D88F4, // 1e38
+        0xBC143FA4E250EB31, // 1e39
+        0xEB194F8E1AE525FD, // 1e40
+    };
+    static_assert(std::size(powersOfTen) == maximumPowerOfTen - minimumPowerOfTen + 1);
+
+    // Full 128-bit product of two 64-bit values.
+    inline void MultiplyFull(uint64_t a, uint64_t b, /*out*/ uint64_t& high, /*out*/ uint64_t& low) noexcept
+    {
+    #if defined(__SIZEOF_INT128__)
+        unsigned __int128 const product = static_cast<unsigned __int128>(a) * b;
+        high = uint64_t(product >> 64);
+        low = uint64_t(product);
+    #else
+        uint64_t const aLow = uint32_t(a), aHigh = a >> 32;
+        uint64_t const bLow = uint32_t(b), bHigh = b >> 32;
+        uint64_t const lowLow = aLow * bLow;
+        uint64_t const highLow = aHigh * bLow;
+        uint64_t const lowHigh = aLow * bHigh;
+        uint64_t const middle = (lowLow >> 32) + uint32_t(highLow) + uint32_t(lowHigh);
+        high = aHigh * bHigh + (highLow >> 32) + (lowHigh >> 32) + (middle >> 32);
+        low = (middle << 32) | uint32_t(lowLow);
+    #endif
+    }
+
+    // Exactly compare the full decimal value against the halfway point (2 * significand + 1) * 2^(exponent - 1),
+    // returning -1 if below, 0 if equal, or 1 if above.
+    inline int CompareToHalfway(DecimalNumber const& number, uint64_t significand, int32_t exponent)
+    {
+        // Digits past this limit can only break ties, since the halfway point of
+        // any supported type has far fewer significant decimal digits.
+        constexpr uint32_t maximumDigitCount = 768;
+
+        BigInteger decimalValue;
+        int32_t decimalExponent = number.digitsExponent;
+        uint32_t digitCount = 0;
+        bool hasTruncatedDigits = false;
+        uint32_t pendingValue = 0;
+        uint32_t pendingMultiplier = 1;
+
+        for (char ch : number.digits)
+        {
+            if (ch == '.')
+            {
+                continue;
+            }
+            uint32_t const digit = ch - '0';
+            if (digitCount == 0 && digit == 0)
+            {
+                continue; // Skip leading zeros.
+            }
+            if (digitCount >= maximumDigitCount)
+            {
+                ++decimalExponent;
+                hasTruncatedDigits |= (digit != 0);
+                continue;
+            }
+
+            // Accumulate 9 digits at a time to reduce big integer passes.
+            ++digitCount;
+            pendingValue = pendingValue * 10 + digit;
+            pendingMultiplier *= 10;
+            if (pendingMultiplier == 1'000'000'000)
+            {
+                decimalValue.MultiplyAdd(pendingMultiplier, pendingValue);
+                pendingValue = 0;
+                pendingMultiplier = 1;
+            }
+        }
+        decimalValue.MultiplyAdd(pendingMultiplier, pendingValue);
+
+        // Compare decimal * 10^decimalExponent against halfway * 2^(exponent - 1),
+        // moving the powers of five and two onto whichever side keeps them integral.
+        BigInteger halfwayValue;
+        halfwayValue.Assign(significand * 2 + 1);
+
+        int32_t const halfwayExponent = exponent - 1;
+        if (decimalExponent >= 0)
+        {
+            decimalValue.MultiplyPowerOfFive(decimalExponent);
+        }
+        else
+        {
+            halfwayValue.MultiplyPowerOfFive(-decimalExponent);
+        }
+
+        // Remaining powers of two: decimal side has 2^decimalExponent, halfway side has 2^halfwayExponent.
+        if (decimalExponent > halfwayExponent)
+        {
+            decimalValue.ShiftLeft(decimalExponent - halfwayExponent);
+        }
+        else
+        {
+            halfwayValue.ShiftLeft(halfwayExponent - decimalExponent);
+        }
+
+        int comparison = BigInteger::Compare(decimalValue, halfwayValue);
+        if (comparison == 0 && hasTruncatedDigits)
+        {
+            comparison = 1;
+        }
+        return comparison;
+    }
+
+    // Round the decimal number to the nearest integer multiple of 2^ulpExponent (ties to even),
+    // where getUlpExponent maps the value's binary exponent (floor(log2(value))) to the exponent
+    // of its unit last place. Results needing more than 54 significand bits are reported as
+    // overflow, which is beyond the range of every supported type anyway.
+    template <typename GetUlpExponent>
+    RoundedNumber RoundToBinary(DecimalNumber const& number, GetUlpExponent&& getUlpExponent)
+    {
+        RoundedNumber rounded = {};
+        if (number.significand == 0)
+        {
+            return rounded;
+        }
+
+        // Values at least 1e41 overflow float32, and values below 1e-46 are under half its smallest subnormal.
+        int32_t const leadingDigitExponent = number.exponent + int32_t(number.significandDigitCount) - 1;
+        if (leadingDigitExponent > maximumPowerOfTen)
+        {
+            rounded.isOverflow = true;
+            return rounded;
+        }
+        if (leadingDigitExponent < minimumPowerOfTen + 18)
+        {
+            return rounded;
+        }
+        assert(number.exponent >= minimumPowerOfTen && number.exponent <= maximumPowerOfTen);
+
+        // Multiply the normalized significand by the power of ten, so the product's top bit is 126 or 127.
+        uint32_t const leadingZeroCount = std::countl_zero(number.significand);
+        uint64_t const normalizedSignificand = number.significand << leadingZeroCount;
+        uint64_t const powerOfTen = powersOfTen[number.exponent - minimumPowerOfTen];
+        int32_t const productExponent = ((number.exponent * 217706) >> 16) - 63 - int32_t(leadingZeroCount); // floor(q * log2(10)) - 63
+        uint64_t high, low;
+        MultiplyFull(normalizedSignificand, powerOfTen, /*out*/ high, /*out*/ low);
+
+        int32_t const productTopBit = (high >> 63) ? 127 : 126;
+        int32_t const valueExponent = productTopBit + productExponent;
+        int32_t const ulpExponent = getUlpExponent(valueExponent);
+        if (valueExponent - ulpExponent > 54)
+        {
+            rounded.isOverflow = true;
+            return rounded;
+        }
+
+        // The count of product bits below the unit last place, always at least 72 due to the
+        // limit above, which leaves room for the truncation error to be well below halfway.
+        int32_t const shift = ulpExponent - productExponent;
+        rounded.exponent = ulpExponent;
+        if (shift >= 130)
+        {
+            return rounded; // Less than half the unit last place, even with error.
+        }
+
+        // The truncated power of ten and any truncated digits leave the true product slightly above
+        // the computed one, by less than 2^69 (33 units of the high word, including carry).
+        bool const isExact = (number.exponent >= 0 && number.exponent <= 27 && !number.hasTruncatedDigits);
+        uint64_t const errorInHighWord = isExact ? 0 : 33;
+
+        uint64_t truncatedSignificand = 0;
+        int roundingDirection = 0; // -1 down, 1 up, 0 undecided
+        if (shift < 128)
+        {
+            uint32_t const highShift = shift - 64;
+            uint64_t const remainderHigh = high & ((uint64_t(1) << highShift) - 1);
+            uint64_t const halfwayHigh = uint64_t(1) << (highShift - 1);
+            truncatedSignificand = high >> highShift;
+
+            if (remainderHigh > halfwayHigh || (remainderHigh == halfwayHigh && low != 0))
+            {
+                roundingDirection = 1;
+            }
+            else if (remainderHigh == halfwayHigh && low == 0 && isExact)
+            {
+                roundingDirection = (truncatedSignificand & 1) ? 1 : -1; // Exact ties round to even.
+            }
+            else if (isExact || remainderHigh + errorInHighWord + 1 <= halfwayHigh)
+            {
+                roundingDirection = -1;
+            }
+        }
+
+        if (roundingDirection == 0)
+        {
+            roundingDirection = CompareToHalfway(number, truncatedSignificand, ulpExponent);
+            if (roundingDirection == 0)
+            {
+                roundingDirection = (truncatedSignificand & 1) ? 1 : -1;
+            }
+        }
+
+        rounded.significand = truncatedSignificand + (roundingDirection > 0);
+        return rounded;
+    }
+
+    // Round the decimal number to the nearest value of the floating point definition
+    // (a FloatNumberDefinitions::Details), returning the raw bits. Values beyond the largest
+    // finite value saturate to infinity, or to the largest value for types without infinity.
+    template <typename FloatDefinition>
+    typename FloatDefinition::baseIntegerType RoundToFloat(DecimalNumber const& number)
+    {
+        using Definition = FloatDefinition;
+        static_assert(Definition::exponentBitCount <= 8, "Types wider than float32 exceed the power of ten table.");
+
+        static constexpr int32_t fractionBitCount = Definition::fractionBitCount;
+        static constexpr int32_t minimumUlpExponent = 1 - Definition::exponentBias - fractionBitCount;
+
+        RoundedNumber const rounded = RoundToBinary(
+            number,
+            [](int32_t valueExponent) { return std::max(valueExponent - fractionBitCount, minimumUlpExponent); }
+        );
+
+        uint64_t bits = 0;
+        if (rounded.isOverflow)
+        {
+            bits = Definition::maximumLegalBitValue;
+        }
+        else if (rounded.significand != 0)
+        {
+            // Rounding up may carry into a new bit.
+            uint64_t significand = rounded.significand;
+            int32_t exponent = rounded.exponent;
+            if (significand >> (fractionBitCount + 1))
+            {
+                significand >>= 1;
+                ++exponent;
+            }
+
+            // The hidden bit of normal numbers adds one to the biased exponent field, and
+            // subnormals (with the minimum exponent and no hidden bit) just store the fraction.
+            bits = (uint64_t(exponent - minimumUlpExponent) << fractionBitCount) + significand;
+            bits = std::min<uint64_t>(bits, Definition::maximumLegalBitValue);
+
+            if (!Definition::hasSubnormals && bits <= Definition::fractionMask)
+            {
+                bits = 0;
+            }
+        }
+
+        if (number.isNegative)
+        {
+            bits |= Definition::signMask;
+        }
+        return typename Definition::baseIntegerType(bits);
+    }
+
+    // Round the decimal number to the nearest two's complement fixed point value, returning
+    // the raw integer bits. Values beyond the range saturate to the minimum/maximum.
+    template <uint32_t TotalBitCount, uint32_t FractionBitCount>
+    int64_t RoundToFixed(DecimalNumber const& number)
+    {
+        static_assert(TotalBitCount <= 54);
+
+        RoundedNumber const rounded = RoundToBinary(
+            number,
+            [](int32_t) { return -int32_t(FractionBitCount); }
+        );
+
+        uint64_t constexpr maximumMagnitude = (uint64_t(1) << (TotalBitCount - 1)) - 1;
+        uint64_t const limit = maximumMagnitude + number.isNegative; // One more for negative two's complement.
+        uint64_t const magnitude = rounded.isOverflow ? limit : std::min(rounded.significand, limit);
+
+        return number.isNegative ? -int64_t(magnitude) : int64_t(magnitude);
+    }
+
+} // namespace DecimalParser
@@ -0,0 +1,677 @@
+//-----------------------------------------------------------------------------
+//
+//  Sequential chunked file reading and writing with several requests in
+//  flight, so that converting threads are not stalled on blocking I/O.
+//
+//  On Linux, requests go through io_uring (via raw system calls, so there is
+//  no liburing dependency) using buffers registered up front with fixed
+//  buffer reads and writes. Elsewhere, or when io_uring is unavailable (old
+//  kernels, disabled by policy), each request is a positional pread/pwrite
+//  run asynchronously, so callers see the same queue either way.
+//
+//  Direct I/O (O_DIRECT / FILE_FLAG_NO_BUFFERING) bypasses the page cache for
+//  files much larger than memory. Buffers and chunk sizes are aligned to
+//  allow it, and it is silently dropped when the file system refuses it.
+//
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <cerrno>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <new>
+#include <vector>
+
+#if _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#define FILEIO_IO_URING 1
+#endif
+#endif
+
+namespace FileIo
+{
+    // Buffer and chunk alignment satisfying direct I/O on common block devices.
+    constexpr size_t alignment = 4096;
+
+    enum class Backend
+    {
+        None,
+        Positional, // pread/pwrite (ReadFile/WriteFile at offsets on Windows)
+        IoUring,
+    };
+
+    namespace Details
+    {
+    #if _WIN32
+        using Handle = HANDLE;
+        inline const Handle invalidHandle = INVALID_HANDLE_VALUE;
+    #else
+        using Handle = int;
+        constexpr Handle invalidHandle = -1;
+    #endif
+
+        struct AlignedDelete
+        {
+            void operator()(uint8_t* p) const noexcept { ::operator delete[](p, std::align_val_t(alignment)); }
+        };
+        using AlignedBuffer = std::unique_ptr<uint8_t[], AlignedDelete>;
+
+        inline AlignedBuffer AllocateAlignedBuffer(size_t byteSize)
+        {
+            return AlignedBuffer(static_cast<uint8_t*>(::operator new[](byteSize, std::align_val_t(alignment))));
+        }
+
+        inline Handle OpenHandle(const char* filePath, bool forWriting, bool useDirectIo)
+        {
+        #if _WIN32
+            const DWORD flags = FILE_ATTRIBUTE_NORMAL | (useDirectIo ? FILE_FLAG_NO_BUFFERING : 0);
+            return forWriting
+                ? CreateFileA(filePath, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, flags, nullptr)
+                : CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+        #else
+            int flags = forWriting ? (O_WRONLY | O_CREAT | O_TRUNC) : O_RDONLY;
+        #ifdef O_DIRECT
+            flags |= useDirectIo ? O_DIRECT : 0;
+        #endif
+            return open(filePath, flags | O_CLOEXEC, 0666);
+        #endif
+        }
+
+        inline void CloseHandle(Handle handle) noexcept
+        {
+        #if _WIN32
+            ::CloseHandle(handle);
+        #else
+            close(handle);
+        #endif
+        }
+
+        inline bool GetFileSize(Handle handle, /*out*/ uint64_t& fileSize) noexcept
+        {
+        #if _WIN32
+            LARGE_INTEGER size = {};
+            if (!GetFileSizeEx(handle, &size))
+            {
+                return false;
+            }
+            fileSize = uint64_t(size.QuadPart);
+        #else
+            struct stat fileStatus;
+            if (fstat(handle, &fileStatus) != 0)
+            {
+                return false;
+            }
+            fileSize = uint64_t(fileStatus.st_size);
+        #endif
+            return true;
+        }
+
+        inline bool SetFileSize(Handle handle, uint64_t fileSize) noexcept
+        {
+        #if _WIN32
+            FILE_END_OF_FILE_INFO endOfFile = {};
+            endOfFile.EndOfFile.QuadPart = LONGLONG(fileSize);
+            return SetFileInformationByHandle(handle, FileEndOfFileInfo, &endOfFile, sizeof(endOfFile));
+        #else
+            return ftruncate(handle, off_t(fileSize)) == 0;
+        #endif
+        }
+
+        // Reads or writes up to byteCount bytes, continuing after partial transfers until at least
+        // requiredByteCount or the end of file, returning the byte count transferred, or -1 on error.
+        // (direct I/O may request more than the file holds, since sizes must be whole blocks)
+        inline int64_t TransferAt(Handle handle, bool forWriting, uint8_t* data, size_t byteCount, size_t requiredByteCount, uint64_t offset) noexcept
+        {
+            size_t totalByteCount = 0;
+            while (totalByteCount < requiredByteCount)
+            {
+                const size_t remainingByteCount = byteCount - totalByteCount;
+            #if _WIN32
+                OVERLAPPED overlapped = {};
+                overlapped.Offset = DWORD(offset + totalByteCount);
+                overlapped.OffsetHigh = DWORD((offset + totalByteCount) >> 32);
+                DWORD transferredByteCount = 0;
+                const DWORD requestedByteCount = DWORD(std::min<size_t>(remainingByteCount, 1u << 30));
+                const BOOL succeeded = forWriting
+                    ? WriteFile(handle, data + totalByteCount, requestedByteCount, &transferredByteCount, &overlapped)
+                    : ReadFile(handle, data + totalByteCount, requestedByteCount, &transferredByteCount, &overlapped);
+                if (!succeeded)
+                {
+                    if (!forWriting && GetLastError() == ERROR_HANDLE_EOF)
+                    {
+                        break;
+                    }
+                    return -1;
+                }
+            #else
+                const ssize_t transferredByteCount = forWriting
+                    ? pwrite(handle, data + totalByteCount, remainingByteCount, off_t(offset + totalByteCount))
+                    : pread(handle, data + totalByteCount, remainingByteCount, off_t(offset + totalByteCount));
+                if (transferredByteCount < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    return -1;
+                }
+            #endif
+                if (transferredByteCount == 0)
+                {
+                    break; // End of file.
+                }
+                totalByteCount += size_t(transferredByteCount);
+            }
+            return int64_t(totalByteCount);
+        }
+
+    #if defined(FILEIO_IO_URING)
+        // Minimal io_uring submission/completion rings over registered buffers, one request per buffer.
+        class IoUring
+        {
+        public:
+            IoUring() = default;
+            IoUring(const IoUring&) = delete;
+            IoUring& operator=(const IoUring&) = delete;
+            ~IoUring() { Close(); }
+
+            bool Open(uint32_t entryCount, const struct iovec* buffers, uint32_t bufferCount)
+            {
+                io_uring_params params = {};
+                ringFd_ = int(syscall(__NR_io_uring_setup, entryCount, &params));
+                if (ringFd_ < 0)
+                {
+                    return false;
+                }
+
+                sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+                cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                const bool isSingleMapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+                if (isSingleMapping)
+                {
+                    sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+                }
+
+                sqRing_ = MapRing(sqRingSize_, IORING_OFF_SQ_RING);
+                cqRing_ = isSingleMapping ? sqRing_ : MapRing(cqRingSize_, IORING_OFF_CQ_RING);
+                sqes_ = static_cast<io_uring_sqe*>(MapRing(params.sq_entries * sizeof(io_uring_sqe), IORING_OFF_SQES));
+                sqeCount_ = params.sq_entries;
+                if (sqRing_ == nullptr || cqRing_ == nullptr || sqes_ == nullptr)
+                {
+                    Close();
+                    return false;
+                }
+
+                auto* sqBase = static_cast<uint8_t*>(sqRing_);
+                auto* cqBase = static_cast<uint8_t*>(cqRing_);
+                sqTail_ = reinterpret_cast<uint32_t*>(sqBase + params.sq_off.tail);
+                sqMask_ = *reinterpret_cast<uint32_t*>(sqBase + params.sq_off.ring_mask);
+                sqArray_ = reinterpret_cast<uint32_t*>(sqBase + params.sq_off.array);
+                cqHead_ = reinterpret_cast<uint32_t*>(cqBase + params.cq_off.head);
+                cqTail_ = reinterpret_cast<uint32_t*>(cqBase + params.cq_off.tail);
+                cqMask_ = *reinterpret_cast<uint32_t*>(cqBase + params.cq_off.ring_mask);
+                cqes_ = reinterpret_cast<io_uring_cqe*>(cqBase + params.cq_off.cqes);
+
+                // Registered buffers are pinned once, rather than mapped on every request.
+                if (syscall(__NR_io_uring_register, ringFd_, IORING_REGISTER_BUFFERS, buffers, bufferCount) != 0)
+                {
+                    Close();
+                    return false;
+                }
+                return true;
+            }
+
+            void Close() noexcept
+            {
+                if (sqes_ != nullptr) munmap(sqes_, sqeCount_ * sizeof(io_uring_sqe));
+                if (cqRing_ != nullptr && cqRing_ != sqRing_) munmap(cqRing_, cqRingSize_);
+                if (sqRing_ != nullptr) munmap(sqRing_, sqRingSize_);
+                if (ringFd_ >= 0) close(ringFd_);
+                sqes_ = nullptr;
+                cqRing_ = nullptr;
+                sqRing_ = nullptr;
+                ringFd_ = -1;
+            }
+
+            // Submits a fixed buffer read or write, tagged with the buffer index. If the kernel refuses
+            // it (like EAGAIN, EBUSY, or a seccomp filter), the entry is withdrawn from the ring again.
+            bool Submit(int fd, bool forWriting, const struct iovec& buffer, uint32_t bufferIndex, size_t byteCount, uint64_t offset) noexcept
+            {
+                const uint32_t tail = *sqTail_; // Only this thread writes the tail.
+                const uint32_t index = tail & sqMask_;
+                io_uring_sqe& sqe = sqes_[index];
+                sqe = {};
+                sqe.opcode = forWriting ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+                sqe.fd = fd;
+                sqe.off = offset;
+                sqe.addr = reinterpret_cast<uint64_t>(buffer.iov_base);
+                sqe.len = uint32_t(byteCount);
+                sqe.buf_index = uint16_t(bufferIndex);
+                sqe.user_data = bufferIndex;
+                sqArray_[index] = index;
+                std::atomic_ref<uint32_t>(*sqTail_).store(tail + 1, std::memory_order_release);
+
+                while (true)
+                {
+                    const long result = syscall(__NR_io_uring_enter, ringFd_, 1, 0, 0, nullptr, 0);
+                    if (result == 1)
+                    {
+                        return true;
+                    }
+                    if (result < 0 && errno == EINTR)
+                    {
+                        continue;
+                    }
+                    // Unconsumed entries are only read during io_uring_enter, so the tail can step back.
+                    std::atomic_ref<uint32_t>(*sqTail_).store(tail, std::memory_order_release);
+                    return false;
+                }
+            }
+
+            // Waits for the next completion, returning its buffer index and result (bytes or -errno).
+            bool WaitCompletion(/*out*/ uint32_t& bufferIndex, /*out*/ int32_t& result) noexcept
+            {
+                const uint32_t head = *cqHead_; // Only this thread writes the head.
+                while (std::atomic_ref<uint32_t>(*cqTail_).load(std::memory_order_acquire) == head)
+                {
+                    const long enterResult = syscall(__NR_io_uring_enter, ringFd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                    if (enterResult < 0 && errno != EINTR)
+                    {
+                        return false;
+                    }
+                }
+
+                const io_uring_cqe& cqe = cqes_[head & cqMask_];
+                bufferIndex = uint32_t(cqe.user_data);
+                result = cqe.res;
+                std::atomic_ref<uint32_t>(*cqHead_).store(head + 1, std::memory_order_release);
+                return true;
+            }
+
+        private:
+            void* MapRing(size_t byteSize, off_t offset) noexcept
+            {
+                void* ring = mmap(nullptr, byteSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, offset);
+                return ring == MAP_FAILED ? nullptr : ring;
+            }
+
+            int ringFd_ = -1;
+            void* sqRing_ = nullptr;
+            void* cqRing_ = nullptr;
+            size_t sqRingSize_ = 0;
+            size_t cqRingSize_ = 0;
+            io_uring_sqe* sqes_ = nullptr;
+            uint32_t sqeCount_ = 0;
+            uint32_t* sqTail_ = nullptr;
+            uint32_t* sqArray_ = nullptr;
+            uint32_t sqMask_ = 0;
+            uint32_t* cqHead_ = nullptr;
+            uint32_t* cqTail_ = nullptr;
+            uint32_t cqMask_ = 0;
+            io_uring_cqe* cqes_ = nullptr;
+        };
+    #endif
+
+        // Ring of equally sized buffers, each with at most one read or write in flight. Requests
+        // are submitted and waited on in buffer order, which keeps file order for the callers.
+        class RequestQueue
+        {
+        public:
+            RequestQueue() = default;
+            RequestQueue(const RequestQueue&) = delete;
+            RequestQueue& operator=(const RequestQueue&) = delete;
+            ~RequestQueue() { Close(); }
+
+            bool Open(const char* filePath, bool forWriting, size_t bufferByteSize, uint32_t bufferCount, bool useDirectIo)
+            {
+                Close();
+                forWriting_ = forWriting;
+                useDirectIo_ = useDirectIo;
+                handle_ = OpenHandle(filePath, forWriting, useDirectIo);
+                if (handle_ == invalidHandle && useDirectIo)
+                {
+                    // Some file systems (like tmpfs) refuse direct I/O, so fall back to cached I/O.
+                    useDirectIo_ = false;
+                    handle_ = OpenHandle(filePath, forWriting, false);
+                }
+                if (handle_ == invalidHandle)
+                {
+                    return false;
+                }
+
+                bufferByteSize_ = (bufferByteSize + alignment - 1) & ~(alignment - 1);
+                requests_.resize(bufferCount);
+                for (auto& request : requests_)
+                {
+                    request.buffer = AllocateAlignedBuffer(bufferByteSize_);
+                }
+
+                backend_ = Backend::Positional;
+            #if defined(FILEIO_IO_URING)
+                std::vector<struct iovec> buffers(bufferCount);
+                for (uint32_t i = 0; i < bufferCount; ++i)
+                {
+                    buffers[i] = {requests_[i].buffer.get(), bufferByteSize_};
+                }
+                if (ioUring_.Open(bufferCount, buffers.data(), bufferCount))
+                {
+                    backend_ = Backend::IoUring;
+                }
+            #endif
+                return true;
+            }
+
+            // Waits for outstanding requests, then closes the file, optionally setting its final size
+            // (since direct writes round the last chunk up to the alignment).
+            bool Close(uint64_t finalFileSize = UINT64_MAX)
+            {
+                bool succeeded = true;
+                for (uint32_t i = 0; i < requests_.size(); ++i)
+                {
+                    succeeded &= (Wait(i) >= 0);
+                }
+                if (handle_ != invalidHandle)
+                {
+                    if (finalFileSize != UINT64_MAX)
+                    {
+                        succeeded &= SetFileSize(handle_, finalFileSize);
+                    }
+                    CloseHandle(handle_);
+                }
+            #if defined(FILEIO_IO_URING)
+                ioUring_.Close();
+            #endif
+                handle_ = invalidHandle;
+                backend_ = Backend::None;
+                requests_.clear();
+                return succeeded;
+            }
+
+            Handle GetHandle() const noexcept { return handle_; }
+            Backend GetBackend() const noexcept { return backend_; }
+            bool IsDirectIo() const noexcept { return useDirectIo_; }
+            size_t GetBufferByteSize() const noexcept { return bufferByteSize_; }
+            uint32_t GetBufferCount() const noexcept { return uint32_t(requests_.size()); }
+            uint8_t* GetBuffer(uint32_t bufferIndex) const noexcept { return requests_[bufferIndex].buffer.get(); }
+
+            // Starts reading into or writing from the buffer, which must not have a request in flight.
+            // Only requiredByteCount need be transferred, where byteCount was rounded up for direct I/O.
+            bool Submit(uint32_t bufferIndex, size_t byteCount, size_t requiredByteCount, uint64_t offset)
+            {
+                Request& request = requests_[bufferIndex];
+                request.byteCount = byteCount;
+                request.requiredByteCount = requiredByteCount;
+                request.offset = offset;
+                request.state = RequestState::Pending;
+
+            #if defined(FILEIO_IO_URING)
+                if (backend_ == Backend::IoUring)
+                {
+                    const struct iovec buffer = {request.buffer.get(), bufferByteSize_};
+                    request.isOnRing = ioUring_.Submit(handle_, forWriting_, buffer, bufferIndex, byteCount, offset);
+                    if (request.isOnRing)
+                    {
+                        return true;
+                    }
+                    // The ring refused the request even though setup succeeded, so transfer this one and all
+                    // later ones positionally, while any already on the ring still complete there.
+                    backend_ = Backend::Positional;
+                }
+            #endif
+
+                request.transfer = std::async(
+                    std::launch::async,
+                    [handle = handle_, forWriting = forWriting_, data = request.buffer.get(), byteCount, requiredByteCount, offset]()
+                    {
+                        return TransferAt(handle, forWriting, data, byteCount, requiredByteCount, offset);
+                    }
+                );
+                return true;
+            }
+
+            // Waits for the buffer's request, returning the bytes transferred, or -1 on error. A buffer
+            // with no request in flight (already waited, or never submitted) returns zero.
+            int64_t Wait(uint32_t bufferIndex)
+            {
+                Request& request = requests_[bufferIndex];
+                if (request.state == RequestState::Idle)
+                {
+                    return 0;
+                }
+
+            #if defined(FILEIO_IO_URING)
+                if (request.isOnRing)
+                {
+                    // Completions may arrive out of order, so record others until this one arrives.
+                    while (request.state == RequestState::Pending)
+                    {
+                        uint32_t completedIndex;
+                        int32_t result;
+                        if (!ioUring_.WaitCompletion(/*out*/ completedIndex, /*out*/ result) || completedIndex >= requests_.size())
+                        {
+                            return -1;
+                        }
+                        CompleteRequest(requests_[completedIndex], result);
+                    }
+                    request.state = RequestState::Idle;
+                    request.isOnRing = false;
+                    return std::min<int64_t>(request.result, request.requiredByteCount);
+                }
+            #endif
+
+                // Direct reads may transfer more than required (whole blocks), which callers never want.
+                request.state = RequestState::Idle;
+                return std::min<int64_t>(request.transfer.get(), request.requiredByteCount);
+            }
+
+        private:
+            enum class RequestState
+            {
+                Idle,
+                Pending,
+                Completed, // Waiting to be returned by Wait.
+            };
+
+            struct Request
+            {
+                AlignedBuffer buffer;
+                size_t byteCount = 0;
+                size_t requiredByteCount = 0;
+                uint64_t offset = 0;
+                int64_t result = 0; // Once completed.
+                RequestState state = RequestState::Idle;
+                bool isOnRing = false; // Else transferred positionally.
+                std::future<int64_t> transfer; // Positional transfers only.
+            };
+
+        #if defined(FILEIO_IO_URING)
+            void CompleteRequest(Request& request, int32_t result) noexcept
+            {
+                request.state = RequestState::Completed;
+                request.result = result;
+                if (result >= 0 && size_t(result) < request.requiredByteCount)
+                {
+                    // Short transfers are rare (interrupted or split by the kernel), so finish them synchronously.
+                    const int64_t remainder = TransferAt(
+                        handle_,
+                        forWriting_,
+                        request.buffer.get() + result,
+                        request.byteCount - size_t(result),
+                        request.requiredByteCount - size_t(result),
+                        request.offset + uint64_t(result)
+                    );
+                    request.result = (remainder < 0) ? -1 : result + remainder;
+                }
+                else if (result < 0)
+                {
+                    request.result = -1;
+                }
+            }
+
+            IoUring ioUring_;
+        #endif
+
+            Handle handle_ = invalidHandle;
+            Backend backend_ = Backend::None;
+            bool forWriting_ = false;
+            bool useDirectIo_ = false;
+            size_t bufferByteSize_ = 0;
+            std::vector<Request> requests_;
+        };
+    }
+
+    struct Options
+    {
+        size_t chunkByteSize = size_t(1) << 22; // Rounded up to the alignment.
+        uint32_t queueDepth = 4;                // Requests in flight.
+        bool useDirectIo = false;
+    };
+
+    // Reads a file front to back in chunks, keeping reads ahead of the caller in flight.
+    class Reader
+    {
+    public:
+        // Opens the file to read from the byte offset up to the byte count (or end of file). Direct reads
+        // must start at an aligned offset, so unaligned ones (like after a file header) are cached.
+        bool Open(const char* filePath, const Options& options = {}, uint64_t byteOffset = 0, uint64_t byteCount = UINT64_MAX)
+        {
+            const bool useDirectIo = options.useDirectIo && (byteOffset % alignment == 0);
+            if (!queue_.Open(filePath, /*forWriting*/ false, options.chunkByteSize, std::max(options.queueDepth, 2u), useDirectIo)
+            ||  !Details::GetFileSize(queue_.GetHandle(), /*out*/ fileSize_))
+            {
+                queue_.Close();
+                return false;
+            }
+
+            endOffset_ = (byteOffset > fileSize_ || byteCount > fileSize_ - byteOffset) ? fileSize_ : byteOffset + byteCount;
+            nextReadOffset_ = byteOffset;
+            nextChunkIndex_ = 0;
+            hasError_ = false;
+            for (uint32_t i = 0; i < queue_.GetBufferCount(); ++i)
+            {
+                SubmitNextRead(i);
+            }
+            return true;
+        }
+
+        // Returns the byte count of the next chunk in file order, and its data which stays valid until
+        // the following call, or zero at the end of the file (or upon error).
+        size_t ReadNext(/*out*/ const uint8_t*& data)
+        {
+            data = nullptr;
+            // The previous chunk's buffer is free again, so queue another read into it.
+            const uint32_t bufferCount = queue_.GetBufferCount();
+            if (nextChunkIndex_ > 0)
+            {
+                SubmitNextRead(uint32_t((nextChunkIndex_ - 1) % bufferCount));
+            }
+
+            const uint32_t bufferIndex = uint32_t(nextChunkIndex_ % bufferCount);
+            const int64_t byteCount = hasError_ ? -1 : queue_.Wait(bufferIndex);
+            if (byteCount <= 0)
+            {
+                hasError_ |= (byteCount < 0);
+                return 0;
+            }
+
+            ++nextChunkIndex_;
+            data = queue_.GetBuffer(bufferIndex);
+            return size_t(byteCount);
+        }
+
+        bool Close() { return queue_.Close() && !hasError_; }
+        bool HasError() const noexcept { return hasError_; }
+        uint64_t GetFileSize() const noexcept { return fileSize_; }
+        Backend GetBackend() const noexcept { return queue_.GetBackend(); }
+
+    private:
+        void SubmitNextRead(uint32_t bufferIndex)
+        {
+            if (nextReadOffset_ >= endOffset_ || hasError_)
+            {
+                return; // Leaves the buffer idle, reading as zero bytes at the end.
+            }
+
+            // Direct reads must be whole blocks, so ask for the full chunk even if the file ends sooner.
+            const size_t byteCount = size_t(std::min<uint64_t>(queue_.GetBufferByteSize(), endOffset_ - nextReadOffset_));
+            const size_t requestByteCount = queue_.IsDirectIo() ? queue_.GetBufferByteSize() : byteCount;
+            hasError_ |= !queue_.Submit(bufferIndex, requestByteCount, byteCount, nextReadOffset_);
+            nextReadOffset_ += byteCount;
+        }
+
+        Details::RequestQueue queue_;
+        uint64_t fileSize_ = 0;
+        uint64_t endOffset_ = 0;
+        uint64_t nextReadOffset_ = 0;
+        uint64_t nextChunkIndex_ = 0;
+        bool hasError_ = false;
+    };
+
+    // Writes a file front to back in chunks, returning to the caller while earlier chunks are still being written.
+    class Writer
+    {
+    public:
+        bool Open(const char* filePath, const Options& options = {})
+        {
+            nextWriteOffset_ = 0;
+            nextChunkIndex_ = 0;
+            hasError_ = false;
+            return queue_.Open(filePath, /*forWriting*/ true, options.chunkByteSize, std::max(options.queueDepth, 2u), options.useDirectIo);
+        }
+
+        // Returns the next free buffer to fill, of GetChunkByteSize() bytes, waiting on an earlier write if needed.
+        uint8_t* GetBuffer()
+        {
+            const uint32_t bufferIndex = uint32_t(nextChunkIndex_ % queue_.GetBufferCount());
+            hasError_ |= (queue_.Wait(bufferIndex) < 0);
+            return queue_.GetBuffer(bufferIndex);
+        }
+
+        // Writes the buffer last returned by GetBuffer. For direct I/O, every chunk but the last must be
+        // a multiple of the alignment (like a file header padded to it).
+        bool Write(size_t byteCount)
+        {
+            const uint32_t bufferIndex = uint32_t(nextChunkIndex_ % queue_.GetBufferCount());
+            const size_t requestByteCount = queue_.IsDirectIo() ? (byteCount + alignment - 1) & ~(alignment - 1) : byteCount;
+            hasError_ |= !queue_.Submit(bufferIndex, requestByteCount, requestByteCount, nextWriteOffset_);
+            nextWriteOffset_ += byteCount;
+            ++nextChunkIndex_;
+            return !hasError_;
+        }
+
+        // Waits for all writes, trimming any padding of a final direct write.
+        bool Close()
+        {
+            const bool isDirectIo = queue_.IsDirectIo();
+            return queue_.Close(isDirectIo ? nextWriteOffset_ : UINT64_MAX) && !hasError_;
+        }
+
+        size_t GetChunkByteSize() const noexcept { return queue_.GetBufferByteSize(); }
+        Backend GetBackend() const noexcept { return queue_.GetBackend(); }
+
+    private:
+        Details::RequestQueue queue_;
+        uint64_t nextWriteOffset_ = 0;
+        uint64_t nextChunkIndex_ = 0;
+        bool hasError_ = false;
+    };
+}
@@ -24,17 +24,17 @@ struct float16m7e8s1_t
     float16m7e8s1_t(const float16m7e8s1_t&) = default;
     float16m7e8s1_t(float16m7e8s1_t&&) = default;
 
+    // Rounds to nearest even rather than just keeping the top 16 bits of the float32.
     float16m7e8s1_t(float floatValue) noexcept
     {
-        value = reinterpret_cast<uint32_t&>(floatValue) >> 16;
+        value = FloatNumberDefinitions::ConvertRawFloatType<FloatNumberDefinitions::Float32, FloatNumberDefinitions::Float16f7e8s1>(reinterpret_cast<uint32_t&>(floatValue));
     }
 
     float16m7e8s1_t& operator =(const float16m7e8s1_t&) = default;
 
     float16m7e8s1_t& operator =(float floatValue) noexcept
     {
-        value = reinterpret_cast<uint32_t&>(floatValue) >> 16;
-        return *this;
+        return *this = float16m7e8s1_t(floatValue);
     }
 
     operator float() const noexcept
@@ -0,0 +1,471 @@
+//-----------------------------------------------------------------------------
+//
+//  GGUF model file (llama.cpp) header parsing and block dequantization.
+//
+//  A GGUF file is a magic string, version, tensor and metadata counts, typed
+//  metadata key/value pairs, and a table of tensor names, dimensions, ggml
+//  types, and offsets, followed by the aligned tensor data region.
+//  https://github.com/ggerganov/ggml/blob/master/docs/gguf.md
+//
+//  Block quantized types hold a float16 scale (and sometimes a minimum) per
+//  block of packed small integers. Blocks are dequantized to float32 one at
+//  a time, so callers stream a tensor without ever expanding all of it. The
+//  integer to float scaling runs 16 quants at a time with SSE2 or NEON.
+//
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Half.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define GGUF_SSE2 1
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#include <arm_neon.h>
+#define GGUF_NEON 1
+#endif
+
+namespace Gguf
+{
+    constexpr std::string_view magic = "GGUF";
+
+    // ggml tensor types, only naming those with a fixed block layout.
+    enum class TensorType : uint32_t
+    {
+        F32 = 0,
+        F16 = 1,
+        Q4_0 = 2,
+        Q4_1 = 3,
+        Q5_0 = 6,
+        Q5_1 = 7,
+        Q8_0 = 8,
+        Q8_1 = 9,
+        Q2_K = 10,
+        Q3_K = 11,
+        Q4_K = 12,
+        Q5_K = 13,
+        Q6_K = 14,
+        Q8_K = 15,
+        I8 = 24,
+        I16 = 25,
+        I32 = 26,
+        I64 = 27,
+        F64 = 28,
+        BF16 = 30,
+    };
+
+    struct TypeInfo
+    {
+        std::string_view name;          // Empty for unknown types
+        uint32_t blockElementCount;     // 1 for plain types
+        uint32_t blockByteSize;
+    };
+
+    constexpr TypeInfo g_typeInfos[] =
+    {
+        {"F32",  1,   4},   // 0
+        {"F16",  1,   2},   // 1
+        {"Q4_0", 32,  18},  // 2  - f16 scale, 16 bytes of 4-bit quants
+        {"Q4_1", 32,  20},  // 3
+        {},                 // 4  - removed Q4_2
+        {},                 // 5  - removed Q4_3
+        {"Q5_0", 32,  22},  // 6
+        {"Q5_1", 32,  24},  // 7
+        {"Q8_0", 32,  34},  // 8  - f16 scale, 32 bytes of 8-bit quants
+        {"Q8_1", 32,  36},  // 9
+        {"Q2_K", 256, 84},  // 10
+        {"Q3_K", 256, 110}, // 11
+        {"Q4_K", 256, 144}, // 12 - f16 scale and minimum, 12 bytes of 6-bit sub-block scales, 128 bytes of 4-bit quants
+        {"Q5_K", 256, 176}, // 13
+        {"Q6_K", 256, 210}, // 14
+        {"Q8_K", 256, 292}, // 15
+        {}, {}, {}, {}, {}, {}, {}, {}, // 16-23 - importance matrix types
+        {"I8",   1,   1},   // 24
+        {"I16",  1,   2},   // 25
+        {"I32",  1,   4},   // 26
+        {"I64",  1,   8},   // 27
+        {"F64",  1,   8},   // 28
+        {},                 // 29
+        {"BF16", 1,   2},   // 30
+    };
+
+    constexpr uint32_t maximumBlockElementCount = 256;
+
+    // Returns the block layout of a ggml type, with an empty name and zero sizes for unknown types.
+    inline TypeInfo GetTypeInfo(uint32_t type) noexcept
+    {
+        return (type < std::size(g_typeInfos)) ? g_typeInfos[type] : TypeInfo{};
+    }
+
+    struct TensorInfo
+    {
+        std::string name;
+        std::vector<uint64_t> shape;    // Outermost dimension first, like numpy (reversed from ggml's ne order)
+        uint32_t type = 0;              // ggml type, possibly unknown
+        uint64_t dataBegin = 0;         // Byte offset relative to the data region
+
+        uint64_t GetElementCount() const noexcept
+        {
+            uint64_t elementCount = 1;
+            for (uint64_t dimension : shape)
+            {
+                elementCount *= dimension;
+            }
+            return elementCount;
+        }
+
+        // Byte size of the tensor's blocks, or zero for unknown types.
+        uint64_t GetByteCount() const noexcept
+        {
+            const TypeInfo typeInfo = GetTypeInfo(type);
+            return (typeInfo.blockElementCount == 0) ? 0 : GetElementCount() / typeInfo.blockElementCount * typeInfo.blockByteSize;
+        }
+    };
+
+    struct Header
+    {
+        uint32_t version = 0;
+        std::vector<TensorInfo> tensors; // In file order
+        uint32_t alignment = 32;         // From "general.alignment", if present
+        size_t dataOffset = 0;           // Byte offset of the data region in the file
+    };
+
+    inline bool IsGguf(const uint8_t* data, size_t size) noexcept
+    {
+        return size >= magic.size() && memcmp(data, magic.data(), magic.size()) == 0;
+    }
+
+    namespace Details
+    {
+        enum class ValueType : uint32_t
+        {
+            Uint8, Int8, Uint16, Int16, Uint32, Int32, Float32, Bool, String, Array, Uint64, Int64, Float64,
+            Total,
+        };
+
+        constexpr uint8_t g_valueByteSizes[] = {1, 1, 2, 2, 4, 4, 4, 1, 0, 0, 8, 8, 8};
+        static_assert(std::size(g_valueByteSizes) == size_t(ValueType::Total));
+
+        // Bounds checked little endian reader, which stays failed after any read past the end.
+        struct Reader
+        {
+            const uint8_t* data;
+            size_t size;
+            size_t i = 0;
+            bool failed = false;
+
+            template <typename T>
+            T Read() noexcept
+            {
+                T value = {};
+                if (failed || size - i < sizeof(T))
+                {
+                    failed = true;
+                    return value;
+                }
+                memcpy(&value, data + i, sizeof(T));
+                i += sizeof(T);
+                return value;
+            }
+
+            bool Skip(uint64_t byteCount) noexcept
+            {
+                if (failed || byteCount > size - i)
+                {
+                    failed = true;
+                    return false;
+                }
+                i += size_t(byteCount);
+                return true;
+            }
+
+            std::string_view ReadString() noexcept
+            {
+                const uint64_t length = Read<uint64_t>();
+                const size_t stringBegin = i;
+                if (!Skip(length))
+                {
+                    return {};
+                }
+                return {reinterpret_cast<const char*>(data + stringBegin), size_t(length)};
+            }
+
+            // Skips a metadata value, including arrays (of arrays) of strings.
+            bool SkipValue(ValueType valueType, uint32_t depth = 0) noexcept
+            {
+                if (valueType == ValueType::String)
+                {
+                    ReadString();
+                }
+                else if (valueType == ValueType::Array)
+                {
+                    const ValueType elementType = ValueType(Read<uint32_t>());
+                    const uint64_t elementCount = Read<uint64_t>();
+                    if (elementType >= ValueType::Total || depth > 4)
+                    {
+                        failed = true;
+                    }
+                    else if (elementType == ValueType::String || elementType == ValueType::Array)
+                    {
+                        for (uint64_t j = 0; j < elementCount && !failed; ++j)
+                        {
+                            SkipValue(elementType, depth + 1);
+                        }
+                    }
+                    else
+                    {
+                        const uint64_t elementByteSize = g_valueByteSizes[uint32_t(elementType)];
+                        Skip(elementCount > UINT64_MAX / elementByteSize ? UINT64_MAX : elementCount * elementByteSize);
+                    }
+                }
+                else if (valueType < ValueType::Total)
+                {
+                    Skip(g_valueByteSizes[uint32_t(valueType)]);
+                }
+                else
+                {
+                    failed = true;
+                }
+                return !failed;
+            }
+        };
+    }
+
+    // Parses the header of a GGUF file (versions 2 and 3), returning false if it is malformed or
+    // any tensor of a known type extends beyond the end of the file.
+    inline bool ParseHeader(const uint8_t* data, size_t size, /*out*/ Header& header)
+    {
+        header = {};
+        if (!IsGguf(data, size))
+        {
+            return false;
+        }
+        Details::Reader reader = {data, size, magic.size()};
+        header.version = reader.Read<uint32_t>();
+        const uint64_t tensorCount = reader.Read<uint64_t>();
+        const uint64_t metadataCount = reader.Read<uint64_t>();
+        if (header.version < 2 || header.version > 3 || tensorCount > size || metadataCount > size)
+        {
+            return false; // Version 1 used 32-bit counts and lengths, and is long obsolete.
+        }
+
+        for (uint64_t j = 0; j < metadataCount && !reader.failed; ++j)
+        {
+            const std::string_view key = reader.ReadString();
+            const auto valueType = Details::ValueType(reader.Read<uint32_t>());
+            if (key == "general.alignment" && valueType == Details::ValueType::Uint32)
+            {
+                header.alignment = reader.Read<uint32_t>();
+            }
+            else
+            {
+                reader.SkipValue(valueType);
+            }
+        }
+        if (header.alignment == 0 || (header.alignment & (header.alignment - 1)) != 0)
+        {
+            return false;
+        }
+
+        header.tensors.reserve(size_t(tensorCount));
+        for (uint64_t j = 0; j < tensorCount && !reader.failed; ++j)
+        {
+            TensorInfo& tensor = header.tensors.emplace_back();
+            tensor.name = reader.ReadString();
+            const uint32_t dimensionCount = reader.Read<uint32_t>();
+            if (dimensionCount > 8)
+            {
+                return false;
+            }
+            tensor.shape.resize(dimensionCount);
+            for (uint32_t k = 0; k < dimensionCount; ++k)
+            {
+                tensor.shape[dimensionCount - 1 - k] = reader.Read<uint64_t>();
+            }
+            tensor.type = reader.Read<uint32_t>();
+            tensor.dataBegin = reader.Read<uint64_t>();
+        }
+        if (reader.failed)
+        {
+            return false;
+        }
+
+        header.dataOffset = (reader.i + header.alignment - 1) / header.alignment * header.alignment;
+        if (header.dataOffset > size)
+        {
+            header.dataOffset = size; // Padding may be omitted after the last tensor info of a file without data.
+            return header.tensors.empty();
+        }
+        for (auto& tensor : header.tensors)
+        {
+            const uint64_t byteCount = tensor.GetByteCount();
+            if (tensor.dataBegin > size - header.dataOffset || byteCount > size - header.dataOffset - tensor.dataBegin)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    namespace Details
+    {
+        inline float ReadFloat16(const uint8_t* data) noexcept
+        {
+            half_float::half value;
+            memcpy(&value, data, sizeof(value));
+            return float(value);
+        }
+
+        // Splits 16 bytes of packed 4-bit quants into low nibbles and high nibbles, less the offset.
+        inline void UnpackNibbles16(const uint8_t* packed, int8_t offset, /*out*/ int8_t* low, /*out*/ int8_t* high) noexcept
+        {
+        #if defined(GGUF_SSE2)
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(packed));
+            const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+            const __m128i offsets = _mm_set1_epi8(offset);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(low), _mm_sub_epi8(_mm_and_si128(bytes, nibbleMask), offsets));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(high), _mm_sub_epi8(_mm_and_si128(_mm_srli_epi16(bytes, 4), nibbleMask), offsets));
+        #elif defined(GGUF_NEON)
+            const uint8x16_t bytes = vld1q_u8(packed);
+            const int8x16_t offsets = vdupq_n_s8(offset);
+            vst1q_s8(low, vsubq_s8(vreinterpretq_s8_u8(vandq_u8(bytes, vdupq_n_u8(0x0F))), offsets));
+            vst1q_s8(high, vsubq_s8(vreinterpretq_s8_u8(vshrq_n_u8(bytes, 4)), offsets));
+        #else
+            for (size_t i = 0; i < 16; ++i)
+            {
+                low[i] = int8_t((packed[i] & 0x0F) - offset);
+                high[i] = int8_t((packed[i] >> 4) - offset);
+            }
+        #endif
+        }
+
+        // output[i] = quants[i] * scale - minimum, for 32 signed 8-bit quants.
+        inline void ScaleQuants32(const int8_t* quants, float scale, float minimum, /*out*/ float* output) noexcept
+        {
+        #if defined(GGUF_SSE2)
+            // SSE2 lacks sign extension, so bytes are unpacked with themselves and arithmetic shifted down.
+            const __m128 scales = _mm_set1_ps(scale);
+            const __m128 minimums = _mm_set1_ps(minimum);
+            for (size_t i = 0; i < 32; i += 16)
+            {
+                const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(quants + i));
+                const __m128i words[2] = {_mm_srai_epi16(_mm_unpacklo_epi8(bytes, bytes), 8), _mm_srai_epi16(_mm_unpackhi_epi8(bytes, bytes), 8)};
+                for (size_t j = 0; j < 2; ++j)
+                {
+                    const __m128i lanes[2] = {_mm_srai_epi32(_mm_unpacklo_epi16(words[j], words[j]), 16), _mm_srai_epi32(_mm_unpackhi_epi16(words[j], words[j]), 16)};
+                    for (size_t k = 0; k < 2; ++k)
+                    {
+                        _mm_storeu_ps(output + i + j * 8 + k * 4, _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(lanes[k]), scales), minimums));
+                    }
+                }
+            }
+        #elif defined(GGUF_NEON)
+            const float32x4_t minimums = vdupq_n_f32(minimum);
+            for (size_t i = 0; i < 32; i += 16)
+            {
+                const int8x16_t bytes = vld1q_s8(quants + i);
+                const int16x8_t words[2] = {vmovl_s8(vget_low_s8(bytes)), vmovl_s8(vget_high_s8(bytes))};
+                for (size_t j = 0; j < 2; ++j)
+                {
+                    const int32x4_t lanes[2] = {vmovl_s16(vget_low_s16(words[j])), vmovl_s16(vget_high_s16(words[j]))};
+                    for (size_t k = 0; k < 2; ++k)
+                    {
+                        vst1q_f32(output + i + j * 8 + k * 4, vsubq_f32(vmulq_n_f32(vcvtq_f32_s32(lanes[k]), scale), minimums));
+                    }
+                }
+            }
+        #else
+            for (size_t i = 0; i < 32; ++i)
+            {
+                output[i] = float(quants[i]) * scale - minimum;
+            }
+        #endif
+        }
+
+        // 32 elements: x = (q - 8) * d
+        inline void DequantizeBlockQ4_0(const uint8_t* block, /*out*/ float* output) noexcept
+        {
+            int8_t quants[32];
+            UnpackNibbles16(block + 2, 8, /*out*/ quants, /*out*/ quants + 16);
+            ScaleQuants32(quants, ReadFloat16(block), 0.0f, /*out*/ output);
+        }
+
+        // 32 elements: x = q * d
+        inline void DequantizeBlockQ8_0(const uint8_t* block, /*out*/ float* output) noexcept
+        {
+            ScaleQuants32(reinterpret_cast<const int8_t*>(block + 2), ReadFloat16(block), 0.0f, /*out*/ output);
+        }
+
+        // Reads the 6-bit scale and minimum of a Q4_K sub-block, packed into 12 bytes as the low 6 bits
+        // of the first eight bytes and then nibbles of the last four (with their upper 2 bits from the first eight).
+        inline void ReadScaleAndMinimumQ4_K(const uint8_t* scales, uint32_t subblock, /*out*/ uint32_t& scale, /*out*/ uint32_t& minimum) noexcept
+        {
+            if (subblock < 4)
+            {
+                scale = scales[subblock] & 63;
+                minimum = scales[subblock + 4] & 63;
+            }
+            else
+            {
+                scale = (scales[subblock + 4] & 0x0F) | ((scales[subblock - 4] >> 6) << 4);
+                minimum = (scales[subblock + 4] >> 4) | ((scales[subblock] >> 6) << 4);
+            }
+        }
+
+        // 256 elements in 8 sub-blocks of 32: x = q * (d * scale) - (dmin * minimum)
+        inline void DequantizeBlockQ4_K(const uint8_t* block, /*out*/ float* output) noexcept
+        {
+            const float d = ReadFloat16(block);
+            const float dmin = ReadFloat16(block + 2);
+            const uint8_t* scales = block + 4;
+            const uint8_t* packed = block + 16;
+
+            // Each 32 bytes hold a pair of sub-blocks, the even one in the low nibbles and the odd one in the high.
+            for (uint32_t pair = 0; pair < 4; ++pair)
+            {
+                int8_t quants[64];
+                UnpackNibbles16(packed + pair * 32, 0, /*out*/ quants, /*out*/ quants + 32);
+                UnpackNibbles16(packed + pair * 32 + 16, 0, /*out*/ quants + 16, /*out*/ quants + 48);
+                for (uint32_t k = 0; k < 2; ++k)
+                {
+                    uint32_t scale, minimum;
+                    ReadScaleAndMinimumQ4_K(scales, pair * 2 + k, /*out*/ scale, /*out*/ minimum);
+                    ScaleQuants32(quants + k * 32, d * float(scale), dmin * float(minimum), /*out*/ output + (pair * 2 + k) * 32);
+                }
+            }
+        }
+    }
+
+    // Whether blocks of the type can be dequantized to float32 by DequantizeBlocks.
+    inline bool IsDequantizable(uint32_t type) noexcept
+    {
+        return type == uint32_t(TensorType::Q4_0) || type == uint32_t(TensorType::Q8_0) || type == uint32_t(TensorType::Q4_K);
+    }
+
+    // Dequantizes whole blocks to float32 (blockCount * blockElementCount values), returning false for
+    // unsupported types.
+    inline bool DequantizeBlocks(uint32_t type, const uint8_t* blocks, size_t blockCount, /*out*/ float* output) noexcept
+    {
+        const TypeInfo typeInfo = GetTypeInfo(type);
+        void (*dequantizeBlock)(const uint8_t*, float*) noexcept = nullptr;
+        switch (TensorType(type))
+        {
+        case TensorType::Q4_0: dequantizeBlock = &Details::DequantizeBlockQ4_0; break;
+        case TensorType::Q8_0: dequantizeBlock = &Details::DequantizeBlockQ8_0; break;
+        case TensorType::Q4_K: dequantizeBlock = &Details::DequantizeBlockQ4_K; break;
+        default: return false;
+        }
+        for (size_t i = 0; i < blockCount; ++i)
+        {
+            dequantizeBlock(blocks + i * typeInfo.blockByteSize, /*out*/ output + i * typeInfo.blockElementCount);
+        }
+        return true;
+    }
+}
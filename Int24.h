@@ -1,67 +1,239 @@
-#pragma once
-
-
-struct uint24_t
-{
-    // Explicit getter returning native type. Converts from file representation,
-    // which is little-endian.
-    uint32_t Get() const throw()
-    {
-        return 
-            (static_cast<uint32_t>(value[2]) << 16) | 
-            (static_cast<uint32_t>(value[1]) << 8) | 
-            value[0];
-    }
-
-    // Implicit conversion to native type.
-    operator uint32_t() const throw()
-    {
-        return Get();
-    }
-
-    void Set(uint32_t v) throw()
-    {
-        value[0] = uint8_t(v);
-        value[1] = uint8_t(v >> 8);
-        value[2] = uint8_t(v >> 16);
-    }
-
-    uint24_t& operator =(uint32_t v) throw()
-    {
-        Set(v);
-        return *this;
-    }
-
-    uint8_t value[3];
-};
-
-struct int24_t
-{
-    // Explicit getter returning native type. Converts from file representation,
-    // which is little-endian.
-    int32_t Get() const throw()
-    {
-        return value.Get();
-    }
-
-    // Implicit conversion to native type.
-    operator int32_t() const throw()
-    {
-        // Get the 32-bit value from 24-bits, then extend sign.
-        uint32_t integerValue = value.Get();
-        return int32_t(integerValue << 8) >> 8;
-    }
-
-    void Set(int32_t v) throw()
-    {
-        value.Set(v);
-    }
-
-    int24_t& operator =(int32_t v) throw()
-    {
-        value.Set(v);
-        return *this;
-    }
-
-    uint24_t value;
-};
+#pragma once
+
+#include "CpuFeatures.h"
+
+#if defined(CPUFEATURES_X86)
+#include <tmmintrin.h>
+#define INT24_SSSE3 1
+#elif defined(_M_ARM64) || defined(__aarch64__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define INT24_NEON 1
+#endif
+
+struct uint24_t
+{
+    // Explicit getter returning native type. Converts from file representation,
+    // which is little-endian.
+    uint32_t Get() const throw()
+    {
+        return 
+            (static_cast<uint32_t>(value[2]) << 16) | 
+            (static_cast<uint32_t>(value[1]) << 8) | 
+            value[0];
+    }
+
+    // Implicit conversion to native type.
+    operator uint32_t() const throw()
+    {
+        return Get();
+    }
+
+    void Set(uint32_t v) throw()
+    {
+        value[0] = uint8_t(v);
+        value[1] = uint8_t(v >> 8);
+        value[2] = uint8_t(v >> 16);
+    }
+
+    uint24_t& operator =(uint32_t v) throw()
+    {
+        Set(v);
+        return *this;
+    }
+
+    uint8_t value[3];
+};
+
+struct int24_t
+{
+    // Explicit getter returning native type. Converts from file representation,
+    // which is little-endian.
+    int32_t Get() const throw()
+    {
+        return value.Get();
+    }
+
+    // Implicit conversion to native type.
+    operator int32_t() const throw()
+    {
+        // Get the 32-bit value from 24-bits, then extend sign.
+        uint32_t integerValue = value.Get();
+        return int32_t(integerValue << 8) >> 8;
+    }
+
+    void Set(int32_t v) throw()
+    {
+        value.Set(v);
+    }
+
+    int24_t& operator =(int32_t v) throw()
+    {
+        value.Set(v);
+        return *this;
+    }
+
+    uint24_t value;
+};
+
+// Bulk conversions between packed little-endian 24-bit samples (like 24-bit PCM audio) and
+// 32-bit integers, 16 samples at a time. SSSE3 shuffles each group of 4 samples into the upper
+// 3 bytes of 32-bit lanes and arithmetic shifts them down to sign extend, and NEON deinterleaves
+// the 3 bytes of each sample with vld3. Packing truncates each value to its low 24 bits. The SSSE3
+// kernels are chosen at runtime, returning how many samples they converted (a multiple of 16).
+
+#if defined(INT24_SSSE3)
+CPUFEATURES_TARGET("ssse3") inline size_t UnpackInt24ToInt32Ssse3(const uint8_t* input, int32_t* output, size_t count) noexcept
+{
+    size_t i = 0;
+    const __m128i lowShuffle = _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+    const __m128i highShuffle = _mm_setr_epi8(-1, 4, 5, 6, -1, 7, 8, 9, -1, 10, 11, 12, -1, 13, 14, 15);
+    for (/*above*/; i + 16 <= count; i += 16)
+    {
+        // The last load starts 4 bytes early so as not to read past the 48 bytes.
+        const uint8_t* p = input + i * 3;
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 12));
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 24));
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 32));
+        __m128i* o = reinterpret_cast<__m128i*>(output + i);
+        _mm_storeu_si128(o + 0, _mm_srai_epi32(_mm_shuffle_epi8(a, lowShuffle), 8));
+        _mm_storeu_si128(o + 1, _mm_srai_epi32(_mm_shuffle_epi8(b, lowShuffle), 8));
+        _mm_storeu_si128(o + 2, _mm_srai_epi32(_mm_shuffle_epi8(c, lowShuffle), 8));
+        _mm_storeu_si128(o + 3, _mm_srai_epi32(_mm_shuffle_epi8(d, highShuffle), 8));
+    }
+    return i;
+}
+
+CPUFEATURES_TARGET("ssse3") inline size_t UnpackInt24ToFloat32Ssse3(const uint8_t* input, float* output, size_t count, float scale) noexcept
+{
+    size_t i = 0;
+    const __m128i lowShuffle = _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+    const __m128i highShuffle = _mm_setr_epi8(-1, 4, 5, 6, -1, 7, 8, 9, -1, 10, 11, 12, -1, 13, 14, 15);
+    const __m128 scales = _mm_set1_ps(scale);
+    for (/*above*/; i + 16 <= count; i += 16)
+    {
+        const uint8_t* p = input + i * 3;
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 12));
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 24));
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 32));
+        _mm_storeu_ps(output + i + 0, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_shuffle_epi8(a, lowShuffle), 8)), scales));
+        _mm_storeu_ps(output + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_shuffle_epi8(b, lowShuffle), 8)), scales));
+        _mm_storeu_ps(output + i + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_shuffle_epi8(c, lowShuffle), 8)), scales));
+        _mm_storeu_ps(output + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_shuffle_epi8(d, highShuffle), 8)), scales));
+    }
+    return i;
+}
+
+CPUFEATURES_TARGET("ssse3") inline size_t PackInt32ToInt24Ssse3(const int32_t* input, uint8_t* output, size_t count) noexcept
+{
+    size_t i = 0;
+    // Drop the top byte of each lane, leaving 12 bytes at the bottom of each vector, and then
+    // splice the four 12 byte pieces into three full vectors.
+    const __m128i packShuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    for (/*above*/; i + 16 <= count; i += 16)
+    {
+        const __m128i* in = reinterpret_cast<const __m128i*>(input + i);
+        const __m128i a = _mm_shuffle_epi8(_mm_loadu_si128(in + 0), packShuffle);
+        const __m128i b = _mm_shuffle_epi8(_mm_loadu_si128(in + 1), packShuffle);
+        const __m128i c = _mm_shuffle_epi8(_mm_loadu_si128(in + 2), packShuffle);
+        const __m128i d = _mm_shuffle_epi8(_mm_loadu_si128(in + 3), packShuffle);
+        __m128i* o = reinterpret_cast<__m128i*>(output + i * 3);
+        _mm_storeu_si128(o + 0, _mm_or_si128(a, _mm_slli_si128(b, 12)));
+        _mm_storeu_si128(o + 1, _mm_or_si128(_mm_srli_si128(b, 4), _mm_slli_si128(c, 8)));
+        _mm_storeu_si128(o + 2, _mm_or_si128(_mm_srli_si128(c, 8), _mm_slli_si128(d, 4)));
+    }
+    return i;
+}
+#endif
+
+inline void UnpackInt24ToInt32(const uint8_t* input, int32_t* output, size_t count) noexcept
+{
+    size_t i = 0;
+#if defined(INT24_SSSE3)
+    if (CpuFeatures::UseSsse3())
+    {
+        i = UnpackInt24ToInt32Ssse3(input, output, count);
+    }
+#elif defined(INT24_NEON)
+    for (/*above*/; i + 16 <= count; i += 16)
+    {
+        const uint8x16x3_t bytes = vld3q_u8(input + i * 3);
+        const uint8x16x2_t lowPairs = vzipq_u8(bytes.val[0], bytes.val[1]);
+        const int8x16_t high = vreinterpretq_s8_u8(bytes.val[2]);
+        const uint16x8_t lows[2] = {vreinterpretq_u16_u8(lowPairs.val[0]), vreinterpretq_u16_u8(lowPairs.val[1])};
+        const int16x8_t highs[2] = {vmovl_s8(vget_low_s8(high)), vmovl_s8(vget_high_s8(high))};
+        for (uint32_t j = 0; j < 2; ++j)
+        {
+            const int32x4_t first = vorrq_s32(vshll_n_s16(vget_low_s16(highs[j]), 16), vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(lows[j]))));
+            const int32x4_t second = vorrq_s32(vshll_n_s16(vget_high_s16(highs[j]), 16), vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(lows[j]))));
+            vst1q_s32(output + i + j * 8, first);
+            vst1q_s32(output + i + j * 8 + 4, second);
+        }
+    }
+#endif
+    for (/*above*/; i < count; ++i)
+    {
+        output[i] = *reinterpret_cast<const int24_t*>(input + i * 3);
+    }
+}
+
+// Converts 24-bit samples to float, multiplied by the scale (like 2^-23 to normalize audio into [-1,1)).
+inline void UnpackInt24ToFloat32(const uint8_t* input, float* output, size_t count, float scale) noexcept
+{
+    size_t i = 0;
+#if defined(INT24_SSSE3)
+    if (CpuFeatures::UseSsse3())
+    {
+        i = UnpackInt24ToFloat32Ssse3(input, output, count, scale);
+    }
+#elif defined(INT24_NEON)
+    const float32x4_t scales = vdupq_n_f32(scale);
+    int32_t integers[16];
+    for (/*above*/; i + 16 <= count; i += 16)
+    {
+        UnpackInt24ToInt32(input + i * 3, integers, 16);
+        for (uint32_t j = 0; j < 16; j += 4)
+        {
+            vst1q_f32(output + i + j, vmulq_f32(vcvtq_f32_s32(vld1q_s32(integers + j)), scales));
+        }
+    }
+#endif
+    for (/*above*/; i < count; ++i)
+    {
+        output[i] = float(int32_t(*reinterpret_cast<const int24_t*>(input + i * 3))) * scale;
+    }
+}
+
+inline void PackInt32ToInt24(const int32_t* input, uint8_t* output, size_t count) noexcept
+{
+    size_t i = 0;
+#if defined(INT24_SSSE3)
+    if (CpuFeatures::UseSsse3())
+    {
+        i = PackInt32ToInt24Ssse3(input, output, count);
+    }
+#elif defined(INT24_NEON)
+    for (/*above*/; i + 16 <= count; i += 16)
+    {
+        const uint32_t* in = reinterpret_cast<const uint32_t*>(input + i);
+        uint8x16x3_t bytes;
+        for (uint32_t shift = 0; shift < 3; ++shift)
+        {
+            uint16x8_t halves[2];
+            for (uint32_t j = 0; j < 2; ++j)
+            {
+                const uint32x4_t first = vshlq_u32(vld1q_u32(in + j * 8), vdupq_n_s32(-int32_t(shift * 8)));
+                const uint32x4_t second = vshlq_u32(vld1q_u32(in + j * 8 + 4), vdupq_n_s32(-int32_t(shift * 8)));
+                halves[j] = vcombine_u16(vmovn_u32(first), vmovn_u32(second));
+            }
+            bytes.val[shift] = vcombine_u8(vmovn_u16(halves[0]), vmovn_u16(halves[1]));
+        }
+        vst3q_u8(output + i * 3, bytes);
+    }
+#endif
+    for (/*above*/; i < count; ++i)
+    {
+        reinterpret_cast<int24_t*>(output + i * 3)->Set(input[i]);
+    }
+}
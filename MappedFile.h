@@ -0,0 +1,213 @@
+//-----------------------------------------------------------------------------
+//
+//  Read-only file view, memory mapped so that large inputs (command files,
+//  binary number files) can be read in place without copying them first.
+//
+//  Sources which cannot be mapped, like pipes to stdin, are read into an
+//  owned buffer instead, so callers see the same contiguous view either way.
+//
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+#if _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { Close(); }
+
+    bool Open(const char* filePath)
+    {
+        Close();
+    #if _WIN32
+        HANDLE file = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        bool succeeded = MapHandle(file);
+        CloseHandle(file);
+        return succeeded;
+    #else
+        int file = open(filePath, O_RDONLY);
+        if (file < 0)
+        {
+            return false;
+        }
+        bool succeeded = MapHandle(file);
+        close(file);
+        return succeeded;
+    #endif
+    }
+
+    // Maps stdin when redirected from a file, else reads it until the end.
+    bool OpenStandardInput()
+    {
+        Close();
+    #if _WIN32
+        HANDLE file = GetStdHandle(STD_INPUT_HANDLE);
+        if (GetFileType(file) == FILE_TYPE_DISK)
+        {
+            return MapHandle(file);
+        }
+    #else
+        struct stat fileStatus;
+        if (fstat(STDIN_FILENO, &fileStatus) == 0 && S_ISREG(fileStatus.st_mode))
+        {
+            return MapHandle(STDIN_FILENO);
+        }
+    #endif
+        return ReadToBuffer(stdin);
+    }
+
+    void Close()
+    {
+        if (mappedData_ != nullptr)
+        {
+        #if _WIN32
+            UnmapViewOfFile(mappedData_);
+        #else
+            munmap(mappedData_, size_);
+        #endif
+        }
+        mappedData_ = nullptr;
+        data_ = nullptr;
+        size_ = 0;
+        buffer_.clear();
+    }
+
+    // Hints that the view will be read front to back, so the OS reads ahead more aggressively
+    // and may drop pages already passed. Windows has no equivalent for mapped views.
+    void AdviseSequential() noexcept
+    {
+    #if !_WIN32
+        if (mappedData_ != nullptr)
+        {
+            madvise(mappedData_, size_, MADV_SEQUENTIAL);
+        }
+    #endif
+    }
+
+    const uint8_t* data() const noexcept { return data_; }
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    std::string_view GetStringView() const noexcept { return {reinterpret_cast<const char*>(data_), size_}; }
+
+private:
+#if _WIN32
+    bool MapHandle(HANDLE file)
+    {
+        LARGE_INTEGER fileSize = {};
+        if (!GetFileSizeEx(file, &fileSize))
+        {
+            return false;
+        }
+        if (fileSize.QuadPart == 0)
+        {
+            return true; // Empty files cannot be mapped, but are valid.
+        }
+        if (uint64_t(fileSize.QuadPart) > SIZE_MAX)
+        {
+            return false;
+        }
+
+        HANDLE fileMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (fileMapping == nullptr)
+        {
+            return false;
+        }
+        mappedData_ = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(fileMapping); // The view keeps the mapping alive.
+        if (mappedData_ == nullptr)
+        {
+            return false;
+        }
+
+        data_ = static_cast<const uint8_t*>(mappedData_);
+        size_ = size_t(fileSize.QuadPart);
+        return true;
+    }
+#else
+    bool MapHandle(int file)
+    {
+        struct stat fileStatus;
+        if (fstat(file, &fileStatus) != 0)
+        {
+            return false;
+        }
+        if (fileStatus.st_size == 0)
+        {
+            return true; // Empty files cannot be mapped, but are valid.
+        }
+        if (uint64_t(fileStatus.st_size) > SIZE_MAX)
+        {
+            return false;
+        }
+
+        void* mappedData = mmap(nullptr, size_t(fileStatus.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        if (mappedData == MAP_FAILED)
+        {
+            return false;
+        }
+
+        mappedData_ = mappedData;
+        data_ = static_cast<const uint8_t*>(mappedData);
+        size_ = size_t(fileStatus.st_size);
+        return true;
+    }
+#endif
+
+    bool ReadToBuffer(FILE* file)
+    {
+        constexpr size_t readSize = 1 << 16;
+        size_t totalSize = 0;
+        while (true)
+        {
+            buffer_.resize(totalSize + readSize);
+            size_t bytesRead = std::fread(buffer_.data() + totalSize, 1, readSize, file);
+            totalSize += bytesRead;
+            if (bytesRead < readSize)
+            {
+                break;
+            }
+        }
+        buffer_.resize(totalSize);
+
+        if (std::ferror(file))
+        {
+            buffer_.clear();
+            return false;
+        }
+
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+        return true;
+    }
+
+    void* mappedData_ = nullptr;
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    std::vector<uint8_t> buffer_; // Only used when the source cannot be mapped.
+};
@@ -0,0 +1,167 @@
+//-----------------------------------------------------------------------------
+//
+//  Bulk search for non-finite floats (NaN or infinity), for finding where a
+//  diverged training run first went bad without decoding any values.
+//
+//  An element is non-finite when its bits without the sign reach the least
+//  non-finite pattern, the all ones exponent for IEEE types, or the lone NaN
+//  pattern of types without infinity (like float8 e4m3). Since the sign bit
+//  is masked off, the magnitudes fit a signed compare of the same width.
+//
+//  SSE2 masks and compares 64 bytes per iteration, testing the combined
+//  movemask once, so clean data costs little more than reading it. 64-bit
+//  elements compare just their upper half, which holds the whole exponent.
+//  NEON (on ARM64) tests 16 bytes at a time, and the tails are checked one
+//  at a time.
+//
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <bit>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define NONFINITESCAN_SSE2 1
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#include <arm_neon.h>
+#define NONFINITESCAN_NEON 1
+#endif
+
+namespace Nonfinite
+{
+    struct Layout
+    {
+        uint32_t elementByteSize;   // 1, 2, 4, or 8
+        uint64_t magnitudeMask;     // All bits but the sign
+        uint64_t nonfiniteMinimum;  // Least magnitude of an infinity or NaN, with a zero lower half for 64-bit elements
+    };
+
+    namespace Details
+    {
+        inline size_t FindNextScalar(const uint8_t* elements, size_t begin, size_t count, const Layout& layout) noexcept
+        {
+            for (size_t i = begin; i < count; ++i)
+            {
+                uint64_t bits = 0; // Little-endian
+                memcpy(&bits, elements + i * layout.elementByteSize, layout.elementByteSize);
+                if ((bits & layout.magnitudeMask) >= layout.nonfiniteMinimum)
+                {
+                    return i;
+                }
+            }
+            return count;
+        }
+
+    #if defined(NONFINITESCAN_SSE2)
+        // Returns whether a lane of laneByteSize in the bytes [begin, end) is non-finite after masking,
+        // setting offset to its byte, or else to the start of the tail left unscanned.
+        template <uint32_t laneByteSize>
+        bool FindNextSse2(const uint8_t* data, size_t begin, size_t end, __m128i magnitudeMask, __m128i threshold, /*out*/ size_t& offset) noexcept
+        {
+            auto compare = [&](size_t byteIndex) -> __m128i
+            {
+                const __m128i x = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + byteIndex)), magnitudeMask);
+                if constexpr (laneByteSize == 1) return _mm_cmpgt_epi8(x, threshold);
+                else if constexpr (laneByteSize == 2) return _mm_cmpgt_epi16(x, threshold);
+                else return _mm_cmpgt_epi32(x, threshold);
+            };
+
+            size_t i = begin;
+            for (/*above*/; i + 64 <= end; i += 64)
+            {
+                const __m128i c0 = compare(i), c1 = compare(i + 16), c2 = compare(i + 32), c3 = compare(i + 48);
+                if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(c0, c1), _mm_or_si128(c2, c3))) != 0)
+                {
+                    const uint64_t mask = uint64_t(uint32_t(_mm_movemask_epi8(c0)) | (uint32_t(_mm_movemask_epi8(c1)) << 16))
+                                        | (uint64_t(uint32_t(_mm_movemask_epi8(c2)) | (uint32_t(_mm_movemask_epi8(c3)) << 16)) << 32);
+                    offset = i + std::countr_zero(mask);
+                    return true;
+                }
+            }
+            for (/*above*/; i + 16 <= end; i += 16)
+            {
+                const uint32_t mask = uint32_t(_mm_movemask_epi8(compare(i)));
+                if (mask != 0)
+                {
+                    offset = i + std::countr_zero(mask);
+                    return true;
+                }
+            }
+            offset = i;
+            return false;
+        }
+    #endif
+    }
+
+    // Returns the index of the first non-finite element in [begin, count), or count if there is none.
+    inline size_t FindNext(const uint8_t* elements, size_t begin, size_t count, const Layout& layout) noexcept
+    {
+        const uint32_t elementByteSize = layout.elementByteSize;
+        size_t i = begin;
+    #if defined(NONFINITESCAN_SSE2)
+        const size_t byteBegin = begin * elementByteSize, byteEnd = count * elementByteSize;
+        size_t offset = byteBegin;
+        bool isFound = false;
+        switch (elementByteSize)
+        {
+        case 1:
+            isFound = Details::FindNextSse2<1>(elements, byteBegin, byteEnd, _mm_set1_epi8(char(layout.magnitudeMask)), _mm_set1_epi8(char(layout.nonfiniteMinimum - 1)), /*out*/ offset);
+            break;
+        case 2:
+            isFound = Details::FindNextSse2<2>(elements, byteBegin, byteEnd, _mm_set1_epi16(short(layout.magnitudeMask)), _mm_set1_epi16(short(layout.nonfiniteMinimum - 1)), /*out*/ offset);
+            break;
+        case 4:
+            isFound = Details::FindNextSse2<4>(elements, byteBegin, byteEnd, _mm_set1_epi32(int(layout.magnitudeMask)), _mm_set1_epi32(int(layout.nonfiniteMinimum - 1)), /*out*/ offset);
+            break;
+        case 8:
+            {
+                // The lower halves are masked to zero, never exceeding their zero threshold.
+                const int32_t upperMagnitudeMask = int32_t(layout.magnitudeMask >> 32), upperThreshold = int32_t((layout.nonfiniteMinimum >> 32) - 1);
+                isFound = Details::FindNextSse2<4>(
+                    elements,
+                    byteBegin,
+                    byteEnd,
+                    _mm_set_epi32(upperMagnitudeMask, 0, upperMagnitudeMask, 0),
+                    _mm_set_epi32(upperThreshold, 0, upperThreshold, 0),
+                    /*out*/ offset
+                );
+            }
+            break;
+        }
+        if (isFound)
+        {
+            return offset / elementByteSize;
+        }
+        i = offset / elementByteSize;
+    #elif defined(NONFINITESCAN_NEON)
+        if (elementByteSize == 1 || elementByteSize == 2 || elementByteSize == 4)
+        {
+            const uint8x16_t magnitudeMask = vreinterpretq_u8_u64(vdupq_n_u64(
+                (elementByteSize == 1) ? layout.magnitudeMask * 0x0101010101010101ull
+                : (elementByteSize == 2) ? layout.magnitudeMask * 0x0001000100010001ull
+                : layout.magnitudeMask * 0x0000000100000001ull
+            ));
+            const uint32x4_t threshold32 = vdupq_n_u32(uint32_t(layout.nonfiniteMinimum - 1));
+            const uint16x8_t threshold16 = vdupq_n_u16(uint16_t(layout.nonfiniteMinimum - 1));
+            const uint8x16_t threshold8 = vdupq_n_u8(uint8_t(layout.nonfiniteMinimum - 1));
+            const size_t elementsPerBlock = 16 / elementByteSize;
+            for (/*above*/; i + elementsPerBlock <= count; i += elementsPerBlock)
+            {
+                const uint8x16_t x = vandq_u8(vld1q_u8(elements + i * elementByteSize), magnitudeMask);
+                const uint8x16_t isNonfinite = (elementByteSize == 1) ? vcgtq_u8(x, threshold8)
+                                             : (elementByteSize == 2) ? vreinterpretq_u8_u16(vcgtq_u16(vreinterpretq_u16_u8(x), threshold16))
+                                             : vreinterpretq_u8_u32(vcgtq_u32(vreinterpretq_u32_u8(x), threshold32));
+                if (vmaxvq_u8(isNonfinite) != 0)
+                {
+                    break; // Locate it below.
+                }
+            }
+        }
+    #endif
+        return Details::FindNextScalar(elements, i, count, layout);
+    }
+}
@@ -0,0 +1,237 @@
+//-----------------------------------------------------------------------------
+//
+//  NumPy .npy file header parsing and writing.
+//
+//  An .npy file is a magic string, a version, a header length, and then a
+//  Python dictionary literal describing the array, padded with spaces:
+//
+//      \x93NUMPY \x01\x00 \x76\x00 {'descr': '<f4', 'fortran_order': False, 'shape': (3, 4), }
+//
+//  followed directly by the raw element data, which callers map or stream
+//  in place. The dtype string is left to the caller to interpret.
+//  https://numpy.org/doc/stable/reference/generated/numpy.lib.format.html
+//
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Npy
+{
+    constexpr std::string_view magic = "\x93NUMPY";
+
+    struct Header
+    {
+        std::string descr;              // dtype string, like "<f4" or "|u1"
+        bool isFortranOrder = false;    // Column major rather than row major
+        std::vector<uint64_t> shape;
+        size_t dataOffset = 0;          // Byte offset of the element data in the file
+
+        uint64_t GetElementCount() const noexcept
+        {
+            uint64_t elementCount = 1;
+            for (uint64_t dimension : shape)
+            {
+                elementCount *= dimension;
+            }
+            return elementCount;
+        }
+    };
+
+    inline bool IsNpy(const uint8_t* data, size_t size) noexcept
+    {
+        return size >= magic.size() && memcmp(data, magic.data(), magic.size()) == 0;
+    }
+
+    namespace Details
+    {
+        inline void SkipSpaces(std::string_view s, /*inout*/ size_t& i) noexcept
+        {
+            while (i < s.size() && (s[i] == ' ' || s[i] == '\t' || s[i] == '\n'))
+            {
+                ++i;
+            }
+        }
+
+        inline bool SkipCharacter(std::string_view s, /*inout*/ size_t& i, char ch) noexcept
+        {
+            SkipSpaces(s, /*inout*/ i);
+            if (i >= s.size() || s[i] != ch)
+            {
+                return false;
+            }
+            ++i;
+            return true;
+        }
+
+        // Reads a single or double quoted Python string literal (without escapes, which dtype names lack).
+        inline bool ReadString(std::string_view s, /*inout*/ size_t& i, /*out*/ std::string_view& value) noexcept
+        {
+            SkipSpaces(s, /*inout*/ i);
+            if (i >= s.size() || (s[i] != '\'' && s[i] != '"'))
+            {
+                return false;
+            }
+            const size_t end = s.find(s[i], i + 1);
+            if (end == std::string_view::npos)
+            {
+                return false;
+            }
+            value = s.substr(i + 1, end - i - 1);
+            i = end + 1;
+            return true;
+        }
+
+        inline bool ReadBoolean(std::string_view s, /*inout*/ size_t& i, /*out*/ bool& value) noexcept
+        {
+            SkipSpaces(s, /*inout*/ i);
+            for (std::string_view name : {std::string_view("True"), std::string_view("False")})
+            {
+                if (s.substr(i, name.size()) == name)
+                {
+                    value = (name.front() == 'T');
+                    i += name.size();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Reads a tuple of integers, like "()", "(7,)", or "(3, 4)".
+        inline bool ReadShape(std::string_view s, /*inout*/ size_t& i, /*out*/ std::vector<uint64_t>& shape)
+        {
+            shape.clear();
+            if (!SkipCharacter(s, /*inout*/ i, '('))
+            {
+                return false;
+            }
+            while (!SkipCharacter(s, /*inout*/ i, ')'))
+            {
+                SkipSpaces(s, /*inout*/ i);
+                uint64_t dimension = 0;
+                const size_t digitsBegin = i;
+                for (/*above*/; i < s.size() && s[i] >= '0' && s[i] <= '9'; ++i)
+                {
+                    dimension = dimension * 10 + uint64_t(s[i] - '0');
+                }
+                SkipCharacter(s, /*inout*/ i, 'L'); // Python 2 long suffix, in old files.
+                if (i == digitsBegin)
+                {
+                    return false;
+                }
+                shape.push_back(dimension);
+                SkipCharacter(s, /*inout*/ i, ',');
+            }
+            return true;
+        }
+    }
+
+    // Parses the header of an .npy file, returning false if it is malformed or lacks any of
+    // descr, fortran_order, or shape. The header may be followed by the data or not.
+    inline bool ParseHeader(const uint8_t* data, size_t size, /*out*/ Header& header)
+    {
+        header = {};
+        if (!IsNpy(data, size) || size < 10)
+        {
+            return false;
+        }
+
+        // Version 1.0 has a 16-bit header length, and versions 2.0 and 3.0 have 32-bit lengths.
+        const uint8_t majorVersion = data[6];
+        size_t headerLength = 0;
+        size_t headerOffset = 0;
+        if (majorVersion == 1)
+        {
+            headerLength = size_t(data[8]) | (size_t(data[9]) << 8);
+            headerOffset = 10;
+        }
+        else if ((majorVersion == 2 || majorVersion == 3) && size >= 12)
+        {
+            headerLength = size_t(data[8]) | (size_t(data[9]) << 8) | (size_t(data[10]) << 16) | (size_t(data[11]) << 24);
+            headerOffset = 12;
+        }
+        else
+        {
+            return false;
+        }
+        if (headerLength > size - headerOffset)
+        {
+            return false;
+        }
+
+        const std::string_view dictionary(reinterpret_cast<const char*>(data + headerOffset), headerLength);
+        size_t i = 0;
+        if (!Details::SkipCharacter(dictionary, /*inout*/ i, '{'))
+        {
+            return false;
+        }
+
+        bool hasDescr = false, hasFortranOrder = false, hasShape = false;
+        while (!Details::SkipCharacter(dictionary, /*inout*/ i, '}'))
+        {
+            std::string_view key, descr;
+            if (!Details::ReadString(dictionary, /*inout*/ i, /*out*/ key) || !Details::SkipCharacter(dictionary, /*inout*/ i, ':'))
+            {
+                return false;
+            }
+
+            bool succeeded = false;
+            if (key == "descr")
+            {
+                // Structured dtypes are lists rather than strings, and so fail here as unsupported.
+                succeeded = hasDescr = Details::ReadString(dictionary, /*inout*/ i, /*out*/ descr);
+                header.descr = descr;
+            }
+            else if (key == "fortran_order")
+            {
+                succeeded = hasFortranOrder = Details::ReadBoolean(dictionary, /*inout*/ i, /*out*/ header.isFortranOrder);
+            }
+            else if (key == "shape")
+            {
+                succeeded = hasShape = Details::ReadShape(dictionary, /*inout*/ i, /*out*/ header.shape);
+            }
+            if (!succeeded)
+            {
+                return false;
+            }
+            Details::SkipCharacter(dictionary, /*inout*/ i, ',');
+        }
+
+        header.dataOffset = headerOffset + headerLength;
+        return hasDescr && hasFortranOrder && hasShape;
+    }
+
+    // Returns a version 1.0 header, padded with spaces so the data that follows starts at a multiple
+    // of the alignment (which must be a multiple of 64, the minimum numpy writes).
+    inline std::string MakeHeader(std::string_view descr, bool isFortranOrder, const std::vector<uint64_t>& shape, size_t alignment = 64)
+    {
+        std::string dictionary = "{'descr': '";
+        dictionary.append(descr);
+        dictionary.append(isFortranOrder ? "', 'fortran_order': True, 'shape': (" : "', 'fortran_order': False, 'shape': (");
+        for (size_t i = 0; i < shape.size(); ++i)
+        {
+            dictionary.append(i > 0 ? ", " : "");
+            dictionary.append(std::to_string(shape[i]));
+        }
+        dictionary.append(shape.size() == 1 ? ",), }" : "), }");
+
+        constexpr size_t prefixSize = 10; // Magic, version, and 16-bit header length.
+        const size_t paddedSize = (prefixSize + dictionary.size() + 1 + alignment - 1) / alignment * alignment;
+        const size_t headerLength = paddedSize - prefixSize;
+        dictionary.resize(headerLength - 1, ' ');
+        dictionary.push_back('\n');
+
+        std::string header(magic);
+        header.push_back('\x01'); // Version 1.0
+        header.push_back('\x00');
+        header.push_back(char(headerLength & 0xFF));
+        header.push_back(char(headerLength >> 8));
+        header.append(dictionary);
+        return header;
+    }
+}
@@ -0,0 +1,241 @@
+//-----------------------------------------------------------------------------
+//
+//  ONNX model initializer (weight) extraction.
+//
+//  An .onnx file is a protobuf ModelProto, whose graph holds the weights as
+//  TensorProto initializers. Rather than depend on protobuf, the wire format
+//  is walked directly, only descending into ModelProto.graph.initializer and
+//  skipping every other field (like the nodes) by its length prefix, so even
+//  multi-gigabyte models are indexed without touching the weight bytes:
+//
+//      ModelProto { 7: graph GraphProto { 5: initializer TensorProto {
+//          1: dims, 2: data_type, 8: name, 9: raw_data, 4: float_data, ... } } }
+//
+//  Tensor data is returned as a byte range of the file, for callers to map in
+//  place. Data stored as varints or in external files has no such range.
+//  https://github.com/onnx/onnx/blob/main/onnx/onnx.proto
+//
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Onnx
+{
+    // TensorProto.DataType names, indexed by the enum value.
+    constexpr std::string_view g_dataTypeNames[] =
+    {
+        "UNDEFINED", "FLOAT", "UINT8", "INT8", "UINT16", "INT16", "INT32", "INT64",
+        "STRING", "BOOL", "FLOAT16", "DOUBLE", "UINT32", "UINT64", "COMPLEX64", "COMPLEX128",
+        "BFLOAT16", "FLOAT8E4M3FN", "FLOAT8E4M3FNUZ", "FLOAT8E5M2", "FLOAT8E5M2FNUZ", "UINT4", "INT4", "FLOAT4E2M1",
+    };
+
+    inline std::string_view GetDataTypeName(int32_t dataType) noexcept
+    {
+        return (dataType >= 0 && size_t(dataType) < std::size(g_dataTypeNames)) ? g_dataTypeNames[dataType] : std::string_view{};
+    }
+
+    enum class DataLocation
+    {
+        RawData,        // raw_data bytes
+        PackedData,     // Packed fixed size float_data or double_data, laid out the same as raw_data
+        Varints,        // int32_data, int64_data, or uint64_data (or unpacked values), not contiguous in the file
+        External,       // Stored in a separate file
+    };
+
+    struct TensorInfo
+    {
+        std::string name;
+        std::vector<uint64_t> shape;
+        int32_t dataType = 0;
+        DataLocation dataLocation = DataLocation::Varints;
+        uint64_t dataOffset = 0;        // Byte offset in the file, for RawData and PackedData
+        uint64_t byteCount = 0;
+    };
+
+    namespace Details
+    {
+        enum class WireType : uint32_t
+        {
+            Varint = 0,
+            Fixed64 = 1,
+            LengthDelimited = 2,
+            Fixed32 = 5,
+        };
+
+        // Bounds checked protobuf wire format reader over one message, which stays failed after any
+        // read past the end.
+        struct Reader
+        {
+            const uint8_t* data;
+            size_t begin;
+            size_t end;
+            bool failed = false;
+
+            bool IsAtEnd() const noexcept { return begin >= end || failed; }
+
+            uint64_t ReadVarint() noexcept
+            {
+                uint64_t value = 0;
+                for (uint32_t shift = 0; shift < 64; shift += 7)
+                {
+                    if (begin >= end)
+                    {
+                        break;
+                    }
+                    const uint8_t byte = data[begin++];
+                    value |= uint64_t(byte & 0x7F) << shift;
+                    if ((byte & 0x80) == 0)
+                    {
+                        return value;
+                    }
+                }
+                failed = true;
+                return 0;
+            }
+
+            // Reads a field key, returning false at the end of the message.
+            bool ReadKey(/*out*/ uint32_t& fieldNumber, /*out*/ WireType& wireType) noexcept
+            {
+                if (IsAtEnd())
+                {
+                    return false;
+                }
+                const uint64_t key = ReadVarint();
+                fieldNumber = uint32_t(key >> 3);
+                wireType = WireType(key & 7);
+                return !failed;
+            }
+
+            // Reads a length delimited field's range, leaving the reader after it.
+            Reader ReadMessage() noexcept
+            {
+                const uint64_t length = ReadVarint();
+                if (failed || length > end - begin)
+                {
+                    failed = true;
+                    return {data, begin, begin, true};
+                }
+                Reader message = {data, begin, begin + size_t(length)};
+                begin += size_t(length);
+                return message;
+            }
+
+            void SkipField(WireType wireType) noexcept
+            {
+                size_t byteCount = 0;
+                switch (wireType)
+                {
+                case WireType::Varint: ReadVarint(); return;
+                case WireType::Fixed64: byteCount = 8; break;
+                case WireType::Fixed32: byteCount = 4; break;
+                case WireType::LengthDelimited: ReadMessage(); return;
+                default: failed = true; return; // Groups are long deprecated.
+                }
+                if (byteCount > end - begin)
+                {
+                    failed = true;
+                    return;
+                }
+                begin += byteCount;
+            }
+        };
+
+        inline bool ReadTensor(Reader tensorReader, /*out*/ TensorInfo& tensor)
+        {
+            bool isExternal = false;
+            uint32_t fieldNumber;
+            WireType wireType;
+            while (tensorReader.ReadKey(/*out*/ fieldNumber, /*out*/ wireType))
+            {
+                if (fieldNumber == 1 && wireType == WireType::Varint) // dims, unpacked
+                {
+                    tensor.shape.push_back(tensorReader.ReadVarint());
+                }
+                else if (fieldNumber == 1 && wireType == WireType::LengthDelimited) // dims, packed
+                {
+                    Reader dims = tensorReader.ReadMessage();
+                    while (!dims.IsAtEnd())
+                    {
+                        tensor.shape.push_back(dims.ReadVarint());
+                    }
+                    tensorReader.failed |= dims.failed;
+                }
+                else if (fieldNumber == 2 && wireType == WireType::Varint) // data_type
+                {
+                    tensor.dataType = int32_t(tensorReader.ReadVarint());
+                }
+                else if (fieldNumber == 8 && wireType == WireType::LengthDelimited) // name
+                {
+                    const Reader name = tensorReader.ReadMessage();
+                    tensor.name.assign(reinterpret_cast<const char*>(name.data + name.begin), name.end - name.begin);
+                }
+                else if ((fieldNumber == 9 || fieldNumber == 4 || fieldNumber == 10) && wireType == WireType::LengthDelimited) // raw_data, float_data, double_data
+                {
+                    const Reader bytes = tensorReader.ReadMessage();
+                    tensor.dataLocation = (fieldNumber == 9) ? DataLocation::RawData : DataLocation::PackedData;
+                    tensor.dataOffset = bytes.begin;
+                    tensor.byteCount = bytes.end - bytes.begin;
+                }
+                else if (fieldNumber == 14 && wireType == WireType::Varint) // data_location
+                {
+                    isExternal = (tensorReader.ReadVarint() == 1);
+                }
+                else
+                {
+                    tensorReader.SkipField(wireType);
+                }
+            }
+            if (isExternal)
+            {
+                tensor.dataLocation = DataLocation::External;
+                tensor.byteCount = 0;
+            }
+            return !tensorReader.failed;
+        }
+    }
+
+    // Reads the initializers of the main graph of an ONNX model, returning false if the protobuf
+    // is malformed (and so probably not an ONNX model at all).
+    inline bool ParseInitializers(const uint8_t* data, size_t size, /*out*/ std::vector<TensorInfo>& tensors)
+    {
+        using namespace Details;
+        tensors.clear();
+        Reader modelReader = {data, 0, size};
+        uint32_t fieldNumber;
+        WireType wireType;
+        bool hasGraph = false;
+        while (modelReader.ReadKey(/*out*/ fieldNumber, /*out*/ wireType))
+        {
+            if (fieldNumber != 7 || wireType != WireType::LengthDelimited) // graph
+            {
+                modelReader.SkipField(wireType);
+                continue;
+            }
+
+            hasGraph = true;
+            Reader graphReader = modelReader.ReadMessage();
+            while (graphReader.ReadKey(/*out*/ fieldNumber, /*out*/ wireType))
+            {
+                if (fieldNumber != 5 || wireType != WireType::LengthDelimited) // initializer
+                {
+                    graphReader.SkipField(wireType);
+                    continue;
+                }
+                if (!ReadTensor(graphReader.ReadMessage(), /*out*/ tensors.emplace_back()))
+                {
+                    return false;
+                }
+            }
+            if (graphReader.failed)
+            {
+                return false;
+            }
+        }
+        return hasGraph && !modelReader.failed;
+    }
+}
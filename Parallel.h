@@ -0,0 +1,175 @@
+//-----------------------------------------------------------------------------
+//
+//  Minimal parallel loop over independent tasks using standard threads.
+//
+//  Each thread starts with its own contiguous range of task indices, taking
+//  them from the front, so neighboring tasks (like consecutive chunks of one
+//  file) stay on one thread for locality. Threads which run out steal the
+//  back half of another thread's remaining range, so uneven task costs still
+//  balance across cores.
+//
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Returns the number of threads worth running, one per hardware thread.
+inline uint32_t GetParallelThreadCount()
+{
+    const uint32_t threadCount = std::thread::hardware_concurrency();
+    return std::max(threadCount, 1u);
+}
+
+// Returns the number of worker threads a parallel loop of taskCount tasks runs on, for sizing
+// per-thread state indexed by ParallelForWithThreadIndex.
+inline size_t GetParallelForThreadCount(size_t taskCount)
+{
+    return std::min<size_t>(GetParallelThreadCount(), taskCount);
+}
+
+namespace ParallelDetails
+{
+    // Range of task indices [begin, end) packed into one atomic, so that the owner taking from the
+    // front and thieves taking from the back never both claim the same index.
+    struct alignas(64) TaskRange
+    {
+        std::atomic<uint64_t> range = 0;
+
+        static uint64_t Pack(uint32_t begin, uint32_t end) noexcept { return uint64_t(begin) | (uint64_t(end) << 32); }
+
+        // Takes the front index for the owning thread.
+        bool PopFront(/*out*/ uint32_t& taskIndex) noexcept
+        {
+            uint64_t packedRange = range.load(std::memory_order_relaxed);
+            while (true)
+            {
+                const uint32_t begin = uint32_t(packedRange), end = uint32_t(packedRange >> 32);
+                if (begin >= end)
+                {
+                    return false;
+                }
+                if (range.compare_exchange_weak(packedRange, Pack(begin + 1, end), std::memory_order_relaxed))
+                {
+                    taskIndex = begin;
+                    return true;
+                }
+            }
+        }
+
+        // Takes the back half (rounded up) for another thread.
+        bool StealBack(/*out*/ uint32_t& stolenBegin, /*out*/ uint32_t& stolenEnd) noexcept
+        {
+            uint64_t packedRange = range.load(std::memory_order_relaxed);
+            while (true)
+            {
+                const uint32_t begin = uint32_t(packedRange), end = uint32_t(packedRange >> 32);
+                if (begin >= end)
+                {
+                    return false;
+                }
+                const uint32_t middle = end - (end - begin + 1) / 2;
+                if (range.compare_exchange_weak(packedRange, Pack(begin, middle), std::memory_order_relaxed))
+                {
+                    stolenBegin = middle;
+                    stolenEnd = end;
+                    return true;
+                }
+            }
+        }
+    };
+}
+
+namespace ParallelDetails
+{
+    // Runs tasks [taskBegin, taskBegin + taskCount) across threadCount threads, for fewer than 2^32 tasks,
+    // calling taskFunction(taskIndex, threadIndex).
+    template <typename TaskFunction>
+    void ParallelForPiece(size_t taskBegin, uint32_t taskCount, size_t threadCount, TaskFunction& taskFunction)
+    {
+        std::vector<TaskRange> taskRanges(threadCount);
+        for (size_t i = 0; i < threadCount; ++i)
+        {
+            const uint32_t begin = uint32_t(uint64_t(taskCount) * i / threadCount);
+            const uint32_t end = uint32_t(uint64_t(taskCount) * (i + 1) / threadCount);
+            taskRanges[i].range.store(TaskRange::Pack(begin, end), std::memory_order_relaxed);
+        }
+
+        auto worker = [&](size_t threadIndex)
+        {
+            auto& ownRange = taskRanges[threadIndex];
+            while (true)
+            {
+                uint32_t taskIndex;
+                while (ownRange.PopFront(/*out*/ taskIndex))
+                {
+                    taskFunction(taskBegin + taskIndex, threadIndex);
+                }
+
+                // Once every other range is seen empty, all remaining tasks are already owned by
+                // running threads (ranges are only refilled by stealing), so this thread can finish.
+                uint32_t stolenBegin = 0, stolenEnd = 0;
+                bool hasStolen = false;
+                for (size_t i = 1; i < threadCount && !hasStolen; ++i)
+                {
+                    hasStolen = taskRanges[(threadIndex + i) % threadCount].StealBack(/*out*/ stolenBegin, /*out*/ stolenEnd);
+                }
+                if (!hasStolen)
+                {
+                    return;
+                }
+                ownRange.range.store(TaskRange::Pack(stolenBegin, stolenEnd), std::memory_order_relaxed);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount - 1);
+        for (size_t i = 1; i < threadCount; ++i)
+        {
+            threads.emplace_back(worker, i);
+        }
+        worker(0);
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+}
+
+// Calls taskFunction(taskIndex, threadIndex) once for every index in [0, taskCount), distributed
+// across worker threads (including the calling thread, index 0), returning after all tasks complete.
+// Tasks with the same thread index never run concurrently, so they can share per-thread state.
+template <typename TaskFunction>
+void ParallelForWithThreadIndex(size_t taskCount, TaskFunction&& taskFunction)
+{
+    const size_t threadCount = GetParallelForThreadCount(taskCount);
+    if (threadCount <= 1)
+    {
+        for (size_t taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+        {
+            taskFunction(taskIndex, size_t(0));
+        }
+        return;
+    }
+
+    // Ranges hold 32-bit indices, so run any enormous loop in pieces.
+    constexpr size_t maximumPieceTaskCount = UINT32_MAX;
+    for (size_t pieceBegin = 0; pieceBegin < taskCount; pieceBegin += maximumPieceTaskCount)
+    {
+        const uint32_t pieceTaskCount = uint32_t(std::min(maximumPieceTaskCount, taskCount - pieceBegin));
+        ParallelDetails::ParallelForPiece(pieceBegin, pieceTaskCount, std::min<size_t>(threadCount, pieceTaskCount), taskFunction);
+    }
+}
+
+// Calls taskFunction(taskIndex) once for every index in [0, taskCount), distributed across
+// worker threads (including the calling thread), returning after all tasks complete.
+template <typename TaskFunction>
+void ParallelFor(size_t taskCount, TaskFunction&& taskFunction)
+{
+    ParallelForWithThreadIndex(taskCount, [&](size_t taskIndex, size_t /*threadIndex*/) { taskFunction(taskIndex); });
+}
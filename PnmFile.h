@@ -0,0 +1,154 @@
+//-----------------------------------------------------------------------------
+//
+//  Netpbm binary image header parsing: PGM and PPM (8 or 16-bit gray or RGB)
+//  and PFM (float32 gray or RGB, the portable float map used for HDR).
+//
+//  Each is a short text header followed directly by the raw pixels, which
+//  callers map in place:
+//
+//      P5 or P6 <width> <height> <maxValue>\n  samples (16-bit if maxValue > 255, big-endian)
+//      Pf or PF <width> <height> <scale>\n     float32 samples (little-endian if scale < 0)
+//
+//  PFM rows are stored bottom to top. The ASCII (P1-P3) and bitmap (P4)
+//  formats are not supported.
+//  https://netpbm.sourceforge.net/doc/pgm.html
+//  https://netpbm.sourceforge.net/doc/pfm.html
+//
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <cctype>
+#include <cstdlib>
+#include <string>
+
+namespace Pnm
+{
+    struct Header
+    {
+        char format = 0;                // '5' (PGM), '6' (PPM), 'f' (gray PFM), or 'F' (RGB PFM)
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t channelCount = 0;      // 1 or 3
+        uint32_t sampleByteSize = 0;    // 1, 2, or 4
+        uint32_t maximumValue = 0;      // Of PGM and PPM samples
+        float scale = 0;                // Of PFM samples, negative for little-endian
+        bool isFloat = false;
+        bool isBigEndian = false;
+        bool isBottomUp = false;        // PFM rows run from the bottom of the image up.
+        size_t dataOffset = 0;          // Byte offset of the pixels in the file
+
+        uint64_t GetByteCount() const noexcept
+        {
+            return uint64_t(width) * height * channelCount * sampleByteSize;
+        }
+    };
+
+    inline bool IsPnm(const uint8_t* data, size_t size) noexcept
+    {
+        if (size < 3 || data[0] != 'P')
+        {
+            return false;
+        }
+        const uint8_t format = data[1], separator = data[2];
+        return (format == '5' || format == '6' || format == 'f' || format == 'F')
+            && (separator == ' ' || separator == '\t' || separator == '\r' || separator == '\n');
+    }
+
+    namespace Details
+    {
+        inline bool IsSpace(uint8_t ch) noexcept
+        {
+            return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n' || ch == '\v' || ch == '\f';
+        }
+
+        // Skips whitespace and '#' comments (which run to the end of the line), then reads a field.
+        inline bool ReadField(const uint8_t* data, size_t size, /*inout*/ size_t& i, /*out*/ std::string& field)
+        {
+            while (i < size && (IsSpace(data[i]) || data[i] == '#'))
+            {
+                if (data[i] == '#')
+                {
+                    while (i < size && data[i] != '\n')
+                    {
+                        ++i;
+                    }
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+            field.clear();
+            for (/*above*/; i < size && !IsSpace(data[i]) && field.size() < 32; ++i)
+            {
+                field.push_back(char(data[i]));
+            }
+            return !field.empty() && (i >= size || IsSpace(data[i]));
+        }
+
+        inline bool ParseUnsigned(const std::string& field, uint32_t maximumValue, /*out*/ uint32_t& value)
+        {
+            char* end = nullptr;
+            const unsigned long long parsedValue = strtoull(field.c_str(), &end, 10);
+            value = uint32_t(parsedValue);
+            return *end == '\0' && isdigit(uint8_t(field.front())) && parsedValue > 0 && parsedValue <= maximumValue;
+        }
+    }
+
+    // Parses the header of a binary PGM, PPM, or PFM image, returning false if it is malformed. The
+    // pixels may be truncated, leaving callers to clamp to the file size.
+    inline bool ParseHeader(const uint8_t* data, size_t size, /*out*/ Header& header)
+    {
+        using namespace Details;
+        header = {};
+        if (!IsPnm(data, size))
+        {
+            return false;
+        }
+
+        header.format = char(data[1]);
+        header.isFloat = (header.format == 'f' || header.format == 'F');
+        header.channelCount = (header.format == '6' || header.format == 'F') ? 3 : 1;
+
+        size_t i = 2;
+        std::string field;
+        if (!ReadField(data, size, /*inout*/ i, /*out*/ field) || !ParseUnsigned(field, INT32_MAX, /*out*/ header.width)
+        ||  !ReadField(data, size, /*inout*/ i, /*out*/ field) || !ParseUnsigned(field, INT32_MAX, /*out*/ header.height)
+        ||  !ReadField(data, size, /*inout*/ i, /*out*/ field))
+        {
+            return false;
+        }
+
+        if (header.isFloat)
+        {
+            char* end = nullptr;
+            header.scale = strtof(field.c_str(), &end);
+            if (*end != '\0' || header.scale == 0)
+            {
+                return false;
+            }
+            header.sampleByteSize = 4;
+            header.isBigEndian = (header.scale > 0);
+            header.isBottomUp = true;
+        }
+        else
+        {
+            if (!ParseUnsigned(field, UINT16_MAX, /*out*/ header.maximumValue))
+            {
+                return false;
+            }
+            header.sampleByteSize = (header.maximumValue > UINT8_MAX) ? 2 : 1;
+            header.isBigEndian = (header.sampleByteSize > 1);
+        }
+
+        // A single whitespace character separates the header from the pixels.
+        if (i >= size)
+        {
+            return false;
+        }
+        header.dataOffset = i + 1;
+        return true;
+    }
+}
@@ -0,0 +1,288 @@
+//-----------------------------------------------------------------------------
+//
+//  Bulk census of which range of each narrower target type the elements of
+//  a float array fall in, counting in one pass how many would overflow,
+//  round to zero, or become subnormal under every target at once.
+//
+//  Each element's bits map to a signed ordinal (the magnitude, negated when
+//  the sign is set), which orders floats the same as their values. So every
+//  target's range is just a band of ordinals, precomputed by the caller from
+//  the target's limits, and classifying an element under a target is a pair
+//  of integer compares per band rather than a conversion.
+//
+//  SSE2 and NEON (on ARM64) widen 1, 2, or 4 byte elements to 32-bit lanes,
+//  four at a time, counting each band in lane counters. 8-byte elements and
+//  the tails are classified one at a time.
+//
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define RANGECENSUS_SSE2 1
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#include <arm_neon.h>
+#define RANGECENSUS_NEON 1
+#endif
+
+namespace RangeCensus
+{
+    // How a float element's bits are laid out, with all masks in the low bits of the element.
+    struct Layout
+    {
+        uint32_t elementByteSize;       // 1, 2, 4, or 8
+        uint64_t signMask;
+        uint64_t finiteMagnitudeEnd;    // Least magnitude (bits without the sign) of infinity, or else of NaN
+        uint64_t nanMagnitudeMinimum;   // Least magnitude of NaN
+    };
+
+    // Ordinals in (lowExclusive, highInclusive], the form the lane compares test directly.
+    struct Band
+    {
+        int64_t lowExclusive;
+        int64_t highInclusive;
+    };
+
+    // Bands of a target, where inRange holds all values that round to a finite value of the target,
+    // underflow all that round to zero, and subnormal all that round to zero or a subnormal (so it
+    // encloses underflow).
+    struct TargetBands
+    {
+        Band inRange;
+        Band underflow;
+        Band subnormal;
+    };
+
+    struct BandCounts
+    {
+        uint64_t inRange = 0;
+        uint64_t underflow = 0;
+        uint64_t subnormal = 0;
+    };
+
+    // Counts shared by all targets.
+    struct ClassCounts
+    {
+        uint64_t finite = 0;
+        uint64_t notNan = 0;            // Finite or infinity
+        uint64_t zero = 0;
+    };
+
+    namespace Details
+    {
+        constexpr size_t blockElementCount = 1024; // Few enough for 32-bit lane counters, and to stay cached across targets.
+
+        // Whole groups of four lanes, up to a block.
+        inline size_t GetBlockCount(size_t remainingCount) noexcept
+        {
+            return (remainingCount < blockElementCount) ? remainingCount & ~size_t(3) : blockElementCount;
+        }
+
+        inline int64_t GetOrdinal(uint64_t bits, const Layout& layout, /*out*/ uint64_t& magnitude) noexcept
+        {
+            magnitude = bits & ~layout.signMask;
+            return (bits & layout.signMask) ? -int64_t(magnitude) : int64_t(magnitude);
+        }
+
+        inline bool IsInBand(int64_t ordinal, const Band& band) noexcept
+        {
+            return ordinal > band.lowExclusive && ordinal <= band.highInclusive;
+        }
+
+        inline void CountBandsScalar(
+            const uint8_t* elements,
+            size_t begin,
+            size_t end,
+            const Layout& layout,
+            const TargetBands* targets,
+            size_t targetCount,
+            /*inout*/ ClassCounts& classCounts,
+            /*inout*/ BandCounts* bandCounts
+        ) noexcept
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                uint64_t bits = 0, magnitude; // Little-endian
+                memcpy(&bits, elements + i * layout.elementByteSize, layout.elementByteSize);
+                const int64_t ordinal = GetOrdinal(bits, layout, /*out*/ magnitude);
+                classCounts.finite += (magnitude < layout.finiteMagnitudeEnd);
+                classCounts.notNan += (magnitude < layout.nanMagnitudeMinimum);
+                classCounts.zero += (magnitude == 0);
+                for (size_t t = 0; t < targetCount; ++t)
+                {
+                    bandCounts[t].inRange += IsInBand(ordinal, targets[t].inRange);
+                    bandCounts[t].underflow += IsInBand(ordinal, targets[t].underflow);
+                    bandCounts[t].subnormal += IsInBand(ordinal, targets[t].subnormal);
+                }
+            }
+        }
+    }
+
+    // Adds the count of elements in each band of every target, and the finite, non-NaN, and zero
+    // elements. Band bounds must lie within +-finiteMagnitudeEnd.
+    inline void CountBands(
+        const uint8_t* elements,
+        size_t count,
+        const Layout& layout,
+        const TargetBands* targets,
+        size_t targetCount,
+        /*inout*/ ClassCounts& classCounts,
+        /*inout*/ BandCounts* bandCounts
+    ) noexcept
+    {
+        size_t i = 0;
+        const uint32_t elementByteSize = layout.elementByteSize;
+    #if defined(RANGECENSUS_SSE2) || defined(RANGECENSUS_NEON)
+        if (elementByteSize == 1 || elementByteSize == 2 || elementByteSize == 4)
+        {
+            // Each block's ordinals are computed once, then tested against every target while cached.
+            alignas(16) int32_t ordinals[Details::blockElementCount];
+            const uint32_t laneSignMask = uint32_t(layout.signMask);
+            const uint32_t laneMagnitudeMask = ~uint32_t(0) >> (32 - elementByteSize * 8) & ~laneSignMask;
+        #if defined(RANGECENSUS_SSE2)
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i signMask = _mm_set1_epi32(int32_t(laneSignMask));
+            const __m128i magnitudeMask = _mm_set1_epi32(int32_t(laneMagnitudeMask));
+            const __m128i finiteEnd = _mm_set1_epi32(int32_t(layout.finiteMagnitudeEnd));
+            const __m128i nanMinimum = _mm_set1_epi32(int32_t(layout.nanMagnitudeMinimum));
+
+            auto load = [&](const uint8_t* p) -> __m128i
+            {
+                if (elementByteSize == 4)
+                {
+                    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                }
+                else if (elementByteSize == 2)
+                {
+                    return _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)), zero);
+                }
+                int32_t bytes;
+                memcpy(&bytes, p, sizeof(bytes));
+                return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero), zero);
+            };
+            // Lanes of all ones count as one when subtracted.
+            auto countInBand = [](__m128i ordinal, __m128i lowExclusive, __m128i highInclusive) -> __m128i
+            {
+                return _mm_andnot_si128(_mm_cmpgt_epi32(ordinal, highInclusive), _mm_cmpgt_epi32(ordinal, lowExclusive));
+            };
+            auto sumLanes = [](__m128i x) -> uint64_t
+            {
+                alignas(16) uint32_t lanes[4];
+                _mm_store_si128(reinterpret_cast<__m128i*>(lanes), x);
+                return uint64_t(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+            };
+
+            while (i + 4 <= count)
+            {
+                const size_t blockCount = Details::GetBlockCount(count - i);
+                __m128i finiteCount = zero, notNanCount = zero, zeroCount = zero;
+                for (size_t j = 0; j < blockCount; j += 4)
+                {
+                    const __m128i x = load(elements + (i + j) * elementByteSize);
+                    const __m128i magnitude = _mm_and_si128(x, magnitudeMask);
+                    const __m128i isNegative = _mm_xor_si128(_mm_cmpeq_epi32(_mm_and_si128(x, signMask), zero), _mm_set1_epi32(-1));
+                    finiteCount = _mm_sub_epi32(finiteCount, _mm_cmpgt_epi32(finiteEnd, magnitude));
+                    notNanCount = _mm_sub_epi32(notNanCount, _mm_cmpgt_epi32(nanMinimum, magnitude));
+                    zeroCount = _mm_sub_epi32(zeroCount, _mm_cmpeq_epi32(magnitude, zero));
+                    _mm_store_si128(reinterpret_cast<__m128i*>(ordinals + j), _mm_sub_epi32(_mm_xor_si128(magnitude, isNegative), isNegative));
+                }
+                classCounts.finite += sumLanes(finiteCount);
+                classCounts.notNan += sumLanes(notNanCount);
+                classCounts.zero += sumLanes(zeroCount);
+
+                for (size_t t = 0; t < targetCount; ++t)
+                {
+                    const TargetBands& target = targets[t];
+                    const __m128i inRangeLow = _mm_set1_epi32(int32_t(target.inRange.lowExclusive)), inRangeHigh = _mm_set1_epi32(int32_t(target.inRange.highInclusive));
+                    const __m128i underflowLow = _mm_set1_epi32(int32_t(target.underflow.lowExclusive)), underflowHigh = _mm_set1_epi32(int32_t(target.underflow.highInclusive));
+                    const __m128i subnormalLow = _mm_set1_epi32(int32_t(target.subnormal.lowExclusive)), subnormalHigh = _mm_set1_epi32(int32_t(target.subnormal.highInclusive));
+                    __m128i inRangeCount = zero, underflowCount = zero, subnormalCount = zero;
+                    for (size_t j = 0; j < blockCount; j += 4)
+                    {
+                        const __m128i ordinal = _mm_load_si128(reinterpret_cast<const __m128i*>(ordinals + j));
+                        inRangeCount = _mm_sub_epi32(inRangeCount, countInBand(ordinal, inRangeLow, inRangeHigh));
+                        underflowCount = _mm_sub_epi32(underflowCount, countInBand(ordinal, underflowLow, underflowHigh));
+                        subnormalCount = _mm_sub_epi32(subnormalCount, countInBand(ordinal, subnormalLow, subnormalHigh));
+                    }
+                    bandCounts[t].inRange += sumLanes(inRangeCount);
+                    bandCounts[t].underflow += sumLanes(underflowCount);
+                    bandCounts[t].subnormal += sumLanes(subnormalCount);
+                }
+                i += blockCount;
+            }
+        #elif defined(RANGECENSUS_NEON)
+            const uint32x4_t signMask = vdupq_n_u32(laneSignMask);
+            const uint32x4_t magnitudeMask = vdupq_n_u32(laneMagnitudeMask);
+            const uint32x4_t finiteEnd = vdupq_n_u32(uint32_t(layout.finiteMagnitudeEnd));
+            const uint32x4_t nanMinimum = vdupq_n_u32(uint32_t(layout.nanMagnitudeMinimum));
+            const uint32x4_t zero = vdupq_n_u32(0);
+
+            auto load = [&](const uint8_t* p) -> uint32x4_t
+            {
+                if (elementByteSize == 4)
+                {
+                    return vld1q_u32(reinterpret_cast<const uint32_t*>(p));
+                }
+                else if (elementByteSize == 2)
+                {
+                    return vmovl_u16(vld1_u16(reinterpret_cast<const uint16_t*>(p)));
+                }
+                uint32_t bytes;
+                memcpy(&bytes, p, sizeof(bytes));
+                return vmovl_u16(vget_low_u16(vmovl_u8(vcreate_u8(bytes))));
+            };
+            auto countInBand = [](int32x4_t ordinal, int32x4_t lowExclusive, int32x4_t highInclusive) -> uint32x4_t
+            {
+                return vandq_u32(vcgtq_s32(ordinal, lowExclusive), vcleq_s32(ordinal, highInclusive));
+            };
+
+            while (i + 4 <= count)
+            {
+                const size_t blockCount = Details::GetBlockCount(count - i);
+                uint32x4_t finiteCount = zero, notNanCount = zero, zeroCount = zero;
+                for (size_t j = 0; j < blockCount; j += 4)
+                {
+                    const uint32x4_t x = load(elements + (i + j) * elementByteSize);
+                    const uint32x4_t magnitude = vandq_u32(x, magnitudeMask);
+                    const uint32x4_t isNegative = vtstq_u32(x, signMask);
+                    finiteCount = vsubq_u32(finiteCount, vcltq_u32(magnitude, finiteEnd));
+                    notNanCount = vsubq_u32(notNanCount, vcltq_u32(magnitude, nanMinimum));
+                    zeroCount = vsubq_u32(zeroCount, vceqq_u32(magnitude, zero));
+                    vst1q_s32(ordinals + j, vreinterpretq_s32_u32(vsubq_u32(veorq_u32(magnitude, isNegative), isNegative)));
+                }
+                classCounts.finite += vaddvq_u32(finiteCount);
+                classCounts.notNan += vaddvq_u32(notNanCount);
+                classCounts.zero += vaddvq_u32(zeroCount);
+
+                for (size_t t = 0; t < targetCount; ++t)
+                {
+                    const TargetBands& target = targets[t];
+                    const int32x4_t inRangeLow = vdupq_n_s32(int32_t(target.inRange.lowExclusive)), inRangeHigh = vdupq_n_s32(int32_t(target.inRange.highInclusive));
+                    const int32x4_t underflowLow = vdupq_n_s32(int32_t(target.underflow.lowExclusive)), underflowHigh = vdupq_n_s32(int32_t(target.underflow.highInclusive));
+                    const int32x4_t subnormalLow = vdupq_n_s32(int32_t(target.subnormal.lowExclusive)), subnormalHigh = vdupq_n_s32(int32_t(target.subnormal.highInclusive));
+                    uint32x4_t inRangeCount = zero, underflowCount = zero, subnormalCount = zero;
+                    for (size_t j = 0; j < blockCount; j += 4)
+                    {
+                        const int32x4_t ordinal = vld1q_s32(ordinals + j);
+                        inRangeCount = vsubq_u32(inRangeCount, countInBand(ordinal, inRangeLow, inRangeHigh));
+                        underflowCount = vsubq_u32(underflowCount, countInBand(ordinal, underflowLow, underflowHigh));
+                        subnormalCount = vsubq_u32(subnormalCount, countInBand(ordinal, subnormalLow, subnormalHigh));
+                    }
+                    bandCounts[t].inRange += vaddvq_u32(inRangeCount);
+                    bandCounts[t].underflow += vaddvq_u32(underflowCount);
+                    bandCounts[t].subnormal += vaddvq_u32(subnormalCount);
+                }
+                i += blockCount;
+            }
+        #endif
+        }
+    #endif
+
+        Details::CountBandsScalar(elements, i, count, layout, targets, targetCount, /*inout*/ classCounts, /*inout*/ bandCounts);
+    }
+}
@@ -0,0 +1,214 @@
+//-----------------------------------------------------------------------------
+//
+//  Bulk errors of converting doubles to a narrower type, for measuring how
+//  much precision a conversion loses. The caller converts the values to the
+//  type and back (with the same conversion as writing files of the type),
+//  and the differences are summarized here.
+//
+//  A target's values near any value are multiples of its ulp there, which
+//  for floats is the value's own power of two (just its exponent bits),
+//  raised to at least the least normal, then scaled down by the fraction
+//  bits. Integers and fixed point mask no exponent bits, leaving their one
+//  fixed ulp. Since ulps are powers of two, their reciprocals are exact,
+//  found by subtracting the exponent bits.
+//
+//  SSE2 and NEON (on ARM64) accumulate two doubles at a time, branchless,
+//  with the out of range lanes zeroed so they count apart. The tails are
+//  computed one at a time.
+//
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define ROUNDINGERROR_SSE2 1
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#include <arm_neon.h>
+#define ROUNDINGERROR_NEON 1
+#endif
+
+namespace RoundingError
+{
+    struct Target
+    {
+        double minimum;             // Least finite value
+        double maximum;             // Greatest finite value
+        uint64_t exponentMask;      // Exponent bits of a double for float targets, else zero
+        double minimumPowerOfTwo;   // Least normal of float targets, else the fixed ulp
+        double ulpScale;            // 2^-fractionBitCount of float targets, else 1
+    };
+
+    // Errors of the values within the target's range, merged across slices.
+    struct Summary
+    {
+        uint64_t count = 0;             // Of values within the target's range, which the errors are of
+        uint64_t flushedCount = 0;      // Of nonzero values which round to zero
+        double maximumAbsoluteError = 0;
+        double maximumRelativeError = 0;
+        double maximumUlpError = 0;     // In ulps of the target at the value
+        double squaredErrorSum = 0;
+
+        void Merge(const Summary& other) noexcept
+        {
+            count += other.count;
+            flushedCount += other.flushedCount;
+            maximumAbsoluteError = std::max(maximumAbsoluteError, other.maximumAbsoluteError);
+            maximumRelativeError = std::max(maximumRelativeError, other.maximumRelativeError);
+            maximumUlpError = std::max(maximumUlpError, other.maximumUlpError);
+            squaredErrorSum += other.squaredErrorSum;
+        }
+    };
+
+    namespace Details
+    {
+        constexpr uint64_t inverseExponentBase = uint64_t(2046) << 52; // Less the bits of a power of two, the bits of its reciprocal.
+        constexpr uint64_t magnitudeMask = ~uint64_t(0) >> 1;
+
+        inline uint64_t GetBits(double value) noexcept
+        {
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        inline double FromBits(uint64_t bits) noexcept
+        {
+            double value;
+            memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+    }
+
+    inline double GetUlp(double value, const Target& target) noexcept
+    {
+        return std::max(Details::FromBits(Details::GetBits(value) & target.exponentMask), target.minimumPowerOfTwo) * target.ulpScale;
+    }
+
+    inline double GetInverseUlp(double value, const Target& target) noexcept
+    {
+        return Details::FromBits(Details::inverseExponentBase - Details::GetBits(GetUlp(value, target)));
+    }
+
+    namespace Details
+    {
+        inline void AccumulateScalar(const double* values, const double* roundedValues, size_t begin, size_t end, const Target& target, /*inout*/ Summary& summary) noexcept
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                const double value = values[i];
+                const bool isInRange = (value >= target.minimum) & (value <= target.maximum);
+                const double inRangeValue = isInRange ? value : 0.0;
+                const double inverseUlp = GetInverseUlp(inRangeValue, target);
+                const double roundedValue = isInRange ? roundedValues[i] : 0.0;
+                const double absoluteError = std::abs(roundedValue - inRangeValue);
+                summary.count += isInRange;
+                summary.flushedCount += (inRangeValue != 0) & (roundedValue == 0);
+                summary.maximumAbsoluteError = std::max(summary.maximumAbsoluteError, absoluteError);
+                summary.maximumRelativeError = std::max(summary.maximumRelativeError, absoluteError / std::abs(inRangeValue)); // Ignoring NaN of 0 / 0
+                summary.maximumUlpError = std::max(summary.maximumUlpError, absoluteError * inverseUlp);
+                summary.squaredErrorSum += absoluteError * absoluteError;
+            }
+        }
+    }
+
+    // Accumulates the errors between each value and its rounded value, converted to the target and back.
+    // Values beyond its range (and NaN) are only excluded from the count, leaving callers to subtract it
+    // from their finite count.
+    inline void Accumulate(const double* values, const double* roundedValues, size_t count, const Target& target, /*inout*/ Summary& summary) noexcept
+    {
+        size_t i = 0;
+    #if defined(ROUNDINGERROR_SSE2)
+        const __m128d minimum = _mm_set1_pd(target.minimum), maximum = _mm_set1_pd(target.maximum);
+        const __m128d exponentMask = _mm_castsi128_pd(_mm_set1_epi64x(int64_t(target.exponentMask)));
+        const __m128d minimumPowerOfTwo = _mm_set1_pd(target.minimumPowerOfTwo), ulpScale = _mm_set1_pd(target.ulpScale);
+        const __m128d magnitudeMask = _mm_castsi128_pd(_mm_set1_epi64x(int64_t(Details::magnitudeMask)));
+        const __m128d zero = _mm_setzero_pd();
+        const __m128i inverseExponentBase = _mm_set1_epi64x(int64_t(Details::inverseExponentBase));
+        __m128i inRangeCounts = _mm_setzero_si128(), flushedCounts = _mm_setzero_si128();
+        __m128d maximumAbsoluteErrors = zero, maximumRelativeErrors = zero, maximumUlpErrors = zero, squaredErrorSums = zero;
+
+        for (/*above*/; i + 2 <= count; i += 2)
+        {
+            const __m128d value = _mm_loadu_pd(values + i);
+            const __m128d isInRange = _mm_and_pd(_mm_cmpge_pd(value, minimum), _mm_cmple_pd(value, maximum));
+            const __m128d x = _mm_and_pd(isInRange, value);
+            const __m128d ulp = _mm_mul_pd(_mm_max_pd(_mm_and_pd(x, exponentMask), minimumPowerOfTwo), ulpScale);
+            const __m128d inverseUlp = _mm_castsi128_pd(_mm_sub_epi64(inverseExponentBase, _mm_castpd_si128(ulp)));
+            const __m128d roundedValue = _mm_and_pd(isInRange, _mm_loadu_pd(roundedValues + i));
+            const __m128d absoluteError = _mm_and_pd(_mm_sub_pd(roundedValue, x), magnitudeMask);
+            const __m128d isFlushed = _mm_andnot_pd(_mm_cmpeq_pd(x, zero), _mm_cmpeq_pd(roundedValue, zero));
+            inRangeCounts = _mm_sub_epi64(inRangeCounts, _mm_castpd_si128(isInRange));
+            flushedCounts = _mm_sub_epi64(flushedCounts, _mm_castpd_si128(isFlushed));
+            // maxpd returns the second operand when either is NaN, which skips 0 / 0.
+            maximumAbsoluteErrors = _mm_max_pd(absoluteError, maximumAbsoluteErrors);
+            maximumRelativeErrors = _mm_max_pd(_mm_div_pd(absoluteError, _mm_and_pd(x, magnitudeMask)), maximumRelativeErrors);
+            maximumUlpErrors = _mm_max_pd(_mm_mul_pd(absoluteError, inverseUlp), maximumUlpErrors);
+            squaredErrorSums = _mm_add_pd(squaredErrorSums, _mm_mul_pd(absoluteError, absoluteError));
+        }
+
+        uint64_t laneCounts[2][2];
+        double laneErrors[4][2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(laneCounts[0]), inRangeCounts);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(laneCounts[1]), flushedCounts);
+        _mm_storeu_pd(laneErrors[0], maximumAbsoluteErrors);
+        _mm_storeu_pd(laneErrors[1], maximumRelativeErrors);
+        _mm_storeu_pd(laneErrors[2], maximumUlpErrors);
+        _mm_storeu_pd(laneErrors[3], squaredErrorSums);
+    #elif defined(ROUNDINGERROR_NEON)
+        const float64x2_t minimum = vdupq_n_f64(target.minimum), maximum = vdupq_n_f64(target.maximum);
+        const uint64x2_t exponentMask = vdupq_n_u64(target.exponentMask);
+        const float64x2_t minimumPowerOfTwo = vdupq_n_f64(target.minimumPowerOfTwo), ulpScale = vdupq_n_f64(target.ulpScale);
+        const float64x2_t zero = vdupq_n_f64(0.0);
+        const uint64x2_t inverseExponentBase = vdupq_n_u64(Details::inverseExponentBase);
+        uint64x2_t inRangeCounts = vdupq_n_u64(0), flushedCounts = vdupq_n_u64(0);
+        float64x2_t maximumAbsoluteErrors = zero, maximumRelativeErrors = zero, maximumUlpErrors = zero, squaredErrorSums = zero;
+
+        for (/*above*/; i + 2 <= count; i += 2)
+        {
+            const float64x2_t value = vld1q_f64(values + i);
+            const uint64x2_t isInRange = vandq_u64(vcgeq_f64(value, minimum), vcleq_f64(value, maximum));
+            const float64x2_t x = vreinterpretq_f64_u64(vandq_u64(isInRange, vreinterpretq_u64_f64(value)));
+            const float64x2_t ulp = vmulq_f64(vmaxq_f64(vreinterpretq_f64_u64(vandq_u64(vreinterpretq_u64_f64(x), exponentMask)), minimumPowerOfTwo), ulpScale);
+            const float64x2_t inverseUlp = vreinterpretq_f64_u64(vsubq_u64(inverseExponentBase, vreinterpretq_u64_f64(ulp)));
+            const float64x2_t roundedValue = vreinterpretq_f64_u64(vandq_u64(isInRange, vreinterpretq_u64_f64(vld1q_f64(roundedValues + i))));
+            const float64x2_t absoluteError = vabsq_f64(vsubq_f64(roundedValue, x));
+            inRangeCounts = vsubq_u64(inRangeCounts, isInRange);
+            flushedCounts = vsubq_u64(flushedCounts, vbicq_u64(vceqq_f64(roundedValue, zero), vceqq_f64(x, zero)));
+            // maxnm returns the number when one is NaN, which skips 0 / 0.
+            maximumAbsoluteErrors = vmaxnmq_f64(maximumAbsoluteErrors, absoluteError);
+            maximumRelativeErrors = vmaxnmq_f64(maximumRelativeErrors, vdivq_f64(absoluteError, vabsq_f64(x)));
+            maximumUlpErrors = vmaxnmq_f64(maximumUlpErrors, vmulq_f64(absoluteError, inverseUlp));
+            squaredErrorSums = vaddq_f64(squaredErrorSums, vmulq_f64(absoluteError, absoluteError));
+        }
+
+        uint64_t laneCounts[2][2];
+        double laneErrors[4][2];
+        vst1q_u64(laneCounts[0], inRangeCounts);
+        vst1q_u64(laneCounts[1], flushedCounts);
+        vst1q_f64(laneErrors[0], maximumAbsoluteErrors);
+        vst1q_f64(laneErrors[1], maximumRelativeErrors);
+        vst1q_f64(laneErrors[2], maximumUlpErrors);
+        vst1q_f64(laneErrors[3], squaredErrorSums);
+    #endif
+    #if defined(ROUNDINGERROR_SSE2) || defined(ROUNDINGERROR_NEON)
+        for (size_t lane = 0; lane < 2; ++lane)
+        {
+            summary.count += laneCounts[0][lane];
+            summary.flushedCount += laneCounts[1][lane];
+            summary.maximumAbsoluteError = std::max(summary.maximumAbsoluteError, laneErrors[0][lane]);
+            summary.maximumRelativeError = std::max(summary.maximumRelativeError, laneErrors[1][lane]);
+            summary.maximumUlpError = std::max(summary.maximumUlpError, laneErrors[2][lane]);
+            summary.squaredErrorSum += laneErrors[3][lane];
+        }
+    #endif
+
+        Details::AccumulateScalar(values, roundedValues, i, count, target, /*inout*/ summary);
+    }
+}
@@ -0,0 +1,452 @@
+//-----------------------------------------------------------------------------
+//
+//  safetensors model file header parsing and writing.
+//
+//  A safetensors file is a 64-bit little endian header length, a JSON object
+//  describing each tensor, and then one data region holding all tensors:
+//
+//      {"embed.weight": {"dtype": "BF16", "shape": [32000, 4096], "data_offsets": [0, 262144000]},
+//       "__metadata__": {"format": "pt"}}
+//
+//  Data offsets are relative to the start of the data region, which callers
+//  map or stream in place. The dtype string is left to the caller.
+//  https://github.com/huggingface/safetensors
+//
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Safetensors
+{
+    struct TensorInfo
+    {
+        std::string name;
+        std::string dtype;              // Like "F32", "BF16", or "F8_E4M3"
+        std::vector<uint64_t> shape;
+        uint64_t dataBegin = 0;         // Byte offsets relative to the data region
+        uint64_t dataEnd = 0;
+    };
+
+    struct Header
+    {
+        std::vector<TensorInfo> tensors; // In data offset order
+        std::string metadata;            // Raw JSON object of "__metadata__", if any
+        size_t dataOffset = 0;           // Byte offset of the data region in the file
+    };
+
+    namespace Details
+    {
+        // Minimal JSON reader over the header, just enough for the safetensors schema, skipping
+        // any values it does not need.
+        struct JsonReader
+        {
+            std::string_view s;
+            size_t i = 0;
+
+            void SkipSpaces() noexcept
+            {
+                while (i < s.size() && (s[i] == ' ' || s[i] == '\t' || s[i] == '\r' || s[i] == '\n'))
+                {
+                    ++i;
+                }
+            }
+
+            bool SkipCharacter(char ch) noexcept
+            {
+                SkipSpaces();
+                if (i >= s.size() || s[i] != ch)
+                {
+                    return false;
+                }
+                ++i;
+                return true;
+            }
+
+            bool ReadString(/*out*/ std::string& value)
+            {
+                value.clear();
+                if (!SkipCharacter('"'))
+                {
+                    return false;
+                }
+                while (i < s.size() && s[i] != '"')
+                {
+                    char ch = s[i++];
+                    if (ch == '\\')
+                    {
+                        if (i >= s.size())
+                        {
+                            return false;
+                        }
+                        ch = s[i++];
+                        switch (ch)
+                        {
+                        case 'b': ch = '\b'; break;
+                        case 'f': ch = '\f'; break;
+                        case 'n': ch = '\n'; break;
+                        case 'r': ch = '\r'; break;
+                        case 't': ch = '\t'; break;
+                        case 'u':
+                            if (!ReadUnicodeEscape(/*inout*/ value))
+                            {
+                                return false;
+                            }
+                            continue;
+                        default: break; // Quote, backslash, and slash stand for themselves.
+                        }
+                    }
+                    value.push_back(ch);
+                }
+                return SkipCharacter('"');
+            }
+
+            bool ReadInteger(/*out*/ uint64_t& value) noexcept
+            {
+                SkipSpaces();
+                value = 0;
+                const size_t digitsBegin = i;
+                for (/*above*/; i < s.size() && s[i] >= '0' && s[i] <= '9'; ++i)
+                {
+                    value = value * 10 + uint64_t(s[i] - '0');
+                }
+                return i > digitsBegin;
+            }
+
+            bool ReadIntegerArray(/*out*/ std::vector<uint64_t>& values)
+            {
+                values.clear();
+                if (!SkipCharacter('['))
+                {
+                    return false;
+                }
+                if (SkipCharacter(']'))
+                {
+                    return true;
+                }
+                do
+                {
+                    uint64_t value;
+                    if (!ReadInteger(/*out*/ value))
+                    {
+                        return false;
+                    }
+                    values.push_back(value);
+                } while (SkipCharacter(','));
+                return SkipCharacter(']');
+            }
+
+            // Skips any value, including nested objects and arrays, returning its text.
+            bool SkipValue(/*out*/ std::string_view& valueText)
+            {
+                SkipSpaces();
+                const size_t valueBegin = i;
+                uint32_t depth = 0;
+                std::string ignoredString;
+                do
+                {
+                    SkipSpaces();
+                    if (i >= s.size())
+                    {
+                        return false;
+                    }
+                    const char ch = s[i];
+                    if (ch == '"')
+                    {
+                        if (!ReadString(/*out*/ ignoredString))
+                        {
+                            return false;
+                        }
+                    }
+                    else if (ch == '{' || ch == '[')
+                    {
+                        ++depth;
+                        ++i;
+                    }
+                    else if (ch == '}' || ch == ']')
+                    {
+                        if (depth == 0)
+                        {
+                            return false;
+                        }
+                        --depth;
+                        ++i;
+                    }
+                    else
+                    {
+                        // Numbers, literals, and separators within containers.
+                        ++i;
+                        while (i < s.size() && depth == 0 && s[i] != ',' && s[i] != '}' && s[i] != ']' && s[i] != ' ')
+                        {
+                            ++i;
+                        }
+                    }
+                } while (depth > 0);
+                valueText = s.substr(valueBegin, i - valueBegin);
+                return true;
+            }
+
+        private:
+            static uint32_t ParseHexDigit(char ch) noexcept
+            {
+                if (ch >= '0' && ch <= '9') return uint32_t(ch - '0');
+                if (ch >= 'A' && ch <= 'F') return uint32_t(ch - 'A' + 10);
+                if (ch >= 'a' && ch <= 'f') return uint32_t(ch - 'a' + 10);
+                return UINT32_MAX;
+            }
+
+            bool ReadHexCodeUnit(/*out*/ uint32_t& codeUnit) noexcept
+            {
+                codeUnit = 0;
+                for (size_t end = i + 4; i < end; ++i)
+                {
+                    const uint32_t digit = (i < s.size()) ? ParseHexDigit(s[i]) : UINT32_MAX;
+                    if (digit == UINT32_MAX)
+                    {
+                        return false;
+                    }
+                    codeUnit = (codeUnit << 4) | digit;
+                }
+                return true;
+            }
+
+            // Reads the hex digits after \u (and any low surrogate escape), appending UTF-8.
+            bool ReadUnicodeEscape(/*inout*/ std::string& value)
+            {
+                uint32_t codePoint;
+                if (!ReadHexCodeUnit(/*out*/ codePoint))
+                {
+                    return false;
+                }
+                if (codePoint >= 0xD800 && codePoint < 0xDC00 && s.substr(i, 2) == "\\u")
+                {
+                    i += 2;
+                    uint32_t lowSurrogate;
+                    if (!ReadHexCodeUnit(/*out*/ lowSurrogate))
+                    {
+                        return false;
+                    }
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+                }
+
+                if (codePoint < 0x80)
+                {
+                    value.push_back(char(codePoint));
+                }
+                else if (codePoint < 0x800)
+                {
+                    value.push_back(char(0xC0 | (codePoint >> 6)));
+                    value.push_back(char(0x80 | (codePoint & 0x3F)));
+                }
+                else if (codePoint < 0x10000)
+                {
+                    value.push_back(char(0xE0 | (codePoint >> 12)));
+                    value.push_back(char(0x80 | ((codePoint >> 6) & 0x3F)));
+                    value.push_back(char(0x80 | (codePoint & 0x3F)));
+                }
+                else
+                {
+                    value.push_back(char(0xF0 | (codePoint >> 18)));
+                    value.push_back(char(0x80 | ((codePoint >> 12) & 0x3F)));
+                    value.push_back(char(0x80 | ((codePoint >> 6) & 0x3F)));
+                    value.push_back(char(0x80 | (codePoint & 0x3F)));
+                }
+                return true;
+            }
+        };
+
+        inline void AppendJsonString(/*inout*/ std::string& json, std::string_view value)
+        {
+            constexpr char hexDigits[] = "0123456789ABCDEF";
+            json.push_back('"');
+            for (char ch : value)
+            {
+                if (ch == '"' || ch == '\\')
+                {
+                    json.push_back('\\');
+                    json.push_back(ch);
+                }
+                else if (uint8_t(ch) < 0x20)
+                {
+                    json.append("\\u00");
+                    json.push_back(hexDigits[uint8_t(ch) >> 4]);
+                    json.push_back(hexDigits[uint8_t(ch) & 15]);
+                }
+                else
+                {
+                    json.push_back(ch);
+                }
+            }
+            json.push_back('"');
+        }
+
+        inline void AppendJsonIntegerArray(/*inout*/ std::string& json, const uint64_t* values, size_t valueCount)
+        {
+            json.push_back('[');
+            for (size_t i = 0; i < valueCount; ++i)
+            {
+                json.append(i > 0 ? "," : "");
+                json.append(std::to_string(values[i]));
+            }
+            json.push_back(']');
+        }
+    }
+
+    // Parses the header of a safetensors file, returning false if it is malformed (including any
+    // tensor data range beyond the end of the file).
+    inline bool ParseHeader(const uint8_t* data, size_t size, /*out*/ Header& header)
+    {
+        header = {};
+        constexpr size_t headerLengthSize = 8;
+        if (size < headerLengthSize)
+        {
+            return false;
+        }
+        uint64_t headerLength = 0;
+        for (size_t i = 0; i < headerLengthSize; ++i)
+        {
+            headerLength |= uint64_t(data[i]) << (i * 8);
+        }
+        if (headerLength > size - headerLengthSize)
+        {
+            return false;
+        }
+
+        Details::JsonReader reader = {{reinterpret_cast<const char*>(data + headerLengthSize), size_t(headerLength)}};
+        if (!reader.SkipCharacter('{'))
+        {
+            return false;
+        }
+        if (!reader.SkipCharacter('}'))
+        {
+            do
+            {
+                std::string name;
+                if (!reader.ReadString(/*out*/ name) || !reader.SkipCharacter(':'))
+                {
+                    return false;
+                }
+                if (name == "__metadata__")
+                {
+                    std::string_view metadata;
+                    if (!reader.SkipValue(/*out*/ metadata))
+                    {
+                        return false;
+                    }
+                    header.metadata = metadata;
+                    continue;
+                }
+
+                TensorInfo tensor;
+                tensor.name = std::move(name);
+                std::vector<uint64_t> dataOffsets;
+                if (!reader.SkipCharacter('{'))
+                {
+                    return false;
+                }
+                do
+                {
+                    std::string key;
+                    if (!reader.ReadString(/*out*/ key) || !reader.SkipCharacter(':'))
+                    {
+                        return false;
+                    }
+                    std::string_view ignoredValue;
+                    const bool succeeded = (key == "dtype") ? reader.ReadString(/*out*/ tensor.dtype)
+                                         : (key == "shape") ? reader.ReadIntegerArray(/*out*/ tensor.shape)
+                                         : (key == "data_offsets") ? reader.ReadIntegerArray(/*out*/ dataOffsets)
+                                         : reader.SkipValue(/*out*/ ignoredValue);
+                    if (!succeeded)
+                    {
+                        return false;
+                    }
+                } while (reader.SkipCharacter(','));
+                if (!reader.SkipCharacter('}') || dataOffsets.size() != 2 || dataOffsets[0] > dataOffsets[1])
+                {
+                    return false;
+                }
+                tensor.dataBegin = dataOffsets[0];
+                tensor.dataEnd = dataOffsets[1];
+                header.tensors.push_back(std::move(tensor));
+            } while (reader.SkipCharacter(','));
+
+            if (!reader.SkipCharacter('}'))
+            {
+                return false;
+            }
+        }
+
+        header.dataOffset = headerLengthSize + size_t(headerLength);
+        for (auto& tensor : header.tensors)
+        {
+            if (tensor.dataEnd > size - header.dataOffset)
+            {
+                return false;
+            }
+        }
+        std::stable_sort(
+            header.tensors.begin(),
+            header.tensors.end(),
+            [](const TensorInfo& a, const TensorInfo& b) { return a.dataBegin < b.dataBegin; }
+        );
+        return true;
+    }
+
+    // Whether the file plausibly starts with a safetensors header (a sane length and then a JSON object).
+    inline bool IsSafetensors(const uint8_t* data, size_t size) noexcept
+    {
+        if (size < 9 || data[8] != '{')
+        {
+            return false;
+        }
+        uint64_t headerLength = 0;
+        for (size_t i = 0; i < 8; ++i)
+        {
+            headerLength |= uint64_t(data[i]) << (i * 8);
+        }
+        return headerLength >= 2 && headerLength <= size - 8;
+    }
+
+    // Returns a complete header (length and JSON) for the tensors, in the given order, padding the
+    // JSON with spaces so the data region starts at a multiple of the alignment.
+    inline std::string MakeHeader(const std::vector<TensorInfo>& tensors, std::string_view metadata, size_t alignment = 8)
+    {
+        std::string json = "{";
+        if (!metadata.empty())
+        {
+            json.append("\"__metadata__\":");
+            json.append(metadata);
+        }
+        for (auto& tensor : tensors)
+        {
+            json.append(json.size() > 1 ? "," : "");
+            Details::AppendJsonString(/*inout*/ json, tensor.name);
+            json.append(":{\"dtype\":");
+            Details::AppendJsonString(/*inout*/ json, tensor.dtype);
+            json.append(",\"shape\":");
+            Details::AppendJsonIntegerArray(/*inout*/ json, tensor.shape.data(), tensor.shape.size());
+            json.append(",\"data_offsets\":");
+            const uint64_t dataOffsets[2] = {tensor.dataBegin, tensor.dataEnd};
+            Details::AppendJsonIntegerArray(/*inout*/ json, dataOffsets, 2);
+            json.push_back('}');
+        }
+        json.push_back('}');
+
+        constexpr size_t headerLengthSize = 8;
+        const size_t paddedSize = (headerLengthSize + json.size() + alignment - 1) / alignment * alignment;
+        json.resize(paddedSize - headerLengthSize, ' ');
+
+        std::string header(headerLengthSize, '\0');
+        for (size_t i = 0; i < headerLengthSize; ++i)
+        {
+            header[i] = char(uint64_t(json.size()) >> (i * 8));
+        }
+        header.append(json);
+        return header;
+    }
+}
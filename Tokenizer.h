@@ -0,0 +1,297 @@
+//-----------------------------------------------------------------------------
+//
+//  Tokenizing helpers for the command language, fast enough for command
+//  files with millions of tokens rather than just a few argv parameters.
+//
+//  Character classes are scanned 32 bytes at a time with AVX2 or 16 bytes at
+//  a time with SSE2/NEON, falling back to a byte loop for the tail. Tokens
+//  are returned as views into the original string without copying.
+//
+//  Keywords are found via a perfect hash table computed at compile time,
+//  so a lookup is one hash, one table read, and one string comparison.
+//
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <string_view>
+#include <bit>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define TOKENIZER_SSE2 1
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#include <arm_neon.h>
+#define TOKENIZER_NEON 1
+#endif
+
+namespace Tokenizer
+{
+    // Spaces and line breaks separate tokens (line breaks matter for command files).
+    constexpr bool IsSpace(char ch) noexcept
+    {
+        return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+    }
+
+    // Identifiers cover keywords and numbers (e.g. "float32", "-1.5e3", "0x7F", "fixed12_12").
+    // Any other character is a single character token, like parentheses and commas.
+    constexpr bool IsIdentifier(char ch) noexcept
+    {
+        return (ch >= '0' && ch <= '9')
+            || (ch >= 'A' && ch <= 'Z')
+            || (ch >= 'a' && ch <= 'z')
+            || (ch == '.')
+            || (ch == '-')
+            || (ch == '_');
+    }
+
+    namespace Details
+    {
+    #if defined(__AVX2__)
+        constexpr size_t blockSize = 32;
+        using Block = __m256i;
+
+        inline Block Load(const char* p) noexcept { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        inline Block Splat(char ch) noexcept { return _mm256_set1_epi8(ch); }
+        inline Block Equal(Block a, char ch) noexcept { return _mm256_cmpeq_epi8(a, Splat(ch)); }
+        inline Block Or(Block a, Block b) noexcept { return _mm256_or_si256(a, b); }
+        inline uint32_t ToMask(Block a) noexcept { return uint32_t(_mm256_movemask_epi8(a)); }
+
+        // Unsigned (ch - low) <= (high - low), using min since there is no unsigned byte compare.
+        inline Block InRange(Block a, char low, char high) noexcept
+        {
+            Block offset = _mm256_sub_epi8(a, Splat(low));
+            return _mm256_cmpeq_epi8(_mm256_min_epu8(offset, Splat(char(high - low))), offset);
+        }
+    #elif defined(TOKENIZER_SSE2)
+        constexpr size_t blockSize = 16;
+        using Block = __m128i;
+
+        inline Block Load(const char* p) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+        inline Block Splat(char ch) noexcept { return _mm_set1_epi8(ch); }
+        inline Block Equal(Block a, char ch) noexcept { return _mm_cmpeq_epi8(a, Splat(ch)); }
+        inline Block Or(Block a, Block b) noexcept { return _mm_or_si128(a, b); }
+        inline uint32_t ToMask(Block a) noexcept { return uint32_t(_mm_movemask_epi8(a)); }
+
+        inline Block InRange(Block a, char low, char high) noexcept
+        {
+            Block offset = _mm_sub_epi8(a, Splat(low));
+            return _mm_cmpeq_epi8(_mm_min_epu8(offset, Splat(char(high - low))), offset);
+        }
+    #elif defined(TOKENIZER_NEON)
+        constexpr size_t blockSize = 16;
+        using Block = uint8x16_t;
+
+        inline Block Load(const char* p) noexcept { return vld1q_u8(reinterpret_cast<const uint8_t*>(p)); }
+        inline Block Splat(char ch) noexcept { return vdupq_n_u8(uint8_t(ch)); }
+        inline Block Equal(Block a, char ch) noexcept { return vceqq_u8(a, Splat(ch)); }
+        inline Block Or(Block a, Block b) noexcept { return vorrq_u8(a, b); }
+
+        inline uint32_t ToMask(Block a) noexcept
+        {
+            // NEON lacks movemask, so weight each lane's bit and sum both halves horizontally.
+            const uint8_t bitWeights[16] = {1,2,4,8,16,32,64,128, 1,2,4,8,16,32,64,128};
+            Block bits = vandq_u8(a, vld1q_u8(bitWeights));
+            return uint32_t(vaddv_u8(vget_low_u8(bits))) | (uint32_t(vaddv_u8(vget_high_u8(bits))) << 8);
+        }
+
+        inline Block InRange(Block a, char low, char high) noexcept
+        {
+            return vcleq_u8(vsubq_u8(a, Splat(low)), Splat(char(high - low)));
+        }
+    #endif
+
+    #if defined(__AVX2__) || defined(TOKENIZER_SSE2) || defined(TOKENIZER_NEON)
+        #define TOKENIZER_SIMD 1
+
+        inline uint32_t GetSpaceMask(const char* p) noexcept
+        {
+            Block block = Load(p);
+            return ToMask(Or(Or(Equal(block, ' '), Equal(block, '\t')), Or(Equal(block, '\r'), Equal(block, '\n'))));
+        }
+
+        inline uint32_t GetIdentifierMask(const char* p) noexcept
+        {
+            Block block = Load(p);
+            Block lowercase = Or(block, Splat(0x20)); // Fold A-Z onto a-z.
+            Block letters = InRange(lowercase, 'a', 'z');
+            Block digits = InRange(block, '0', '9');
+            Block punctuation = Or(Or(Equal(block, '.'), Equal(block, '-')), Equal(block, '_'));
+            return ToMask(Or(Or(letters, digits), punctuation));
+        }
+    #endif
+
+        // Returns the index of the first character at or after i not in the class.
+        template <bool (*IsInClass)(char) noexcept, uint32_t (*GetClassMask)(const char*) noexcept>
+        size_t SkipClass(std::string_view s, size_t i) noexcept
+        {
+            const size_t size = s.size();
+        #if defined(TOKENIZER_SIMD)
+            constexpr uint32_t fullMask = uint32_t((uint64_t(1) << blockSize) - 1);
+            for (/*above*/; i + blockSize <= size; i += blockSize)
+            {
+                uint32_t mismatchMask = ~GetClassMask(s.data() + i) & fullMask;
+                if (mismatchMask != 0)
+                {
+                    return i + std::countr_zero(mismatchMask);
+                }
+            }
+        #endif
+            for (/*above*/; i < size && IsInClass(s[i]); ++i)
+            { }
+            return i;
+        }
+    }
+
+    inline size_t SkipSpaces(std::string_view s, size_t i = 0) noexcept
+    {
+        // Most tokens are separated by a single space, so check before setting up the vector scan.
+        if (i < s.size() && !IsSpace(s[i]))
+        {
+            return i;
+        }
+    #if defined(TOKENIZER_SIMD)
+        return Details::SkipClass<IsSpace, Details::GetSpaceMask>(s, i);
+    #else
+        return Details::SkipClass<IsSpace, nullptr>(s, i);
+    #endif
+    }
+
+    inline size_t SkipIdentifier(std::string_view s, size_t i = 0) noexcept
+    {
+    #if defined(TOKENIZER_SIMD)
+        return Details::SkipClass<IsIdentifier, Details::GetIdentifierMask>(s, i);
+    #else
+        return Details::SkipClass<IsIdentifier, nullptr>(s, i);
+    #endif
+    }
+
+    // Returns the next token after any leading spaces, either an identifier or a single other
+    // character, or an empty view pointing at the end.
+    inline std::string_view GetToken(std::string_view s) noexcept
+    {
+        const size_t i = SkipSpaces(s);
+        if (i >= s.size())
+        {
+            return {s.data() + s.size(), 0};
+        }
+        if (!IsIdentifier(s[i]))
+        {
+            return {s.data() + i, 1};
+        }
+        const size_t j = SkipIdentifier(s, i + 1);
+        return {s.data() + i, j - i};
+    }
+
+    // Returns the next space delimited word after any leading spaces, such as a file path,
+    // including any double quotes around it (which allow spaces within).
+    inline std::string_view GetWord(std::string_view s) noexcept
+    {
+        const size_t i = SkipSpaces(s);
+        size_t j = i;
+        if (j < s.size() && s[j] == '"')
+        {
+            j = s.find('"', j + 1);
+            j = (j == std::string_view::npos) ? s.size() : j + 1;
+        }
+        else
+        {
+            for (/*above*/; j < s.size() && !IsSpace(s[j]); ++j)
+            { }
+        }
+        return {s.data() + i, j - i};
+    }
+
+    inline std::string_view Unquote(std::string_view s) noexcept
+    {
+        if (s.size() >= 2 && s.front() == '"' && s.back() == '"')
+        {
+            return s.substr(1, s.size() - 2);
+        }
+        return s;
+    }
+
+    // Compile-time perfect hash over the names of a fixed array of entries (anything with a
+    // std::string_view name field). Each name maps to a distinct slot, so lookups never probe.
+    template <size_t SlotCount>
+    struct PerfectHashTable
+    {
+        static_assert((SlotCount & (SlotCount - 1)) == 0, "The slot count must be a power of two.");
+        static constexpr uint8_t emptySlot = 0xFF;
+
+        uint32_t seed = 0;
+        uint8_t slots[SlotCount] = {}; // Entry index per slot, or emptySlot.
+
+        // Seeded FNV-1a with a final mix, since the low bits select the slot.
+        static constexpr uint32_t Hash(std::string_view s, uint32_t seed) noexcept
+        {
+            uint32_t hash = 0x811C9DC5u ^ (seed * 0x9E3779B9u);
+            for (char ch : s)
+            {
+                hash ^= uint8_t(ch);
+                hash *= 0x01000193u;
+            }
+            hash ^= hash >> 16;
+            hash *= 0x7FEB352Du;
+            hash ^= hash >> 15;
+            return hash;
+        }
+
+        template <typename EntryType, size_t EntryCount>
+        static constexpr PerfectHashTable Make(const EntryType (&entries)[EntryCount])
+        {
+            static_assert(EntryCount < emptySlot, "Too many entries for 8-bit slot indices.");
+
+            // Try seeds until no two names collide. Slots are stamped with the seed generation
+            // rather than cleared each attempt, which keeps the compile-time evaluation cheap.
+            uint16_t slotGenerations[SlotCount] = {};
+            for (uint32_t seed = 0; seed < 0xFFFF; ++seed)
+            {
+                const uint16_t generation = uint16_t(seed + 1);
+                bool hasCollision = false;
+                for (auto& entry : entries)
+                {
+                    auto& slotGeneration = slotGenerations[Hash(entry.name, seed) & (SlotCount - 1)];
+                    if (slotGeneration == generation)
+                    {
+                        hasCollision = true;
+                        break;
+                    }
+                    slotGeneration = generation;
+                }
+
+                if (!hasCollision)
+                {
+                    PerfectHashTable table;
+                    table.seed = seed;
+                    for (auto& slot : table.slots)
+                    {
+                        slot = emptySlot;
+                    }
+                    for (size_t i = 0; i < EntryCount; ++i)
+                    {
+                        table.slots[Hash(entries[i].name, seed) & (SlotCount - 1)] = uint8_t(i);
+                    }
+                    return table;
+                }
+            }
+
+            throw "No perfect hash seed found (are there duplicate names?)."; // Fails compilation.
+        }
+
+        // Returns the matching entry, or null if the name is not in the table.
+        template <typename EntryType, size_t EntryCount>
+        constexpr const EntryType* Find(std::string_view name, const EntryType (&entries)[EntryCount]) const noexcept
+        {
+            const uint8_t index = slots[Hash(name, seed) & (SlotCount - 1)];
+            if (index == emptySlot || entries[index].name != name)
+            {
+                return nullptr;
+            }
+            return &entries[index];
+        }
+    };
+}
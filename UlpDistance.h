@@ -0,0 +1,208 @@
+//-----------------------------------------------------------------------------
+//
+//  Bulk distance in units in the last place (ulp) between two arrays of the
+//  same element type, for comparing computed results against a reference.
+//
+//  Each element's bits map to a monotonic integer order, so the distance is
+//  just the difference of the two ordinals, the count of representable
+//  values between them. Floats are sign-magnitude, which is turned into two's
+//  complement (negating the magnitude when the sign is set, so -0 and +0 are
+//  both 0), while integers and fixed point already are ordered (offsetting
+//  32 and 64-bit unsigned values to fit the signed compare).
+//
+//  SSE2 and NEON widen 1, 2, or 4 byte elements to 32-bit lanes, four at a
+//  time. Wider elements, other sizes, and the tails are computed one at a
+//  time.
+//
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define ULPDISTANCE_SSE2 1
+#elif defined(_M_ARM64) || defined(__aarch64__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define ULPDISTANCE_NEON 1
+#endif
+
+namespace Ulp
+{
+    // Distance written where exactly one of the pair is NaN, which no pair of floats can otherwise reach.
+    constexpr uint64_t nanMismatch = UINT64_MAX;
+
+    // How an element's bits are ordered, with all masks in the low bits of the element.
+    struct Layout
+    {
+        uint32_t elementByteSize;       // 1 to 8
+        uint64_t signMask;              // Of floats, else zero
+        uint64_t nanMagnitudeMinimum;   // Least magnitude (bits without the sign) of a float NaN, else zero
+        bool isSigned;                  // Two's complement integer or fixed point
+    };
+
+    namespace Details
+    {
+        inline int64_t GetOrdinal(uint64_t bits, const Layout& layout) noexcept
+        {
+            const uint32_t unusedBitCount = 64 - layout.elementByteSize * 8;
+            if (layout.signMask != 0)
+            {
+                const int64_t magnitude = int64_t(bits & ~layout.signMask);
+                return (bits & layout.signMask) ? -magnitude : magnitude;
+            }
+            if (layout.isSigned)
+            {
+                return int64_t(bits << unusedBitCount) >> unusedBitCount;
+            }
+            return (unusedBitCount == 0) ? int64_t(bits ^ (uint64_t(1) << 63)) : int64_t(bits);
+        }
+
+        inline bool IsNan(uint64_t bits, const Layout& layout) noexcept
+        {
+            return layout.nanMagnitudeMinimum != 0 && (bits & ~layout.signMask) >= layout.nanMagnitudeMinimum;
+        }
+
+        inline void ComputeUlpDistancesScalar(const uint8_t* a, const uint8_t* b, size_t begin, size_t end, const Layout& layout, /*out*/ uint64_t* distances) noexcept
+        {
+            const uint32_t elementByteSize = layout.elementByteSize;
+            for (size_t i = begin; i < end; ++i)
+            {
+                uint64_t bitsA = 0, bitsB = 0; // Little-endian
+                memcpy(&bitsA, a + i * elementByteSize, elementByteSize);
+                memcpy(&bitsB, b + i * elementByteSize, elementByteSize);
+                const bool isNanA = IsNan(bitsA, layout), isNanB = IsNan(bitsB, layout);
+                const int64_t ordinalA = GetOrdinal(bitsA, layout), ordinalB = GetOrdinal(bitsB, layout);
+                const uint64_t distance = (ordinalA > ordinalB) ? uint64_t(ordinalA) - uint64_t(ordinalB) : uint64_t(ordinalB) - uint64_t(ordinalA);
+                distances[i] = (isNanA | isNanB) ? (isNanA == isNanB ? 0 : nanMismatch) : distance;
+            }
+        }
+    }
+
+    // Writes the ulp distance between each pair of elements a[i] and b[i]. Two NaNs are equal
+    // regardless of payload, while a NaN paired with a number gets nanMismatch.
+    inline void ComputeUlpDistances(const uint8_t* a, const uint8_t* b, size_t count, const Layout& layout, /*out*/ uint64_t* distances) noexcept
+    {
+        size_t i = 0;
+        const uint32_t elementByteSize = layout.elementByteSize;
+    #if defined(ULPDISTANCE_SSE2) || defined(ULPDISTANCE_NEON)
+        if (elementByteSize == 1 || elementByteSize == 2 || elementByteSize == 4)
+        {
+            // Narrow elements are sign extended to the whole lane via a pair of shifts, and 32-bit
+            // unsigned ones flip the top bit so the signed lane compare orders them.
+            const uint32_t laneSignMask = uint32_t(layout.signMask);
+            const uint32_t laneMagnitudeMask = (laneSignMask != 0) ? ~uint32_t(0) >> (32 - elementByteSize * 8) & ~laneSignMask : ~uint32_t(0);
+            const uint32_t laneFlip = (!layout.isSigned && laneSignMask == 0 && elementByteSize == 4) ? 0x80000000u : 0u;
+            const int32_t laneNanThreshold = (layout.nanMagnitudeMinimum != 0) ? int32_t(layout.nanMagnitudeMinimum) - 1 : INT32_MAX;
+            const int32_t extensionShift = (layout.isSigned && elementByteSize < 4) ? 32 - int32_t(elementByteSize) * 8 : 0;
+        #if defined(ULPDISTANCE_SSE2)
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i signMask = _mm_set1_epi32(int32_t(laneSignMask));
+            const __m128i magnitudeMask = _mm_set1_epi32(int32_t(laneMagnitudeMask));
+            const __m128i flip = _mm_set1_epi32(int32_t(laneFlip));
+            const __m128i nanThreshold = _mm_set1_epi32(laneNanThreshold);
+            const __m128i shiftCount = _mm_cvtsi32_si128(extensionShift);
+
+            auto load = [&](const uint8_t* p) -> __m128i
+            {
+                __m128i x;
+                if (elementByteSize == 4)
+                {
+                    x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                }
+                else if (elementByteSize == 2)
+                {
+                    x = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)), zero);
+                }
+                else
+                {
+                    int32_t bytes;
+                    memcpy(&bytes, p, sizeof(bytes));
+                    x = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero), zero);
+                }
+                return _mm_sra_epi32(_mm_sll_epi32(x, shiftCount), shiftCount);
+            };
+            // Returns the ordinals, and sets isNan lanes to all ones.
+            auto getOrdinals = [&](__m128i x, /*out*/ __m128i& isNan) -> __m128i
+            {
+                const __m128i magnitude = _mm_and_si128(x, magnitudeMask);
+                const __m128i isNegative = _mm_xor_si128(_mm_cmpeq_epi32(_mm_and_si128(x, signMask), zero), _mm_set1_epi32(-1));
+                isNan = _mm_cmpgt_epi32(magnitude, nanThreshold);
+                return _mm_xor_si128(_mm_sub_epi32(_mm_xor_si128(magnitude, isNegative), isNegative), flip);
+            };
+
+            for (/*above*/; i + 4 <= count; i += 4)
+            {
+                __m128i isNanA, isNanB;
+                const __m128i ordinalA = getOrdinals(load(a + i * elementByteSize), /*out*/ isNanA);
+                const __m128i ordinalB = getOrdinals(load(b + i * elementByteSize), /*out*/ isNanB);
+                const __m128i isGreater = _mm_cmpgt_epi32(ordinalA, ordinalB);
+                __m128i distance = _mm_or_si128(
+                    _mm_and_si128(isGreater, _mm_sub_epi32(ordinalA, ordinalB)),
+                    _mm_andnot_si128(isGreater, _mm_sub_epi32(ordinalB, ordinalA))
+                );
+                // Two NaNs are 0 apart, and one NaN is all ones, which fills the upper half too.
+                const __m128i isMismatch = _mm_xor_si128(isNanA, isNanB);
+                distance = _mm_or_si128(_mm_andnot_si128(_mm_or_si128(isNanA, isNanB), distance), isMismatch);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(distances + i), _mm_unpacklo_epi32(distance, isMismatch));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(distances + i + 2), _mm_unpackhi_epi32(distance, isMismatch));
+            }
+        #elif defined(ULPDISTANCE_NEON)
+            const uint32x4_t signMask = vdupq_n_u32(laneSignMask);
+            const uint32x4_t magnitudeMask = vdupq_n_u32(laneMagnitudeMask);
+            const uint32x4_t flip = vdupq_n_u32(laneFlip);
+            const int32x4_t nanThreshold = vdupq_n_s32(laneNanThreshold);
+            const int32x4_t leftShift = vdupq_n_s32(extensionShift), rightShift = vdupq_n_s32(-extensionShift);
+
+            auto load = [&](const uint8_t* p) -> uint32x4_t
+            {
+                uint32x4_t x;
+                if (elementByteSize == 4)
+                {
+                    x = vld1q_u32(reinterpret_cast<const uint32_t*>(p));
+                }
+                else if (elementByteSize == 2)
+                {
+                    x = vmovl_u16(vld1_u16(reinterpret_cast<const uint16_t*>(p)));
+                }
+                else
+                {
+                    uint32_t bytes;
+                    memcpy(&bytes, p, sizeof(bytes));
+                    x = vmovl_u16(vget_low_u16(vmovl_u8(vcreate_u8(bytes))));
+                }
+                return vreinterpretq_u32_s32(vshlq_s32(vreinterpretq_s32_u32(vshlq_u32(x, leftShift)), rightShift));
+            };
+            auto getOrdinals = [&](uint32x4_t x, /*out*/ uint32x4_t& isNan) -> int32x4_t
+            {
+                const uint32x4_t magnitude = vandq_u32(x, magnitudeMask);
+                const uint32x4_t isNegative = vtstq_u32(x, signMask);
+                isNan = vcgtq_s32(vreinterpretq_s32_u32(magnitude), nanThreshold);
+                return vreinterpretq_s32_u32(veorq_u32(vsubq_u32(veorq_u32(magnitude, isNegative), isNegative), flip));
+            };
+
+            for (/*above*/; i + 4 <= count; i += 4)
+            {
+                uint32x4_t isNanA, isNanB;
+                const int32x4_t ordinalA = getOrdinals(load(a + i * elementByteSize), /*out*/ isNanA);
+                const int32x4_t ordinalB = getOrdinals(load(b + i * elementByteSize), /*out*/ isNanB);
+                const uint32x4_t isGreater = vcgtq_s32(ordinalA, ordinalB);
+                uint32x4_t distance = vbslq_u32(
+                    isGreater,
+                    vreinterpretq_u32_s32(vsubq_s32(ordinalA, ordinalB)),
+                    vreinterpretq_u32_s32(vsubq_s32(ordinalB, ordinalA))
+                );
+                const uint32x4_t isMismatch = veorq_u32(isNanA, isNanB);
+                distance = vorrq_u32(vbicq_u32(distance, vorrq_u32(isNanA, isNanB)), isMismatch);
+                vst2q_u32(reinterpret_cast<uint32_t*>(distances + i), uint32x4x2_t{{distance, isMismatch}});
+            }
+        #endif
+        }
+    #endif
+
+        Details::ComputeUlpDistancesScalar(a, b, i, count, layout, /*out*/ distances);
+    }
+}
@@ -0,0 +1,173 @@
+//-----------------------------------------------------------------------------
+//
+//  WAV (RIFF WAVE) audio file header parsing and writing.
+//
+//  A .wav file is a RIFF container of chunks, each a four character id, a
+//  32-bit little-endian size, and the chunk data padded to an even size:
+//
+//      "RIFF" size "WAVE" | "fmt " 16 {format, channels, rate, ...} | "data" size samples...
+//
+//  Other chunks (like LIST metadata or fact) are skipped. The samples are
+//  interleaved frames of little-endian PCM integers (8-bit unsigned, 16, 24,
+//  or 32-bit signed) or IEEE floats, returned as a byte range of the file for
+//  callers to map in place.
+//  https://learn.microsoft.com/en-us/windows/win32/api/mmreg/ns-mmreg-waveformatex
+//
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace Wav
+{
+    enum class Format : uint16_t
+    {
+        Pcm = 1,
+        Float = 3,
+        Extensible = 0xFFFE, // Real format is the first 2 bytes of the sub format GUID.
+    };
+
+    struct Header
+    {
+        Format format = Format::Pcm;    // Pcm or Float, after resolving Extensible
+        uint16_t channelCount = 0;
+        uint32_t sampleRate = 0;
+        uint16_t bitsPerSample = 0;
+        uint16_t blockAlign = 0;        // Bytes per frame of all channels
+        size_t dataOffset = 0;          // Byte offset of the samples in the file
+        size_t dataByteCount = 0;       // Clamped to the file size, for truncated recordings
+
+        uint64_t GetFrameCount() const noexcept
+        {
+            return blockAlign > 0 ? dataByteCount / blockAlign : 0;
+        }
+    };
+
+    inline bool IsWav(const uint8_t* data, size_t size) noexcept
+    {
+        return size >= 12 && memcmp(data, "RIFF", 4) == 0 && memcmp(data + 8, "WAVE", 4) == 0;
+    }
+
+    namespace Details
+    {
+        inline uint16_t Read16(const uint8_t* p) noexcept
+        {
+            return uint16_t(p[0] | (p[1] << 8));
+        }
+
+        inline uint32_t Read32(const uint8_t* p) noexcept
+        {
+            return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+        }
+
+        inline void Append16(/*inout*/ std::string& s, uint32_t value)
+        {
+            s.push_back(char(value & 0xFF));
+            s.push_back(char((value >> 8) & 0xFF));
+        }
+
+        inline void Append32(/*inout*/ std::string& s, uint32_t value)
+        {
+            Append16(/*inout*/ s, value & 0xFFFF);
+            Append16(/*inout*/ s, value >> 16);
+        }
+    }
+
+    // Parses the fmt and data chunks of a WAV file, returning false if either is missing or the
+    // format is neither PCM nor float (like ADPCM). The sample size is not validated, leaving
+    // callers to reject unusual depths like 12-bit.
+    inline bool ParseHeader(const uint8_t* data, size_t size, /*out*/ Header& header)
+    {
+        using namespace Details;
+        header = {};
+        if (!IsWav(data, size))
+        {
+            return false;
+        }
+
+        bool hasFormat = false, hasData = false;
+        for (size_t offset = 12; !hasData && offset + 8 <= size; /*below*/)
+        {
+            const uint8_t* chunk = data + offset;
+            const size_t chunkSize = Read32(chunk + 4);
+            const size_t chunkBegin = offset + 8;
+            const size_t chunkAvailable = std::min(chunkSize, size - chunkBegin);
+
+            if (memcmp(chunk, "fmt ", 4) == 0)
+            {
+                if (chunkAvailable < 16)
+                {
+                    return false;
+                }
+                const uint8_t* format = data + chunkBegin;
+                header.format = Format(Read16(format));
+                header.channelCount = Read16(format + 2);
+                header.sampleRate = Read32(format + 4);
+                header.blockAlign = Read16(format + 12);
+                header.bitsPerSample = Read16(format + 14);
+                if (header.format == Format::Extensible)
+                {
+                    if (chunkAvailable < 40)
+                    {
+                        return false;
+                    }
+                    header.format = Format(Read16(format + 24));
+                }
+                hasFormat = true;
+            }
+            else if (memcmp(chunk, "data", 4) == 0)
+            {
+                // Streaming recorders write 0 or 0xFFFFFFFF until finished, so take the rest of the file then.
+                header.dataOffset = chunkBegin;
+                header.dataByteCount = (chunkSize == 0 || chunkSize == 0xFFFFFFFF) ? size - chunkBegin : chunkAvailable;
+                hasData = true;
+            }
+
+            if (chunkSize > size - chunkBegin)
+            {
+                break;
+            }
+            offset = chunkBegin + chunkSize + (chunkSize & 1);
+        }
+
+        return hasFormat && hasData
+            && (header.format == Format::Pcm || header.format == Format::Float)
+            && header.channelCount > 0
+            && header.blockAlign > 0;
+    }
+
+    // Returns a canonical 44 byte header for the given sample data size, or with an alignment over
+    // 1, a JUNK chunk before the data chunk pads it so the samples start at a multiple of the
+    // alignment (which must be even and at least 64). For simplicity, integer samples over 16 bits
+    // use plain PCM rather than Extensible, which nearly all readers accept.
+    inline std::string MakeHeader(Format format, uint16_t channelCount, uint32_t sampleRate, uint16_t bitsPerSample, uint32_t dataByteCount, size_t alignment = 1)
+    {
+        using namespace Details;
+        constexpr uint32_t canonicalSize = 44, chunkHeaderSize = 8;
+        const uint32_t junkSize = (alignment > 1) ? uint32_t(alignment - canonicalSize % alignment) : 0;
+        const uint32_t blockAlign = channelCount * ((bitsPerSample + 7u) / 8u);
+        std::string header = "RIFF";
+        Append32(/*inout*/ header, canonicalSize - chunkHeaderSize + junkSize + dataByteCount);
+        header.append("WAVEfmt ");
+        Append32(/*inout*/ header, 16);
+        Append16(/*inout*/ header, uint32_t(format));
+        Append16(/*inout*/ header, channelCount);
+        Append32(/*inout*/ header, sampleRate);
+        Append32(/*inout*/ header, sampleRate * blockAlign);
+        Append16(/*inout*/ header, blockAlign);
+        Append16(/*inout*/ header, bitsPerSample);
+        if (junkSize > 0)
+        {
+            header.append("JUNK");
+            Append32(/*inout*/ header, junkSize - chunkHeaderSize);
+            header.append(junkSize - chunkHeaderSize, '\0');
+        }
+        header.append("data");
+        Append32(/*inout*/ header, dataByteCount);
+        return header;
+    }
+}